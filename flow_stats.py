@@ -0,0 +1,72 @@
+import mmap
+import struct
+
+import numpy as np
+
+# Layout written by ExportFlowStatsToMapped (scratch/adaptive-tcp/lib/flow-stats-recorder.h)
+MAGIC = b'FSMAP001'
+HEADER = struct.Struct('=8sIIII')
+FLOW_ENTRY = struct.Struct('=II')
+SERIES_ENTRY = struct.Struct('=IIIIQQQ')
+
+METRICS = ['throughputs', 'cwnds', 'rtts', 'lastRtts', 'rtos', 'congestionStates',
+           'bytesInFlights', 'pacingRates']
+STATISTICS = ['', 'Min', 'Max', 'Mean']
+
+
+class FlowStatsFile:
+    """Zero-copy reader of the .fsm files written by adaptive-tcp-test --format=mmap.
+
+    Series are numpy views on the mapped file, so only the pages that are
+    actually sliced are read from disk.
+    """
+
+    def __init__(self, path):
+        with open(path, 'rb') as f:
+            self._mmap = mmap.mmap(f.fileno(), 0, access=mmap.ACCESS_READ)
+
+        magic, version, flow_count, series_count, names_size = HEADER.unpack_from(self._mmap, 0)
+        if magic != MAGIC or version != 1:
+            raise ValueError(f'{path} is not a mapped flow stats file')
+
+        offset = HEADER.size
+        flow_table = [FLOW_ENTRY.unpack_from(self._mmap, offset + i * FLOW_ENTRY.size)
+                      for i in range(flow_count)]
+        offset += flow_count * FLOW_ENTRY.size
+
+        self._series = {}
+        for i in range(series_count):
+            flow, metric, statistic, _, count, times, values = SERIES_ENTRY.unpack_from(
+                self._mmap, offset + i * SERIES_ENTRY.size)
+            self._series[(flow, METRICS[metric] + STATISTICS[statistic])] = (count, times, values)
+        offset += series_count * SERIES_ENTRY.size
+
+        names = self._mmap[offset:offset + names_size].decode()
+        self.flows = [names[start:start + length] for start, length in flow_table]
+
+    def series_names(self, flow):
+        return sorted(name for f, name in self._series if f == flow)
+
+    def series(self, flow, name, t_start=None, t_end=None, max_points=None):
+        """Return the (times, values) arrays of a series of a flow.
+
+        t_start and t_end select a time range with a binary search, and
+        max_points decimates the range with a stride. Without decimation the
+        arrays are views on the mapped file.
+        """
+        if (flow, name) not in self._series:
+            return np.empty(0), np.empty(0)
+        count, times_offset, values_offset = self._series[(flow, name)]
+        times = np.frombuffer(self._mmap, dtype=np.float64, count=count, offset=times_offset)
+        values = np.frombuffer(self._mmap, dtype=np.float64, count=count, offset=values_offset)
+
+        first = 0 if t_start is None else np.searchsorted(times, t_start, side='left')
+        last = count if t_end is None else np.searchsorted(times, t_end, side='right')
+        step = 1
+        if max_points and last - first > max_points:
+            step = -(-(last - first) // max_points)
+        return times[first:last:step], values[first:last:step]
+
+    def close(self):
+        # Only possible once no array returned by series() is alive anymore
+        self._mmap.close()
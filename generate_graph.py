@@ -1,7 +1,10 @@
 import json
 import matplotlib.pyplot as plt
+import numpy as np
 import fire
 
+from flow_stats import FlowStatsFile
+
 DIMENSION_INFO = {
     'cwnds': {
         'title': 'Congestion Window (cwnd) over Time for Different CCAs',
@@ -17,20 +20,42 @@ DIMENSION_INFO = {
     }
 }
 
-def plot_dimension(data, dimension, sample_one_cca, output_file='plot.png'):
+def load_json_series(json_file):
+    # Returns a function giving the (cca, times, values) of every flow for a dimension
+    with open(json_file, 'r') as f:
+        data = json.load(f)
+
+    def series(dimension, t_start, t_end, max_points):
+        for cca_data in data:
+            points = np.asarray(cca_data.get(dimension, []), dtype=np.float64).reshape(-1, 2)
+            times, values = points[:, 0], points[:, 1]
+            first = 0 if t_start is None else np.searchsorted(times, t_start, side='left')
+            last = len(times) if t_end is None else np.searchsorted(times, t_end, side='right')
+            step = max(1, -(-(last - first) // max_points)) if max_points else 1
+            yield cca_data['cca'], times[first:last:step], values[first:last:step]
+
+    return series
+
+def load_mapped_series(fsm_file):
+    stats = FlowStatsFile(fsm_file)
+
+    def series(dimension, t_start, t_end, max_points):
+        for flow, cca in enumerate(stats.flows):
+            times, values = stats.series(flow, dimension, t_start, t_end, max_points)
+            yield cca, times, values
+
+    return series
+
+def plot_dimension(series, dimension, sample_one_cca, output_file='plot.png',
+                   t_start=None, t_end=None, max_points=None):
     plt.figure(figsize=(10, 6))
     seen_ccas = set()
 
-    for cca_data in data:
-        cca = cca_data['cca']
+    for cca, times, dim_values in series(dimension, t_start, t_end, max_points):
         if sample_one_cca and cca in seen_ccas:
             continue
         seen_ccas.add(cca)
-        values = cca_data[dimension]
-        
-        times = [point[0] for point in values]
-        dim_values = [point[1] for point in values]
-        
+
         opacity = 1.0 if cca == 'ns3::AdaptiveTcp' else 0.5
 
         plt.plot(times, dim_values, label=cca, linewidth=0.5, alpha=opacity)
@@ -48,17 +73,22 @@ def generate_graph(
         json_file='ns-allinone-3.43/ns-3.43/100Mbps-2ms-50p.json',
         output_file='plot.png',
         dimension='all',
-        sample_one_cca=True):
-    # Load the JSON data from the file
-    with open(json_file, 'r') as f:
-        data = json.load(f)
+        sample_one_cca=True,
+        t_start=None,
+        t_end=None,
+        max_points=200000):
+    # .fsm files (adaptive-tcp-test --format=mmap) are sliced in place, anything else is read as JSON
+    if json_file.endswith('.fsm'):
+        series = load_mapped_series(json_file)
+    else:
+        series = load_json_series(json_file)
 
     dimensions = ['cwnds', 'throughputs', 'rtts']
     if dimension == 'all':
         for dim in dimensions:
-            plot_dimension(data, dim, sample_one_cca, output_file)
+            plot_dimension(series, dim, sample_one_cca, output_file, t_start, t_end, max_points)
     else:
-        plot_dimension(data, dimension, sample_one_cca, output_file)
+        plot_dimension(series, dimension, sample_one_cca, output_file, t_start, t_end, max_points)
 
 if __name__ == '__main__':
-    fire.Fire(generate_graph)
\ No newline at end of file
+    fire.Fire(generate_graph)
@@ -0,0 +1,39 @@
+#----------------------------------------------------------------
+# Generated CMake target import file for configuration "release".
+#----------------------------------------------------------------
+
+# Commands may need to know the format version.
+set(CMAKE_IMPORT_FILE_VERSION 1)
+
+# Import target "ns3::core" for configuration "release"
+set_property(TARGET ns3::core APPEND PROPERTY IMPORTED_CONFIGURATIONS RELEASE)
+set_target_properties(ns3::core PROPERTIES
+  IMPORTED_LOCATION_RELEASE "${_IMPORT_PREFIX}/lib/libns3.43-core.so"
+  IMPORTED_SONAME_RELEASE "libns3.43-core.so"
+  )
+
+list(APPEND _cmake_import_check_targets ns3::core )
+list(APPEND _cmake_import_check_files_for_ns3::core "${_IMPORT_PREFIX}/lib/libns3.43-core.so" )
+
+# Import target "ns3::network" for configuration "release"
+set_property(TARGET ns3::network APPEND PROPERTY IMPORTED_CONFIGURATIONS RELEASE)
+set_target_properties(ns3::network PROPERTIES
+  IMPORTED_LOCATION_RELEASE "${_IMPORT_PREFIX}/lib/libns3.43-network.so"
+  IMPORTED_SONAME_RELEASE "libns3.43-network.so"
+  )
+
+list(APPEND _cmake_import_check_targets ns3::network )
+list(APPEND _cmake_import_check_files_for_ns3::network "${_IMPORT_PREFIX}/lib/libns3.43-network.so" )
+
+# Import target "ns3::stats" for configuration "release"
+set_property(TARGET ns3::stats APPEND PROPERTY IMPORTED_CONFIGURATIONS RELEASE)
+set_target_properties(ns3::stats PROPERTIES
+  IMPORTED_LOCATION_RELEASE "${_IMPORT_PREFIX}/lib/libns3.43-stats.so"
+  IMPORTED_SONAME_RELEASE "libns3.43-stats.so"
+  )
+
+list(APPEND _cmake_import_check_targets ns3::stats )
+list(APPEND _cmake_import_check_files_for_ns3::stats "${_IMPORT_PREFIX}/lib/libns3.43-stats.so" )
+
+# Commands beyond this point should not need to know the version.
+set(CMAKE_IMPORT_FILE_VERSION)
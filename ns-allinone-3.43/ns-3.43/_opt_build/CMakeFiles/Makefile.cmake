@@ -0,0 +1,154 @@
+# CMAKE generated file: DO NOT EDIT!
+# Generated by "Unix Makefiles" Generator, CMake Version 3.25
+
+# The generator used is:
+set(CMAKE_DEPENDS_GENERATOR "Unix Makefiles")
+
+# The top level Makefile was generated from the following files:
+set(CMAKE_MAKEFILE_DEPENDS
+  "CMakeCache.txt"
+  "/root/repo/ns-allinone-3.43/ns-3.43/CMakeLists.txt"
+  "CMakeFiles/3.25.1/CMakeCCompiler.cmake"
+  "CMakeFiles/3.25.1/CMakeCXXCompiler.cmake"
+  "CMakeFiles/3.25.1/CMakeSystem.cmake"
+  "CMakeFiles/VerifyGlobs.cmake"
+  "CMakeFiles/cmake.verify_globs"
+  "/root/repo/ns-allinone-3.43/ns-3.43/build-support/3rd-party/FindEigen3.cmake"
+  "/root/repo/ns-allinone-3.43/ns-3.43/build-support/3rd-party/FindHarfBuzz.cmake"
+  "/root/repo/ns-allinone-3.43/ns-3.43/build-support/3rd-party/FindSphinx.cmake"
+  "/root/repo/ns-allinone-3.43/ns-3.43/build-support/3rd-party/colored-messages.cmake"
+  "/root/repo/ns-allinone-3.43/ns-3.43/build-support/3rd-party/find-program-hints.cmake"
+  "/root/repo/ns-allinone-3.43/ns-3.43/build-support/Config.cmake.in"
+  "/root/repo/ns-allinone-3.43/ns-3.43/build-support/config-store-config-template.h"
+  "/root/repo/ns-allinone-3.43/ns-3.43/build-support/core-config-template.h"
+  "/root/repo/ns-allinone-3.43/ns-3.43/build-support/custom-modules/ns3-check-dependencies.cmake"
+  "/root/repo/ns-allinone-3.43/ns-3.43/build-support/custom-modules/ns3-cmake-package.cmake"
+  "/root/repo/ns-allinone-3.43/ns-3.43/build-support/custom-modules/ns3-compiler-and-linker-support.cmake"
+  "/root/repo/ns-allinone-3.43/ns-3.43/build-support/custom-modules/ns3-compiler-workarounds.cmake"
+  "/root/repo/ns-allinone-3.43/ns-3.43/build-support/custom-modules/ns3-configtable.cmake"
+  "/root/repo/ns-allinone-3.43/ns-3.43/build-support/custom-modules/ns3-contributions.cmake"
+  "/root/repo/ns-allinone-3.43/ns-3.43/build-support/custom-modules/ns3-executables.cmake"
+  "/root/repo/ns-allinone-3.43/ns-3.43/build-support/custom-modules/ns3-filter-modules.cmake"
+  "/root/repo/ns-allinone-3.43/ns-3.43/build-support/custom-modules/ns3-find-external-library.cmake"
+  "/root/repo/ns-allinone-3.43/ns-3.43/build-support/custom-modules/ns3-hidden-settings.cmake"
+  "/root/repo/ns-allinone-3.43/ns-3.43/build-support/custom-modules/ns3-lock.cmake"
+  "/root/repo/ns-allinone-3.43/ns-3.43/build-support/custom-modules/ns3-module-macros.cmake"
+  "/root/repo/ns-allinone-3.43/ns-3.43/build-support/custom-modules/ns3-ns3rc-parser.cmake"
+  "/root/repo/ns-allinone-3.43/ns-3.43/build-support/custom-modules/ns3-output-directory.cmake"
+  "/root/repo/ns-allinone-3.43/ns-3.43/build-support/custom-modules/ns3-platform-support.cmake"
+  "/root/repo/ns-allinone-3.43/ns-3.43/build-support/custom-modules/ns3-vcpkg-hunter.cmake"
+  "/root/repo/ns-allinone-3.43/ns-3.43/build-support/custom-modules/ns3-versioning.cmake"
+  "/root/repo/ns-allinone-3.43/ns-3.43/build-support/macros-and-definitions.cmake"
+  "/root/repo/ns-allinone-3.43/ns-3.43/build-support/pkgconfig-template.pc.in"
+  "/root/repo/ns-allinone-3.43/ns-3.43/examples/CMakeLists.txt"
+  "/root/repo/ns-allinone-3.43/ns-3.43/scratch/CMakeLists.txt"
+  "/root/repo/ns-allinone-3.43/ns-3.43/scratch/adaptive-tcp/CMakeLists.txt"
+  "/root/repo/ns-allinone-3.43/ns-3.43/src/CMakeLists.txt"
+  "/root/repo/ns-allinone-3.43/ns-3.43/src/core/CMakeLists.txt"
+  "/root/repo/ns-allinone-3.43/ns-3.43/src/network/CMakeLists.txt"
+  "/root/repo/ns-allinone-3.43/ns-3.43/src/stats/CMakeLists.txt"
+  "/root/repo/ns-allinone-3.43/ns-3.43/utils/CMakeLists.txt"
+  "/usr/lib/x86_64-linux-gnu/cmake/Boost-1.74.0/BoostConfig.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/Boost-1.74.0/BoostConfigVersion.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/boost_headers-1.74.0/boost_headers-config-version.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/boost_headers-1.74.0/boost_headers-config.cmake"
+  "/usr/share/cmake-3.25/Modules/BasicConfigVersion-ExactVersion.cmake.in"
+  "/usr/share/cmake-3.25/Modules/CMakeCInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCXXInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCommonLanguageInclude.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeGenericSystem.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeInitializeConfigs.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeLanguageInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakePackageConfigHelpers.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeSystemSpecificInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeSystemSpecificInitialize.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckCSourceCompiles.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckCXXSourceCompiles.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckFunctionExists.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckIncludeFile.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckIncludeFileCXX.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckIncludeFiles.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckLibraryExists.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/CMakeCommonCompilerMacros.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU-C.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU-CXX.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU.cmake"
+  "/usr/share/cmake-3.25/Modules/FindBoost.cmake"
+  "/usr/share/cmake-3.25/Modules/FindGSL.cmake"
+  "/usr/share/cmake-3.25/Modules/FindGit.cmake"
+  "/usr/share/cmake-3.25/Modules/FindLibXml2.cmake"
+  "/usr/share/cmake-3.25/Modules/FindPackageHandleStandardArgs.cmake"
+  "/usr/share/cmake-3.25/Modules/FindPackageMessage.cmake"
+  "/usr/share/cmake-3.25/Modules/FindPkgConfig.cmake"
+  "/usr/share/cmake-3.25/Modules/FindThreads.cmake"
+  "/usr/share/cmake-3.25/Modules/GNUInstallDirs.cmake"
+  "/usr/share/cmake-3.25/Modules/Internal/CheckSourceCompiles.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU-C.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU-CXX.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/UnixPaths.cmake"
+  "/usr/share/cmake-3.25/Modules/ProcessorCount.cmake"
+  "/usr/share/cmake-3.25/Modules/WriteBasicConfigVersionFile.cmake"
+  )
+
+# The corresponding makefile is:
+set(CMAKE_MAKEFILE_OUTPUTS
+  "Makefile"
+  "CMakeFiles/cmake.check_cache"
+  )
+
+# Byproducts of CMake generate step:
+set(CMAKE_MAKEFILE_PRODUCTS
+  "/root/repo/ns-allinone-3.43/ns-3.43/build/include/ns3/config-store-config.h"
+  "/root/repo/ns-allinone-3.43/ns-3.43/build/include/ns3/core-config.h"
+  "pkgconfig/ns3-stats.pc"
+  "pkgconfig/ns3-network.pc"
+  "pkgconfig/ns3-core.pc"
+  "ns3Config.cmake"
+  "ns3ConfigVersion.cmake"
+  "CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/core/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/network/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/stats/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "examples/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "scratch/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "scratch/adaptive-tcp/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "utils/CMakeFiles/CMakeDirectoryInformation.cmake"
+  )
+
+# Dependency information for all targets:
+set(CMAKE_DEPEND_INFO_FILES
+  "CMakeFiles/uninstall.dir/DependInfo.cmake"
+  "CMakeFiles/copy_all_headers.dir/DependInfo.cmake"
+  "CMakeFiles/check-version.dir/DependInfo.cmake"
+  "CMakeFiles/run-print-introspected-doxygen.dir/DependInfo.cmake"
+  "CMakeFiles/run-introspected-command-line.dir/DependInfo.cmake"
+  "CMakeFiles/assemble-introspected-command-line.dir/DependInfo.cmake"
+  "CMakeFiles/update_doxygen_version.dir/DependInfo.cmake"
+  "CMakeFiles/doxygen.dir/DependInfo.cmake"
+  "CMakeFiles/doxygen-no-build.dir/DependInfo.cmake"
+  "CMakeFiles/sphinx.dir/DependInfo.cmake"
+  "CMakeFiles/sphinx_manual.dir/DependInfo.cmake"
+  "CMakeFiles/sphinx_models.dir/DependInfo.cmake"
+  "CMakeFiles/sphinx_tutorial.dir/DependInfo.cmake"
+  "CMakeFiles/sphinx_contributing.dir/DependInfo.cmake"
+  "CMakeFiles/sphinx_installation.dir/DependInfo.cmake"
+  "CMakeFiles/uninstall_pkgconfig_stats.dir/DependInfo.cmake"
+  "CMakeFiles/uninstall_pkgconfig_network.dir/DependInfo.cmake"
+  "CMakeFiles/uninstall_pkgconfig_core.dir/DependInfo.cmake"
+  "src/core/CMakeFiles/core.dir/DependInfo.cmake"
+  "src/network/CMakeFiles/network.dir/DependInfo.cmake"
+  "src/stats/CMakeFiles/stats.dir/DependInfo.cmake"
+  "scratch/adaptive-tcp/CMakeFiles/scratch-nested-subdir-lib.dir/DependInfo.cmake"
+  "scratch/adaptive-tcp/CMakeFiles/scratch_adaptive-tcp_adaptive-tcp-test.dir/DependInfo.cmake"
+  "utils/CMakeFiles/bench-scheduler.dir/DependInfo.cmake"
+  "utils/CMakeFiles/bench-inject.dir/DependInfo.cmake"
+  "utils/CMakeFiles/decode-log.dir/DependInfo.cmake"
+  "utils/CMakeFiles/bench-random-variable.dir/DependInfo.cmake"
+  "utils/CMakeFiles/bench-packets.dir/DependInfo.cmake"
+  "utils/CMakeFiles/bench-config.dir/DependInfo.cmake"
+  "utils/CMakeFiles/print-introspected-doxygen.dir/DependInfo.cmake"
+  "utils/CMakeFiles/perf-io.dir/DependInfo.cmake"
+  )
@@ -0,0 +1,23 @@
+# CMAKE generated file: DO NOT EDIT!
+# Generated by CMake Version 3.25
+cmake_policy(SET CMP0009 NEW)
+
+# scratch_subdirectories at scratch/CMakeLists.txt:83 (file)
+file(GLOB NEW_GLOB LIST_DIRECTORIES true "/root/repo/ns-allinone-3.43/ns-3.43/scratch/**")
+set(OLD_GLOB
+  "/root/repo/ns-allinone-3.43/ns-3.43/scratch/CMakeLists.txt"
+  "/root/repo/ns-allinone-3.43/ns-3.43/scratch/adaptive-tcp"
+  )
+if(NOT "${NEW_GLOB}" STREQUAL "${OLD_GLOB}")
+  message("-- GLOB mismatch!")
+  file(TOUCH_NOCREATE "/root/repo/ns-allinone-3.43/ns-3.43/_opt_build/CMakeFiles/cmake.verify_globs")
+endif()
+
+# single_source_file_scratches at scratch/CMakeLists.txt:77 (file)
+file(GLOB NEW_GLOB LIST_DIRECTORIES true "/root/repo/ns-allinone-3.43/ns-3.43/scratch/[^.]*.cc")
+set(OLD_GLOB
+  )
+if(NOT "${NEW_GLOB}" STREQUAL "${OLD_GLOB}")
+  message("-- GLOB mismatch!")
+  file(TOUCH_NOCREATE "/root/repo/ns-allinone-3.43/ns-3.43/_opt_build/CMakeFiles/cmake.verify_globs")
+endif()
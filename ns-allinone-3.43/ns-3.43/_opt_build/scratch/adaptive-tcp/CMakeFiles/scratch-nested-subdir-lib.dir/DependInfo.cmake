@@ -0,0 +1,27 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/ns-allinone-3.43/ns-3.43/scratch/adaptive-tcp/lib/dumbbell-scenario.cc" "scratch/adaptive-tcp/CMakeFiles/scratch-nested-subdir-lib.dir/lib/dumbbell-scenario.cc.o" "gcc" "scratch/adaptive-tcp/CMakeFiles/scratch-nested-subdir-lib.dir/lib/dumbbell-scenario.cc.o.d"
+  "/root/repo/ns-allinone-3.43/ns-3.43/scratch/adaptive-tcp/lib/flow-stats-recorder.cc" "scratch/adaptive-tcp/CMakeFiles/scratch-nested-subdir-lib.dir/lib/flow-stats-recorder.cc.o" "gcc" "scratch/adaptive-tcp/CMakeFiles/scratch-nested-subdir-lib.dir/lib/flow-stats-recorder.cc.o.d"
+  "/root/repo/ns-allinone-3.43/ns-3.43/scratch/adaptive-tcp/lib/recording-policy.cc" "scratch/adaptive-tcp/CMakeFiles/scratch-nested-subdir-lib.dir/lib/recording-policy.cc.o" "gcc" "scratch/adaptive-tcp/CMakeFiles/scratch-nested-subdir-lib.dir/lib/recording-policy.cc.o.d"
+  "/root/repo/ns-allinone-3.43/ns-3.43/scratch/adaptive-tcp/lib/run-metrics.cc" "scratch/adaptive-tcp/CMakeFiles/scratch-nested-subdir-lib.dir/lib/run-metrics.cc.o" "gcc" "scratch/adaptive-tcp/CMakeFiles/scratch-nested-subdir-lib.dir/lib/run-metrics.cc.o.d"
+  "/root/repo/ns-allinone-3.43/ns-3.43/scratch/adaptive-tcp/lib/scratch-nested-subdir-library-source.cc" "scratch/adaptive-tcp/CMakeFiles/scratch-nested-subdir-lib.dir/lib/scratch-nested-subdir-library-source.cc.o" "gcc" "scratch/adaptive-tcp/CMakeFiles/scratch-nested-subdir-lib.dir/lib/scratch-nested-subdir-library-source.cc.o.d"
+  "/root/repo/ns-allinone-3.43/ns-3.43/scratch/adaptive-tcp/lib/simulation-fork.cc" "scratch/adaptive-tcp/CMakeFiles/scratch-nested-subdir-lib.dir/lib/simulation-fork.cc.o" "gcc" "scratch/adaptive-tcp/CMakeFiles/scratch-nested-subdir-lib.dir/lib/simulation-fork.cc.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/ns-allinone-3.43/ns-3.43/_opt_build/src/network/CMakeFiles/network.dir/DependInfo.cmake"
+  "/root/repo/ns-allinone-3.43/ns-3.43/_opt_build/src/stats/CMakeFiles/stats.dir/DependInfo.cmake"
+  "/root/repo/ns-allinone-3.43/ns-3.43/_opt_build/src/core/CMakeFiles/core.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,21 @@
+file(REMOVE_RECURSE
+  "/root/repo/ns-allinone-3.43/ns-3.43/build/lib/libscratch-nested-subdir-lib.a"
+  "/root/repo/ns-allinone-3.43/ns-3.43/build/lib/libscratch-nested-subdir-lib.pdb"
+  "CMakeFiles/scratch-nested-subdir-lib.dir/lib/dumbbell-scenario.cc.o"
+  "CMakeFiles/scratch-nested-subdir-lib.dir/lib/dumbbell-scenario.cc.o.d"
+  "CMakeFiles/scratch-nested-subdir-lib.dir/lib/flow-stats-recorder.cc.o"
+  "CMakeFiles/scratch-nested-subdir-lib.dir/lib/flow-stats-recorder.cc.o.d"
+  "CMakeFiles/scratch-nested-subdir-lib.dir/lib/recording-policy.cc.o"
+  "CMakeFiles/scratch-nested-subdir-lib.dir/lib/recording-policy.cc.o.d"
+  "CMakeFiles/scratch-nested-subdir-lib.dir/lib/run-metrics.cc.o"
+  "CMakeFiles/scratch-nested-subdir-lib.dir/lib/run-metrics.cc.o.d"
+  "CMakeFiles/scratch-nested-subdir-lib.dir/lib/scratch-nested-subdir-library-source.cc.o"
+  "CMakeFiles/scratch-nested-subdir-lib.dir/lib/scratch-nested-subdir-library-source.cc.o.d"
+  "CMakeFiles/scratch-nested-subdir-lib.dir/lib/simulation-fork.cc.o"
+  "CMakeFiles/scratch-nested-subdir-lib.dir/lib/simulation-fork.cc.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/scratch-nested-subdir-lib.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,3 @@
+file(REMOVE_RECURSE
+  "/root/repo/ns-allinone-3.43/ns-3.43/build/lib/libscratch-nested-subdir-lib.a"
+)
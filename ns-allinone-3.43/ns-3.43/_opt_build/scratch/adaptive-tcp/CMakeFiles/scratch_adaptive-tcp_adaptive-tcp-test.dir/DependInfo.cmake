@@ -0,0 +1,23 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/ns-allinone-3.43/ns-3.43/scratch/adaptive-tcp/adaptive-tcp-test.cc" "scratch/adaptive-tcp/CMakeFiles/scratch_adaptive-tcp_adaptive-tcp-test.dir/adaptive-tcp-test.cc.o" "gcc" "scratch/adaptive-tcp/CMakeFiles/scratch_adaptive-tcp_adaptive-tcp-test.dir/adaptive-tcp-test.cc.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/ns-allinone-3.43/ns-3.43/_opt_build/scratch/adaptive-tcp/CMakeFiles/scratch-nested-subdir-lib.dir/DependInfo.cmake"
+  "/root/repo/ns-allinone-3.43/ns-3.43/_opt_build/src/network/CMakeFiles/network.dir/DependInfo.cmake"
+  "/root/repo/ns-allinone-3.43/ns-3.43/_opt_build/src/stats/CMakeFiles/stats.dir/DependInfo.cmake"
+  "/root/repo/ns-allinone-3.43/ns-3.43/_opt_build/src/core/CMakeFiles/core.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "/root/repo/ns-allinone-3.43/ns-3.43/build/scratch/adaptive-tcp/ns3.43-adaptive-tcp-test"
+  "/root/repo/ns-allinone-3.43/ns-3.43/build/scratch/adaptive-tcp/ns3.43-adaptive-tcp-test.pdb"
+  "CMakeFiles/scratch_adaptive-tcp_adaptive-tcp-test.dir/adaptive-tcp-test.cc.o"
+  "CMakeFiles/scratch_adaptive-tcp_adaptive-tcp-test.dir/adaptive-tcp-test.cc.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/scratch_adaptive-tcp_adaptive-tcp-test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,151 @@
+file(REMOVE_RECURSE
+  "/root/repo/ns-allinone-3.43/ns-3.43/build/lib/libns3.43-core.pdb"
+  "/root/repo/ns-allinone-3.43/ns-3.43/build/lib/libns3.43-core.so"
+  "CMakeFiles/core.dir/helper/csv-reader.cc.o"
+  "CMakeFiles/core.dir/helper/csv-reader.cc.o.d"
+  "CMakeFiles/core.dir/helper/event-garbage-collector.cc.o"
+  "CMakeFiles/core.dir/helper/event-garbage-collector.cc.o.d"
+  "CMakeFiles/core.dir/helper/random-variable-stream-helper.cc.o"
+  "CMakeFiles/core.dir/helper/random-variable-stream-helper.cc.o.d"
+  "CMakeFiles/core.dir/model/ascii-file.cc.o"
+  "CMakeFiles/core.dir/model/ascii-file.cc.o.d"
+  "CMakeFiles/core.dir/model/attribute-construction-list.cc.o"
+  "CMakeFiles/core.dir/model/attribute-construction-list.cc.o.d"
+  "CMakeFiles/core.dir/model/attribute.cc.o"
+  "CMakeFiles/core.dir/model/attribute.cc.o.d"
+  "CMakeFiles/core.dir/model/boolean.cc.o"
+  "CMakeFiles/core.dir/model/boolean.cc.o.d"
+  "CMakeFiles/core.dir/model/breakpoint.cc.o"
+  "CMakeFiles/core.dir/model/breakpoint.cc.o.d"
+  "CMakeFiles/core.dir/model/calendar-scheduler.cc.o"
+  "CMakeFiles/core.dir/model/calendar-scheduler.cc.o.d"
+  "CMakeFiles/core.dir/model/callback.cc.o"
+  "CMakeFiles/core.dir/model/callback.cc.o.d"
+  "CMakeFiles/core.dir/model/command-line.cc.o"
+  "CMakeFiles/core.dir/model/command-line.cc.o.d"
+  "CMakeFiles/core.dir/model/config.cc.o"
+  "CMakeFiles/core.dir/model/config.cc.o.d"
+  "CMakeFiles/core.dir/model/default-simulator-impl.cc.o"
+  "CMakeFiles/core.dir/model/default-simulator-impl.cc.o.d"
+  "CMakeFiles/core.dir/model/demangle.cc.o"
+  "CMakeFiles/core.dir/model/demangle.cc.o.d"
+  "CMakeFiles/core.dir/model/des-metrics.cc.o"
+  "CMakeFiles/core.dir/model/des-metrics.cc.o.d"
+  "CMakeFiles/core.dir/model/double.cc.o"
+  "CMakeFiles/core.dir/model/double.cc.o.d"
+  "CMakeFiles/core.dir/model/environment-variable.cc.o"
+  "CMakeFiles/core.dir/model/environment-variable.cc.o.d"
+  "CMakeFiles/core.dir/model/event-id.cc.o"
+  "CMakeFiles/core.dir/model/event-id.cc.o.d"
+  "CMakeFiles/core.dir/model/event-impl.cc.o"
+  "CMakeFiles/core.dir/model/event-impl.cc.o.d"
+  "CMakeFiles/core.dir/model/event-pool.cc.o"
+  "CMakeFiles/core.dir/model/event-pool.cc.o.d"
+  "CMakeFiles/core.dir/model/event-profiler.cc.o"
+  "CMakeFiles/core.dir/model/event-profiler.cc.o.d"
+  "CMakeFiles/core.dir/model/fatal-impl.cc.o"
+  "CMakeFiles/core.dir/model/fatal-impl.cc.o.d"
+  "CMakeFiles/core.dir/model/global-value.cc.o"
+  "CMakeFiles/core.dir/model/global-value.cc.o.d"
+  "CMakeFiles/core.dir/model/hash-fnv.cc.o"
+  "CMakeFiles/core.dir/model/hash-fnv.cc.o.d"
+  "CMakeFiles/core.dir/model/hash-function.cc.o"
+  "CMakeFiles/core.dir/model/hash-function.cc.o.d"
+  "CMakeFiles/core.dir/model/hash-murmur3.cc.o"
+  "CMakeFiles/core.dir/model/hash-murmur3.cc.o.d"
+  "CMakeFiles/core.dir/model/hash.cc.o"
+  "CMakeFiles/core.dir/model/hash.cc.o.d"
+  "CMakeFiles/core.dir/model/heap-scheduler.cc.o"
+  "CMakeFiles/core.dir/model/heap-scheduler.cc.o.d"
+  "CMakeFiles/core.dir/model/int64x64-128.cc.o"
+  "CMakeFiles/core.dir/model/int64x64-128.cc.o.d"
+  "CMakeFiles/core.dir/model/int64x64.cc.o"
+  "CMakeFiles/core.dir/model/int64x64.cc.o.d"
+  "CMakeFiles/core.dir/model/integer.cc.o"
+  "CMakeFiles/core.dir/model/integer.cc.o.d"
+  "CMakeFiles/core.dir/model/length.cc.o"
+  "CMakeFiles/core.dir/model/length.cc.o.d"
+  "CMakeFiles/core.dir/model/list-scheduler.cc.o"
+  "CMakeFiles/core.dir/model/list-scheduler.cc.o.d"
+  "CMakeFiles/core.dir/model/log-binary.cc.o"
+  "CMakeFiles/core.dir/model/log-binary.cc.o.d"
+  "CMakeFiles/core.dir/model/log.cc.o"
+  "CMakeFiles/core.dir/model/log.cc.o.d"
+  "CMakeFiles/core.dir/model/map-scheduler.cc.o"
+  "CMakeFiles/core.dir/model/map-scheduler.cc.o.d"
+  "CMakeFiles/core.dir/model/matrix-array.cc.o"
+  "CMakeFiles/core.dir/model/matrix-array.cc.o.d"
+  "CMakeFiles/core.dir/model/names.cc.o"
+  "CMakeFiles/core.dir/model/names.cc.o.d"
+  "CMakeFiles/core.dir/model/node-printer.cc.o"
+  "CMakeFiles/core.dir/model/node-printer.cc.o.d"
+  "CMakeFiles/core.dir/model/object-base.cc.o"
+  "CMakeFiles/core.dir/model/object-base.cc.o.d"
+  "CMakeFiles/core.dir/model/object-factory.cc.o"
+  "CMakeFiles/core.dir/model/object-factory.cc.o.d"
+  "CMakeFiles/core.dir/model/object-ptr-container.cc.o"
+  "CMakeFiles/core.dir/model/object-ptr-container.cc.o.d"
+  "CMakeFiles/core.dir/model/object.cc.o"
+  "CMakeFiles/core.dir/model/object.cc.o.d"
+  "CMakeFiles/core.dir/model/pointer.cc.o"
+  "CMakeFiles/core.dir/model/pointer.cc.o.d"
+  "CMakeFiles/core.dir/model/priority-queue-scheduler.cc.o"
+  "CMakeFiles/core.dir/model/priority-queue-scheduler.cc.o.d"
+  "CMakeFiles/core.dir/model/random-variable-stream.cc.o"
+  "CMakeFiles/core.dir/model/random-variable-stream.cc.o.d"
+  "CMakeFiles/core.dir/model/realtime-simulator-impl.cc.o"
+  "CMakeFiles/core.dir/model/realtime-simulator-impl.cc.o.d"
+  "CMakeFiles/core.dir/model/rng-seed-manager.cc.o"
+  "CMakeFiles/core.dir/model/rng-seed-manager.cc.o.d"
+  "CMakeFiles/core.dir/model/rng-stream.cc.o"
+  "CMakeFiles/core.dir/model/rng-stream.cc.o.d"
+  "CMakeFiles/core.dir/model/scheduler.cc.o"
+  "CMakeFiles/core.dir/model/scheduler.cc.o.d"
+  "CMakeFiles/core.dir/model/show-progress.cc.o"
+  "CMakeFiles/core.dir/model/show-progress.cc.o.d"
+  "CMakeFiles/core.dir/model/simulator-impl.cc.o"
+  "CMakeFiles/core.dir/model/simulator-impl.cc.o.d"
+  "CMakeFiles/core.dir/model/simulator.cc.o"
+  "CMakeFiles/core.dir/model/simulator.cc.o.d"
+  "CMakeFiles/core.dir/model/string.cc.o"
+  "CMakeFiles/core.dir/model/string.cc.o.d"
+  "CMakeFiles/core.dir/model/synchronizer.cc.o"
+  "CMakeFiles/core.dir/model/synchronizer.cc.o.d"
+  "CMakeFiles/core.dir/model/system-path.cc.o"
+  "CMakeFiles/core.dir/model/system-path.cc.o.d"
+  "CMakeFiles/core.dir/model/system-wall-clock-ms.cc.o"
+  "CMakeFiles/core.dir/model/system-wall-clock-ms.cc.o.d"
+  "CMakeFiles/core.dir/model/system-wall-clock-timestamp.cc.o"
+  "CMakeFiles/core.dir/model/system-wall-clock-timestamp.cc.o.d"
+  "CMakeFiles/core.dir/model/test.cc.o"
+  "CMakeFiles/core.dir/model/test.cc.o.d"
+  "CMakeFiles/core.dir/model/time-printer.cc.o"
+  "CMakeFiles/core.dir/model/time-printer.cc.o.d"
+  "CMakeFiles/core.dir/model/time.cc.o"
+  "CMakeFiles/core.dir/model/time.cc.o.d"
+  "CMakeFiles/core.dir/model/timer.cc.o"
+  "CMakeFiles/core.dir/model/timer.cc.o.d"
+  "CMakeFiles/core.dir/model/timing-wheel-scheduler.cc.o"
+  "CMakeFiles/core.dir/model/timing-wheel-scheduler.cc.o.d"
+  "CMakeFiles/core.dir/model/trace-source-accessor.cc.o"
+  "CMakeFiles/core.dir/model/trace-source-accessor.cc.o.d"
+  "CMakeFiles/core.dir/model/trickle-timer.cc.o"
+  "CMakeFiles/core.dir/model/trickle-timer.cc.o.d"
+  "CMakeFiles/core.dir/model/type-id.cc.o"
+  "CMakeFiles/core.dir/model/type-id.cc.o.d"
+  "CMakeFiles/core.dir/model/uinteger.cc.o"
+  "CMakeFiles/core.dir/model/uinteger.cc.o.d"
+  "CMakeFiles/core.dir/model/unix-fd-reader.cc.o"
+  "CMakeFiles/core.dir/model/unix-fd-reader.cc.o.d"
+  "CMakeFiles/core.dir/model/vector.cc.o"
+  "CMakeFiles/core.dir/model/vector.cc.o.d"
+  "CMakeFiles/core.dir/model/wall-clock-synchronizer.cc.o"
+  "CMakeFiles/core.dir/model/wall-clock-synchronizer.cc.o.d"
+  "CMakeFiles/core.dir/model/watchdog.cc.o"
+  "CMakeFiles/core.dir/model/watchdog.cc.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/core.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,57 @@
+file(REMOVE_RECURSE
+  "/root/repo/ns-allinone-3.43/ns-3.43/build/lib/libns3.43-stats.pdb"
+  "/root/repo/ns-allinone-3.43/ns-3.43/build/lib/libns3.43-stats.so"
+  "CMakeFiles/stats.dir/helper/file-helper.cc.o"
+  "CMakeFiles/stats.dir/helper/file-helper.cc.o.d"
+  "CMakeFiles/stats.dir/helper/gnuplot-helper.cc.o"
+  "CMakeFiles/stats.dir/helper/gnuplot-helper.cc.o.d"
+  "CMakeFiles/stats.dir/model/basic-data-calculators.cc.o"
+  "CMakeFiles/stats.dir/model/basic-data-calculators.cc.o.d"
+  "CMakeFiles/stats.dir/model/boolean-probe.cc.o"
+  "CMakeFiles/stats.dir/model/boolean-probe.cc.o.d"
+  "CMakeFiles/stats.dir/model/data-calculator.cc.o"
+  "CMakeFiles/stats.dir/model/data-calculator.cc.o.d"
+  "CMakeFiles/stats.dir/model/data-collection-object.cc.o"
+  "CMakeFiles/stats.dir/model/data-collection-object.cc.o.d"
+  "CMakeFiles/stats.dir/model/data-collector.cc.o"
+  "CMakeFiles/stats.dir/model/data-collector.cc.o.d"
+  "CMakeFiles/stats.dir/model/data-output-interface.cc.o"
+  "CMakeFiles/stats.dir/model/data-output-interface.cc.o.d"
+  "CMakeFiles/stats.dir/model/double-probe.cc.o"
+  "CMakeFiles/stats.dir/model/double-probe.cc.o.d"
+  "CMakeFiles/stats.dir/model/file-aggregator.cc.o"
+  "CMakeFiles/stats.dir/model/file-aggregator.cc.o.d"
+  "CMakeFiles/stats.dir/model/get-wildcard-matches.cc.o"
+  "CMakeFiles/stats.dir/model/get-wildcard-matches.cc.o.d"
+  "CMakeFiles/stats.dir/model/gnuplot-aggregator.cc.o"
+  "CMakeFiles/stats.dir/model/gnuplot-aggregator.cc.o.d"
+  "CMakeFiles/stats.dir/model/gnuplot.cc.o"
+  "CMakeFiles/stats.dir/model/gnuplot.cc.o.d"
+  "CMakeFiles/stats.dir/model/histogram.cc.o"
+  "CMakeFiles/stats.dir/model/histogram.cc.o.d"
+  "CMakeFiles/stats.dir/model/omnet-data-output.cc.o"
+  "CMakeFiles/stats.dir/model/omnet-data-output.cc.o.d"
+  "CMakeFiles/stats.dir/model/probe.cc.o"
+  "CMakeFiles/stats.dir/model/probe.cc.o.d"
+  "CMakeFiles/stats.dir/model/sqlite-data-output.cc.o"
+  "CMakeFiles/stats.dir/model/sqlite-data-output.cc.o.d"
+  "CMakeFiles/stats.dir/model/sqlite-output.cc.o"
+  "CMakeFiles/stats.dir/model/sqlite-output.cc.o.d"
+  "CMakeFiles/stats.dir/model/time-data-calculators.cc.o"
+  "CMakeFiles/stats.dir/model/time-data-calculators.cc.o.d"
+  "CMakeFiles/stats.dir/model/time-probe.cc.o"
+  "CMakeFiles/stats.dir/model/time-probe.cc.o.d"
+  "CMakeFiles/stats.dir/model/time-series-adaptor.cc.o"
+  "CMakeFiles/stats.dir/model/time-series-adaptor.cc.o.d"
+  "CMakeFiles/stats.dir/model/uinteger-16-probe.cc.o"
+  "CMakeFiles/stats.dir/model/uinteger-16-probe.cc.o.d"
+  "CMakeFiles/stats.dir/model/uinteger-32-probe.cc.o"
+  "CMakeFiles/stats.dir/model/uinteger-32-probe.cc.o.d"
+  "CMakeFiles/stats.dir/model/uinteger-8-probe.cc.o"
+  "CMakeFiles/stats.dir/model/uinteger-8-probe.cc.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/stats.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,22 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/ns-allinone-3.43/ns-3.43/utils/bench-config.cc" "utils/CMakeFiles/bench-config.dir/bench-config.cc.o" "gcc" "utils/CMakeFiles/bench-config.dir/bench-config.cc.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/ns-allinone-3.43/ns-3.43/_opt_build/src/network/CMakeFiles/network.dir/DependInfo.cmake"
+  "/root/repo/ns-allinone-3.43/ns-3.43/_opt_build/src/stats/CMakeFiles/stats.dir/DependInfo.cmake"
+  "/root/repo/ns-allinone-3.43/ns-3.43/_opt_build/src/core/CMakeFiles/core.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
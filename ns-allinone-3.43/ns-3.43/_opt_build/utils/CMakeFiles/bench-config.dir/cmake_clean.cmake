@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "/root/repo/ns-allinone-3.43/ns-3.43/build/utils/ns3.43-bench-config"
+  "/root/repo/ns-allinone-3.43/ns-3.43/build/utils/ns3.43-bench-config.pdb"
+  "CMakeFiles/bench-config.dir/bench-config.cc.o"
+  "CMakeFiles/bench-config.dir/bench-config.cc.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/bench-config.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "/root/repo/ns-allinone-3.43/ns-3.43/build/utils/ns3.43-bench-inject"
+  "/root/repo/ns-allinone-3.43/ns-3.43/build/utils/ns3.43-bench-inject.pdb"
+  "CMakeFiles/bench-inject.dir/bench-inject.cc.o"
+  "CMakeFiles/bench-inject.dir/bench-inject.cc.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/bench-inject.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
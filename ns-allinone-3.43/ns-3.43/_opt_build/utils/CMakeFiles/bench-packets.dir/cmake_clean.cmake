@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "/root/repo/ns-allinone-3.43/ns-3.43/build/utils/ns3.43-bench-packets"
+  "/root/repo/ns-allinone-3.43/ns-3.43/build/utils/ns3.43-bench-packets.pdb"
+  "CMakeFiles/bench-packets.dir/bench-packets.cc.o"
+  "CMakeFiles/bench-packets.dir/bench-packets.cc.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/bench-packets.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
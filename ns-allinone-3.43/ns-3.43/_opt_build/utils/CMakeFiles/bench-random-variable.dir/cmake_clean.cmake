@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "/root/repo/ns-allinone-3.43/ns-3.43/build/utils/ns3.43-bench-random-variable"
+  "/root/repo/ns-allinone-3.43/ns-3.43/build/utils/ns3.43-bench-random-variable.pdb"
+  "CMakeFiles/bench-random-variable.dir/bench-random-variable.cc.o"
+  "CMakeFiles/bench-random-variable.dir/bench-random-variable.cc.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/bench-random-variable.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "/root/repo/ns-allinone-3.43/ns-3.43/build/utils/ns3.43-bench-scheduler"
+  "/root/repo/ns-allinone-3.43/ns-3.43/build/utils/ns3.43-bench-scheduler.pdb"
+  "CMakeFiles/bench-scheduler.dir/bench-scheduler.cc.o"
+  "CMakeFiles/bench-scheduler.dir/bench-scheduler.cc.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/bench-scheduler.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "/root/repo/ns-allinone-3.43/ns-3.43/build/utils/ns3.43-decode-log"
+  "/root/repo/ns-allinone-3.43/ns-3.43/build/utils/ns3.43-decode-log.pdb"
+  "CMakeFiles/decode-log.dir/decode-log.cc.o"
+  "CMakeFiles/decode-log.dir/decode-log.cc.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/decode-log.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
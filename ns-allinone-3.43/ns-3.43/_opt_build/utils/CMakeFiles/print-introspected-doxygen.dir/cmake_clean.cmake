@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "/root/repo/ns-allinone-3.43/ns-3.43/build/utils/ns3.43-print-introspected-doxygen"
+  "/root/repo/ns-allinone-3.43/ns-3.43/build/utils/ns3.43-print-introspected-doxygen.pdb"
+  "CMakeFiles/print-introspected-doxygen.dir/print-introspected-doxygen.cc.o"
+  "CMakeFiles/print-introspected-doxygen.dir/print-introspected-doxygen.cc.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/print-introspected-doxygen.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
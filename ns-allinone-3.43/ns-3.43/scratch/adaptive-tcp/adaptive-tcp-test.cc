@@ -22,11 +22,11 @@
 #include "ns3/internet-module.h"
 #include "ns3/point-to-point-module.h"
 #include "ns3/applications-module.h"
-#include "ns3/netanim-module.h"
 #include "adaptive-tcp-test.h"
-#include "lib/json.h"
 //#include "ns3/mpi-interface.h"
 
+#include <memory>
+#include <sstream>
 #include <vector>
 
 using namespace ns3;
@@ -60,18 +60,53 @@ main(int argc, char* argv[])
 
     std::string linkBandwidth = "1000Mbps"; // Default to 1Gbps
     double simulationTime = 60.0; // Default to 1 minutes
-    double senderCount = 8; // Default to 8 senders
+    uint32_t senderCount = 8; // Default to 8 senders
+    std::string mix = "equal"; // One sender per CCA with the default sender count
+    uint32_t flowsPerNode = 1;
+    std::string minAccessDelay = "1ms";
+    std::string maxAccessDelay = "1ms";
     std::string bottleneckDelay = "2ms"; // Default to 2ms
     std::string buffer = "50p"; // Default to 50 packets
     std::string outputFilename = "";
+    std::string outputFormat = "json"; // Binary samples are always kept
+    uint32_t chunkSize = 4096; // Samples buffered per series before being written
+    std::string recording = ""; // Record every change of every trace by default
+    bool traces = true; // The run summary is always written
+    std::string metricsWindow = "100ms";
+    double forkAt = 0; // Run straight to the end by default
+    std::string variants = "";
+    uint32_t forkJobs = 0; // All continuations at once
 
     CommandLine cmd;
     cmd.AddValue("linkBandwidth", "Bandwidth of the middle link", linkBandwidth);
     cmd.AddValue("simulationTime", "Simulation runtime in seconds", simulationTime);
-    cmd.AddValue("senderCount", "Number of senders", senderCount);
+    cmd.AddValue("senderCount", "Number of competing flows (AdaptiveTcp not included)", senderCount);
+    cmd.AddValue("mix",
+                 "How the competing flows are split among the CCAs: equal, or internet "
+                 "(the deployment percentages of ccaData)",
+                 mix);
+    cmd.AddValue("flowsPerNode", "Flows run by every sender node", flowsPerNode);
+    cmd.AddValue("minAccessDelay", "Minimum delay of the sender access links", minAccessDelay);
+    cmd.AddValue("maxAccessDelay",
+                 "Maximum delay of the sender access links, drawn uniformly per sender node",
+                 maxAccessDelay);
     cmd.AddValue("delay", "Delay time of bottleneck link", bottleneckDelay);
     cmd.AddValue("buffer", "Buffer size in packets", buffer);
     cmd.AddValue("output", "Output file name", outputFilename);
+    cmd.AddValue("format", "Export format of the recorded samples: json, csv, mmap or bin", outputFormat);
+    cmd.AddValue("chunkSize", "Samples buffered per flow and metric before being written", chunkSize);
+    cmd.AddValue("recording",
+                 "Recording policy per trace, e.g. \"*=bucket:0.001,rtts=threshold:0.05,cwnds=reservoir:10000\". "
+                 "Policies: every, bucket:<seconds>, threshold:<relative change>, reservoir:<samples>",
+                 recording);
+    cmd.AddValue("traces", "Record the per-flow traces (disable to only write the run summary)", traces);
+    cmd.AddValue("metricsWindow", "Measurement window of the utilization and fairness metrics", metricsWindow);
+    cmd.AddValue("forkAt", "Simulation time in seconds at which the run forks into its variants", forkAt);
+    cmd.AddValue("variants",
+                 "Continuations forked at forkAt, e.g. \"bandwidth=500Mbps,delay=10ms;switch=ns3::TcpVegas;none\". "
+                 "Keys: bandwidth=<rate>, delay=<time>, switch=<CCA of AdaptiveTcp>; none keeps the run unchanged",
+                 variants);
+    cmd.AddValue("forkJobs", "Continuations running at the same time, 0 for all of them", forkJobs);
     cmd.Parse(argc, argv);
 
 
@@ -80,89 +115,106 @@ main(int argc, char* argv[])
         outputFilename = linkBandwidth + "-" + bottleneckDelay + "-" + buffer;
     }
 
-    // Create sender, receiver, and bottleneck nodes
-    // Create nodes
-    NS_LOG_INFO("Creating nodes.");
-    NodeContainer senders, bottleneck, receivers;
-    senders.Create(senderCount + 1);
-    bottleneck.Create(2);  // bottleneck.Get(0) is left, bottleneck.Get(1) is right
-    receivers.Create(senderCount + 1);
-
-    // Connect each sender to the bottleneck and each receiver to the bottleneck
-    InternetStackHelper stack;
-    stack.Install(senders);
-    stack.Install(receivers);
-    stack.Install(bottleneck);
-
-    // Set up the throttled link between bottleneck nodes
-    PointToPointHelper bottleneckLink;
-    bottleneckLink.SetDeviceAttribute("DataRate", StringValue(linkBandwidth));
-    // TODO parameterize the delay
-    bottleneckLink.SetChannelAttribute("Delay", StringValue(bottleneckDelay));
-    bottleneckLink.SetQueue("ns3::DropTailQueue", "MaxSize", StringValue(buffer)); // Example: 50 packets
-
-    NetDeviceContainer bottleneckDevices = bottleneckLink.Install(bottleneck.Get(0), bottleneck.Get(1));
-
-    // Assign IPs for the bottleneck link
-    Ipv4AddressHelper address;
-    address.SetBase("10.1.1.0", "255.255.255.0");
-    
-    Ipv4InterfaceContainer bottleneckInterfaces = address.Assign(bottleneckDevices);
-
-    int senderIndex = 0; // Index to keep track of sender-receiver pairs
-    
-    std::vector<std::shared_ptr<FlowData>> flowData;
-    
-    // Install the competing congestion control algorithms    
-    for (int i = 0; i < CCA_COUNT; i++) {
-        // int numSenders = ccaData[i].percentage / 100.0 * senderCount;
-        int numSenders = 1;
-
-        if(numSenders == 0) continue;  // Skip if no senders for this CCA
+    // AdaptiveTcp can switch to any of the competing CCAs at runtime
+    std::string candidates;
+    for (const auto& data : ccaData) {
+        candidates += data.tcpTypeId + ";";
+    }
+    Config::SetDefault("ns3::AdaptiveTcp::Candidates", StringValue(candidates));
 
-        for (int j = 0; j < numSenders; j++) {
+    // Samples are streamed to this file while the simulation runs
+    std::unique_ptr<FlowStatsRecorder> recorder;
+    if (traces) {
+        recorder = std::make_unique<FlowStatsRecorder>(outputFilename + ".bin", chunkSize);
+    }
+    auto recordingPolicies = ParseRecordingPolicies(recording);
 
-            if (senderIndex >= senderCount) break;  // Prevent going beyond available senders
+    // Create the bottleneck, then the senders and receivers of every CCA
+    NS_LOG_INFO("Creating nodes.");
+    DumbbellConfig dumbbellConfig;
+    dumbbellConfig.bottleneckRate = linkBandwidth;
+    dumbbellConfig.bottleneckDelay = bottleneckDelay;
+    dumbbellConfig.bottleneckQueue = buffer;
+    dumbbellConfig.minAccessDelay = Time(minAccessDelay);
+    dumbbellConfig.maxAccessDelay = Time(maxAccessDelay);
+    dumbbellConfig.flowsPerNode = flowsPerNode;
+    dumbbellConfig.stop = Seconds(simulationTime);
+    DumbbellScenario dumbbell(dumbbellConfig);
+
+    NS_ABORT_MSG_IF(mix != "equal" && mix != "internet", "Unknown CCA mix " << mix);
+    std::vector<double> percentages;
+    for (const auto& data : ccaData) {
+        percentages.push_back(mix == "equal" ? 1 : data.percentage);
+    }
+    std::vector<uint32_t> flowCounts = SplitFlows(senderCount, percentages);
 
-            ns3::Ptr<ns3::Node> sender = senders.Get(senderIndex);
-            ns3::Ptr<ns3::Node> receiver = receivers.Get(senderIndex);
-            
-            setPairGoingThroughLink(sender,
-                                    bottleneck,
-                                    receiver,
-                                    simulationTime,
-                                    senderIndex,
-                                    TypeId::LookupByName(ccaData[i].tcpTypeId),
-                                    flowData,
-                                    false);
+    std::vector<std::shared_ptr<FlowData>> flowData;
+    flowData.reserve(senderCount + 1);
 
-            senderIndex++;  // Move to the next sender-receiver pair
+    // Install the competing congestion control algorithms
+    for (int i = 0; i < CCA_COUNT; i++) {
+        NS_LOG_INFO(flowCounts[i] << " flows of " << ccaData[i].tcpTypeId);
+        for (const auto& flow : dumbbell.AddFlows(TypeId::LookupByName(ccaData[i].tcpTypeId), flowCounts[i])) {
+            trackFlow(flow, simulationTime, flowData, false, traces);
         }
     }
 
     // Add our custom CCA, AdaptiveTCP
-    setPairGoingThroughLink(senders.Get(senderIndex),
-                            bottleneck,
-                            receivers.Get(senderIndex),
-                            simulationTime,
-                            senderIndex,
-                            TypeId::LookupByName("ns3::TcpCubic"),
-                            flowData, true);
+    for (const auto& flow : dumbbell.AddFlows(TypeId::LookupByName("ns3::AdaptiveTcp"), 1)) {
+        trackFlow(flow, simulationTime, flowData, true, traces);
+    }
+    NS_LOG_INFO(flowData.size() << " flows on " << dumbbell.GetSenderCount() << " sender nodes");
 
     // Store our AdaptiveTCPs flow data
     auto adaptiveTcpFlow = flowData.back();
 
-    NS_LOG_INFO("Initialize Global Routing.");
-    Ipv4GlobalRoutingHelper::PopulateRoutingTables();
+    // Fairness, utilization and queueing delay are computed while the simulation runs
+    RunMetricsConfig metricsConfig;
+    metricsConfig.window = Time(metricsWindow);
+    RunMetrics metrics(metricsConfig);
+    metrics.MonitorBottleneck(DynamicCast<PointToPointNetDevice>(dumbbell.GetBottleneckDevice()));
+    for (const auto& fd : flowData) {
+        metrics.AddFlow(fd->cca, fd->sink);
+        if (recorder) {
+            fd->stats.Setup(*recorder, recorder->AddFlow(fd->cca), recordingPolicies);
+        }
+    }
+    metrics.Start(dumbbellConfig.start, dumbbellConfig.stop);
 
     // Enable NetAnim
     // AnimationInterface anim("adaptive-tcp-test.xml");
     
     NS_LOG_INFO("Starting the simulation with runtime of " << simulationTime << "s...");
-    Simulator::Stop(Seconds(simulationTime + 5));
-
     ShowProgress progress (Seconds (5), std::cerr);
 
+    // Simulate the warm-up once, then every variant in its own process
+    std::vector<ForkVariant> forkVariants = parseForkVariants(variants);
+    if (!forkVariants.empty()) {
+        NS_ABORT_MSG_IF(forkAt <= dumbbellConfig.start.GetSeconds() || forkAt >= simulationTime,
+                        "forkAt must be between the start and the end of the flows");
+        Simulator::Stop(Seconds(forkAt));
+        Simulator::Run();
+
+        NS_LOG_INFO("Forking " << forkVariants.size() << " continuations at " << forkAt << "s");
+        if (recorder) {
+            recorder->Flush();
+        }
+        ForkedContinuation continuation = ForkContinuations(forkVariants.size(), forkJobs);
+        if (!continuation.isChild) {
+            // The parent only keeps the warm-up samples in outputFilename.bin
+            Simulator::Destroy();
+            NS_LOG_INFO(continuation.failed << " of " << forkVariants.size() << " continuations failed.");
+            return continuation.failed == 0 ? 0 : 1;
+        }
+
+        applyForkVariant(forkVariants[continuation.index], dumbbell, adaptiveTcpFlow);
+        outputFilename += "-fork" + std::to_string(continuation.index);
+        if (recorder) {
+            recorder->Branch(outputFilename + ".bin");
+        }
+    }
+    Simulator::Stop(Seconds(simulationTime + 5) - Simulator::Now());
+
     // Simulator::Schedule(
     //     Seconds(15),
     //     &setAdaptiveTcpCca,
@@ -188,7 +240,14 @@ main(int argc, char* argv[])
         NS_LOG_INFO("CCA: " << fd->cca << ", Throughput: " << throughput << " Mbps");
     }
 
-    saveFlowDataToJson(flowData, outputFilename);
+    metrics.WriteSummary(outputFilename + ".summary.json");
+
+    if (recorder) {
+        for (const auto& fd : flowData) {
+            fd->stats.Finish();
+        }
+        saveFlowData(*recorder, outputFilename, outputFormat);
+    }
 
     // // Finalize MPI
 //    MpiInterface::Disable();
@@ -206,238 +265,171 @@ setAdaptiveTcpCca(std::shared_ptr<FlowData> adaptiveTcpFlow, CCA new_cca) {
     Ptr<TcpSocketBase> tcpSocketBase = DynamicCast<TcpSocketBase>(tcpSocket);
     NS_ASSERT_MSG(tcpSocketBase, "TcpSocketBase not found");
 
-    // Set the congestion control algorithm on the socket
-    tcpSocketBase->SetCongestionControlAlgorithm(cca_ops[new_cca]);
+    // The socket owns its AdaptiveTcp, which owns its own forked candidates
+    PointerValue congestionOps;
+    tcpSocketBase->GetAttribute("CongestionOps", congestionOps);
+    Ptr<AdaptiveTcp> adaptiveTcp = congestionOps.Get<AdaptiveTcp>();
+    NS_ASSERT_MSG(adaptiveTcp, "The flow does not use AdaptiveTcp");
+
+    // The switch happens on the next ACK, carrying over the window and min RTT
+    uint32_t candidate = adaptiveTcp->GetCandidateIndex(TypeId::LookupByName(ccaData[new_cca].tcpTypeId));
+    NS_ASSERT_MSG(candidate < adaptiveTcp->GetCandidateCount(), "CCA is not an AdaptiveTcp candidate");
+    adaptiveTcp->RequestSwitch(candidate);
 }
 
-void
-    saveFlowDataToJson(std::vector<std::shared_ptr<FlowData>>& flowData, std::string outputFileName)
-{
-    // Serialize the information in flowdata to a json file using the nlohmann json library
-    nlohmann::json j;
-    for (const auto& fd : flowData)
-    {
-        nlohmann::json flow;
-        flow["cca"] = fd->cca;
-
-        for (const auto& dp : fd->stats.throughputs)
-        {
-            flow["throughputs"].push_back({dp.time, dp.value});
+std::vector<ForkVariant>
+parseForkVariants(const std::string& spec) {
+    std::vector<ForkVariant> variants;
+    std::istringstream entries(spec);
+    std::string entry;
+    while (std::getline(entries, entry, ';')) {
+        if (entry.empty()) {
+            continue;
         }
-
-        for (const auto& dp : fd->stats.cwnds)
-        {
-            flow["cwnds"].push_back({dp.time, dp.value});
-
-            // Print if time is greater than 5ms
-
-            if(fd->cca == "ns3::TcpCubic") {
-                std::cout << "";
+        ForkVariant variant;
+        std::istringstream changes(entry == "none" ? "" : entry);
+        std::string change;
+        while (std::getline(changes, change, ',')) {
+            auto separator = change.find('=');
+            NS_ABORT_MSG_IF(separator == std::string::npos, "Expected key=value, got " << change);
+            std::string key = change.substr(0, separator);
+            std::string value = change.substr(separator + 1);
+            if (key == "bandwidth") {
+                variant.bandwidth = value;
+            } else if (key == "delay") {
+                variant.delay = value;
+            } else if (key == "switch") {
+                variant.cca = (value.rfind("ns3::", 0) == 0 ? value : "ns3::" + value);
+            } else {
+                NS_ABORT_MSG("Unknown variant key " << key);
             }
-
-            if(dp.time > 5 && fd->cca == "ns3::TcpCubic") {
-                std::cout << "";
-            }
-        }
-
-        for (const auto& dp : fd->stats.rtts)
-        {
-            flow["rtts"].push_back({dp.time, dp.value});
-        }
-
-        for (const auto& dp : fd->stats.lastRtts)
-        {
-            flow["lastRtts"].push_back({dp.time, dp.value});
-        }
-
-        for (const auto& dp : fd->stats.rtos)
-        {
-            flow["rtos"].push_back({dp.time, dp.value});
-        }
-
-        for (const auto& dp : fd->stats.congestionStates)
-        {
-            flow["congestionStates"].push_back({dp.time, dp.value});
-        }
-
-        for (const auto& dp : fd->stats.bytesInFlights)
-        {
-            flow["bytesInFlights"].push_back({dp.time, dp.value});
         }
+        variants.push_back(variant);
+    }
+    return variants;
+}
 
-        for (const auto& dp : fd->stats.pacingRates)
-        {
-            flow["pacingRates"].push_back({dp.time, dp.value.GetBitRate()});
+void
+applyForkVariant(const ForkVariant& variant,
+                 DumbbellScenario& dumbbell,
+                 std::shared_ptr<FlowData> adaptiveTcpFlow) {
+    if (!variant.bandwidth.empty()) {
+        NS_LOG_INFO("Bottleneck rate set to " << variant.bandwidth);
+        dumbbell.SetBottleneckRate(DataRate(variant.bandwidth));
+    }
+    if (!variant.delay.empty()) {
+        NS_LOG_INFO("Bottleneck delay set to " << variant.delay);
+        dumbbell.SetBottleneckDelay(Time(variant.delay));
+    }
+    if (!variant.cca.empty()) {
+        int cca = 0;
+        while (cca < CCA_COUNT && ccaData[cca].tcpTypeId != variant.cca) {
+            cca++;
         }
-
-        j.push_back(flow);
+        NS_ABORT_MSG_IF(cca == CCA_COUNT, "AdaptiveTcp cannot switch to " << variant.cca);
+        NS_LOG_INFO("AdaptiveTcp switches to " << variant.cca);
+        setAdaptiveTcpCca(adaptiveTcpFlow, static_cast<CCA>(cca));
     }
-
-    std::string final_out = outputFileName + ".json";
-
-    std::ofstream o(final_out);
-    o << std::setw(4) << j << std::endl;
 }
 
 void
-setPairGoingThroughLink(ns3::Ptr<ns3::Node> sender,
-                        ns3::NodeContainer& bottleneck,
-                        ns3::Ptr<ns3::Node> receiver,
-                        double simulationTime,
-                        int senderIndex,
-                        ns3::TypeId tcpTypeId,
-                        std::vector<std::shared_ptr<FlowData>>& flowData,
-                        bool isAdaptiveTcp)
+saveFlowData(FlowStatsRecorder& recorder, std::string outputFileName, std::string format)
 {
-    Ipv4AddressHelper address;
-    
-    // Connect each sender to bottleneck.Get(0)
-    PointToPointHelper senderLink;
-    senderLink.SetDeviceAttribute("DataRate",
-                                  StringValue("10Gbps")); // High bandwidth for sender links
-    senderLink.SetChannelAttribute("Delay", StringValue("1ms"));
-    NetDeviceContainer senderDevices =
-        senderLink.Install(sender, bottleneck.Get(0));
-
-    // Assign IPs for sender links
-    address.SetBase(("10.2." + std::to_string(senderIndex) + ".0").c_str(), "255.255.255.0");
-    Ipv4InterfaceContainer senderInterfaces = address.Assign(senderDevices);
-
-    // Connect each receiver to bottleneck.Get(1)
-    PointToPointHelper receiverLink;
-    receiverLink.SetDeviceAttribute("DataRate",
-                                    StringValue("10Gbps")); // High bandwidth for receiver links
-    receiverLink.SetChannelAttribute("Delay", StringValue("1ms"));
-    
-    NetDeviceContainer receiverDevices =
-        receiverLink.Install(bottleneck.Get(1), receiver);
-
-    // Assign IPs for receiver links
-    address.SetBase(("10.3." + std::to_string(senderIndex) + ".0").c_str(), "255.255.255.0");
-    Ipv4InterfaceContainer receiverInterfaces = address.Assign(receiverDevices);
-
-    // Set TCP type for the specific sender based on ccaData
-    Config::Set("/NodeList/" + std::to_string(sender->GetId()) + "/$ns3::TcpL4Protocol/SocketType",
-                TypeIdValue(tcpTypeId));
-
-    // Set up applications
-    uint16_t port = 9;
-
-    // BulkSend application on sender side
-    BulkSendHelper bulkSend("ns3::TcpSocketFactory",
-                            InetSocketAddress(receiverInterfaces.GetAddress(1), port));
-    bulkSend.SetAttribute("MaxBytes", UintegerValue(0));
-    ApplicationContainer senderApps = bulkSend.Install(sender);
-    senderApps.Start(Seconds(1.0));
-    senderApps.Stop(Seconds(simulationTime));
-
-    // PacketSink application on receiver side to act as sink
-    PacketSinkHelper sink("ns3::TcpSocketFactory", InetSocketAddress(Ipv4Address::GetAny(), port));
-    ApplicationContainer receiverApps = sink.Install(receiver);
-    receiverApps.Start(Seconds(1.0));
-    receiverApps.Stop(Seconds(simulationTime));
-
-    // Get a pointer to the PacketSink application
-    Ptr<PacketSink> pktSink = DynamicCast<PacketSink>(receiverApps.Get(0));
+    // Write the remaining buffered samples, then convert the binary file if requested
+    recorder.Close();
+
+    if (format == "json") {
+        ExportFlowStatsToJson(outputFileName + ".bin", outputFileName + ".json");
+    } else if (format == "csv") {
+        ExportFlowStatsToCsv(outputFileName + ".bin", outputFileName + ".csv");
+    } else if (format == "mmap") {
+        ExportFlowStatsToMapped(outputFileName + ".bin", outputFileName + ".fsm");
+    } else if (format != "bin") {
+        NS_LOG_WARN("Unknown output format " << format << ", only " << outputFileName << ".bin was written");
+    }
+}
 
+void
+trackFlow(const DumbbellFlow& dumbbellFlow,
+          double simulationTime,
+          std::vector<std::shared_ptr<FlowData>>& flowData,
+          bool isAdaptiveTcp,
+          bool traces)
+{
     // Store flow data
     auto flow = std::make_shared<FlowData>();
-    flow->sink = pktSink;
-    flow->cca = (isAdaptiveTcp ? "AdaptiveTcp" : tcpTypeId.GetName());
-    flow->app = DynamicCast<BulkSendApplication>(senderApps.Get(0));
-    NS_ASSERT_MSG(flow->app, "BulkSendApplication not found");
+    flow->sink = dumbbellFlow.sink;
+    flow->cca = (isAdaptiveTcp ? "AdaptiveTcp" : dumbbellFlow.cca.GetName());
+    flow->app = dumbbellFlow.app;
 
-    // Schedule throughput calculation
-    double interval = 1.0; // Interval in seconds
-    Simulator::Schedule(Seconds(0), &CalculateThroughput, flow.get(), interval, simulationTime);
+    if (traces) {
+        // Schedule throughput calculation
+        double interval = 1.0; // Interval in seconds
+        Simulator::Schedule(Seconds(0), &CalculateThroughput, flow.get(), interval, simulationTime);
 
-    // **Connect the cwnd and RTT trace sources**
-    // ConnectTraceSources(sender, &flow, senderIndex);
-    Simulator::Schedule(Seconds(0), &ConnectTraceSources, sender, flow.get(), senderIndex);
+        // **Connect the cwnd and RTT trace sources** as soon as the socket exists
+        flow->app->TraceConnectWithoutContext("SocketCreated", MakeBoundCallback(&ConnectTraceSources, flow.get()));
+    }
 
     // Store the flow data
     flowData.push_back(flow);
 }
 
-void ConnectTraceSources(Ptr<Node> sender, FlowData* flow, int senderIndex)
+void ConnectTraceSources(FlowData* flow, Ptr<Socket> socket)
 {
-    // Construct the path to the socket used by the BulkSendApplication
-    NS_LOG_DEBUG("Connecting trace sources for flow " << senderIndex);
-    Ptr<Socket> socket = flow->app->GetSocket();
-
-    // If socket is null, reschedule for one second later
-    if (socket == nullptr) {
-        Simulator::Schedule(Seconds(1.0), &ConnectTraceSources, sender, flow, senderIndex);
-        return;
-    }
-
-    std::string path = "/NodeList/" + std::to_string(sender->GetId()) +
-                       "/$ns3::TcpL4Protocol/SocketList/0";
+    // Called when the BulkSendApplication creates its socket, before the SYN is sent
+    NS_LOG_DEBUG("Connecting trace sources for flow " << flow->cca << " on node " << socket->GetNode()->GetId());
 
     // Connect to the CongestionWindow and RTT trace sources
-    Config::ConnectWithoutContext(path + "/CongestionWindow",
-                                  MakeBoundCallback(&CwndTracer, flow));
-    Config::ConnectWithoutContext(path + "/RTT",
-                                  MakeBoundCallback(&RttTracer, flow));
-    Config::ConnectWithoutContext(path + "/LastRTT",
-                                  MakeBoundCallback(&LastRttTracer, flow));
-    Config::ConnectWithoutContext(path + "/RTO",
-                                  MakeBoundCallback(&RtoTracer, flow));
-    Config::ConnectWithoutContext(path + "/CongState",
-                                  MakeBoundCallback(&CongestionStateTracer, flow));
-    Config::ConnectWithoutContext(path + "/BytesInFlight",
-                                  MakeBoundCallback(&BytesInFlightTracer, flow));
-    Config::ConnectWithoutContext(path + "/PacingRate",
-                                    MakeBoundCallback(&PacingRateTracer, flow));
+    socket->TraceConnectWithoutContext("CongestionWindow", MakeBoundCallback(&CwndTracer, flow));
+    socket->TraceConnectWithoutContext("RTT", MakeBoundCallback(&RttTracer, flow));
+    socket->TraceConnectWithoutContext("LastRTT", MakeBoundCallback(&LastRttTracer, flow));
+    socket->TraceConnectWithoutContext("RTO", MakeBoundCallback(&RtoTracer, flow));
+    socket->TraceConnectWithoutContext("CongState", MakeBoundCallback(&CongestionStateTracer, flow));
+    socket->TraceConnectWithoutContext("BytesInFlight", MakeBoundCallback(&BytesInFlightTracer, flow));
+    socket->TraceConnectWithoutContext("PacingRate", MakeBoundCallback(&PacingRateTracer, flow));
 }
 
 static void
 CwndTracer(FlowData* flow, uint32_t oldCwnd, uint32_t newCwnd)
 {
-    Time now = Simulator::Now();
-    flow->stats.cwnds.emplace_back(now.GetSeconds(), newCwnd);
+    flow->stats.Record(CWND, newCwnd);
 }
 
 void
 RttTracer(FlowData* flow, Time oldRtt, Time newRtt)
 {
-    Time now = Simulator::Now();
-    flow->stats.rtts.emplace_back(now.GetSeconds(), static_cast<uint32_t>(newRtt.GetMilliSeconds()));
+    flow->stats.Record(RTT, static_cast<uint32_t>(newRtt.GetMilliSeconds()));
 }
 
 void
 LastRttTracer(FlowData* flow, Time oldLastRtt, Time newLastRtt)
 {
-    Time now = Simulator::Now();
-    flow->stats.lastRtts.emplace_back(now.GetSeconds(), static_cast<uint32_t>(newLastRtt.GetMilliSeconds()));
+    flow->stats.Record(LAST_RTT, static_cast<uint32_t>(newLastRtt.GetMilliSeconds()));
 }
 
 void
 RtoTracer(FlowData* flow, Time oldRto, Time newRto)
 {
-    Time now = Simulator::Now();
-    flow->stats.rtos.emplace_back(now.GetSeconds(), static_cast<uint32_t>(newRto.GetMilliSeconds()));
+    flow->stats.Record(RTO, static_cast<uint32_t>(newRto.GetMilliSeconds()));
 }
 
 void
 CongestionStateTracer(FlowData* flow, TcpSocketState::TcpCongState_t oldState, TcpSocketState::TcpCongState_t newState)
 {
-    Time now = Simulator::Now();
-    flow->stats.congestionStates.emplace_back(now.GetSeconds(), static_cast<uint32_t>(newState));
+    flow->stats.Record(CONG_STATE, static_cast<uint32_t>(newState));
 }
 
 void
 BytesInFlightTracer(FlowData* flow, uint32_t oldBytesInFlight, uint32_t newBytesInFlight)
 {
-    Time now = Simulator::Now();
-    flow->stats.bytesInFlights.emplace_back(now.GetSeconds(), newBytesInFlight);
+    flow->stats.Record(BYTES_IN_FLIGHT, newBytesInFlight);
 }
 
 void
 PacingRateTracer(FlowData* flow, DataRate oldPacingRate, DataRate newPacingRate)
 {
-    Time now = Simulator::Now();
-    flow->stats.pacingRates.emplace_back(now.GetSeconds(), newPacingRate);
+    flow->stats.Record(PACING_RATE, newPacingRate.GetBitRate());
 }
 
 void
@@ -448,7 +440,7 @@ CalculateThroughput(FlowData* flow, double interval, double simulationTime)
     double throughput = (totalBytes - flow->lastTotalRx) * 8 / (interval * 1e3); // Kbps
 
     // Collect data
-    flow->stats.throughputs.emplace_back(now.GetSeconds(), static_cast<uint32_t>(throughput));
+    flow->stats.Record(THROUGHPUT, static_cast<uint32_t>(throughput));
 
     flow->lastTotalRx = totalBytes;
 
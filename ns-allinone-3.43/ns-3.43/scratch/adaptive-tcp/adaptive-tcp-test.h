@@ -1,7 +1,10 @@
 #include <string>
 #include <array>
-#include "ns3/node-container.h"
-#include "ns3/ipv4-address-helper.h"
+#include "lib/dumbbell-scenario.h"
+#include "lib/flow-stats-recorder.h"
+#include "lib/recording-policy.h"
+#include "lib/run-metrics.h"
+#include "lib/simulation-fork.h"
 
 using namespace ns3;
 
@@ -18,17 +21,6 @@ enum CCA {
     CCA_COUNT
 };
 
-Ptr<TcpCongestionOps> cca_ops[] = {
-    CreateObject<TcpBbr>(),
-    CreateObject<TcpBic>(),
-    CreateObject<TcpCubic>(),
-    CreateObject<TcpHtcp>(),
-    CreateObject<TcpIllinois>(),
-    CreateObject<TcpNewReno>(),
-    CreateObject<TcpVegas>(),
-    CreateObject<TcpVeno>()
-};
-
 struct CCAData {
     int percentage;
     std::string tcpTypeId;
@@ -45,19 +37,27 @@ static const std::array<CCAData, CCA_COUNT> ccaData = {
     CCAData{1, "ns3::TcpVeno"}       // Veno
 };
 
-template<typename DataType>
-struct DataPoint {
-    double time;
-    DataType value;
-
-    DataPoint(double t, DataType v) : time(t), value(v) {}
-};
-
+// Samplers that reduce each trace of a flow according to its recording policy
+// before streaming it to the FlowStatsRecorder
 struct FlowStats {
-    std::string cca;
-    std::vector<DataPoint<uint32_t>> rtts, throughputs, cwnds, lastRtts, srtts, rtos,
-                           congestionStates, bytesInFlights;
-    std::vector<DataPoint<DataRate>> pacingRates;
+    std::array<SeriesSampler, FLOW_METRIC_COUNT> samplers;
+
+    void Setup(FlowStatsRecorder& recorder, uint32_t flowId,
+               const std::array<RecordingPolicy, FLOW_METRIC_COUNT>& policies) {
+        for (uint32_t i = 0; i < FLOW_METRIC_COUNT; i++) {
+            samplers[i].Setup(&recorder, flowId, static_cast<FlowMetric>(i), policies[i]);
+        }
+    }
+
+    void Record(FlowMetric metric, double value) {
+        samplers[metric].Add(Simulator::Now().GetSeconds(), value);
+    }
+
+    void Finish() {
+        for (auto& sampler : samplers) {
+            sampler.Finish();
+        }
+    }
 };
 
 struct FlowData {
@@ -68,19 +68,29 @@ struct FlowData {
     uint64_t lastTotalRx = 0;  // Add this field to store the last total received bytes
 };
 
+// What a forked continuation changes when it starts, empty fields are kept
+struct ForkVariant {
+    std::string bandwidth;  // New rate of the bottleneck link
+    std::string delay;      // New delay of the bottleneck link
+    std::string cca;        // TypeId of the CCA AdaptiveTcp switches to
+};
+
 void
 setAdaptiveTcpCca(std::shared_ptr<FlowData> adaptiveTcpFlow, CCA new_cca);
 
-void setPairGoingThroughLink(ns3::Ptr<ns3::Node> sender,
-                             ns3::NodeContainer& bottleneck,
-                             ns3::Ptr<ns3::Node> receiver,
-                             double simulationTime,
-                             int senderIndex,
-                             ns3::TypeId tcpTypeId,
-                             std::vector<std::shared_ptr<FlowData>>& flowData,
-                             bool isAdaptiveTcp);
+std::vector<ForkVariant> parseForkVariants(const std::string& spec);
+
+void applyForkVariant(const ForkVariant& variant,
+                      DumbbellScenario& dumbbell,
+                      std::shared_ptr<FlowData> adaptiveTcpFlow);
+
+void trackFlow(const DumbbellFlow& dumbbellFlow,
+               double simulationTime,
+               std::vector<std::shared_ptr<FlowData>>& flowData,
+               bool isAdaptiveTcp,
+               bool traces);
 
-void saveFlowDataToJson(std::__1::vector<std::__1::shared_ptr<FlowData>>& flowData, std::string outputFileName);
+void saveFlowData(FlowStatsRecorder& recorder, std::string outputFileName, std::string format);
 
 static void
 CwndTracer(FlowData* flow, uint32_t oldCwnd, uint32_t newCwnd);
@@ -106,4 +116,4 @@ PacingRateTracer(FlowData* flow, DataRate oldPacingRate, DataRate newPacingRate)
 void
 CalculateThroughput(FlowData* flow, double interval, double simulationTime);
 
-void ConnectTraceSources(Ptr<Node> sender, FlowData* flow, int senderIndex);
\ No newline at end of file
+void ConnectTraceSources(FlowData* flow, Ptr<Socket> socket);
\ No newline at end of file
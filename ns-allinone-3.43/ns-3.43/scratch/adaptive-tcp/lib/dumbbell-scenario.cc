@@ -0,0 +1,189 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "dumbbell-scenario.h"
+
+#include "ns3/abort.h"
+#include "ns3/channel.h"
+#include "ns3/inet-socket-address.h"
+#include "ns3/ipv4-static-routing-helper.h"
+#include "ns3/string.h"
+#include "ns3/tcp-l4-protocol.h"
+#include "ns3/tcp-socket-factory.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+namespace ns3
+{
+
+namespace
+{
+
+/// First port of the flows of a node, the next flows use the next ports
+const uint16_t FIRST_PORT = 5000;
+
+/**
+ * Point the default route of a node to a neighbor.
+ *
+ * \param node The node
+ * \param nextHop Address of the neighbor
+ * \param interface Interface of the node towards the neighbor
+ */
+void
+SetDefaultRoute(Ptr<Node> node, Ipv4Address nextHop, uint32_t interface)
+{
+    Ipv4StaticRoutingHelper routing;
+    routing.GetStaticRouting(node->GetObject<Ipv4>())->SetDefaultRoute(nextHop, interface);
+}
+
+} // namespace
+
+std::vector<uint32_t>
+SplitFlows(uint32_t flowCount, const std::vector<double>& percentages)
+{
+    double total = std::accumulate(percentages.begin(), percentages.end(), 0.0);
+    NS_ABORT_MSG_IF(total <= 0, "The percentages add up to " << total);
+
+    std::vector<uint32_t> counts(percentages.size());
+    std::vector<std::pair<double, size_t>> remainders;
+    uint32_t assigned = 0;
+    for (size_t i = 0; i < percentages.size(); i++)
+    {
+        double exact = flowCount * percentages[i] / total;
+        counts[i] = static_cast<uint32_t>(std::floor(exact));
+        assigned += counts[i];
+        remainders.emplace_back(exact - counts[i], i);
+    }
+
+    // The flows left over go to the largest remainders, ties to the first entries
+    std::stable_sort(remainders.begin(), remainders.end(), [](const auto& a, const auto& b) {
+        return a.first > b.first;
+    });
+    for (size_t i = 0; assigned < flowCount; i++, assigned++)
+    {
+        counts[remainders[i].second]++;
+    }
+    return counts;
+}
+
+DumbbellScenario::DumbbellScenario(const DumbbellConfig& config)
+    : m_config(config)
+{
+    NS_ABORT_MSG_IF(config.flowsPerNode == 0, "Every sender node needs at least one flow");
+    NS_ABORT_MSG_IF(config.minAccessDelay > config.maxAccessDelay,
+                    "Minimum access delay above the maximum");
+
+    m_stack.SetIpv6StackInstall(false);
+    m_stack.SetRoutingHelper(Ipv4StaticRoutingHelper());
+
+    m_routers.Create(2);
+    m_stack.Install(m_routers);
+
+    PointToPointHelper bottleneckLink;
+    bottleneckLink.SetDeviceAttribute("DataRate", StringValue(config.bottleneckRate));
+    bottleneckLink.SetChannelAttribute("Delay", StringValue(config.bottleneckDelay));
+    bottleneckLink.SetQueue("ns3::DropTailQueue", "MaxSize", StringValue(config.bottleneckQueue));
+    m_bottleneckDevices = bottleneckLink.Install(m_routers);
+
+    Ipv4AddressHelper bottleneckAddresses("10.1.1.0", "255.255.255.0");
+    Ipv4InterfaceContainer interfaces = bottleneckAddresses.Assign(m_bottleneckDevices);
+
+    // Access subnets are directly connected, everything else is across the bottleneck
+    SetDefaultRoute(m_routers.Get(0), interfaces.GetAddress(1), interfaces.Get(0).second);
+    SetDefaultRoute(m_routers.Get(1), interfaces.GetAddress(0), interfaces.Get(1).second);
+
+    m_accessLink.SetDeviceAttribute("DataRate", StringValue(config.accessRate));
+    m_accessAddresses.SetBase("10.2.0.0", "255.255.255.252");
+    m_accessDelay = CreateObject<UniformRandomVariable>();
+}
+
+Ipv4Address
+DumbbellScenario::Attach(Ptr<Node> host, Ptr<Node> router, Time delay)
+{
+    m_accessLink.SetChannelAttribute("Delay", TimeValue(delay));
+    NetDeviceContainer devices = m_accessLink.Install(host, router);
+    Ipv4InterfaceContainer interfaces = m_accessAddresses.Assign(devices);
+    m_accessAddresses.NewNetwork();
+
+    SetDefaultRoute(host, interfaces.GetAddress(1), interfaces.Get(0).second);
+    return interfaces.GetAddress(0);
+}
+
+std::vector<DumbbellFlow>
+DumbbellScenario::AddFlows(TypeId cca, uint32_t flowCount)
+{
+    std::vector<DumbbellFlow> flows;
+    flows.reserve(flowCount);
+    for (uint32_t first = 0; first < flowCount; first += m_config.flowsPerNode)
+    {
+        Ptr<Node> sender = CreateObject<Node>();
+        Ptr<Node> receiver = CreateObject<Node>();
+        m_stack.Install(sender);
+        m_stack.Install(receiver);
+
+        // The CCA is a setting of the sender host
+        sender->GetObject<TcpL4Protocol>()->SetAttribute("SocketType", TypeIdValue(cca));
+
+        Time accessDelay =
+            NanoSeconds(std::llround(m_accessDelay->GetValue(m_config.minAccessDelay.GetNanoSeconds(),
+                                                             m_config.maxAccessDelay.GetNanoSeconds())));
+        Attach(sender, m_routers.Get(0), accessDelay);
+        Ipv4Address receiverAddress = Attach(receiver, m_routers.Get(1), m_config.receiverDelay);
+
+        uint32_t nodeFlows = std::min(m_config.flowsPerNode, flowCount - first);
+        for (uint32_t i = 0; i < nodeFlows; i++)
+        {
+            uint16_t port = FIRST_PORT + i;
+
+            Ptr<BulkSendApplication> app = CreateObject<BulkSendApplication>();
+            app->SetAttribute("Protocol", TypeIdValue(TcpSocketFactory::GetTypeId()));
+            app->SetAttribute("Remote", AddressValue(InetSocketAddress(receiverAddress, port)));
+            app->SetStartTime(m_config.start);
+            app->SetStopTime(m_config.stop);
+            sender->AddApplication(app);
+
+            Ptr<PacketSink> sink = CreateObject<PacketSink>();
+            sink->SetAttribute("Protocol", TypeIdValue(TcpSocketFactory::GetTypeId()));
+            sink->SetAttribute("Local", AddressValue(InetSocketAddress(Ipv4Address::GetAny(), port)));
+            sink->SetStartTime(m_config.start);
+            sink->SetStopTime(m_config.stop);
+            receiver->AddApplication(sink);
+
+            flows.push_back({cca, sender, i, app, sink, accessDelay});
+        }
+        m_senderCount++;
+    }
+    return flows;
+}
+
+void
+DumbbellScenario::SetBottleneckRate(DataRate rate)
+{
+    for (uint32_t i = 0; i < m_bottleneckDevices.GetN(); i++)
+    {
+        m_bottleneckDevices.Get(i)->SetAttribute("DataRate", DataRateValue(rate));
+    }
+}
+
+void
+DumbbellScenario::SetBottleneckDelay(Time delay)
+{
+    m_bottleneckDevices.Get(0)->GetChannel()->SetAttribute("Delay", TimeValue(delay));
+}
+
+Ptr<NetDevice>
+DumbbellScenario::GetBottleneckDevice() const
+{
+    return m_bottleneckDevices.Get(0);
+}
+
+uint32_t
+DumbbellScenario::GetSenderCount() const
+{
+    return m_senderCount;
+}
+
+} // namespace ns3
@@ -0,0 +1,152 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+// Builder of the dumbbell topology of adaptive-tcp-test, sized for thousands
+// of flows.
+//
+// Sender nodes hang off the left router and receiver nodes off the right one,
+// each through its own point-to-point access link. A sender node runs
+// flowsPerNode flows of the same CCA (the CCA is a per-host setting, as
+// with the tcp_congestion_control sysctl of Linux), towards a receiver node
+// of its own. Access links use /30 subnets and every node only gets a static
+// default route, so setup time and per-node memory grow linearly with the
+// number of flows; global routing would compute and store a route to every
+// other node on every node.
+
+#ifndef DUMBBELL_SCENARIO_H
+#define DUMBBELL_SCENARIO_H
+
+#include "ns3/bulk-send-application.h"
+#include "ns3/data-rate.h"
+#include "ns3/internet-stack-helper.h"
+#include "ns3/ipv4-address-helper.h"
+#include "ns3/net-device-container.h"
+#include "ns3/node-container.h"
+#include "ns3/nstime.h"
+#include "ns3/packet-sink.h"
+#include "ns3/point-to-point-helper.h"
+#include "ns3/random-variable-stream.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * Parameters of the dumbbell.
+ */
+struct DumbbellConfig
+{
+    std::string bottleneckRate = "1000Mbps"; //!< Rate of the bottleneck link
+    std::string bottleneckDelay = "2ms";     //!< Delay of the bottleneck link
+    std::string bottleneckQueue = "50p";     //!< Queue size of the bottleneck link
+    std::string accessRate = "10Gbps";       //!< Rate of the access links
+    Time minAccessDelay = MilliSeconds(1);   //!< Minimum delay of a sender access link
+    Time maxAccessDelay = MilliSeconds(1);   //!< Maximum delay of a sender access link
+    Time receiverDelay = MilliSeconds(1);    //!< Delay of the receiver access links
+    uint32_t flowsPerNode = 1;               //!< Flows run by every sender node
+    Time start = Seconds(1);                 //!< Start time of the flows
+    Time stop = Seconds(60);                 //!< Stop time of the flows
+};
+
+/**
+ * A flow created by the DumbbellScenario.
+ */
+struct DumbbellFlow
+{
+    TypeId cca;                   //!< Congestion control of the flow
+    Ptr<Node> sender;             //!< Sender node
+    uint32_t indexOnNode;         //!< Index of the flow among the flows of its sender node
+    Ptr<BulkSendApplication> app; //!< Sending application
+    Ptr<PacketSink> sink;         //!< Receiving application
+    Time accessDelay;             //!< One-way delay of the sender access link
+};
+
+/**
+ * Split a number of flows according to percentages, with the largest
+ * remainder method so that the counts add up to flowCount.
+ *
+ * \param flowCount Number of flows to split
+ * \param percentages Share of every entry
+ * \return The number of flows of every entry
+ */
+std::vector<uint32_t> SplitFlows(uint32_t flowCount, const std::vector<double>& percentages);
+
+/**
+ * Builds a dumbbell incrementally, one group of flows at a time.
+ */
+class DumbbellScenario
+{
+  public:
+    /**
+     * Create the two routers and the bottleneck link between them.
+     *
+     * \param config Parameters of the dumbbell
+     */
+    DumbbellScenario(const DumbbellConfig& config);
+
+    /**
+     * Add flows of one CCA, packed config.flowsPerNode per sender node.
+     * The access delay of every new sender node is drawn uniformly between
+     * config.minAccessDelay and config.maxAccessDelay.
+     *
+     * \param cca Congestion control of the flows
+     * \param flowCount Number of flows
+     * \return The new flows
+     */
+    std::vector<DumbbellFlow> AddFlows(TypeId cca, uint32_t flowCount);
+
+    /**
+     * Change the rate of the bottleneck link, in both directions.
+     * Packets already being transmitted keep the old rate.
+     *
+     * \param rate The new rate
+     */
+    void SetBottleneckRate(DataRate rate);
+
+    /**
+     * Change the delay of the bottleneck link. Packets already in flight
+     * keep the old delay.
+     *
+     * \param delay The new delay
+     */
+    void SetBottleneckDelay(Time delay);
+
+    /**
+     * \return The device of the left router on the bottleneck link
+     */
+    Ptr<NetDevice> GetBottleneckDevice() const;
+
+    /**
+     * \return The number of sender nodes created so far
+     */
+    uint32_t GetSenderCount() const;
+
+  private:
+    /**
+     * Connect a host to a router with a new /30 access link and point the
+     * default route of the host to the router.
+     *
+     * \param host The host
+     * \param router The router
+     * \param delay Delay of the link
+     * \return The address of the host
+     */
+    Ipv4Address Attach(Ptr<Node> host, Ptr<Node> router, Time delay);
+
+    DumbbellConfig m_config;                  //!< Parameters of the dumbbell
+    InternetStackHelper m_stack;              //!< IPv4 only stack with static routing
+    PointToPointHelper m_accessLink;          //!< Helper of the access links
+    Ipv4AddressHelper m_accessAddresses;      //!< Allocator of the /30 access subnets
+    NodeContainer m_routers;                  //!< Left (0) and right (1) routers
+    NetDeviceContainer m_bottleneckDevices;   //!< Devices of the bottleneck link
+    Ptr<UniformRandomVariable> m_accessDelay; //!< Access delay of new sender nodes, in ns
+    uint32_t m_senderCount{0};                //!< Number of sender nodes
+};
+
+} // namespace ns3
+
+#endif // DUMBBELL_SCENARIO_H
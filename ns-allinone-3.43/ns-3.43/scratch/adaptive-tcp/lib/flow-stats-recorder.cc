@@ -0,0 +1,446 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "flow-stats-recorder.h"
+
+#include "ns3/abort.h"
+
+#include <charconv>
+#include <cstring>
+#include <filesystem>
+#include <map>
+#include <tuple>
+#include <utility>
+
+namespace ns3
+{
+
+namespace
+{
+
+const char FLOW_STATS_MAGIC[8] = {'F', 'S', 'R', 'E', 'C', '0', '0', '2'};
+const char MAPPED_FLOW_STATS_MAGIC[8] = {'F', 'S', 'M', 'A', 'P', '0', '0', '1'};
+const uint32_t MAPPED_FLOW_STATS_VERSION = 1;
+const uint32_t FLOW_STATS_VERSION = 2;
+const uint32_t FLOW_BLOCK = 1;
+const uint32_t CHUNK_BLOCK = 2;
+
+template <typename T>
+void
+WriteRaw(std::ofstream& os, const T& value)
+{
+    os.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+bool
+ReadRaw(std::ifstream& is, T& value)
+{
+    return static_cast<bool>(is.read(reinterpret_cast<char*>(&value), sizeof(T)));
+}
+
+/**
+ * Sequential reader of the blocks of a FlowStatsRecorder file.
+ */
+class FlowStatsReader
+{
+  public:
+    FlowStatsReader(const std::string& fileName)
+        : m_file(fileName, std::ios::binary)
+    {
+        NS_ABORT_MSG_IF(!m_file, "Cannot open flow stats file " << fileName);
+        char magic[sizeof(FLOW_STATS_MAGIC)];
+        uint32_t version = 0;
+        uint32_t chunkSize = 0;
+        m_file.read(magic, sizeof(magic));
+        ReadRaw(m_file, version);
+        ReadRaw(m_file, chunkSize);
+        NS_ABORT_MSG_IF(!m_file || std::memcmp(magic, FLOW_STATS_MAGIC, sizeof(magic)) != 0 ||
+                            version != FLOW_STATS_VERSION,
+                        fileName << " is not a flow stats file");
+    }
+
+    /**
+     * Read the next block. For chunks, the samples are only read by ReadSamples.
+     * \return false at the end of the file
+     */
+    bool Next()
+    {
+        if (!ReadRaw(m_file, tag))
+        {
+            return false;
+        }
+        if (tag == FLOW_BLOCK)
+        {
+            uint32_t length = 0;
+            ReadRaw(m_file, flowId);
+            ReadRaw(m_file, length);
+            name.resize(length);
+            m_file.read(name.data(), length);
+        }
+        else
+        {
+            NS_ABORT_MSG_IF(tag != CHUNK_BLOCK, "Corrupted flow stats file");
+            ReadRaw(m_file, flowId);
+            ReadRaw(m_file, metric);
+            ReadRaw(m_file, statistic);
+            ReadRaw(m_file, count);
+            samplesOffset = m_file.tellg();
+            m_file.seekg(count * 2 * sizeof(double), std::ios::cur);
+        }
+        NS_ABORT_MSG_IF(!m_file, "Truncated flow stats file");
+        return true;
+    }
+
+    /**
+     * Read the samples of a chunk found at a given offset.
+     */
+    void ReadSamples(std::streamoff offset,
+                     uint32_t n,
+                     std::vector<double>& times,
+                     std::vector<double>& values)
+    {
+        m_file.clear(); // The index pass may have stopped at the end of the file
+        std::streamoff position = m_file.tellg();
+        times.resize(n);
+        values.resize(n);
+        m_file.seekg(offset);
+        m_file.read(reinterpret_cast<char*>(times.data()), n * sizeof(double));
+        m_file.read(reinterpret_cast<char*>(values.data()), n * sizeof(double));
+        NS_ABORT_MSG_IF(!m_file, "Truncated flow stats file");
+        m_file.seekg(position);
+    }
+
+    uint32_t tag{0};                 //!< Tag of the current block
+    uint32_t flowId{0};              //!< Flow of the current block
+    std::string name;                //!< Flow name, for FLOW blocks
+    uint32_t metric{0};              //!< Metric, for CHUNK blocks
+    uint32_t statistic{0};           //!< Statistic, for CHUNK blocks
+    uint32_t count{0};               //!< Number of samples, for CHUNK blocks
+    std::streamoff samplesOffset{0}; //!< Offset of the samples, for CHUNK blocks
+
+  private:
+    std::ifstream m_file; //!< Input file
+};
+
+/// Flows and chunk locations of a FlowStatsRecorder file
+struct FlowStatsIndex
+{
+    /// Chunks of a series, as (samples offset, sample count)
+    using Chunks = std::vector<std::pair<std::streamoff, uint32_t>>;
+
+    std::map<uint32_t, std::string> flows; //!< Flow names by id
+    /// Chunks by (flow id, metric, statistic), in file order
+    std::map<std::tuple<uint32_t, uint32_t, uint32_t>, Chunks> chunks;
+};
+
+/// Scan a whole file, without reading the samples
+void
+IndexFlowStats(FlowStatsReader& reader, FlowStatsIndex& index)
+{
+    while (reader.Next())
+    {
+        if (reader.tag == FLOW_BLOCK)
+        {
+            index.flows[reader.flowId] = reader.name;
+        }
+        else
+        {
+            index.chunks[{reader.flowId, reader.metric, reader.statistic}].emplace_back(
+                reader.samplesOffset,
+                reader.count);
+        }
+    }
+}
+
+/// Write a double with the shortest representation that reads back exactly
+void
+WriteNumber(std::ostream& os, double value)
+{
+    char buffer[32];
+    auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+    os.write(buffer, result.ptr - buffer);
+}
+
+} // namespace
+
+const char*
+FlowMetricName(FlowMetric metric)
+{
+    static const char* names[FLOW_METRIC_COUNT] = {"throughputs",
+                                                   "cwnds",
+                                                   "rtts",
+                                                   "lastRtts",
+                                                   "rtos",
+                                                   "congestionStates",
+                                                   "bytesInFlights",
+                                                   "pacingRates"};
+    return names[metric];
+}
+
+std::string
+FlowSeriesName(FlowMetric metric, FlowStatistic statistic)
+{
+    static const char* suffixes[FLOW_STATISTIC_COUNT] = {"", "Min", "Max", "Mean"};
+    return std::string(FlowMetricName(metric)) + suffixes[statistic];
+}
+
+FlowStatsRecorder::FlowStatsRecorder(const std::string& fileName, uint32_t chunkSize)
+    : m_fileName(fileName),
+      m_file(fileName, std::ios::binary | std::ios::trunc),
+      m_chunkSize(chunkSize)
+{
+    NS_ABORT_MSG_IF(!m_file, "Cannot open flow stats file " << fileName);
+    NS_ABORT_MSG_IF(chunkSize == 0, "Chunk size must be positive");
+    m_file.write(FLOW_STATS_MAGIC, sizeof(FLOW_STATS_MAGIC));
+    WriteRaw(m_file, FLOW_STATS_VERSION);
+    WriteRaw(m_file, m_chunkSize);
+}
+
+FlowStatsRecorder::~FlowStatsRecorder()
+{
+    Close();
+}
+
+uint32_t
+FlowStatsRecorder::AddFlow(const std::string& name)
+{
+    auto flowId = static_cast<uint32_t>(m_flows.size());
+    // Buffers grow on first use, so unused series cost no memory
+    m_flows.emplace_back();
+
+    WriteRaw(m_file, FLOW_BLOCK);
+    WriteRaw(m_file, flowId);
+    WriteRaw(m_file, static_cast<uint32_t>(name.size()));
+    m_file.write(name.data(), name.size());
+    return flowId;
+}
+
+void
+FlowStatsRecorder::WriteChunk(uint32_t flowId,
+                              FlowMetric metric,
+                              FlowStatistic statistic,
+                              Series& series)
+{
+    auto count = static_cast<uint32_t>(series.times.size());
+    WriteRaw(m_file, CHUNK_BLOCK);
+    WriteRaw(m_file, flowId);
+    WriteRaw(m_file, static_cast<uint32_t>(metric));
+    WriteRaw(m_file, static_cast<uint32_t>(statistic));
+    WriteRaw(m_file, count);
+    m_file.write(reinterpret_cast<const char*>(series.times.data()), count * sizeof(double));
+    m_file.write(reinterpret_cast<const char*>(series.values.data()), count * sizeof(double));
+    series.times.clear();
+    series.values.clear();
+}
+
+void
+FlowStatsRecorder::Flush()
+{
+    for (uint32_t flowId = 0; flowId < m_flows.size(); flowId++)
+    {
+        for (uint32_t metric = 0; metric < FLOW_METRIC_COUNT; metric++)
+        {
+            for (uint32_t statistic = 0; statistic < FLOW_STATISTIC_COUNT; statistic++)
+            {
+                Series& series = m_flows[flowId][metric][statistic];
+                if (!series.times.empty())
+                {
+                    WriteChunk(flowId,
+                               static_cast<FlowMetric>(metric),
+                               static_cast<FlowStatistic>(statistic),
+                               series);
+                }
+            }
+        }
+    }
+    m_file.flush();
+}
+
+void
+FlowStatsRecorder::Close()
+{
+    if (m_file.is_open())
+    {
+        Flush();
+        m_file.close();
+    }
+}
+
+void
+FlowStatsRecorder::Branch(const std::string& fileName)
+{
+    NS_ABORT_MSG_IF(!m_file.is_open(), "Cannot branch closed flow stats file " << m_fileName);
+    Close();
+    std::filesystem::copy_file(m_fileName,
+                               fileName,
+                               std::filesystem::copy_options::overwrite_existing);
+    m_fileName = fileName;
+    m_file.open(fileName, std::ios::binary | std::ios::app);
+    NS_ABORT_MSG_IF(!m_file, "Cannot open flow stats file " << fileName);
+}
+
+void
+ExportFlowStatsToJson(const std::string& binaryFile, const std::string& jsonFile)
+{
+    // First pass: find the flows and the chunks of every series
+    FlowStatsReader reader(binaryFile);
+    FlowStatsIndex index;
+    IndexFlowStats(reader, index);
+
+    // Second pass: write every series in order, one chunk at a time
+    std::ofstream os(jsonFile);
+    NS_ABORT_MSG_IF(!os, "Cannot open " << jsonFile);
+    std::vector<double> times;
+    std::vector<double> values;
+    os << "[";
+    bool firstFlow = true;
+    for (const auto& [flowId, name] : index.flows)
+    {
+        os << (firstFlow ? "\n" : ",\n") << "    {\n        \"cca\": \"" << name << "\"";
+        firstFlow = false;
+        for (uint32_t series = 0; series < uint32_t{FLOW_METRIC_COUNT} * FLOW_STATISTIC_COUNT;
+             series++)
+        {
+            auto metric = static_cast<FlowMetric>(series / FLOW_STATISTIC_COUNT);
+            auto statistic = static_cast<FlowStatistic>(series % FLOW_STATISTIC_COUNT);
+            auto it = index.chunks.find({flowId, metric, statistic});
+            // Plain samples are always listed, aggregated statistics only when recorded
+            if (statistic != STAT_SAMPLE && it == index.chunks.end())
+            {
+                continue;
+            }
+            os << ",\n        \"" << FlowSeriesName(metric, statistic) << "\": [";
+            if (it == index.chunks.end())
+            {
+                os << "]";
+                continue;
+            }
+            bool firstSample = true;
+            for (const auto& [offset, count] : it->second)
+            {
+                reader.ReadSamples(offset, count, times, values);
+                for (uint32_t i = 0; i < count; i++)
+                {
+                    os << (firstSample ? "[" : ",[");
+                    firstSample = false;
+                    WriteNumber(os, times[i]);
+                    os << ",";
+                    WriteNumber(os, values[i]);
+                    os << "]";
+                }
+            }
+            os << "]";
+        }
+        os << "\n    }";
+    }
+    os << "\n]\n";
+}
+
+void
+ExportFlowStatsToCsv(const std::string& binaryFile, const std::string& csvFile)
+{
+    FlowStatsReader reader(binaryFile);
+    std::ofstream os(csvFile);
+    NS_ABORT_MSG_IF(!os, "Cannot open " << csvFile);
+    std::map<uint32_t, std::string> flows;
+    std::vector<double> times;
+    std::vector<double> values;
+
+    os << "flow,cca,metric,time,value\n";
+    while (reader.Next())
+    {
+        if (reader.tag == FLOW_BLOCK)
+        {
+            flows[reader.flowId] = reader.name;
+            continue;
+        }
+        reader.ReadSamples(reader.samplesOffset, reader.count, times, values);
+        std::string metric = FlowSeriesName(static_cast<FlowMetric>(reader.metric),
+                                            static_cast<FlowStatistic>(reader.statistic));
+        for (uint32_t i = 0; i < reader.count; i++)
+        {
+            os << reader.flowId << "," << flows[reader.flowId] << "," << metric << ",";
+            WriteNumber(os, times[i]);
+            os << ",";
+            WriteNumber(os, values[i]);
+            os << "\n";
+        }
+    }
+}
+
+void
+ExportFlowStatsToMapped(const std::string& binaryFile, const std::string& mappedFile)
+{
+    FlowStatsReader reader(binaryFile);
+    FlowStatsIndex index;
+    IndexFlowStats(reader, index);
+
+    // Header, flow table and series table, then the names, then the 8-byte aligned arrays
+    std::string names;
+    std::vector<uint32_t> flowTable;
+    for (const auto& [flowId, name] : index.flows)
+    {
+        NS_ABORT_MSG_IF(flowId != flowTable.size() / 2, "Flow ids are not contiguous");
+        flowTable.push_back(names.size());
+        flowTable.push_back(name.size());
+        names += name;
+    }
+
+    auto flowCount = static_cast<uint32_t>(index.flows.size());
+    auto seriesCount = static_cast<uint32_t>(index.chunks.size());
+    uint64_t offset = sizeof(MAPPED_FLOW_STATS_MAGIC) + 4 * sizeof(uint32_t) +
+                      flowTable.size() * sizeof(uint32_t) +
+                      seriesCount * (4 * sizeof(uint32_t) + 3 * sizeof(uint64_t)) + names.size();
+    uint64_t dataStart = (offset + 7) / 8 * 8;
+
+    std::ofstream os(mappedFile, std::ios::binary | std::ios::trunc);
+    NS_ABORT_MSG_IF(!os, "Cannot open " << mappedFile);
+    os.write(MAPPED_FLOW_STATS_MAGIC, sizeof(MAPPED_FLOW_STATS_MAGIC));
+    WriteRaw(os, MAPPED_FLOW_STATS_VERSION);
+    WriteRaw(os, flowCount);
+    WriteRaw(os, seriesCount);
+    WriteRaw(os, static_cast<uint32_t>(names.size()));
+    os.write(reinterpret_cast<const char*>(flowTable.data()), flowTable.size() * sizeof(uint32_t));
+
+    offset = dataStart;
+    for (const auto& [key, chunks] : index.chunks)
+    {
+        uint64_t count = 0;
+        for (const auto& chunk : chunks)
+        {
+            count += chunk.second;
+        }
+        WriteRaw(os, std::get<0>(key));
+        WriteRaw(os, std::get<1>(key));
+        WriteRaw(os, std::get<2>(key));
+        WriteRaw(os, uint32_t{0});
+        WriteRaw(os, count);
+        WriteRaw(os, offset);                         // times
+        WriteRaw(os, offset + count * sizeof(double)); // values
+        offset += 2 * count * sizeof(double);
+    }
+    os.write(names.data(), names.size());
+    os.write("\0\0\0\0\0\0\0", dataStart - os.tellp());
+
+    // Chunks interleave times and values, so the chunks of a series are read twice
+    std::vector<double> times;
+    std::vector<double> values;
+    for (const auto& [key, chunks] : index.chunks)
+    {
+        for (const auto& [chunkOffset, count] : chunks)
+        {
+            reader.ReadSamples(chunkOffset, count, times, values);
+            os.write(reinterpret_cast<const char*>(times.data()), count * sizeof(double));
+        }
+        for (const auto& [chunkOffset, count] : chunks)
+        {
+            reader.ReadSamples(chunkOffset, count, times, values);
+            os.write(reinterpret_cast<const char*>(values.data()), count * sizeof(double));
+        }
+    }
+    NS_ABORT_MSG_IF(!os, "Failed writing " << mappedFile);
+}
+
+} // namespace ns3
@@ -0,0 +1,213 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+// Bounded-memory recorder for the per-flow time series of adaptive-tcp-test.
+//
+// Samples are buffered per (flow, metric, statistic) series and written to disk in
+// columnar chunks as soon as a buffer fills up, so memory use only depends on
+// the number of series and the chunk size, not on the simulation length.
+//
+// File layout (native endianness):
+//   header: "FSREC002" magic, uint32 version, uint32 chunk size
+//   blocks: uint32 tag followed by
+//     FLOW  (1): uint32 flow id, uint32 name length, name bytes
+//     CHUNK (2): uint32 flow id, uint32 metric, uint32 statistic, uint32 count,
+//                count x double times, count x double values
+
+#ifndef FLOW_STATS_RECORDER_H
+#define FLOW_STATS_RECORDER_H
+
+#include <array>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * Time series recorded for every flow.
+ */
+enum FlowMetric : uint32_t
+{
+    THROUGHPUT,
+    CWND,
+    RTT,
+    LAST_RTT,
+    RTO,
+    CONG_STATE,
+    BYTES_IN_FLIGHT,
+    PACING_RATE,
+    FLOW_METRIC_COUNT
+};
+
+/**
+ * What a recorded value represents. Raw samples and the last value of an
+ * aggregation bucket are both recorded as STAT_SAMPLE.
+ */
+enum FlowStatistic : uint32_t
+{
+    STAT_SAMPLE,
+    STAT_MIN,
+    STAT_MAX,
+    STAT_MEAN,
+    FLOW_STATISTIC_COUNT
+};
+
+/**
+ * Get the name of a metric, as used for the keys of the JSON output.
+ *
+ * \param metric The metric
+ * \return The metric name
+ */
+const char* FlowMetricName(FlowMetric metric);
+
+/**
+ * Get the name of a series, i.e. the metric name followed by the statistic
+ * name ("cwnds", "cwndsMin", "cwndsMax", "cwndsMean").
+ *
+ * \param metric The metric
+ * \param statistic The statistic
+ * \return The series name
+ */
+std::string FlowSeriesName(FlowMetric metric, FlowStatistic statistic);
+
+/**
+ * Streams (time, value) samples of every flow to a binary columnar file.
+ */
+class FlowStatsRecorder
+{
+  public:
+    /**
+     * Open the output file and write the file header.
+     *
+     * \param fileName Name of the binary output file
+     * \param chunkSize Number of samples buffered per series before it is written
+     */
+    FlowStatsRecorder(const std::string& fileName, uint32_t chunkSize = 4096);
+    ~FlowStatsRecorder();
+
+    FlowStatsRecorder(const FlowStatsRecorder&) = delete;
+    FlowStatsRecorder& operator=(const FlowStatsRecorder&) = delete;
+
+    /**
+     * Register a new flow.
+     *
+     * \param name Name of the flow (its CCA)
+     * \return The id to be used when recording samples of this flow
+     */
+    uint32_t AddFlow(const std::string& name);
+
+    /**
+     * Record a sample.
+     *
+     * \param flowId Id returned by AddFlow
+     * \param metric Metric of the sample
+     * \param time Simulation time, in seconds
+     * \param value Sample value
+     * \param statistic What the value represents
+     */
+    void Record(uint32_t flowId,
+                FlowMetric metric,
+                double time,
+                double value,
+                FlowStatistic statistic = STAT_SAMPLE)
+    {
+        Series& series = m_flows[flowId][metric][statistic];
+        series.times.push_back(time);
+        series.values.push_back(value);
+        if (series.times.size() == m_chunkSize)
+        {
+            WriteChunk(flowId, metric, statistic, series);
+        }
+    }
+
+    /**
+     * Write every partially filled buffer to disk.
+     */
+    void Flush();
+
+    /**
+     * Flush and close the output file. Called by the destructor if needed.
+     */
+    void Close();
+
+    /**
+     * Continue recording in a copy of the output file, e.g. in a forked
+     * continuation of the simulation. The samples recorded so far are kept
+     * in both files and the next ones only go to the copy.
+     *
+     * \param fileName Name of the copy
+     */
+    void Branch(const std::string& fileName);
+
+  private:
+    /// Buffered samples of one series
+    struct Series
+    {
+        std::vector<double> times;  //!< Sample times
+        std::vector<double> values; //!< Sample values
+    };
+
+    /// Buffers of every series of a flow
+    using FlowSeries = std::array<std::array<Series, FLOW_STATISTIC_COUNT>, FLOW_METRIC_COUNT>;
+
+    /**
+     * Write the buffered samples of a series as one chunk and clear the buffer.
+     *
+     * \param flowId Flow of the series
+     * \param metric Metric of the series
+     * \param statistic Statistic of the series
+     * \param series The series
+     */
+    void WriteChunk(uint32_t flowId, FlowMetric metric, FlowStatistic statistic, Series& series);
+
+    std::string m_fileName;          //!< Name of the output file
+    std::ofstream m_file;            //!< Output file
+    uint32_t m_chunkSize;            //!< Samples per chunk
+    std::vector<FlowSeries> m_flows; //!< Buffers per flow
+};
+
+/**
+ * Convert a file written by FlowStatsRecorder to the JSON layout of
+ * adaptive-tcp-test (a list of flows with one [time, value] list per metric,
+ * plus one list per aggregated statistic that was recorded).
+ * The conversion streams the samples and never holds more than one chunk in memory.
+ *
+ * \param binaryFile File written by FlowStatsRecorder
+ * \param jsonFile Name of the JSON file to write
+ */
+void ExportFlowStatsToJson(const std::string& binaryFile, const std::string& jsonFile);
+
+/**
+ * Convert a file written by FlowStatsRecorder to a memory-mappable file in
+ * which every series is stored as two contiguous arrays, so that readers can
+ * slice it without parsing (see flow_stats.py for the Python reader).
+ *
+ * Layout (native endianness, arrays aligned to 8 bytes):
+ *   header: "FSMAP001" magic, uint32 version, uint32 flow count,
+ *           uint32 series count, uint32 names size
+ *   flow table: per flow, uint32 name offset and uint32 name length
+ *   series table: per series, uint32 flow id, uint32 metric, uint32 statistic,
+ *                 uint32 padding, uint64 count, uint64 times offset, uint64 values offset
+ *   names, padding, then count x double times and count x double values per series
+ *
+ * \param binaryFile File written by FlowStatsRecorder
+ * \param mappedFile Name of the file to write
+ */
+void ExportFlowStatsToMapped(const std::string& binaryFile, const std::string& mappedFile);
+
+/**
+ * Convert a file written by FlowStatsRecorder to CSV, with one
+ * "flow,cca,metric,time,value" row per sample, where metric is the series name.
+ *
+ * \param binaryFile File written by FlowStatsRecorder
+ * \param csvFile Name of the CSV file to write
+ */
+void ExportFlowStatsToCsv(const std::string& binaryFile, const std::string& csvFile);
+
+} // namespace ns3
+
+#endif // FLOW_STATS_RECORDER_H
@@ -0,0 +1,184 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "recording-policy.h"
+
+#include "ns3/abort.h"
+
+#include <algorithm>
+#include <sstream>
+
+namespace ns3
+{
+
+namespace
+{
+
+RecordingPolicy
+ParseRecordingPolicy(const std::string& spec)
+{
+    RecordingPolicy policy;
+    std::string mode = spec.substr(0, spec.find(':'));
+    if (mode != spec)
+    {
+        policy.parameter = std::stod(spec.substr(mode.size() + 1));
+    }
+
+    if (mode == "every")
+    {
+        policy.mode = RECORD_EVERY_CHANGE;
+    }
+    else if (mode == "bucket")
+    {
+        policy.mode = RECORD_TIME_BUCKET;
+        NS_ABORT_MSG_IF(policy.parameter <= 0, "Bucket width must be positive: " << spec);
+    }
+    else if (mode == "threshold")
+    {
+        policy.mode = RECORD_CHANGE_THRESHOLD;
+        NS_ABORT_MSG_IF(policy.parameter < 0, "Threshold must not be negative: " << spec);
+    }
+    else if (mode == "reservoir")
+    {
+        policy.mode = RECORD_RESERVOIR;
+        NS_ABORT_MSG_IF(policy.parameter < 1, "Reservoir size must be at least 1: " << spec);
+    }
+    else
+    {
+        NS_ABORT_MSG("Unknown recording policy " << spec);
+    }
+    return policy;
+}
+
+/// splitmix64 step, used for the reservoir replacement decisions
+uint64_t
+NextRandom(uint64_t& state)
+{
+    uint64_t z = (state += 0x9e3779b97f4a7c15ULL);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+} // namespace
+
+std::array<RecordingPolicy, FLOW_METRIC_COUNT>
+ParseRecordingPolicies(const std::string& spec)
+{
+    std::array<RecordingPolicy, FLOW_METRIC_COUNT> policies;
+    std::istringstream entries(spec);
+    std::string entry;
+    while (std::getline(entries, entry, ','))
+    {
+        if (entry.empty())
+        {
+            continue;
+        }
+        auto separator = entry.find('=');
+        NS_ABORT_MSG_IF(separator == std::string::npos,
+                        "Expected metric=policy, got " << entry);
+        std::string metric = entry.substr(0, separator);
+        RecordingPolicy policy = ParseRecordingPolicy(entry.substr(separator + 1));
+
+        bool found = false;
+        for (uint32_t i = 0; i < FLOW_METRIC_COUNT; i++)
+        {
+            if (metric == "*" || metric == FlowMetricName(static_cast<FlowMetric>(i)))
+            {
+                policies[i] = policy;
+                found = true;
+            }
+        }
+        NS_ABORT_MSG_IF(!found, "Unknown metric " << metric);
+    }
+    return policies;
+}
+
+void
+SeriesSampler::Setup(FlowStatsRecorder* recorder,
+                     uint32_t flowId,
+                     FlowMetric metric,
+                     const RecordingPolicy& policy)
+{
+    m_recorder = recorder;
+    m_flowId = flowId;
+    m_metric = metric;
+    m_policy = policy;
+    m_rngState = (static_cast<uint64_t>(flowId) << 32) | metric;
+}
+
+void
+SeriesSampler::AddToBucket(double time, double value)
+{
+    auto bucket = static_cast<int64_t>(time / m_policy.parameter);
+    if (bucket != m_bucket)
+    {
+        FlushBucket();
+        m_bucket = bucket;
+        m_min = m_max = m_sum = value;
+        m_count = 1;
+    }
+    else
+    {
+        m_min = std::min(m_min, value);
+        m_max = std::max(m_max, value);
+        m_sum += value;
+        m_count++;
+    }
+    m_last = value;
+}
+
+void
+SeriesSampler::FlushBucket()
+{
+    if (m_count == 0)
+    {
+        return;
+    }
+    double start = m_bucket * m_policy.parameter;
+    m_recorder->Record(m_flowId, m_metric, start, m_last, STAT_SAMPLE);
+    m_recorder->Record(m_flowId, m_metric, start, m_min, STAT_MIN);
+    m_recorder->Record(m_flowId, m_metric, start, m_max, STAT_MAX);
+    m_recorder->Record(m_flowId, m_metric, start, m_sum / m_count, STAT_MEAN);
+    m_count = 0;
+}
+
+void
+SeriesSampler::AddToReservoir(double time, double value)
+{
+    auto size = static_cast<uint64_t>(m_policy.parameter);
+    if (m_seen < size)
+    {
+        m_reservoir.emplace_back(time, value);
+    }
+    else
+    {
+        uint64_t slot = NextRandom(m_rngState) % (m_seen + 1);
+        if (slot < size)
+        {
+            m_reservoir[slot] = {time, value};
+        }
+    }
+    m_seen++;
+}
+
+void
+SeriesSampler::Finish()
+{
+    if (m_policy.mode == RECORD_TIME_BUCKET)
+    {
+        FlushBucket();
+    }
+    else if (m_policy.mode == RECORD_RESERVOIR)
+    {
+        std::sort(m_reservoir.begin(), m_reservoir.end());
+        for (const auto& [time, value] : m_reservoir)
+        {
+            m_recorder->Record(m_flowId, m_metric, time, value);
+        }
+        m_reservoir.clear();
+    }
+}
+
+} // namespace ns3
@@ -0,0 +1,157 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+// Recording policies that reduce the samples of a trace before they reach
+// the FlowStatsRecorder. The reduction happens inside the trace callback, so
+// only the reduced series is ever buffered or written.
+
+#ifndef RECORDING_POLICY_H
+#define RECORDING_POLICY_H
+
+#include "flow-stats-recorder.h"
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * How the samples of a series are recorded.
+ */
+enum RecordingMode
+{
+    RECORD_EVERY_CHANGE,     //!< Record every sample
+    RECORD_TIME_BUCKET,      //!< Record min/max/mean/last of fixed time buckets
+    RECORD_CHANGE_THRESHOLD, //!< Record a sample when it moved enough from the last recorded one
+    RECORD_RESERVOIR,        //!< Record a uniform random subset of fixed size
+};
+
+/**
+ * Recording mode of a series and its parameter.
+ */
+struct RecordingPolicy
+{
+    RecordingMode mode = RECORD_EVERY_CHANGE; //!< Recording mode
+    /// Bucket width in seconds, relative change threshold or reservoir size
+    double parameter = 0;
+};
+
+/**
+ * Parse the policies of every metric.
+ *
+ * The specification is a comma separated list of "metric=policy" entries,
+ * where metric is a JSON key such as "cwnds" (or "*" for all metrics) and
+ * policy is one of "every", "bucket:<seconds>", "threshold:<relative change>"
+ * or "reservoir:<samples>". Metrics that are not listed record every change.
+ * For example "*=bucket:0.001,throughputs=every".
+ *
+ * \param spec The policy specification
+ * \return The policy of every metric
+ */
+std::array<RecordingPolicy, FLOW_METRIC_COUNT> ParseRecordingPolicies(const std::string& spec);
+
+/**
+ * Applies a recording policy to the samples of one (flow, metric) series.
+ */
+class SeriesSampler
+{
+  public:
+    /**
+     * Attach the sampler to a series of a recorder.
+     *
+     * \param recorder Recorder the reduced samples are written to
+     * \param flowId Flow of the series
+     * \param metric Metric of the series
+     * \param policy Recording policy
+     */
+    void Setup(FlowStatsRecorder* recorder,
+               uint32_t flowId,
+               FlowMetric metric,
+               const RecordingPolicy& policy);
+
+    /**
+     * Add a sample to the series.
+     *
+     * \param time Simulation time, in seconds
+     * \param value Sample value
+     */
+    void Add(double time, double value)
+    {
+        switch (m_policy.mode)
+        {
+        case RECORD_EVERY_CHANGE:
+            m_recorder->Record(m_flowId, m_metric, time, value);
+            break;
+        case RECORD_TIME_BUCKET:
+            AddToBucket(time, value);
+            break;
+        case RECORD_CHANGE_THRESHOLD:
+            if (!m_hasLast || std::abs(value - m_last) > m_policy.parameter * std::abs(m_last))
+            {
+                m_recorder->Record(m_flowId, m_metric, time, value);
+                m_last = value;
+                m_hasLast = true;
+            }
+            break;
+        case RECORD_RESERVOIR:
+            AddToReservoir(time, value);
+            break;
+        }
+    }
+
+    /**
+     * Record what is still held by the sampler (the open bucket or the reservoir).
+     */
+    void Finish();
+
+  private:
+    /**
+     * Add a sample in RECORD_TIME_BUCKET mode.
+     * \param time Sample time
+     * \param value Sample value
+     */
+    void AddToBucket(double time, double value);
+
+    /**
+     * Record the statistics of the open bucket.
+     */
+    void FlushBucket();
+
+    /**
+     * Add a sample in RECORD_RESERVOIR mode.
+     * \param time Sample time
+     * \param value Sample value
+     */
+    void AddToReservoir(double time, double value);
+
+    FlowStatsRecorder* m_recorder{nullptr}; //!< Recorder of the reduced samples
+    uint32_t m_flowId{0};                   //!< Flow of the series
+    FlowMetric m_metric{THROUGHPUT};        //!< Metric of the series
+    RecordingPolicy m_policy;               //!< Recording policy
+
+    // RECORD_TIME_BUCKET state
+    int64_t m_bucket{-1}; //!< Index of the open bucket, -1 if none
+    double m_min{0};      //!< Minimum of the open bucket
+    double m_max{0};      //!< Maximum of the open bucket
+    double m_sum{0};      //!< Sum of the open bucket
+    uint64_t m_count{0};  //!< Number of samples in the open bucket
+
+    // RECORD_TIME_BUCKET and RECORD_CHANGE_THRESHOLD state
+    double m_last{0};      //!< Last sample of the bucket, or last recorded sample
+    bool m_hasLast{false}; //!< Whether a sample was recorded yet
+
+    // RECORD_RESERVOIR state
+    std::vector<std::pair<double, double>> m_reservoir; //!< Sampled (time, value) pairs
+    uint64_t m_seen{0};                                 //!< Samples offered so far
+    uint64_t m_rngState{0}; //!< splitmix64 state, independent of the simulation RNG streams
+};
+
+} // namespace ns3
+
+#endif // RECORDING_POLICY_H
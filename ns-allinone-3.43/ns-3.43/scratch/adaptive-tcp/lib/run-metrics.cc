@@ -0,0 +1,421 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "run-metrics.h"
+
+#include "ns3/abort.h"
+#include "ns3/node.h"
+#include "ns3/queue-disc.h"
+#include "ns3/queue.h"
+#include "ns3/simulator.h"
+#include "ns3/traffic-control-layer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+
+namespace ns3
+{
+
+P2Quantile::P2Quantile(double quantile)
+    : m_quantile(quantile)
+{
+    NS_ABORT_MSG_IF(quantile < 0 || quantile > 1, "Invalid quantile " << quantile);
+}
+
+void
+P2Quantile::Add(double value)
+{
+    if (m_count < 5)
+    {
+        m_heights[m_count++] = value;
+        if (m_count == 5)
+        {
+            std::sort(m_heights.begin(), m_heights.end());
+            double p = m_quantile;
+            m_position = {1, 2, 3, 4, 5};
+            m_desired = {1, 1 + 2 * p, 1 + 4 * p, 3 + 2 * p, 5};
+            m_increment = {0, p / 2, p, (1 + p) / 2, 1};
+        }
+        return;
+    }
+
+    // Find the cell of the sample, extending the extreme markers if needed
+    int cell;
+    if (value < m_heights[0])
+    {
+        m_heights[0] = value;
+        cell = 0;
+    }
+    else if (value >= m_heights[4])
+    {
+        m_heights[4] = value;
+        cell = 3;
+    }
+    else
+    {
+        cell = 0;
+        while (value >= m_heights[cell + 1])
+        {
+            cell++;
+        }
+    }
+
+    for (int i = cell + 1; i < 5; i++)
+    {
+        m_position[i]++;
+    }
+    for (int i = 0; i < 5; i++)
+    {
+        m_desired[i] += m_increment[i];
+    }
+
+    // Move the middle markers that are off their desired position by one or more
+    for (int i = 1; i < 4; i++)
+    {
+        double offset = m_desired[i] - m_position[i];
+        if ((offset >= 1 && m_position[i + 1] - m_position[i] > 1) ||
+            (offset <= -1 && m_position[i - 1] - m_position[i] < -1))
+        {
+            double d = offset > 0 ? 1 : -1;
+            double height = Parabolic(i, d);
+            if (m_heights[i - 1] < height && height < m_heights[i + 1])
+            {
+                m_heights[i] = height;
+            }
+            else
+            {
+                m_heights[i] = Linear(i, d);
+            }
+            m_position[i] += d;
+        }
+    }
+    m_count++;
+}
+
+double
+P2Quantile::Parabolic(int i, double d) const
+{
+    const auto& q = m_heights;
+    const auto& n = m_position;
+    return q[i] + d / (n[i + 1] - n[i - 1]) *
+                      ((n[i] - n[i - 1] + d) * (q[i + 1] - q[i]) / (n[i + 1] - n[i]) +
+                       (n[i + 1] - n[i] - d) * (q[i] - q[i - 1]) / (n[i] - n[i - 1]));
+}
+
+double
+P2Quantile::Linear(int i, double d) const
+{
+    int j = i + static_cast<int>(d);
+    return m_heights[i] + d * (m_heights[j] - m_heights[i]) / (m_position[j] - m_position[i]);
+}
+
+double
+P2Quantile::Get() const
+{
+    if (m_count >= 5)
+    {
+        return m_heights[2];
+    }
+    if (m_count == 0)
+    {
+        return 0;
+    }
+    std::array<double, 5> sorted = m_heights;
+    std::sort(sorted.begin(), sorted.begin() + m_count);
+    return sorted[std::lround(m_quantile * (m_count - 1))];
+}
+
+Ewma::Ewma(double alpha)
+    : m_alpha(alpha)
+{
+}
+
+void
+Ewma::Add(double value)
+{
+    m_value = m_empty ? value : m_alpha * value + (1 - m_alpha) * m_value;
+    m_empty = false;
+}
+
+double
+Ewma::Get() const
+{
+    return m_value;
+}
+
+double
+JainIndex(const std::vector<double>& values)
+{
+    double sum = 0;
+    double squares = 0;
+    for (double value : values)
+    {
+        sum += value;
+        squares += value * value;
+    }
+    if (squares == 0)
+    {
+        return 1;
+    }
+    return sum * sum / (values.size() * squares);
+}
+
+RunMetrics::RunMetrics(const RunMetricsConfig& config)
+    : m_config(config),
+      m_utilization(config.ewmaAlpha),
+      m_jain(config.ewmaAlpha),
+      m_queueDelay{P2Quantile(0.5), P2Quantile(0.95), P2Quantile(0.99)},
+      m_discSojourn{P2Quantile(0.5), P2Quantile(0.95), P2Quantile(0.99)}
+{
+    NS_ABORT_MSG_IF(!config.window.IsStrictlyPositive(), "The window must be positive");
+}
+
+void
+RunMetrics::MonitorBottleneck(Ptr<PointToPointNetDevice> device)
+{
+    m_bottleneck = device;
+
+    Ptr<Queue<Packet>> queue = device->GetQueue();
+    queue->TraceConnectWithoutContext("Enqueue", MakeCallback(&RunMetrics::Enqueue, this));
+    queue->TraceConnectWithoutContext("Dequeue", MakeCallback(&RunMetrics::Dequeue, this));
+    queue->TraceConnectWithoutContext("DropBeforeEnqueue",
+                                      MakeCallback(&RunMetrics::QueueDrop, this));
+    device->TraceConnectWithoutContext("PhyTxBegin", MakeCallback(&RunMetrics::Transmit, this));
+
+    // Packets usually wait in the queue disc, the device queue only holds
+    // what the link is about to send
+    Ptr<TrafficControlLayer> tc = device->GetNode()->GetObject<TrafficControlLayer>();
+    if (Ptr<QueueDisc> disc = tc ? tc->GetRootQueueDiscOnDevice(device) : nullptr)
+    {
+        m_hasQueueDisc = true;
+        disc->TraceConnectWithoutContext("Drop", MakeCallback(&RunMetrics::DiscDrop, this));
+        disc->TraceConnectWithoutContext("SojournTime",
+                                         MakeCallback(&RunMetrics::DiscSojourn, this));
+    }
+}
+
+void
+RunMetrics::AddFlow(const std::string& name, Ptr<PacketSink> sink)
+{
+    auto flow = static_cast<uint32_t>(m_flows.size());
+    m_flows.push_back({name});
+    sink->TraceConnectWithoutContext("Rx", MakeCallback(&RunMetrics::Receive, this).Bind(flow));
+}
+
+void
+RunMetrics::Start(Time start, Time stop)
+{
+    m_stop = stop;
+    Simulator::Schedule(start - Simulator::Now(), [this]() {
+        // Only count what happens from the first window on
+        m_windowTxBytes = 0;
+        for (auto& flow : m_flows)
+        {
+            flow.windowBytes = 0;
+        }
+        Simulator::Schedule(m_config.window, &RunMetrics::EndWindow, this);
+    });
+}
+
+void
+RunMetrics::EndWindow()
+{
+    double window = m_config.window.GetSeconds();
+
+    // The rate is read on every window, a forked continuation may change it
+    DataRateValue capacity;
+    m_bottleneck->GetAttribute("DataRate", capacity);
+    double utilization = m_windowTxBytes * 8.0 / (capacity.Get().GetBitRate() * window);
+    m_windowTxBytes = 0;
+    m_utilizationSum += utilization;
+    m_utilization.Add(utilization);
+
+    // Flows take part in the fairness once they received their first byte
+    std::vector<double> throughputs;
+    for (const auto& flow : m_flows)
+    {
+        if (!flow.firstRx.IsNegative())
+        {
+            throughputs.push_back(flow.windowBytes * 8.0 / window);
+        }
+    }
+    if (!throughputs.empty())
+    {
+        double jain = JainIndex(throughputs);
+        m_jainSum += jain;
+        m_jainWindows++;
+        m_jainMin = std::min(m_jainMin, jain);
+        m_jain.Add(jain);
+
+        double fairShare = 0;
+        for (double throughput : throughputs)
+        {
+            fairShare += throughput;
+        }
+        fairShare /= throughputs.size();
+
+        for (auto& flow : m_flows)
+        {
+            if (flow.firstRx.IsNegative() || !flow.convergence.IsNegative())
+            {
+                continue;
+            }
+            double throughput = flow.windowBytes * 8.0 / window;
+            if (std::abs(throughput - fairShare) <= m_config.convergenceTolerance * fairShare)
+            {
+                flow.stableWindows++;
+            }
+            else
+            {
+                flow.stableWindows = 0;
+            }
+            if (flow.stableWindows == m_config.convergenceWindows)
+            {
+                // Converged at the start of the first stable window
+                Time stableSince = Simulator::Now() - m_config.window * flow.stableWindows;
+                flow.convergence = Max(stableSince - flow.firstRx, Time(0));
+            }
+        }
+    }
+    for (auto& flow : m_flows)
+    {
+        flow.totalBytes += flow.windowBytes;
+        flow.windowBytes = 0;
+    }
+    m_windows++;
+
+    if (Simulator::Now() + m_config.window <= m_stop)
+    {
+        Simulator::Schedule(m_config.window, &RunMetrics::EndWindow, this);
+    }
+}
+
+void
+RunMetrics::Enqueue(Ptr<const Packet> packet)
+{
+    m_enqueueTimes.push_back(Simulator::Now());
+}
+
+void
+RunMetrics::Dequeue(Ptr<const Packet> packet)
+{
+    // The device queue is FIFO
+    double delay = (Simulator::Now() - m_enqueueTimes.front()).GetSeconds();
+    m_enqueueTimes.pop_front();
+    for (auto& quantile : m_queueDelay)
+    {
+        quantile.Add(delay);
+    }
+    m_queueDelayMax = std::max(m_queueDelayMax, delay);
+}
+
+void
+RunMetrics::QueueDrop(Ptr<const Packet> packet)
+{
+    m_queueDrops++;
+}
+
+void
+RunMetrics::DiscDrop(Ptr<const QueueDiscItem> item)
+{
+    m_discDrops++;
+}
+
+void
+RunMetrics::DiscSojourn(Time sojourn)
+{
+    double delay = sojourn.GetSeconds();
+    for (auto& quantile : m_discSojourn)
+    {
+        quantile.Add(delay);
+    }
+    m_discSojournMax = std::max(m_discSojournMax, delay);
+}
+
+void
+RunMetrics::Transmit(Ptr<const Packet> packet)
+{
+    m_windowTxBytes += packet->GetSize();
+}
+
+void
+RunMetrics::Receive(uint32_t flow, Ptr<const Packet> packet, const Address& from)
+{
+    Flow& data = m_flows[flow];
+    if (data.firstRx.IsNegative())
+    {
+        data.firstRx = Simulator::Now();
+    }
+    data.windowBytes += packet->GetSize();
+}
+
+namespace
+{
+
+/**
+ * Write the quantiles and maximum of a delay, in milliseconds.
+ *
+ * \param out The output stream
+ * \param quantiles p50, p95 and p99
+ * \param max The maximum
+ */
+void
+WriteDelay(std::ostream& out, const std::array<P2Quantile, 3>& quantiles, double max)
+{
+    out << "{\"p50\": " << quantiles[0].Get() * 1e3 << ", \"p95\": " << quantiles[1].Get() * 1e3
+        << ", \"p99\": " << quantiles[2].Get() * 1e3 << ", \"max\": " << max * 1e3 << "}";
+}
+
+} // namespace
+
+void
+RunMetrics::WriteSummary(const std::string& fileName) const
+{
+    std::ofstream out(fileName);
+    NS_ABORT_MSG_IF(!out, "Cannot open " << fileName);
+
+    double windows = std::max<uint64_t>(m_windows, 1);
+    out << "{\n";
+    out << "  \"window\": " << m_config.window.GetSeconds() << ",\n";
+    out << "  \"windows\": " << m_windows << ",\n";
+    out << "  \"utilization\": {\"mean\": " << m_utilizationSum / windows
+        << ", \"ewma\": " << m_utilization.Get() << "},\n";
+    out << "  \"jain\": {\"mean\": " << m_jainSum / std::max<uint64_t>(m_jainWindows, 1)
+        << ", \"min\": " << m_jainMin << ", \"ewma\": " << m_jain.Get() << "},\n";
+    out << "  \"queueDelayMs\": ";
+    WriteDelay(out, m_queueDelay, m_queueDelayMax);
+    out << ",\n";
+    if (m_hasQueueDisc)
+    {
+        out << "  \"queueDiscSojournMs\": ";
+        WriteDelay(out, m_discSojourn, m_discSojournMax);
+        out << ",\n";
+    }
+    out << "  \"drops\": {\"queue\": " << m_queueDrops << ", \"queueDisc\": " << m_discDrops
+        << "},\n";
+
+    // Mean throughput over the windows, and convergence time (null if the
+    // flow never converged)
+    double duration = m_config.window.GetSeconds() * windows;
+    out << "  \"flows\": [";
+    for (size_t i = 0; i < m_flows.size(); i++)
+    {
+        const Flow& flow = m_flows[i];
+        out << (i ? ",\n" : "\n") << "    {\"cca\": \"" << flow.name
+            << "\", \"throughputMbps\": " << flow.totalBytes * 8.0 / duration / 1e6
+            << ", \"convergenceTime\": ";
+        if (flow.convergence.IsNegative())
+        {
+            out << "null}";
+        }
+        else
+        {
+            out << flow.convergence.GetSeconds() << "}";
+        }
+    }
+    out << "\n  ]\n}\n";
+}
+
+} // namespace ns3
@@ -0,0 +1,262 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+// Metrics of a run of adaptive-tcp-test computed while the simulation runs,
+// with streaming estimators whose memory does not depend on the run length:
+// link utilization, Jain's fairness index, queueing delay quantiles and the
+// time every flow takes to converge to its fair share.
+//
+// Time is cut in fixed measurement windows. At the end of every window the
+// bytes received by every PacketSink and sent on the bottleneck link give the
+// per-window throughputs, Jain's index and utilization, which feed means,
+// minimums and EWMAs. Queueing delays feed P² quantile estimators.
+
+#ifndef RUN_METRICS_H
+#define RUN_METRICS_H
+
+#include "ns3/data-rate.h"
+#include "ns3/nstime.h"
+#include "ns3/packet-sink.h"
+#include "ns3/point-to-point-net-device.h"
+
+#include <array>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <vector>
+
+namespace ns3
+{
+
+class QueueDiscItem;
+
+/**
+ * Streaming estimator of one quantile, with the P² algorithm of Jain and
+ * Chlamtac ("The P² algorithm for dynamic calculation of quantiles and
+ * histograms without storing observations", CACM 1985). It keeps five
+ * markers whatever the number of samples.
+ */
+class P2Quantile
+{
+  public:
+    /**
+     * \param quantile The quantile to estimate, in [0, 1]
+     */
+    explicit P2Quantile(double quantile);
+
+    /**
+     * Add a sample.
+     * \param value The sample
+     */
+    void Add(double value);
+
+    /**
+     * \return The estimated quantile, exact below five samples, 0 without samples
+     */
+    double Get() const;
+
+  private:
+    /**
+     * Height of marker i moved by d positions, with the piecewise-parabolic formula.
+     * \param i Index of the marker
+     * \param d Direction of the move, -1 or 1
+     * \return The new height
+     */
+    double Parabolic(int i, double d) const;
+
+    /**
+     * Height of marker i moved by d positions, with linear interpolation.
+     * \param i Index of the marker
+     * \param d Direction of the move, -1 or 1
+     * \return The new height
+     */
+    double Linear(int i, double d) const;
+
+    double m_quantile;                 //!< Estimated quantile
+    uint64_t m_count{0};               //!< Number of samples
+    std::array<double, 5> m_heights;   //!< Marker heights
+    std::array<double, 5> m_position;  //!< Marker positions
+    std::array<double, 5> m_desired;   //!< Desired marker positions
+    std::array<double, 5> m_increment; //!< Increments of the desired positions
+};
+
+/**
+ * Exponentially weighted moving average.
+ */
+class Ewma
+{
+  public:
+    /**
+     * \param alpha Weight of a new sample
+     */
+    explicit Ewma(double alpha);
+
+    /**
+     * Add a sample, the first one initializes the average.
+     * \param value The sample
+     */
+    void Add(double value);
+
+    /**
+     * \return The average, 0 without samples
+     */
+    double Get() const;
+
+  private:
+    double m_alpha;     //!< Weight of a new sample
+    double m_value{0};  //!< Current average
+    bool m_empty{true}; //!< Whether no sample was added yet
+};
+
+/**
+ * Jain's fairness index, (sum x)^2 / (n sum x^2).
+ *
+ * \param values The allocations
+ * \return The index, in [1/n, 1], or 1 when every allocation is 0
+ */
+double JainIndex(const std::vector<double>& values);
+
+/**
+ * Parameters of RunMetrics.
+ */
+struct RunMetricsConfig
+{
+    Time window = MilliSeconds(100); //!< Length of a measurement window
+    double ewmaAlpha = 0.1;          //!< Weight of a window in the EWMAs
+    /// A flow has converged when its throughput stays within this relative
+    /// distance of the fair share...
+    double convergenceTolerance = 0.2;
+    uint32_t convergenceWindows = 10; //!< ... for this many consecutive windows
+};
+
+/**
+ * Computes the metrics of a run and writes them as a compact JSON summary.
+ */
+class RunMetrics
+{
+  public:
+    /**
+     * \param config Parameters of the metrics
+     */
+    RunMetrics(const RunMetricsConfig& config);
+
+    /**
+     * Trace the queue, the queue disc (if any) and the transmissions of the
+     * bottleneck device.
+     *
+     * \param device The device at the entrance of the bottleneck link
+     */
+    void MonitorBottleneck(Ptr<PointToPointNetDevice> device);
+
+    /**
+     * Trace the bytes received by a flow.
+     *
+     * \param name Name of the flow (its CCA)
+     * \param sink Receiving application of the flow
+     */
+    void AddFlow(const std::string& name, Ptr<PacketSink> sink);
+
+    /**
+     * Schedule the measurement windows.
+     *
+     * \param start Start of the first window
+     * \param stop No window ends after this time
+     */
+    void Start(Time start, Time stop);
+
+    /**
+     * Write the summary of the run.
+     *
+     * \param fileName Name of the JSON file
+     */
+    void WriteSummary(const std::string& fileName) const;
+
+  private:
+    /// Metrics of one flow
+    struct Flow
+    {
+        std::string name;          //!< Name of the flow
+        uint64_t windowBytes{0};   //!< Bytes received in the current window
+        uint64_t totalBytes{0};    //!< Bytes received in the closed windows
+        Time firstRx{-1};          //!< Time of the first received byte, -1 if none
+        uint32_t stableWindows{0}; //!< Consecutive windows close to the fair share
+        Time convergence{-1};      //!< Time to converge after the first byte, -1 if never
+    };
+
+    /**
+     * Close the current measurement window and schedule the next one.
+     */
+    void EndWindow();
+
+    /**
+     * A packet entered the device queue.
+     * \param packet The packet
+     */
+    void Enqueue(Ptr<const Packet> packet);
+
+    /**
+     * A packet left the device queue.
+     * \param packet The packet
+     */
+    void Dequeue(Ptr<const Packet> packet);
+
+    /**
+     * A packet was dropped by the device queue.
+     * \param packet The packet
+     */
+    void QueueDrop(Ptr<const Packet> packet);
+
+    /**
+     * A packet was dropped by the queue disc.
+     * \param item The packet
+     */
+    void DiscDrop(Ptr<const QueueDiscItem> item);
+
+    /**
+     * A packet left the queue disc.
+     * \param sojourn Time it spent in the queue disc
+     */
+    void DiscSojourn(Time sojourn);
+
+    /**
+     * A packet was sent on the bottleneck link.
+     * \param packet The packet
+     */
+    void Transmit(Ptr<const Packet> packet);
+
+    /**
+     * A packet was received by a flow.
+     * \param flow Index of the flow
+     * \param packet The packet
+     * \param from The sender
+     */
+    void Receive(uint32_t flow, Ptr<const Packet> packet, const Address& from);
+
+    RunMetricsConfig m_config;                //!< Parameters of the metrics
+    Ptr<PointToPointNetDevice> m_bottleneck;  //!< Device at the entrance of the bottleneck
+    Time m_stop;                              //!< End of the last window
+    std::vector<Flow> m_flows;                //!< Metrics of every flow
+
+    std::deque<Time> m_enqueueTimes; //!< Enqueue times of the packets in the device queue
+    uint64_t m_windowTxBytes{0};     //!< Bytes sent on the bottleneck in the current window
+    uint64_t m_queueDrops{0};        //!< Packets dropped by the device queue
+    uint64_t m_discDrops{0};         //!< Packets dropped by the queue disc
+    bool m_hasQueueDisc{false};      //!< Whether the bottleneck device has a queue disc
+
+    uint64_t m_windows{0};                   //!< Number of closed windows
+    double m_utilizationSum{0};              //!< Sum of the window utilizations
+    double m_jainSum{0};                     //!< Sum of the window Jain's indexes
+    uint64_t m_jainWindows{0};               //!< Windows with at least one active flow
+    double m_jainMin{1};                     //!< Minimum window Jain's index
+    Ewma m_utilization;                      //!< EWMA of the window utilizations
+    Ewma m_jain;                             //!< EWMA of the window Jain's indexes
+    std::array<P2Quantile, 3> m_queueDelay;  //!< p50, p95, p99 of the device queue delay (s)
+    std::array<P2Quantile, 3> m_discSojourn; //!< p50, p95, p99 of the queue disc sojourn (s)
+    double m_queueDelayMax{0};               //!< Maximum device queue delay (s)
+    double m_discSojournMax{0};              //!< Maximum queue disc sojourn (s)
+};
+
+} // namespace ns3
+
+#endif // RUN_METRICS_H
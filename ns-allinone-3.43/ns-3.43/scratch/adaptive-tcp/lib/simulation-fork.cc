@@ -0,0 +1,84 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "simulation-fork.h"
+
+#include "ns3/abort.h"
+#include "ns3/log.h"
+
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("SimulationFork");
+
+namespace
+{
+
+/**
+ * Wait for any child to exit.
+ *
+ * \return Whether the child exited with status 0
+ */
+bool
+WaitForChild()
+{
+    int status;
+    pid_t pid;
+    do
+    {
+        pid = waitpid(-1, &status, 0);
+    } while (pid < 0 && errno == EINTR);
+    NS_ABORT_MSG_IF(pid < 0, "waitpid failed: " << std::strerror(errno));
+
+    bool success = WIFEXITED(status) && WEXITSTATUS(status) == 0;
+    if (!success)
+    {
+        NS_LOG_WARN("Continuation process " << pid << " failed with status " << status);
+    }
+    return success;
+}
+
+} // namespace
+
+ForkedContinuation
+ForkContinuations(uint32_t count, uint32_t jobs)
+{
+    std::cout.flush();
+    std::cerr.flush();
+    std::clog.flush();
+
+    uint32_t running = 0;
+    uint32_t failed = 0;
+    for (uint32_t i = 0; i < count; i++)
+    {
+        if (jobs != 0 && running == jobs)
+        {
+            failed += !WaitForChild();
+            running--;
+        }
+
+        pid_t pid = fork();
+        NS_ABORT_MSG_IF(pid < 0, "fork failed: " << std::strerror(errno));
+        if (pid == 0)
+        {
+            return {true, i, 0};
+        }
+        NS_LOG_INFO("Continuation " << i << " runs in process " << pid);
+        running++;
+    }
+
+    for (; running > 0; running--)
+    {
+        failed += !WaitForChild();
+    }
+    return {false, 0, failed};
+}
+
+} // namespace ns3
@@ -0,0 +1,54 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+// Continuations of a warmed-up simulation in forked processes.
+//
+// A run can stop at some time T, once the flows are past slow start and the
+// queues are filled, and fork() one child process per variant of the rest of
+// the run. Every child inherits the whole state of the simulation at T (the
+// pending events, the sockets and their congestion control, the queues and
+// the state of every random variable stream), changes what its variant
+// changes and runs to the end, so the warm-up is only simulated once.
+//
+// Only the default single-threaded simulator is safe to fork: the children
+// must not share threads, sockets of the host or MPI communicators with the
+// parent.
+
+#ifndef SIMULATION_FORK_H
+#define SIMULATION_FORK_H
+
+#include <cstdint>
+
+namespace ns3
+{
+
+/**
+ * Where the caller of ForkContinuations runs.
+ */
+struct ForkedContinuation
+{
+    bool isChild;    //!< Whether this is a child process
+    uint32_t index;  //!< Continuation run by the child, unused in the parent
+    uint32_t failed; //!< Children that failed, only set in the parent
+};
+
+/**
+ * Fork one child process per continuation of the simulation.
+ *
+ * The children return right away and go on with their continuation. The
+ * parent returns once every child exited, after running at most jobs children
+ * at a time. The standard streams are flushed first so that buffered output
+ * is not written once by every child; buffered files of the caller must be
+ * flushed by the caller.
+ *
+ * \param count Number of continuations
+ * \param jobs Maximum number of children running at the same time, 0 for no limit
+ * \return In a child, the continuation to run; in the parent, the number of
+ *         children that did not exit with status 0
+ */
+ForkedContinuation ForkContinuations(uint32_t count, uint32_t jobs = 0);
+
+} // namespace ns3
+
+#endif // SIMULATION_FORK_H
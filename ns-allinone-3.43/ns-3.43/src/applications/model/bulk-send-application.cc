@@ -88,7 +88,11 @@ BulkSendApplication::GetTypeId()
             .AddTraceSource("TcpRetransmission",
                             "The TCP socket retransmitted a packet",
                             MakeTraceSourceAccessor(&BulkSendApplication::m_retransmissionTrace),
-                            "ns3::TcpSocketBase::RetransmissionCallback");
+                            "ns3::TcpSocketBase::RetransmissionCallback")
+            .AddTraceSource("SocketCreated",
+                            "The socket was created, before it is bound and connected",
+                            MakeTraceSourceAccessor(&BulkSendApplication::m_socketCreatedTrace),
+                            "ns3::BulkSendApplication::SocketCreatedCallback");
 
     return tid;
 }
@@ -153,6 +157,7 @@ BulkSendApplication::StartApplication() // Called at time specified by Start
                            "BulkSend requires SOCK_STREAM or SOCK_SEQPACKET. "
                            "In other words, use TCP instead of UDP.");
         }
+        m_socketCreatedTrace(m_socket);
 
         NS_ABORT_MSG_IF(m_peer.IsInvalid(), "'Remote' attribute not properly set");
 
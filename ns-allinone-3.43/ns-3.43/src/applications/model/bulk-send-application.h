@@ -98,6 +98,13 @@ class BulkSendApplication : public Application
      */
     Ptr<Socket> GetSocket() const;
 
+    /**
+     * TracedCallback signature for the creation of the socket.
+     *
+     * \param [in] socket The new socket, not bound nor connected yet
+     */
+    typedef void (*SocketCreatedCallback)(Ptr<Socket> socket);
+
   protected:
     void DoDispose() override;
 
@@ -128,6 +135,9 @@ class BulkSendApplication : public Application
     /// Traced Callback: sent packets
     TracedCallback<Ptr<const Packet>> m_txTrace;
 
+    /// Traced Callback: the socket was created
+    TracedCallback<Ptr<Socket>> m_socketCreatedTrace;
+
     /// Traced Callback: retransmitted packets
     TracedCallback<Ptr<const Packet>,
                    const TcpHeader&,
@@ -21,6 +21,7 @@
 #include "ns3/packet-sink.h"
 #include "ns3/simple-net-device-helper.h"
 #include "ns3/string.h"
+#include "ns3/tcp-socket-base.h"
 #include "ns3/test.h"
 #include "ns3/traced-callback.h"
 #include "ns3/uinteger.h"
@@ -250,6 +251,104 @@ BulkSendSeqTsSizeTestCase::DoRun()
     NS_TEST_ASSERT_MSG_EQ(m_received, 300000, "Received the full 300000 bytes");
 }
 
+/**
+ * \ingroup applications-test
+ * \ingroup tests
+ *
+ * Checks that the SocketCreated trace source fires once, when the application
+ * starts, early enough to trace the whole connection.
+ */
+class BulkSendSocketCreatedTestCase : public TestCase
+{
+  public:
+    BulkSendSocketCreatedTestCase();
+
+  private:
+    void DoRun() override;
+    /**
+     * Record the new socket and trace its congestion window
+     * \param socket the socket
+     */
+    void SocketCreated(Ptr<Socket> socket);
+    /**
+     * Record a change of the congestion window
+     * \param oldCwnd old value
+     * \param newCwnd new value
+     */
+    void CwndChange(uint32_t oldCwnd, uint32_t newCwnd);
+    Ptr<Socket> m_socket;              //!< socket passed to the trace
+    uint32_t m_created{0};             //!< number of times the trace fired
+    Time m_createdAt;                  //!< time at which the trace fired
+    uint32_t m_cwndChanges{0};         //!< number of congestion window changes
+    bool m_connectedAtCreation{false}; //!< whether the socket had a peer when the trace fired
+};
+
+BulkSendSocketCreatedTestCase::BulkSendSocketCreatedTestCase()
+    : TestCase("Check the SocketCreated trace source")
+{
+}
+
+void
+BulkSendSocketCreatedTestCase::SocketCreated(Ptr<Socket> socket)
+{
+    m_socket = socket;
+    m_created++;
+    m_createdAt = Simulator::Now();
+    Address peer;
+    m_connectedAtCreation = socket->GetPeerName(peer) == 0;
+    socket->TraceConnectWithoutContext(
+        "CongestionWindow",
+        MakeCallback(&BulkSendSocketCreatedTestCase::CwndChange, this));
+}
+
+void
+BulkSendSocketCreatedTestCase::CwndChange(uint32_t oldCwnd, uint32_t newCwnd)
+{
+    m_cwndChanges++;
+}
+
+void
+BulkSendSocketCreatedTestCase::DoRun()
+{
+    NodeContainer nodes;
+    nodes.Create(2);
+    SimpleNetDeviceHelper simpleHelper;
+    simpleHelper.SetDeviceAttribute("DataRate", StringValue("10Mbps"));
+    simpleHelper.SetChannelAttribute("Delay", StringValue("10ms"));
+    NetDeviceContainer devices = simpleHelper.Install(nodes);
+    InternetStackHelper internet;
+    internet.Install(nodes);
+    Ipv4AddressHelper ipv4;
+    ipv4.SetBase("10.1.1.0", "255.255.255.0");
+    Ipv4InterfaceContainer i = ipv4.Assign(devices);
+    uint16_t port = 9;
+    BulkSendHelper sourceHelper("ns3::TcpSocketFactory", InetSocketAddress(i.GetAddress(1), port));
+    sourceHelper.SetAttribute("MaxBytes", UintegerValue(100000));
+    ApplicationContainer sourceApp = sourceHelper.Install(nodes.Get(0));
+    sourceApp.Start(Seconds(0.5));
+    sourceApp.Stop(Seconds(10.0));
+    PacketSinkHelper sinkHelper("ns3::TcpSocketFactory",
+                                InetSocketAddress(Ipv4Address::GetAny(), port));
+    ApplicationContainer sinkApp = sinkHelper.Install(nodes.Get(1));
+    sinkApp.Start(Seconds(0.0));
+    sinkApp.Stop(Seconds(10.0));
+
+    Ptr<BulkSendApplication> source = DynamicCast<BulkSendApplication>(sourceApp.Get(0));
+    source->TraceConnectWithoutContext(
+        "SocketCreated",
+        MakeCallback(&BulkSendSocketCreatedTestCase::SocketCreated, this));
+
+    Simulator::Run();
+
+    NS_TEST_ASSERT_MSG_EQ(m_created, 1, "One socket is created");
+    NS_TEST_ASSERT_MSG_EQ(m_socket, source->GetSocket(), "Not the socket of the application");
+    NS_TEST_ASSERT_MSG_EQ(m_createdAt, Seconds(0.5), "Socket created when the application starts");
+    NS_TEST_ASSERT_MSG_EQ(m_connectedAtCreation, false, "Trace fired after the connection");
+    NS_TEST_ASSERT_MSG_GT(m_cwndChanges, 0, "Congestion window changes missed");
+
+    Simulator::Destroy();
+}
+
 /**
  * \ingroup applications-test
  * \ingroup tests
@@ -267,6 +366,7 @@ BulkSendTestSuite::BulkSendTestSuite()
 {
     AddTestCase(new BulkSendBasicTestCase, TestCase::Duration::QUICK);
     AddTestCase(new BulkSendSeqTsSizeTestCase, TestCase::Duration::QUICK);
+    AddTestCase(new BulkSendSocketCreatedTestCase, TestCase::Duration::QUICK);
 }
 
 static BulkSendTestSuite g_bulkSendTestSuite; //!< Static variable for test initialization
@@ -19,6 +19,7 @@
 
 #include <functional>
 #include <memory>
+#include <type_traits>
 #include <typeinfo>
 #include <utility>
 #include <vector>
@@ -480,9 +481,6 @@ class Callback : public CallbackBase
                                int> = 0>
     Callback(T func, BArgs... bargs)
     {
-        // store the function in a std::function object
-        std::function<R(BArgs..., UArgs...)> f(func);
-
         // The original function is comparable if it is a function pointer or
         // a pointer to a member function or a pointer to a member data.
         constexpr bool isComp =
@@ -493,8 +491,21 @@ class Callback : public CallbackBase
              std::make_shared<CallbackComponent<std::decay_t<BArgs>>>(bargs)...});
 
         m_impl = Create<CallbackImpl<R, UArgs...>>(
-            [f, bargs...](auto&&... uargs) -> R {
-                return f(bargs..., std::forward<decltype(uargs)>(uargs)...);
+            // The function is invoked directly, rather than through a
+            // std::function of its own, to save an indirect call. The bound
+            // arguments are still passed by copy, which keeps the objects
+            // they point to alive if the callback is released by the call.
+            [func, bargs...](auto&&... uargs) -> R {
+                if constexpr (std::is_void_v<R>)
+                {
+                    std::invoke(func, BArgs(bargs)..., std::forward<decltype(uargs)>(uargs)...);
+                }
+                else
+                {
+                    return std::invoke(func,
+                                       BArgs(bargs)...,
+                                       std::forward<decltype(uargs)>(uargs)...);
+                }
             },
             components);
     }
@@ -15,7 +15,11 @@
 #include "pointer.h"
 #include "singleton.h"
 
+#include <algorithm>
+#include <limits>
 #include <sstream>
+#include <unordered_map>
+#include <utility>
 
 /**
  * \file
@@ -190,10 +194,16 @@ MatchContainer::DisconnectWithoutContext(std::string name, const CallbackBase& c
 /**
  * \ingroup config-impl
  * Helper to test if an array entry matches a config path specification.
+ *
+ * The specification is parsed once into sorted ranges of indices, so that
+ * the matching indices can be enumerated as well as tested.
  */
 class ArrayMatcher
 {
   public:
+    /** A range of matching indices, bounds included. */
+    typedef std::pair<uint32_t, uint32_t> Range;
+
     /**
      * Construct from a Config path specification.
      *
@@ -207,8 +217,27 @@ class ArrayMatcher
      * \returns \c true if the index matches the Config Path.
      */
     bool Matches(std::size_t i) const;
+    /**
+     * Get the number of matching indices.
+     *
+     * \returns The number of matching indices, the maximum value of
+     *          \c std::size_t if every index matches.
+     */
+    std::size_t GetMatchN() const;
+    /**
+     * Get the ranges of matching indices, unless every index matches.
+     *
+     * \returns The disjoint ranges of matching indices, in increasing order.
+     */
+    const std::vector<Range>& GetRanges() const;
 
   private:
+    /**
+     * Parse an alternative of the Config path specification.
+     *
+     * \param [in] element The alternative.
+     */
+    void Parse(std::string element);
     /**
      * Convert a string to an \c uint32_t.
      *
@@ -219,77 +248,121 @@ class ArrayMatcher
     bool StringToUint32(std::string str, uint32_t* value) const;
     /** The Config path element. */
     std::string m_element;
+    /** Whether every index matches. */
+    bool m_all;
+    /** The ranges of matching indices. */
+    std::vector<Range> m_ranges;
 
 }; // class ArrayMatcher
 
 ArrayMatcher::ArrayMatcher(std::string element)
-    : m_element(element)
+    : m_element(element),
+      m_all(false)
 {
     NS_LOG_FUNCTION(this << element);
-}
 
-bool
-ArrayMatcher::Matches(std::size_t i) const
-{
-    NS_LOG_FUNCTION(this << i);
-    if (m_element == "*")
+    std::string::size_type start = 0;
+    std::string::size_type bar;
+    while ((bar = element.find('|', start)) != std::string::npos)
     {
-        NS_LOG_DEBUG("Array " << i << " matches *");
-        return true;
+        Parse(element.substr(start, bar - start));
+        start = bar + 1;
     }
-    std::string::size_type tmp;
-    tmp = m_element.find('|');
-    if (tmp != std::string::npos)
+    Parse(element.substr(start));
+
+    // Merge the overlapping and adjacent ranges.
+    std::sort(m_ranges.begin(), m_ranges.end());
+    std::vector<Range> merged;
+    for (const auto& range : m_ranges)
     {
-        std::string left = m_element.substr(0, tmp - 0);
-        std::string right = m_element.substr(tmp + 1, m_element.size() - (tmp + 1));
-        ArrayMatcher matcher = ArrayMatcher(left);
-        if (matcher.Matches(i))
+        if (!merged.empty() && uint64_t(range.first) <= uint64_t(merged.back().second) + 1)
         {
-            NS_LOG_DEBUG("Array " << i << " matches " << left);
-            return true;
+            merged.back().second = std::max(merged.back().second, range.second);
         }
-        matcher = ArrayMatcher(right);
-        if (matcher.Matches(i))
+        else
         {
-            NS_LOG_DEBUG("Array " << i << " matches " << right);
-            return true;
+            merged.push_back(range);
         }
-        NS_LOG_DEBUG("Array " << i << " does not match " << m_element);
-        return false;
     }
-    std::string::size_type leftBracket = m_element.find('[');
-    std::string::size_type rightBracket = m_element.find(']');
-    std::string::size_type dash = m_element.find('-');
-    if (leftBracket == 0 && rightBracket == m_element.size() - 1 && dash > leftBracket &&
+    m_ranges = std::move(merged);
+}
+
+void
+ArrayMatcher::Parse(std::string element)
+{
+    NS_LOG_FUNCTION(this << element);
+    if (element == "*")
+    {
+        m_all = true;
+        return;
+    }
+    std::string::size_type leftBracket = element.find('[');
+    std::string::size_type rightBracket = element.find(']');
+    std::string::size_type dash = element.find('-');
+    if (leftBracket == 0 && rightBracket == element.size() - 1 && dash > leftBracket &&
         dash < rightBracket)
     {
-        std::string lowerBound = m_element.substr(leftBracket + 1, dash - (leftBracket + 1));
-        std::string upperBound = m_element.substr(dash + 1, rightBracket - (dash + 1));
+        std::string lowerBound = element.substr(leftBracket + 1, dash - (leftBracket + 1));
+        std::string upperBound = element.substr(dash + 1, rightBracket - (dash + 1));
         uint32_t min;
         uint32_t max;
-        if (StringToUint32(lowerBound, &min) && StringToUint32(upperBound, &max) && i >= min &&
-            i <= max)
+        if (StringToUint32(lowerBound, &min) && StringToUint32(upperBound, &max) && min <= max)
         {
-            NS_LOG_DEBUG("Array " << i << " matches " << m_element);
-            return true;
-        }
-        else
-        {
-            NS_LOG_DEBUG("Array " << i << " does not " << m_element);
-            return false;
+            m_ranges.emplace_back(min, max);
         }
+        return;
     }
     uint32_t value;
-    if (StringToUint32(m_element, &value) && i == value)
+    if (StringToUint32(element, &value))
     {
-        NS_LOG_DEBUG("Array " << i << " matches " << m_element);
+        m_ranges.emplace_back(value, value);
+    }
+}
+
+bool
+ArrayMatcher::Matches(std::size_t i) const
+{
+    NS_LOG_FUNCTION(this << i);
+    if (m_all)
+    {
+        NS_LOG_DEBUG("Array " << i << " matches *");
         return true;
     }
+    for (const auto& range : m_ranges)
+    {
+        if (i >= range.first && i <= range.second)
+        {
+            NS_LOG_DEBUG("Array " << i << " matches " << m_element);
+            return true;
+        }
+    }
     NS_LOG_DEBUG("Array " << i << " does not match " << m_element);
     return false;
 }
 
+std::size_t
+ArrayMatcher::GetMatchN() const
+{
+    NS_LOG_FUNCTION(this);
+    if (m_all)
+    {
+        return std::numeric_limits<std::size_t>::max();
+    }
+    std::size_t n = 0;
+    for (const auto& range : m_ranges)
+    {
+        n += std::size_t(range.second - range.first) + 1;
+    }
+    return n;
+}
+
+const std::vector<ArrayMatcher::Range>&
+ArrayMatcher::GetRanges() const
+{
+    NS_LOG_FUNCTION(this);
+    return m_ranges;
+}
+
 bool
 ArrayMatcher::StringToUint32(std::string str, uint32_t* value) const
 {
@@ -300,6 +373,107 @@ ArrayMatcher::StringToUint32(std::string str, uint32_t* value) const
     return !iss.bad() && !iss.fail();
 }
 
+/**
+ * \ingroup config-impl
+ * A Config path parsed into its elements, to be resolved many times.
+ */
+class CompiledPath
+{
+  public:
+    /** An element of a Config path, between two slashes. */
+    struct Element
+    {
+        /**
+         * Construct from the element.
+         *
+         * \param [in] item The element.
+         */
+        Element(std::string item);
+
+        std::string item;     //!< The element
+        ArrayMatcher matcher; //!< The element as an array index specification
+        TypeId tid;           //!< The TypeId of a "$TypeId" element
+        bool hasTid;          //!< Whether the TypeId of a "$TypeId" element is known
+    };
+
+    /**
+     * Construct from a Config path.
+     *
+     * \param [in] path The Config path.
+     */
+    CompiledPath(std::string path);
+
+    /**
+     * Get the number of elements of the path.
+     *
+     * \returns The number of elements.
+     */
+    std::size_t GetN() const;
+    /**
+     * Get an element of the path.
+     *
+     * \param [in] i The index of the element.
+     * \returns The element.
+     */
+    const Element& Get(std::size_t i) const;
+
+  private:
+    /** The elements of the path. */
+    std::vector<Element> m_elements;
+
+}; // class CompiledPath
+
+CompiledPath::Element::Element(std::string item)
+    : item(item),
+      matcher(item),
+      hasTid(false)
+{
+    if (item.find('$') == 0)
+    {
+        // Unknown TypeIds are looked up again when the element is reached.
+        hasTid = TypeId::LookupByNameFailSafe(item.substr(1, item.size() - 1), &tid);
+    }
+}
+
+CompiledPath::CompiledPath(std::string path)
+{
+    NS_LOG_FUNCTION(this << path);
+
+    // ensure that we start and end with a '/'
+    std::string::size_type tmp = path.find('/');
+    if (tmp != 0)
+    {
+        // no slash at start
+        path = "/" + path;
+    }
+    tmp = path.find_last_of('/');
+    if (tmp != (path.size() - 1))
+    {
+        // no slash at end
+        path = path + "/";
+    }
+
+    std::string::size_type start = 0;
+    std::string::size_type next;
+    while ((next = path.find('/', start + 1)) != std::string::npos)
+    {
+        m_elements.emplace_back(path.substr(start + 1, next - (start + 1)));
+        start = next;
+    }
+}
+
+std::size_t
+CompiledPath::GetN() const
+{
+    return m_elements.size();
+}
+
+const CompiledPath::Element&
+CompiledPath::Get(std::size_t i) const
+{
+    return m_elements[i];
+}
+
 /**
  * \ingroup config-impl
  * Abstract class to parse Config paths into object references.
@@ -308,11 +482,11 @@ class Resolver
 {
   public:
     /**
-     * Construct from a base Config path.
+     * Construct from a compiled Config path.
      *
      * \param [in] path The Config path.
      */
-    Resolver(std::string path);
+    Resolver(const CompiledPath& path);
     /** Destructor. */
     virtual ~Resolver();
 
@@ -326,23 +500,26 @@ class Resolver
     void Resolve(Ptr<Object> root);
 
   private:
-    /** Ensure the Config path starts and ends with a '/'. */
-    void Canonicalize();
     /**
      * Parse the next element in the Config path.
      *
-     * \param [in] path The remaining portion of the Config path.
+     * \param [in] i The index of the next element of the Config path.
      * \param [in] root The object corresponding to the current position
      *                  in the Config path.
      */
-    void DoResolve(std::string path, Ptr<Object> root);
+    void DoResolve(std::size_t i, Ptr<Object> root);
     /**
      * Parse an index on the Config path.
      *
-     * \param [in] path The remaining Config path.
-     * \param [in,out] vector The resulting list of matching objects.
+     * \param [in] i The index of the next element of the Config path.
+     * \param [in] root The object holding the container.
+     * \param [in] name The name of the container attribute.
+     * \param [in] accessor The accessor of the container attribute.
      */
-    void DoArrayResolve(std::string path, const ObjectPtrContainerValue& vector);
+    void DoArrayResolve(std::size_t i,
+                        Ptr<Object> root,
+                        std::string name,
+                        const ObjectPtrContainerAccessor& accessor);
     /**
      * Handle one object found on the path.
      *
@@ -366,15 +543,14 @@ class Resolver
     /** Current list of path tokens. */
     std::vector<std::string> m_workStack;
     /** The Config path. */
-    std::string m_path;
+    const CompiledPath& m_path;
 
 }; // class Resolver
 
-Resolver::Resolver(std::string path)
+Resolver::Resolver(const CompiledPath& path)
     : m_path(path)
 {
-    NS_LOG_FUNCTION(this << path);
-    Canonicalize();
+    NS_LOG_FUNCTION(this << &path);
 }
 
 Resolver::~Resolver()
@@ -382,32 +558,12 @@ Resolver::~Resolver()
     NS_LOG_FUNCTION(this);
 }
 
-void
-Resolver::Canonicalize()
-{
-    NS_LOG_FUNCTION(this);
-
-    // ensure that we start and end with a '/'
-    std::string::size_type tmp = m_path.find('/');
-    if (tmp != 0)
-    {
-        // no slash at start
-        m_path = "/" + m_path;
-    }
-    tmp = m_path.find_last_of('/');
-    if (tmp != (m_path.size() - 1))
-    {
-        // no slash at end
-        m_path = m_path + "/";
-    }
-}
-
 void
 Resolver::Resolve(Ptr<Object> root)
 {
     NS_LOG_FUNCTION(this << root);
 
-    DoResolve(m_path, root);
+    DoResolve(0, root);
 }
 
 std::string
@@ -433,13 +589,11 @@ Resolver::DoResolveOne(Ptr<Object> object)
 }
 
 void
-Resolver::DoResolve(std::string path, Ptr<Object> root)
+Resolver::DoResolve(std::size_t i, Ptr<Object> root)
 {
-    NS_LOG_FUNCTION(this << path << root);
-    NS_ASSERT((path.find('/')) == 0);
-    std::string::size_type next = path.find('/', 1);
+    NS_LOG_FUNCTION(this << i << root);
 
-    if (next == std::string::npos)
+    if (i == m_path.GetN())
     {
         //
         // If root is zero, we're beginning to see if we can use the object name
@@ -455,8 +609,8 @@ Resolver::DoResolve(std::string path, Ptr<Object> root)
         }
         return;
     }
-    std::string item = path.substr(1, next - 1);
-    std::string pathLeft = path.substr(next, path.size() - next);
+    const CompiledPath::Element& element = m_path.Get(i);
+    const std::string& item = element.item;
 
     //
     // If root is zero, we're beginning to see if we can use the object name
@@ -467,11 +621,10 @@ Resolver::DoResolve(std::string path, Ptr<Object> root)
     //
     if (!root)
     {
-        std::string::size_type offset = path.find("/Names");
-        if (offset == 0)
+        if (item.find("Names") == 0)
         {
             m_workStack.push_back(item);
-            DoResolve(pathLeft, root);
+            DoResolve(i + 1, root);
             m_workStack.pop_back();
             return;
         }
@@ -488,7 +641,7 @@ Resolver::DoResolve(std::string path, Ptr<Object> root)
     {
         NS_LOG_DEBUG("Name system resolved item = " << item << " to " << namedObject);
         m_workStack.push_back(item);
-        DoResolve(pathLeft, namedObject);
+        DoResolve(i + 1, namedObject);
         m_workStack.pop_back();
         return;
     }
@@ -510,7 +663,7 @@ Resolver::DoResolve(std::string path, Ptr<Object> root)
         // This is a call to GetObject
         std::string tidString = item.substr(1, item.size() - 1);
         NS_LOG_DEBUG("GetObject=" << tidString << " on path=" << GetResolvedPath());
-        TypeId tid = TypeId::LookupByName(tidString);
+        TypeId tid = element.hasTid ? element.tid : TypeId::LookupByName(tidString);
         Ptr<Object> object = root->GetObject<Object>(tid);
         if (!object)
         {
@@ -518,7 +671,7 @@ Resolver::DoResolve(std::string path, Ptr<Object> root)
             return;
         }
         m_workStack.push_back(item);
-        DoResolve(pathLeft, object);
+        DoResolve(i + 1, object);
         m_workStack.pop_back();
     }
     else
@@ -532,10 +685,10 @@ Resolver::DoResolve(std::string path, Ptr<Object> root)
         {
             tid = nextTid;
 
-            for (uint32_t i = 0; i < tid.GetAttributeN(); i++)
+            for (uint32_t j = 0; j < tid.GetAttributeN(); j++)
             {
                 TypeId::AttributeInformation info;
-                info = tid.GetAttribute(i);
+                info = tid.GetAttribute(j);
                 if (info.name != item && item != "*")
                 {
                     continue;
@@ -560,21 +713,21 @@ Resolver::DoResolve(std::string path, Ptr<Object> root)
                     }
                     foundMatch = true;
                     m_workStack.push_back(info.name);
-                    DoResolve(pathLeft, object);
+                    DoResolve(i + 1, object);
                     m_workStack.pop_back();
                 }
                 // attempt to cast to an object vector.
                 const auto vectorChecker =
                     dynamic_cast<const ObjectPtrContainerChecker*>(PeekPointer(info.checker));
-                if (vectorChecker != nullptr)
+                const auto vectorAccessor =
+                    dynamic_cast<const ObjectPtrContainerAccessor*>(PeekPointer(info.accessor));
+                if (vectorChecker != nullptr && vectorAccessor != nullptr)
                 {
-                    NS_LOG_DEBUG("GetAttribute(vector)=" << info.name << " on path="
-                                                         << GetResolvedPath() << pathLeft);
+                    NS_LOG_DEBUG("GetAttribute(vector)=" << info.name
+                                                         << " on path=" << GetResolvedPath());
                     foundMatch = true;
-                    ObjectPtrContainerValue vector;
-                    root->GetAttribute(info.name, vector);
                     m_workStack.push_back(info.name);
-                    DoArrayResolve(pathLeft, vector);
+                    DoArrayResolve(i + 1, root, info.name, *vectorAccessor);
                     m_workStack.pop_back();
                 }
                 // this could be anything else and we don't know what to do with it.
@@ -594,29 +747,64 @@ Resolver::DoResolve(std::string path, Ptr<Object> root)
 }
 
 void
-Resolver::DoArrayResolve(std::string path, const ObjectPtrContainerValue& container)
+Resolver::DoArrayResolve(std::size_t i,
+                         Ptr<Object> root,
+                         std::string name,
+                         const ObjectPtrContainerAccessor& accessor)
 {
-    NS_LOG_FUNCTION(this << path << &container);
-    NS_ASSERT(!path.empty());
-    NS_ASSERT((path.find('/')) == 0);
-    std::string::size_type next = path.find('/', 1);
-    if (next == std::string::npos)
+    NS_LOG_FUNCTION(this << i << root << name << &accessor);
+    if (i == m_path.GetN())
+    {
+        return;
+    }
+    const ArrayMatcher& matcher = m_path.Get(i).matcher;
+
+    //
+    // A few indices of a large container, such as "/NodeList/7", are looked up
+    // by their position, without getting the whole container.  The container
+    // is got only for the indices which are not at their position.
+    //
+    std::size_t n = 0;
+    accessor.GetN(PeekPointer(root), &n);
+    ObjectPtrContainerValue container;
+    bool hasContainer = false;
+    if (matcher.GetMatchN() <= n)
     {
+        for (const auto& range : matcher.GetRanges())
+        {
+            for (std::size_t index = range.first; index <= range.second; index++)
+            {
+                Ptr<Object> object;
+                if (!accessor.GetAt(PeekPointer(root), index, &object))
+                {
+                    if (!hasContainer)
+                    {
+                        root->GetAttribute(name, container);
+                        hasContainer = true;
+                    }
+                    object = container.Get(index);
+                    if (!object)
+                    {
+                        continue;
+                    }
+                }
+                NS_LOG_DEBUG("Array " << index << " matches " << m_path.Get(i).item);
+                m_workStack.push_back(std::to_string(index));
+                DoResolve(i + 1, object);
+                m_workStack.pop_back();
+            }
+        }
         return;
     }
-    std::string item = path.substr(1, next - 1);
-    std::string pathLeft = path.substr(next, path.size() - next);
 
-    ArrayMatcher matcher = ArrayMatcher(item);
+    root->GetAttribute(name, container);
     ObjectPtrContainerValue::Iterator it;
     for (it = container.Begin(); it != container.End(); ++it)
     {
         if (matcher.Matches((*it).first))
         {
-            std::ostringstream oss;
-            oss << (*it).first;
-            m_workStack.push_back(oss.str());
-            DoResolve(pathLeft, (*it).second);
+            m_workStack.push_back(std::to_string((*it).first));
+            DoResolve(i + 1, (*it).second);
             m_workStack.pop_back();
         }
     }
@@ -666,12 +854,24 @@ class ConfigImpl : public Singleton<ConfigImpl>
      */
     void ParsePath(std::string path, std::string* root, std::string* leaf) const;
 
+    /**
+     * Get a Config path compiled, from the paths already compiled.
+     * \param [in] path The Config path.
+     * \returns The compiled Config path.
+     */
+    const CompiledPath& Compile(const std::string& path);
+
     /** Container type to hold the root Config path tokens. */
     typedef std::vector<Ptr<Object>> Roots;
 
     /** The list of Config path roots. */
     Roots m_roots;
 
+    /** Maximum number of compiled Config paths kept. */
+    static constexpr std::size_t COMPILED_PATHS_MAX = 1024;
+    /** The Config paths already compiled. */
+    std::unordered_map<std::string, CompiledPath> m_compiledPaths;
+
 }; // class ConfigImpl
 
 void
@@ -770,6 +970,23 @@ ConfigImpl::Disconnect(std::string path, const CallbackBase& cb)
     container.Disconnect(leaf, cb);
 }
 
+const CompiledPath&
+ConfigImpl::Compile(const std::string& path)
+{
+    NS_LOG_FUNCTION(this << path);
+
+    auto it = m_compiledPaths.find(path);
+    if (it != m_compiledPaths.end())
+    {
+        return it->second;
+    }
+    if (m_compiledPaths.size() >= COMPILED_PATHS_MAX)
+    {
+        m_compiledPaths.clear();
+    }
+    return m_compiledPaths.emplace(path, CompiledPath(path)).first->second;
+}
+
 MatchContainer
 ConfigImpl::LookupMatches(std::string path)
 {
@@ -778,7 +995,7 @@ ConfigImpl::LookupMatches(std::string path)
     class LookupMatchesResolver : public Resolver
     {
       public:
-        LookupMatchesResolver(std::string path)
+        LookupMatchesResolver(const CompiledPath& path)
             : Resolver(path)
         {
         }
@@ -791,7 +1008,7 @@ ConfigImpl::LookupMatches(std::string path)
 
         std::vector<Ptr<Object>> m_objects;
         std::vector<std::string> m_contexts;
-    } resolver = LookupMatchesResolver(path);
+    } resolver = LookupMatchesResolver(Compile(path));
 
     for (auto i = m_roots.begin(); i != m_roots.end(); i++)
     {
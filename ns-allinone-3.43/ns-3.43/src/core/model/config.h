@@ -8,6 +8,7 @@
 #ifndef CONFIG_H
 #define CONFIG_H
 
+#include "object.h"
 #include "ptr.h"
 
 #include <string>
@@ -23,7 +24,6 @@ namespace ns3
 {
 
 class AttributeValue;
-class Object;
 class CallbackBase;
 
 /**
@@ -350,6 +350,22 @@ class MatchContainer
  */
 MatchContainer LookupMatches(std::string path);
 
+/**
+ * \ingroup config
+ * Get at once all the objects which match a path, as a given type.
+ *
+ * The path is resolved once, so this is cheaper than looking up each
+ * object with its own path.
+ *
+ * \tparam T \explicit The type of the objects.
+ * \param [in] path The path to perform a match against
+ * \returns The objects of type T of the objects which match the input path,
+ *          as found by Object::GetObject<T>(), in the order of the matches.
+ *          The matching objects without a T are left out.
+ */
+template <typename T>
+std::vector<Ptr<T>> Resolve(std::string path);
+
 /**
  * \ingroup config
  * \param [in] obj A new root object
@@ -383,4 +399,36 @@ Ptr<Object> GetRootNamespaceObject(uint32_t i);
 
 } // namespace ns3
 
+/********************************************************************
+ *  Implementation of the templates declared above.
+ ********************************************************************/
+
+namespace ns3
+{
+
+namespace Config
+{
+
+template <typename T>
+std::vector<Ptr<T>>
+Resolve(std::string path)
+{
+    MatchContainer matches = LookupMatches(path);
+    std::vector<Ptr<T>> objects;
+    objects.reserve(matches.GetN());
+    for (const auto& match : matches)
+    {
+        Ptr<T> object = match->GetObject<T>();
+        if (object)
+        {
+            objects.push_back(object);
+        }
+    }
+    return objects;
+}
+
+} // namespace Config
+
+} // namespace ns3
+
 #endif /* CONFIG_H */
@@ -8,12 +8,18 @@
 
 #include "default-simulator-impl.h"
 
+#include "abort.h"
 #include "assert.h"
+#include "event-profiler.h"
 #include "log.h"
 #include "scheduler.h"
 #include "simulator.h"
+#include "string.h"
+#include "uinteger.h"
 
 #include <cmath>
+#include <fstream>
+#include <limits>
 
 /**
  * \file
@@ -34,10 +40,22 @@ NS_OBJECT_ENSURE_REGISTERED(DefaultSimulatorImpl);
 TypeId
 DefaultSimulatorImpl::GetTypeId()
 {
-    static TypeId tid = TypeId("ns3::DefaultSimulatorImpl")
-                            .SetParent<SimulatorImpl>()
-                            .SetGroupName("Core")
-                            .AddConstructor<DefaultSimulatorImpl>();
+    static TypeId tid =
+        TypeId("ns3::DefaultSimulatorImpl")
+            .SetParent<SimulatorImpl>()
+            .SetGroupName("Core")
+            .AddConstructor<DefaultSimulatorImpl>()
+            .AddAttribute("ProfileFile",
+                          "The file of the event profile written at Simulator::Destroy, "
+                          "as folded stacks. Empty to run the events without profiling.",
+                          StringValue(""),
+                          MakeStringAccessor(&DefaultSimulatorImpl::m_profileFile),
+                          MakeStringChecker())
+            .AddAttribute("ProfileSamplingPeriod",
+                          "Profile one event out of this number.",
+                          UintegerValue(1),
+                          MakeUintegerAccessor(&DefaultSimulatorImpl::m_profileSamplingPeriod),
+                          MakeUintegerChecker<uint32_t>(1));
     return tid;
 }
 
@@ -51,7 +69,15 @@ DefaultSimulatorImpl::DefaultSimulatorImpl()
     m_currentContext = Simulator::NO_CONTEXT;
     m_unscheduledEvents = 0;
     m_eventCount = 0;
-    m_eventsWithContextEmpty = true;
+    m_profileSamplingPeriod = 1;
+    m_ring = std::make_unique<RingSlot[]>(RING_SIZE);
+    for (uint64_t i = 0; i < RING_SIZE; ++i)
+    {
+        m_ring[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    m_ringTail.store(0, std::memory_order_relaxed);
+    m_ringHead = 0;
+    m_eventsWithContextOverflow.store(false, std::memory_order_relaxed);
     m_mainThreadId = std::this_thread::get_id();
 }
 
@@ -89,6 +115,14 @@ DefaultSimulatorImpl::Destroy()
             ev->Invoke();
         }
     }
+
+    if (m_profiler)
+    {
+        std::ofstream os(m_profileFile);
+        NS_ABORT_MSG_UNLESS(os.is_open(), "Can't open the event profile file " << m_profileFile);
+        m_profiler->WriteFolded(os);
+        m_profiler.reset();
+    }
 }
 
 void
@@ -130,7 +164,14 @@ DefaultSimulatorImpl::ProcessOneEvent()
     m_currentTs = next.key.m_ts;
     m_currentContext = next.key.m_context;
     m_currentUid = next.key.m_uid;
-    next.impl->Invoke();
+    if (m_profiler)
+    {
+        m_profiler->Invoke(next.impl, next.key.m_context);
+    }
+    else
+    {
+        next.impl->Invoke();
+    }
     next.impl->Unref();
 
     ProcessEventsWithContext();
@@ -145,7 +186,9 @@ DefaultSimulatorImpl::IsFinished() const
 void
 DefaultSimulatorImpl::ProcessEventsWithContext()
 {
-    if (m_eventsWithContextEmpty)
+    ProcessRing(std::numeric_limits<uint64_t>::max());
+
+    if (!m_eventsWithContextOverflow.load(std::memory_order_acquire))
     {
         return;
     }
@@ -154,24 +197,54 @@ DefaultSimulatorImpl::ProcessEventsWithContext()
     EventsWithContext eventsWithContext;
     {
         std::unique_lock lock{m_eventsWithContextMutex};
+        // The events a thread wrote in the ring before its first event of
+        // the list go first.
+        ProcessRing(m_ringTail.load(std::memory_order_acquire));
         m_eventsWithContext.swap(eventsWithContext);
-        m_eventsWithContextEmpty = true;
+        m_eventsWithContextOverflow.store(false, std::memory_order_relaxed);
     }
-    while (!eventsWithContext.empty())
+    for (const auto& event : eventsWithContext)
     {
-        EventWithContext event = eventsWithContext.front();
-        eventsWithContext.pop_front();
-        Scheduler::Event ev;
-        ev.impl = event.event;
-        ev.key.m_ts = m_currentTs + event.timestamp;
-        ev.key.m_context = event.context;
-        ev.key.m_uid = m_uid;
-        m_uid++;
-        m_unscheduledEvents++;
-        m_events->Insert(ev);
+        InsertEventWithContext(event);
+    }
+}
+
+void
+DefaultSimulatorImpl::ProcessRing(uint64_t end)
+{
+    while (m_ringHead != end)
+    {
+        RingSlot& slot = m_ring[m_ringHead & (RING_SIZE - 1)];
+        if (slot.sequence.load(std::memory_order_acquire) != m_ringHead + 1)
+        {
+            if (end == std::numeric_limits<uint64_t>::max())
+            {
+                break;
+            }
+            // Claimed by a thread which did not write the event yet
+            std::this_thread::yield();
+            continue;
+        }
+        EventWithContext event = slot.event;
+        slot.sequence.store(m_ringHead + RING_SIZE, std::memory_order_release);
+        m_ringHead++;
+        InsertEventWithContext(event);
     }
 }
 
+void
+DefaultSimulatorImpl::InsertEventWithContext(const EventWithContext& event)
+{
+    Scheduler::Event ev;
+    ev.impl = event.event;
+    ev.key.m_ts = m_currentTs + event.timestamp;
+    ev.key.m_context = event.context;
+    ev.key.m_uid = m_uid;
+    m_uid++;
+    m_unscheduledEvents++;
+    m_events->Insert(ev);
+}
+
 void
 DefaultSimulatorImpl::Run()
 {
@@ -181,6 +254,11 @@ DefaultSimulatorImpl::Run()
     ProcessEventsWithContext();
     m_stop = false;
 
+    if (!m_profileFile.empty() && !m_profiler)
+    {
+        m_profiler = std::make_unique<EventProfiler>(m_profileSamplingPeriod);
+    }
+
     while (!m_events->IsEmpty() && !m_stop)
     {
         ProcessOneEvent();
@@ -253,11 +331,40 @@ DefaultSimulatorImpl::ScheduleWithContext(uint32_t context, const Time& delay, E
         // Current time added in ProcessEventsWithContext()
         ev.timestamp = delay.GetTimeStep();
         ev.event = event;
+
+        if (!m_eventsWithContextOverflow.load(std::memory_order_acquire))
         {
-            std::unique_lock lock{m_eventsWithContextMutex};
-            m_eventsWithContext.push_back(ev);
-            m_eventsWithContextEmpty = false;
+            uint64_t position = m_ringTail.load(std::memory_order_relaxed);
+            while (true)
+            {
+                RingSlot& slot = m_ring[position & (RING_SIZE - 1)];
+                uint64_t sequence = slot.sequence.load(std::memory_order_acquire);
+                if (sequence == position)
+                {
+                    if (m_ringTail.compare_exchange_weak(position,
+                                                         position + 1,
+                                                         std::memory_order_relaxed))
+                    {
+                        slot.event = ev;
+                        slot.sequence.store(position + 1, std::memory_order_release);
+                        return;
+                    }
+                }
+                else if (sequence < position)
+                {
+                    // The ring is full
+                    break;
+                }
+                else
+                {
+                    position = m_ringTail.load(std::memory_order_relaxed);
+                }
+            }
         }
+
+        std::unique_lock lock{m_eventsWithContextMutex};
+        m_eventsWithContext.push_back(ev);
+        m_eventsWithContextOverflow.store(true, std::memory_order_relaxed);
     }
 }
 
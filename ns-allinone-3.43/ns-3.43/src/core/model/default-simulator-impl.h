@@ -11,8 +11,11 @@
 
 #include "simulator-impl.h"
 
+#include <atomic>
 #include <list>
+#include <memory>
 #include <mutex>
+#include <string>
 #include <thread>
 
 /**
@@ -26,11 +29,15 @@ namespace ns3
 
 // Forward
 class Scheduler;
+class EventProfiler;
 
 /**
  * \ingroup simulator
  *
  * The default single process simulator implementation.
+ *
+ * When the ProfileFile attribute is set, the events are run through an
+ * EventProfiler, and its report is written at Simulator::Destroy().
  */
 class DefaultSimulatorImpl : public SimulatorImpl
 {
@@ -86,15 +93,56 @@ class DefaultSimulatorImpl : public SimulatorImpl
         EventImpl* event;
     };
 
+    /**
+     * Move the events of the ring to the main event queue.
+     *
+     * \param [in] end The ring position to stop at, waiting for the slots
+     *             claimed but not written yet by the other threads, or the
+     *             largest position to stop at the first slot not written.
+     */
+    void ProcessRing(uint64_t end);
+    /**
+     * Insert an event from a different context in the main event queue.
+     *
+     * \param [in] event The event.
+     */
+    void InsertEventWithContext(const EventWithContext& event);
+
+    /** A slot of the ring of events from a different context. */
+    struct RingSlot
+    {
+        /**
+         * The ring position the slot can be written at, or this position
+         * plus one once written.
+         */
+        std::atomic<uint64_t> sequence;
+        /** The event. */
+        EventWithContext event;
+    };
+
+    /** Number of slots of the ring, a power of two. */
+    static constexpr uint64_t RING_SIZE = 1024;
+
+    /**
+     * The ring of events from a different context, written by the other
+     * threads without locks and read by the main thread.
+     */
+    std::unique_ptr<RingSlot[]> m_ring;
+    /** Next ring position written by the other threads. */
+    alignas(64) std::atomic<uint64_t> m_ringTail;
+    /** Next ring position read by the main thread. */
+    alignas(64) uint64_t m_ringHead;
+
     /** Container type for the events from a different context. */
     typedef std::list<EventWithContext> EventsWithContext;
-    /** The container of events from a different context. */
+    /** The events from a different context which did not fit in the ring. */
     EventsWithContext m_eventsWithContext;
     /**
-     * Flag \c true if all events with context have been moved to the
-     * primary event queue.
+     * Flag \c true while m_eventsWithContext holds events. The other
+     * threads then add their events to it instead of the ring, so that
+     * the events of every thread stay in order.
      */
-    bool m_eventsWithContextEmpty;
+    std::atomic<bool> m_eventsWithContextOverflow;
     /** Mutex to control access to the list of events with context. */
     std::mutex m_eventsWithContextMutex;
 
@@ -125,6 +173,13 @@ class DefaultSimulatorImpl : public SimulatorImpl
 
     /** Main execution thread. */
     std::thread::id m_mainThreadId;
+
+    /** The file of the event profile, or empty to disable profiling. */
+    std::string m_profileFile;
+    /** Profile one event out of this number. */
+    uint32_t m_profileSamplingPeriod;
+    /** The event profiler, while profiling. */
+    std::unique_ptr<EventProfiler> m_profiler;
 };
 
 } // namespace ns3
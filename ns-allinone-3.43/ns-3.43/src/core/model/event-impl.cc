@@ -10,6 +10,9 @@
 
 #include "log.h"
 
+#include <cstdint>
+#include <cstring>
+
 /**
  * \file
  * \ingroup events
@@ -56,4 +59,52 @@ EventImpl::IsCancelled()
     return m_cancel;
 }
 
+const void*
+EventImpl::GetHandler() const
+{
+    return nullptr;
+}
+
+const void*
+EventImpl::GetMemberFunctionAddress(const void* function, std::size_t size, const void* object)
+{
+#if defined(__GNUC__) && !defined(_WIN32)
+    // A pointer to member function holds a function pointer, or the
+    // offset of the method in the virtual table, and the adjustment of
+    // the object pointer.
+    struct
+    {
+        uintptr_t ptr;
+        ptrdiff_t adj;
+    } rep;
+
+    if (size != sizeof(rep))
+    {
+        return nullptr;
+    }
+    std::memcpy(&rep, function, sizeof(rep));
+#if defined(__arm__) || defined(__aarch64__)
+    // The ARM variant flags the virtual methods in the adjustment.
+    bool isVirtual = rep.adj & 1;
+    uintptr_t offset = rep.ptr;
+    ptrdiff_t adj = rep.adj >> 1;
+#else
+    bool isVirtual = rep.ptr & 1;
+    uintptr_t offset = rep.ptr - 1;
+    ptrdiff_t adj = rep.adj;
+#endif
+    if (!isVirtual)
+    {
+        return reinterpret_cast<const void*>(rep.ptr);
+    }
+    const char* vtable;
+    std::memcpy(&vtable, static_cast<const char*>(object) + adj, sizeof(vtable));
+    const void* address;
+    std::memcpy(&address, vtable + offset, sizeof(address));
+    return address;
+#else
+    return nullptr;
+#endif
+}
+
 } // namespace ns3
@@ -8,8 +8,10 @@
 #ifndef EVENT_IMPL_H
 #define EVENT_IMPL_H
 
+#include "event-pool.h"
 #include "simple-ref-count.h"
 
+#include <new>
 #include <stdint.h>
 
 /**
@@ -38,6 +40,49 @@ class EventImpl : public SimpleRefCount<EventImpl>
     EventImpl();
     /** Destructor. */
     virtual ~EventImpl() = 0;
+    /**
+     * Allocate an event from the EventPool.
+     * \param [in] size Size of the event
+     * \returns The memory of the event
+     */
+    static void* operator new(std::size_t size)
+    {
+        return EventPool::Allocate(size);
+    }
+
+    /**
+     * Give the memory of an event back to the EventPool. The destructor
+     * being virtual, size is the size of the most derived class.
+     * \param [in] p The memory of the event
+     * \param [in] size Size of the event
+     */
+    static void operator delete(void* p, std::size_t size)
+    {
+        EventPool::Free(p, size);
+    }
+
+    /**
+     * Allocate an over-aligned event, outside of the EventPool.
+     * \param [in] size Size of the event
+     * \param [in] alignment Alignment of the event
+     * \returns The memory of the event
+     */
+    static void* operator new(std::size_t size, std::align_val_t alignment)
+    {
+        return ::operator new(size, alignment);
+    }
+
+    /**
+     * Release an over-aligned event.
+     * \param [in] p The memory of the event
+     * \param [in] size Size of the event
+     * \param [in] alignment Alignment of the event
+     */
+    static void operator delete(void* p, std::size_t size, std::align_val_t alignment)
+    {
+        ::operator delete(p, size, alignment);
+    }
+
     /**
      * Called by the simulation engine to notify the event that it is time
      * to execute.
@@ -55,8 +100,34 @@ class EventImpl : public SimpleRefCount<EventImpl>
      * Checked by the simulation engine before calling Invoke().
      */
     bool IsCancelled();
+    /**
+     * Get the address of the function run by the event, used by the
+     * EventProfiler to name the event.
+     *
+     * \returns The address of the function or method bound to the event,
+     *          or nullptr when it is unknown.
+     */
+    virtual const void* GetHandler() const;
 
   protected:
+    /**
+     * Get the address of the function called through a pointer to member
+     * function, resolving the virtual methods with the virtual table of
+     * the object.
+     *
+     * Pointers to member functions are decoded as defined by the Itanium
+     * C++ ABI, the one of the platforms with Demangle().
+     *
+     * \param [in] function The pointer to member function.
+     * \param [in] size The size of the pointer to member function.
+     * \param [in] object The object the method is called on, as the class
+     *             of the method.
+     * \returns The address of the function, or nullptr when it is unknown.
+     */
+    static const void* GetMemberFunctionAddress(const void* function,
+                                                std::size_t size,
+                                                const void* object);
+
     /**
      * Implementation for Invoke().
      *
@@ -0,0 +1,350 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "event-pool.h"
+
+#include "abort.h"
+
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <new>
+#include <unordered_set>
+
+/**
+ * \file
+ * \ingroup events
+ * ns3::EventPool implementation.
+ */
+
+namespace ns3
+{
+
+namespace
+{
+
+/** Size classes are multiples of this size. */
+constexpr std::size_t GRANULE = 16;
+/** Number of size classes. */
+constexpr std::size_t CLASS_COUNT = 16;
+/** Largest pooled event. */
+constexpr std::size_t MAX_POOLED_SIZE = GRANULE * CLASS_COUNT;
+/** Size of the slabs the blocks are cut from. */
+constexpr std::size_t SLAB_SIZE = 64 * 1024;
+/** Blocks moved at once between a thread and the depot. */
+constexpr uint32_t BATCH = 64;
+
+/** Whether new events come from the pool. */
+std::atomic<bool> g_enabled{
+#if defined(__SANITIZE_ADDRESS__)
+    false
+#else
+    true
+#endif
+};
+
+/** A free block, linked to the next one. */
+struct FreeBlock
+{
+    FreeBlock* next; //!< Next free block
+};
+
+/** A list of free blocks of one size class. */
+struct FreeList
+{
+    FreeBlock* head{nullptr}; //!< First block
+    uint32_t count{0};        //!< Number of blocks
+
+    /**
+     * Add a block.
+     * \param [in] block The block
+     */
+    void Push(FreeBlock* block)
+    {
+        block->next = head;
+        head = block;
+        count++;
+    }
+
+    /**
+     * Remove a block.
+     * \returns The block, nullptr if the list is empty
+     */
+    FreeBlock* Pop()
+    {
+        FreeBlock* block = head;
+        if (block)
+        {
+            head = block->next;
+            count--;
+        }
+        return block;
+    }
+
+    /**
+     * Move blocks to another list.
+     * \param [in] other The other list
+     * \param [in] count Maximum number of blocks to move
+     */
+    void MoveTo(FreeList& other, uint32_t count)
+    {
+        for (uint32_t i = 0; i < count && head; i++)
+        {
+            other.Push(Pop());
+        }
+    }
+};
+
+/** Counters written by one thread and read by any thread. */
+struct Counters
+{
+    std::atomic<uint64_t> allocations{0};       //!< Events allocated
+    std::atomic<uint64_t> frees{0};             //!< Events released
+    std::atomic<uint64_t> systemAllocations{0}; //!< Calls to the global operator new
+};
+
+/**
+ * Increment a counter only written by the current thread, without a locked
+ * instruction.
+ * \param [in,out] counter The counter
+ */
+inline void
+Increment(std::atomic<uint64_t>& counter)
+{
+    counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+}
+
+/** The blocks and counters shared by all the threads. */
+struct Depot
+{
+    std::mutex mutex;                         //!< Protects the whole depot
+    std::array<FreeList, CLASS_COUNT> lists;  //!< Free blocks per size class
+    std::unordered_set<const Counters*> live; //!< Counters of the running threads
+    EventPool::Stats retired{0, 0, 0};        //!< Counters of the exited threads
+};
+
+/**
+ * \returns The depot. It is never destroyed, as events may still be released
+ *          by destructors of static objects.
+ */
+Depot&
+GetDepot()
+{
+    static Depot* depot = new Depot;
+    return *depot;
+}
+
+/** Set once the cache of the current thread is destroyed. */
+thread_local bool t_cacheDestroyed = false;
+
+/** The free blocks and counters of one thread. */
+struct ThreadCache
+{
+    std::array<FreeList, CLASS_COUNT> lists; //!< Free blocks per size class
+    Counters counters;                       //!< Counters of the thread
+
+    ThreadCache()
+    {
+        Depot& depot = GetDepot();
+        std::lock_guard lock(depot.mutex);
+        depot.live.insert(&counters);
+    }
+
+    ~ThreadCache()
+    {
+        Depot& depot = GetDepot();
+        std::lock_guard lock(depot.mutex);
+        for (std::size_t i = 0; i < CLASS_COUNT; i++)
+        {
+            lists[i].MoveTo(depot.lists[i], lists[i].count);
+        }
+        depot.retired.allocations += counters.allocations;
+        depot.retired.frees += counters.frees;
+        depot.retired.systemAllocations += counters.systemAllocations;
+        depot.live.erase(&counters);
+        t_cacheDestroyed = true;
+    }
+
+    /**
+     * Fill an empty free list from the depot, or from a new slab.
+     * \param [in] sizeClass The size class of the list
+     */
+    void Refill(std::size_t sizeClass)
+    {
+        Depot& depot = GetDepot();
+        std::lock_guard lock(depot.mutex);
+        if (depot.lists[sizeClass].count > 0)
+        {
+            depot.lists[sizeClass].MoveTo(lists[sizeClass], BATCH);
+            return;
+        }
+
+        // Keep a batch of the new slab and leave the rest in the depot, so
+        // the next Drain() does not give away the blocks released last.
+        auto slab = static_cast<char*>(::operator new(SLAB_SIZE));
+        Increment(counters.systemAllocations);
+        std::size_t blockSize = (sizeClass + 1) * GRANULE;
+        for (std::size_t offset = 0; offset + blockSize <= SLAB_SIZE; offset += blockSize)
+        {
+            depot.lists[sizeClass].Push(reinterpret_cast<FreeBlock*>(slab + offset));
+        }
+        depot.lists[sizeClass].MoveTo(lists[sizeClass], BATCH);
+    }
+
+    /**
+     * Give a batch of blocks back to the depot.
+     * \param [in] sizeClass The size class of the blocks
+     */
+    void Drain(std::size_t sizeClass)
+    {
+        Depot& depot = GetDepot();
+        std::lock_guard lock(depot.mutex);
+        lists[sizeClass].MoveTo(depot.lists[sizeClass], BATCH);
+    }
+};
+
+/** The cache of the current thread. */
+thread_local ThreadCache t_cache;
+
+/**
+ * \param [in] size Size of an event
+ * \returns The size class of the event
+ */
+inline std::size_t
+SizeClass(std::size_t size)
+{
+    return (size - 1) / GRANULE;
+}
+
+/**
+ * Allocate or release an event while the current thread exits, once its
+ * cache is gone, directly in the depot.
+ * \param [in] p The event to release, nullptr to allocate one
+ * \param [in] size Size of the event
+ * \returns The allocated event
+ */
+void*
+UseDepot(void* p, std::size_t size)
+{
+    Depot& depot = GetDepot();
+    std::lock_guard lock(depot.mutex);
+    FreeList& list = depot.lists[SizeClass(size)];
+    if (p)
+    {
+        depot.retired.frees++;
+        list.Push(static_cast<FreeBlock*>(p));
+        return nullptr;
+    }
+    depot.retired.allocations++;
+    if (FreeBlock* block = list.Pop())
+    {
+        return block;
+    }
+    depot.retired.systemAllocations++;
+    return ::operator new(GRANULE * (SizeClass(size) + 1));
+}
+
+} // namespace
+
+void*
+EventPool::Allocate(std::size_t size)
+{
+    bool pooled = size <= MAX_POOLED_SIZE && g_enabled.load(std::memory_order_relaxed);
+    if (t_cacheDestroyed)
+    {
+        if (pooled)
+        {
+            return UseDepot(nullptr, size);
+        }
+        std::lock_guard lock(GetDepot().mutex);
+        GetDepot().retired.allocations++;
+        GetDepot().retired.systemAllocations++;
+        return ::operator new(size);
+    }
+
+    ThreadCache& cache = t_cache;
+    Increment(cache.counters.allocations);
+    if (!pooled)
+    {
+        Increment(cache.counters.systemAllocations);
+        return ::operator new(size);
+    }
+
+    std::size_t sizeClass = SizeClass(size);
+    FreeList& list = cache.lists[sizeClass];
+    if (list.count == 0)
+    {
+        cache.Refill(sizeClass);
+    }
+    return list.Pop();
+}
+
+void
+EventPool::Free(void* p, std::size_t size)
+{
+    bool pooled = size <= MAX_POOLED_SIZE && g_enabled.load(std::memory_order_relaxed);
+    if (t_cacheDestroyed)
+    {
+        if (pooled)
+        {
+            UseDepot(p, size);
+            return;
+        }
+        {
+            std::lock_guard lock(GetDepot().mutex);
+            GetDepot().retired.frees++;
+        }
+        ::operator delete(p);
+        return;
+    }
+
+    ThreadCache& cache = t_cache;
+    Increment(cache.counters.frees);
+    if (!pooled)
+    {
+        ::operator delete(p);
+        return;
+    }
+
+    std::size_t sizeClass = SizeClass(size);
+    FreeList& list = cache.lists[sizeClass];
+    list.Push(static_cast<FreeBlock*>(p));
+    if (list.count > 2 * BATCH)
+    {
+        cache.Drain(sizeClass);
+    }
+}
+
+void
+EventPool::SetEnabled(bool enabled)
+{
+    Stats stats = GetStats();
+    NS_ABORT_MSG_IF(stats.allocations != stats.frees,
+                    "Cannot switch the event pool while " << stats.allocations - stats.frees
+                                                          << " events are alive");
+    g_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+bool
+EventPool::IsEnabled()
+{
+    return g_enabled.load(std::memory_order_relaxed);
+}
+
+EventPool::Stats
+EventPool::GetStats()
+{
+    Depot& depot = GetDepot();
+    std::lock_guard lock(depot.mutex);
+    Stats stats = depot.retired;
+    for (const Counters* counters : depot.live)
+    {
+        stats.allocations += counters->allocations.load(std::memory_order_relaxed);
+        stats.frees += counters->frees.load(std::memory_order_relaxed);
+        stats.systemAllocations += counters->systemAllocations.load(std::memory_order_relaxed);
+    }
+    return stats;
+}
+
+} // namespace ns3
@@ -0,0 +1,91 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef EVENT_POOL_H
+#define EVENT_POOL_H
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * \file
+ * \ingroup events
+ * ns3::EventPool declaration.
+ */
+
+namespace ns3
+{
+
+/**
+ * \ingroup events
+ * \brief Pooled allocator of the EventImpl objects.
+ *
+ * Simulations create and release one EventImpl per scheduled event, most
+ * of them a few tens of bytes large and short lived, so the general purpose
+ * allocator ends up near the top of the profiles. The EventPool rounds the
+ * events up to size classes of 16 bytes, up to 256 bytes, and recycles them
+ * through per-thread free lists: allocating or releasing an event is then a
+ * push or a pop on a list of the current thread.
+ *
+ * The free lists get their blocks from 64 KiB slabs. A thread whose free list
+ * runs out takes a batch of blocks from a shared depot, protected by a mutex,
+ * and gives a batch back when it holds too many, so events created by a
+ * thread (e.g. with Simulator::ScheduleWithContext) and released by another
+ * one flow back to where they are needed. A thread gives all its blocks to
+ * the depot when it exits. Slabs are never returned to the system.
+ *
+ * Larger events, and every event when the pool is disabled, go to the
+ * global operator new. The pool is disabled by default in builds with
+ * AddressSanitizer, so that it can find use after free bugs on events.
+ */
+class EventPool
+{
+  public:
+    /** Allocation counters, summed over all the threads. */
+    struct Stats
+    {
+        uint64_t allocations;       //!< Events allocated
+        uint64_t frees;             //!< Events released
+        uint64_t systemAllocations; //!< Calls to the global operator new
+    };
+
+    /**
+     * Allocate the memory of an event.
+     * \param [in] size Size of the event
+     * \returns The memory of the event
+     */
+    static void* Allocate(std::size_t size);
+
+    /**
+     * Release the memory of an event.
+     * \param [in] p The memory of the event
+     * \param [in] size Size of the event, as given to Allocate()
+     */
+    static void Free(void* p, std::size_t size);
+
+    /**
+     * Enable or disable the pool. As events are released wherever they were
+     * allocated from, this aborts if any event is still alive, so it has to
+     * be called before the first event is scheduled or after
+     * Simulator::Destroy().
+     *
+     * \param [in] enabled Whether new events come from the pool
+     */
+    static void SetEnabled(bool enabled);
+
+    /**
+     * \returns Whether new events come from the pool
+     */
+    static bool IsEnabled();
+
+    /**
+     * \returns The allocation counters, exact once the other threads
+     *          stopped allocating events
+     */
+    static Stats GetStats();
+};
+
+} // namespace ns3
+
+#endif /* EVENT_POOL_H */
@@ -0,0 +1,108 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "event-profiler.h"
+
+#include "assert.h"
+#include "demangle.h"
+#include "log.h"
+#include "simulator.h"
+
+#include <algorithm>
+#include <functional>
+#include <map>
+#include <utility>
+
+#if __has_include(<dlfcn.h>)
+#include <dlfcn.h>
+#endif
+
+/**
+ * \file
+ * \ingroup simulator
+ * ns3::EventProfiler implementation.
+ */
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("EventProfiler");
+
+EventProfiler::EventProfiler(uint32_t samplingPeriod)
+    : m_samplingPeriod(samplingPeriod),
+      m_countdown(samplingPeriod)
+{
+    NS_LOG_FUNCTION(this << samplingPeriod);
+    NS_ASSERT_MSG(samplingPeriod > 0, "The sampling period must be positive");
+}
+
+std::size_t
+EventProfiler::KeyHash::operator()(const Key& key) const
+{
+    std::size_t hash = std::hash<const void*>()(key.type);
+    hash = hash * 31 + std::hash<const void*>()(key.handler);
+    return hash * 31 + key.context;
+}
+
+std::string
+EventProfiler::GetHandlerName(const Key& key)
+{
+#if __has_include(<dlfcn.h>)
+    Dl_info info;
+    if (key.handler && dladdr(key.handler, &info) != 0 && info.dli_sname &&
+        info.dli_saddr == key.handler)
+    {
+        return Demangle(info.dli_sname);
+    }
+#endif
+    return Demangle(key.type->name());
+}
+
+std::vector<EventProfiler::Record>
+EventProfiler::GetRecords() const
+{
+    NS_LOG_FUNCTION(this);
+    // Handlers without symbols may share the name of their event type.
+    std::map<std::pair<uint32_t, std::string>, Stats> merged;
+    for (const auto& [key, stats] : m_stats)
+    {
+        Stats& total = merged[{key.context, GetHandlerName(key)}];
+        total.count += stats.count;
+        total.ticks += stats.ticks;
+    }
+
+    std::vector<Record> records;
+    records.reserve(merged.size());
+    for (const auto& [key, stats] : merged)
+    {
+        records.push_back({key.first, key.second, stats.count, stats.ticks});
+    }
+    std::stable_sort(records.begin(), records.end(), [](const Record& a, const Record& b) {
+        return a.ticks > b.ticks;
+    });
+    return records;
+}
+
+void
+EventProfiler::WriteFolded(std::ostream& os) const
+{
+    NS_LOG_FUNCTION(this);
+    for (const auto& record : GetRecords())
+    {
+        // The frames are separated by semicolons.
+        std::string handler = record.handler;
+        std::replace(handler.begin(), handler.end(), ';', ',');
+        if (record.context == Simulator::NO_CONTEXT)
+        {
+            os << "no context";
+        }
+        else
+        {
+            os << "node " << record.context;
+        }
+        os << ";" << handler << " " << record.ticks << "\n";
+    }
+}
+
+} // namespace ns3
@@ -0,0 +1,192 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef NS3_EVENT_PROFILER_H
+#define NS3_EVENT_PROFILER_H
+
+#include "event-impl.h"
+
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <typeinfo>
+#include <unordered_map>
+#include <vector>
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#include <x86intrin.h>
+#endif
+
+/**
+ * \file
+ * \ingroup simulator
+ * ns3::EventProfiler declaration.
+ */
+
+namespace ns3
+{
+
+/**
+ * \ingroup simulator
+ *
+ * \brief Wall clock profiler of the events run by the simulator.
+ *
+ * The profiler measures the time taken by the events, by handler and by
+ * context. The handler of an event is the function or the method bound
+ * to it by MakeEvent(), named from the symbols of the program, or else
+ * the demangled type of the EventImpl. The time is read from the time
+ * stamp counter of the processor where there is one, and from the
+ * steady clock otherwise; only the relative times are meaningful.
+ *
+ * One event out of the sampling period is measured, to bound the
+ * overhead in simulations with many short events.
+ *
+ * The DefaultSimulatorImpl runs its events through a profiler when the
+ * \c ProfileFile attribute is set, and writes the report in this file at
+ * Simulator::Destroy(), as folded stacks: one line per context and
+ * handler, with the context and the handler as frames, and the time as
+ * the count. The file is the input of the flame graph tools:
+ * \verbatim
+   $ ./ns3 run "tcp-bulk-send --ns3::DefaultSimulatorImpl::ProfileFile=profile.folded"
+   $ flamegraph.pl profile.folded > profile.svg \endverbatim
+ */
+class EventProfiler
+{
+  public:
+    /** Measurements of the events of a handler in a context. */
+    struct Record
+    {
+        uint32_t context;    //!< The context of the events
+        std::string handler; //!< The name of the handler
+        uint64_t count;      //!< The number of events measured
+        uint64_t ticks;      //!< The time taken by the events measured
+    };
+
+    /**
+     * Constructor.
+     *
+     * \param [in] samplingPeriod Measure one event out of this number.
+     */
+    EventProfiler(uint32_t samplingPeriod);
+
+    /**
+     * Invoke an event, measuring it if it is sampled.
+     *
+     * \param [in] event The event.
+     * \param [in] context The context of the event.
+     */
+    void Invoke(EventImpl* event, uint32_t context);
+
+    /**
+     * Get the measurements, by context and handler.
+     *
+     * \returns The records, the most time consuming first.
+     */
+    std::vector<Record> GetRecords() const;
+
+    /**
+     * Write the measurements as folded stacks.
+     *
+     * \param [in,out] os The output stream.
+     */
+    void WriteFolded(std::ostream& os) const;
+
+    /**
+     * Read the clock of the measurements.
+     *
+     * \returns The time stamp counter, or the steady clock in nanoseconds.
+     */
+    static uint64_t ReadTicks();
+
+  private:
+    /** The events measured together. */
+    struct Key
+    {
+        const std::type_info* type; //!< The EventImpl type
+        const void* handler;        //!< The handler address, or nullptr
+        uint32_t context;           //!< The context
+
+        /**
+         * Equality operator.
+         *
+         * \param [in] other The other key.
+         * \returns \c true if the keys are equal.
+         */
+        bool operator==(const Key& other) const = default;
+    };
+
+    /** Hash of a Key. */
+    struct KeyHash
+    {
+        /**
+         * Hash a key.
+         *
+         * \param [in] key The key.
+         * \returns The hash.
+         */
+        std::size_t operator()(const Key& key) const;
+    };
+
+    /** The measurements of a key. */
+    struct Stats
+    {
+        uint64_t count{0}; //!< The number of events measured
+        uint64_t ticks{0}; //!< The time taken by the events measured
+    };
+
+    /**
+     * Name a handler.
+     *
+     * \param [in] key The events of the handler.
+     * \returns The demangled symbol of the handler, or of the event type.
+     */
+    static std::string GetHandlerName(const Key& key);
+
+    /** The measurements. */
+    std::unordered_map<Key, Stats, KeyHash> m_stats;
+    /** Measure one event out of this number. */
+    uint32_t m_samplingPeriod;
+    /** Events left before the next measured event. */
+    uint32_t m_countdown;
+};
+
+inline uint64_t
+EventProfiler::ReadTicks()
+{
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+    return __rdtsc();
+#elif defined(__aarch64__) && defined(__GNUC__)
+    uint64_t ticks;
+    asm volatile("mrs %0, cntvct_el0" : "=r"(ticks));
+    return ticks;
+#else
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+#endif
+}
+
+inline void
+EventProfiler::Invoke(EventImpl* event, uint32_t context)
+{
+    // The handler of a cancelled event may not exist any longer.
+    if (event->IsCancelled() || --m_countdown != 0)
+    {
+        event->Invoke();
+        return;
+    }
+    m_countdown = m_samplingPeriod;
+    Key key{&typeid(*event), event->GetHandler(), context};
+    uint64_t start = ReadTicks();
+    event->Invoke();
+    uint64_t ticks = ReadTicks() - start;
+    Stats& stats = m_stats[key];
+    stats.count++;
+    stats.ticks += ticks;
+}
+
+} // namespace ns3
+
+#endif /* NS3_EVENT_PROFILER_H */
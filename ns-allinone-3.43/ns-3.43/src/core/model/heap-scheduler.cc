@@ -141,10 +141,10 @@ HeapScheduler::IsEmpty() const
 }
 
 void
-HeapScheduler::BottomUp()
+HeapScheduler::BottomUp(std::size_t start)
 {
-    NS_LOG_FUNCTION(this);
-    std::size_t index = Last();
+    NS_LOG_FUNCTION(this << start);
+    std::size_t index = start;
     while (!IsRoot(index) && IsLessStrictly(index, Parent(index)))
     {
         Exch(index, Parent(index));
@@ -192,7 +192,7 @@ HeapScheduler::Insert(const Event& ev)
 {
     NS_LOG_FUNCTION(this << &ev);
     m_heap.push_back(ev);
-    BottomUp();
+    BottomUp(Last());
 }
 
 Scheduler::Event
@@ -225,7 +225,12 @@ HeapScheduler::Remove(const Event& ev)
             NS_ASSERT(m_heap[i].impl == ev.impl);
             Exch(i, Last());
             m_heap.pop_back();
-            TopDown(i);
+            if (i <= Last())
+            {
+                // The former last item may belong above or below i
+                TopDown(i);
+                BottomUp(i);
+            }
             return;
         }
     }
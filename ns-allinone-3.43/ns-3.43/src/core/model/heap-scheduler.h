@@ -160,8 +160,12 @@ class HeapScheduler : public Scheduler
      * \param [in] b The second item.
      */
     inline void Exch(std::size_t a, std::size_t b);
-    /** Percolate a newly inserted Last item to its proper position. */
-    void BottomUp();
+    /**
+     * Percolate an item up the heap to its proper position.
+     *
+     * \param [in] start Starting entry.
+     */
+    void BottomUp(std::size_t start);
     /**
      * Percolate a deletion bubble down the heap.
      *
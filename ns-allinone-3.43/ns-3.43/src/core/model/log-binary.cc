@@ -0,0 +1,655 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "log-binary.h"
+
+#include "environment-variable.h"
+#include "log.h"
+#include "nstime.h"
+#include "simulator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <csignal>
+#include <cstdlib>
+#include <deque>
+#include <fstream>
+#include <iomanip>
+#include <mutex>
+
+/**
+ * \file
+ * \ingroup logging
+ * Binary ring buffer backend of the logging macros, implementation.
+ */
+
+namespace ns3
+{
+
+/**
+ * \ingroup logging
+ * Unnamed namespace for log-binary.cc
+ */
+namespace
+{
+
+/** The signature of a binary log file. */
+constexpr char LOG_BINARY_MAGIC[8] = {'n', 's', '3', 'b', 'l', 'o', 'g', '1'};
+
+/** The record has no simulation time, the simulator was not running. */
+constexpr uint8_t LOG_BINARY_NO_TIME = 0x01;
+/** Arguments of the record were dropped. */
+constexpr uint8_t LOG_BINARY_TRUNCATED = 0x02;
+
+/** A record of the ring. */
+struct alignas(64) LogSlot
+{
+    std::atomic<uint64_t> sequence{0};        //!< The index of the record plus 1, or 0.
+    uint32_t site;                            //!< The statement.
+    uint32_t context;                         //!< The simulation context.
+    int64_t time;                             //!< The simulation time, in time steps.
+    uint16_t size;                            //!< The size of the arguments.
+    uint8_t flags;                            //!< The LOG_BINARY_ flags.
+    uint8_t payload[LogRecord::PAYLOAD_SIZE]; //!< The arguments.
+};
+
+static_assert(sizeof(LogSlot) == LogRecord::SLOT_SIZE, "Unexpected size of the records");
+
+/** The ring of the records. */
+struct LogRing
+{
+    /**
+     * Constructor.
+     * \param [in] filename The file of the records.
+     * \param [in] size The number of records, a power of 2.
+     */
+    LogRing(const std::string& filename, uint64_t size)
+        : slots(size),
+          mask(size - 1),
+          filename(filename)
+    {
+    }
+
+    std::vector<LogSlot> slots;    //!< The records.
+    uint64_t mask;                 //!< The number of records minus 1.
+    std::atomic<uint64_t> head{0}; //!< The index of the next record.
+    std::string filename;          //!< The file of the records.
+};
+
+/** The description of a statement. */
+struct LogSiteInfo
+{
+    std::string component;           //!< The log component.
+    std::string function;            //!< The function.
+    int32_t level;                   //!< The log level.
+    bool isFunction;                 //!< Whether this is a NS_LOG_FUNCTION().
+    bool formatted;                  //!< Whether the pieces are recorded.
+    std::vector<std::string> pieces; //!< The texts around the arguments.
+};
+
+/** The ring of the enabled binary log, or nullptr. */
+std::atomic<LogRing*> g_logRing{nullptr};
+
+/**
+ * Get the lock of the statements.
+ * \returns The mutex.
+ */
+std::mutex&
+GetSitesMutex()
+{
+    static std::mutex mutex;
+    return mutex;
+}
+
+/**
+ * Get the statements, by id.
+ *
+ * The statements are never destroyed, so that the binary log can be
+ * written during the static destructions.
+ *
+ * \returns The statements.
+ */
+std::deque<LogSiteInfo>&
+GetSites()
+{
+    static auto sites = new std::deque<LogSiteInfo>;
+    return *sites;
+}
+
+/**
+ * Write a value to a binary stream.
+ * \param [in,out] os The stream.
+ * \param [in] value The value.
+ */
+template <typename T>
+void
+WriteRaw(std::ostream& os, const T& value)
+{
+    os.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+/**
+ * Write a string to a binary stream, after its length.
+ * \param [in,out] os The stream.
+ * \param [in] text The string.
+ */
+void
+WriteText(std::ostream& os, const std::string& text)
+{
+    WriteRaw(os, static_cast<uint32_t>(text.size()));
+    os.write(text.data(), text.size());
+}
+
+/**
+ * Read a value from a binary stream.
+ * \param [in,out] is The stream.
+ * \param [out] value The value.
+ * \returns \c true if the value was read.
+ */
+template <typename T>
+bool
+ReadRaw(std::istream& is, T& value)
+{
+    return static_cast<bool>(is.read(reinterpret_cast<char*>(&value), sizeof(value)));
+}
+
+/**
+ * Read a string from a binary stream.
+ * \param [in,out] is The stream.
+ * \param [out] text The string.
+ * \returns \c true if the string was read.
+ */
+bool
+ReadText(std::istream& is, std::string& text)
+{
+    uint32_t size;
+    if (!ReadRaw(is, size) || size > (1U << 24))
+    {
+        return false;
+    }
+    text.resize(size);
+    return static_cast<bool>(is.read(text.data(), size));
+}
+
+/**
+ * Write the ring to its file.
+ *
+ * \param [in] ring The ring.
+ * \param [in] crashing Whether the program is crashing, in which case the
+ *                      statements are read even if their lock is taken.
+ */
+void
+WriteRing(LogRing* ring, bool crashing)
+{
+    std::ofstream os(ring->filename, std::ios::binary | std::ios::trunc);
+    if (!os.is_open())
+    {
+        return;
+    }
+    os.write(LOG_BINARY_MAGIC, sizeof(LOG_BINARY_MAGIC));
+    WriteRaw(os, TimeStep(1).GetSeconds());
+
+    std::unique_lock lock(GetSitesMutex(), std::defer_lock);
+    if (crashing)
+    {
+        lock.try_lock();
+    }
+    else
+    {
+        lock.lock();
+    }
+    const auto& sites = GetSites();
+    WriteRaw(os, static_cast<uint32_t>(sites.size()));
+    for (const auto& site : sites)
+    {
+        WriteRaw(os, site.level);
+        WriteRaw(os, static_cast<uint8_t>(site.isFunction));
+        WriteText(os, site.component);
+        WriteText(os, site.function);
+        WriteRaw(os, static_cast<uint32_t>(site.formatted ? site.pieces.size() : 0));
+        if (site.formatted)
+        {
+            for (const auto& piece : site.pieces)
+            {
+                WriteText(os, piece);
+            }
+        }
+    }
+
+    // The records from the oldest one; a record being written is skipped.
+    uint64_t head = ring->head.load(std::memory_order_acquire);
+    uint64_t first = head > ring->slots.size() ? head - ring->slots.size() : 0;
+    for (uint64_t index = first; index < head; ++index)
+    {
+        const LogSlot& slot = ring->slots[index & ring->mask];
+        if (slot.sequence.load(std::memory_order_acquire) != index + 1)
+        {
+            continue;
+        }
+        LogSlot copy;
+        copy.site = slot.site;
+        copy.context = slot.context;
+        copy.time = slot.time;
+        copy.flags = slot.flags;
+        copy.size = std::min<std::size_t>(slot.size, LogRecord::PAYLOAD_SIZE);
+        std::memcpy(copy.payload, slot.payload, copy.size);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.sequence.load(std::memory_order_relaxed) != index + 1)
+        {
+            continue;
+        }
+        WriteRaw(os, copy.site);
+        WriteRaw(os, copy.context);
+        WriteRaw(os, copy.time);
+        WriteRaw(os, copy.flags);
+        WriteRaw(os, copy.size);
+        os.write(reinterpret_cast<const char*>(copy.payload), copy.size);
+    }
+}
+
+/**
+ * Format an argument of a record.
+ *
+ * \param [in,out] position The argument, moved past it.
+ * \param [in] end The end of the arguments.
+ * \param [in,out] os The output stream.
+ * \returns \c false if the argument is malformed.
+ */
+bool
+DecodeArgument(const uint8_t*& position, const uint8_t* end, std::ostream& os)
+{
+    uint8_t tag = *position++;
+    std::size_t size = 8;
+    if (tag == LogRecord::BOOL || tag == LogRecord::CHAR)
+    {
+        size = 1;
+    }
+    else if (tag == LogRecord::STRING)
+    {
+        size = 2;
+    }
+    if (end - position < static_cast<std::ptrdiff_t>(size))
+    {
+        return false;
+    }
+
+    uint64_t raw = 0;
+    std::memcpy(&raw, position, size);
+    position += size;
+    switch (tag)
+    {
+    case LogRecord::BOOL:
+        os << (raw != 0);
+        break;
+    case LogRecord::CHAR:
+        os << static_cast<char>(raw);
+        break;
+    case LogRecord::SIGNED:
+        os << static_cast<int64_t>(raw);
+        break;
+    case LogRecord::UNSIGNED:
+        os << raw;
+        break;
+    case LogRecord::DOUBLE: {
+        double value;
+        std::memcpy(&value, &raw, sizeof(value));
+        os << value;
+        break;
+    }
+    case LogRecord::POINTER:
+        os << reinterpret_cast<const void*>(static_cast<uintptr_t>(raw));
+        break;
+    case LogRecord::STRING: {
+        std::size_t length = raw & ~LogRecord::STRING_CUT;
+        if (end - position < static_cast<std::ptrdiff_t>(length))
+        {
+            return false;
+        }
+        os << std::string_view(reinterpret_cast<const char*>(position), length);
+        position += length;
+        if (raw & LogRecord::STRING_CUT)
+        {
+            os << "...";
+        }
+        break;
+    }
+    default:
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Write the binary log on a crash, then resume the crash.
+ * \param [in] sig The signal.
+ */
+void
+CrashHandler(int sig)
+{
+    static std::atomic<bool> crashed{false};
+    LogRing* ring = g_logRing.load(std::memory_order_acquire);
+    if (ring != nullptr && !crashed.exchange(true))
+    {
+        WriteRing(ring, true);
+    }
+    std::signal(sig, SIG_DFL);
+    std::raise(sig);
+}
+
+/** Write the binary log at the exit of the program. */
+void
+ExitHandler()
+{
+    LogBinaryFlush();
+}
+
+/**
+ * Install the handlers which write the binary log at exit and on a crash.
+ */
+void
+InstallHandlers()
+{
+    static bool installed = false;
+    if (installed)
+    {
+        return;
+    }
+    installed = true;
+    std::atexit(ExitHandler);
+    for (int sig : {SIGSEGV, SIGABRT, SIGFPE, SIGILL})
+    {
+        std::signal(sig, CrashHandler);
+    }
+#ifdef SIGBUS
+    std::signal(SIGBUS, CrashHandler);
+#endif
+}
+
+/**
+ * Handler of the \c NS_LOG_BINARY environment variable.
+ *
+ * A static instance of this class is instantiated below, so the binary
+ * log is enabled when the core library is loaded.
+ */
+class LogBinaryEnvironment
+{
+  public:
+    /** Constructor, enables the binary log. */
+    LogBinaryEnvironment()
+    {
+        auto [found, value] = EnvironmentVariable::Get("NS_LOG_BINARY");
+        if (found && !value.empty())
+        {
+            LogBinaryEnable(value);
+        }
+    }
+};
+
+/** Invoke handler for the \c NS_LOG_BINARY environment variable. */
+LogBinaryEnvironment g_logBinaryEnvironment;
+
+} // Unnamed namespace
+
+void
+LogBinaryEnable(const std::string& filename, uint32_t slots)
+{
+    uint64_t size = 2;
+    while (size < slots)
+    {
+        size *= 2;
+    }
+    LogRing* old = g_logRing.exchange(new LogRing(filename, size));
+    if (old != nullptr)
+    {
+        WriteRing(old, false);
+        delete old;
+    }
+    InstallHandlers();
+}
+
+void
+LogBinaryDisable()
+{
+    LogRing* ring = g_logRing.exchange(nullptr);
+    if (ring != nullptr)
+    {
+        WriteRing(ring, false);
+        delete ring;
+    }
+}
+
+void
+LogBinaryFlush()
+{
+    LogRing* ring = g_logRing.load(std::memory_order_acquire);
+    if (ring != nullptr)
+    {
+        WriteRing(ring, false);
+    }
+}
+
+bool
+LogBinaryIsEnabled()
+{
+    return g_logRing.load(std::memory_order_relaxed) != nullptr;
+}
+
+LogSite::LogSite(const LogComponent& component,
+                 int32_t level,
+                 const char* function,
+                 bool isFunction)
+    : m_isFunction(isFunction),
+      m_formatted(false)
+{
+    std::lock_guard lock(GetSitesMutex());
+    auto& sites = GetSites();
+    m_id = sites.size();
+    sites.push_back({component.Name(), function, level, isFunction, false, {}});
+}
+
+void
+LogSite::SetFormat(const std::vector<std::string>& pieces)
+{
+    std::lock_guard lock(GetSitesMutex());
+    auto& site = GetSites()[m_id];
+    if (!site.formatted)
+    {
+        site.pieces = pieces;
+        site.formatted = true;
+    }
+    m_formatted.store(true, std::memory_order_release);
+}
+
+LogRecord::LogRecord(LogSite& site)
+    : m_site(site),
+      m_slot(nullptr),
+      m_index(0),
+      m_position(nullptr),
+      m_end(nullptr),
+      m_truncated(false),
+      m_first(true)
+{
+    if (!site.IsFormatted())
+    {
+        m_text = std::make_unique<std::vector<std::string>>(1);
+    }
+    LogRing* ring = g_logRing.load(std::memory_order_acquire);
+    if (ring == nullptr)
+    {
+        return;
+    }
+    m_index = ring->head.fetch_add(1, std::memory_order_relaxed);
+    LogSlot* slot = &ring->slots[m_index & ring->mask];
+    slot->sequence.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot->site = site.GetId();
+    // The simulator sets the time printer once its implementation exists;
+    // asking it for the time before would create it from within the log.
+    if (LogGetTimePrinter() != nullptr)
+    {
+        slot->time = Simulator::Now().GetTimeStep();
+        slot->context = Simulator::GetContext();
+        slot->flags = 0;
+    }
+    else
+    {
+        slot->time = 0;
+        slot->context = Simulator::NO_CONTEXT;
+        slot->flags = LOG_BINARY_NO_TIME;
+    }
+    m_slot = reinterpret_cast<uint8_t*>(slot);
+    m_position = slot->payload;
+    m_end = slot->payload + PAYLOAD_SIZE;
+}
+
+LogRecord::~LogRecord()
+{
+    if (m_text)
+    {
+        m_site.SetFormat(*m_text);
+    }
+    if (m_slot != nullptr)
+    {
+        auto slot = reinterpret_cast<LogSlot*>(m_slot);
+        slot->size = static_cast<uint16_t>(m_position - slot->payload);
+        if (m_truncated)
+        {
+            slot->flags |= LOG_BINARY_TRUNCATED;
+        }
+        slot->sequence.store(m_index + 1, std::memory_order_release);
+    }
+}
+
+LogRecord&
+LogRecord::operator<<(std::ostream& (*manipulator)(std::ostream&))
+{
+    if (manipulator == static_cast<std::ostream& (*)(std::ostream&)>(std::endl))
+    {
+        AddText("\n");
+    }
+    return *this;
+}
+
+bool
+LogBinaryDecode(std::istream& is, std::ostream& os)
+{
+    char magic[sizeof(LOG_BINARY_MAGIC)];
+    double secondsPerStep;
+    uint32_t nSites;
+    if (!is.read(magic, sizeof(magic)) ||
+        std::memcmp(magic, LOG_BINARY_MAGIC, sizeof(magic)) != 0 ||
+        !ReadRaw(is, secondsPerStep) || !ReadRaw(is, nSites))
+    {
+        return false;
+    }
+
+    std::vector<LogSiteInfo> sites(nSites);
+    for (auto& site : sites)
+    {
+        uint8_t isFunction;
+        uint32_t nPieces;
+        if (!ReadRaw(is, site.level) || !ReadRaw(is, isFunction) ||
+            !ReadText(is, site.component) || !ReadText(is, site.function) ||
+            !ReadRaw(is, nPieces))
+        {
+            return false;
+        }
+        site.isFunction = isFunction;
+        site.formatted = nPieces > 0;
+        site.pieces.resize(nPieces);
+        for (auto& piece : site.pieces)
+        {
+            if (!ReadText(is, piece))
+            {
+                return false;
+            }
+        }
+    }
+
+    // The precision of the time printer for the resolution of the time steps.
+    int precision = std::clamp(static_cast<int>(std::lround(-std::log10(secondsPerStep))), 0, 15);
+
+    uint32_t siteId;
+    while (ReadRaw(is, siteId))
+    {
+        LogSlot slot;
+        if (!ReadRaw(is, slot.context) || !ReadRaw(is, slot.time) || !ReadRaw(is, slot.flags) ||
+            !ReadRaw(is, slot.size) || slot.size > LogRecord::PAYLOAD_SIZE ||
+            !is.read(reinterpret_cast<char*>(slot.payload), slot.size) || siteId >= nSites)
+        {
+            return false;
+        }
+        const LogSiteInfo& site = sites[siteId];
+
+        std::ostringstream line;
+        line.setf(std::ios_base::boolalpha);
+        if (!(slot.flags & LOG_BINARY_NO_TIME))
+        {
+            double seconds = slot.time * secondsPerStep;
+            line << std::fixed << std::setprecision(precision) << (seconds >= 0 ? "+" : "")
+                 << seconds << "s " << std::defaultfloat << std::setprecision(6);
+            if (slot.context == Simulator::NO_CONTEXT)
+            {
+                line << "-1 ";
+            }
+            else
+            {
+                line << slot.context << " ";
+            }
+        }
+        line << site.component << ":" << site.function << "(";
+        if (!site.isFunction)
+        {
+            line << "): [" << LogComponent::GetLevelLabel(static_cast<LogLevel>(site.level))
+                 << "] ";
+        }
+
+        // The arguments between the pieces of text of the statement;
+        // the arguments dropped are printed once as an ellipsis.
+        const uint8_t* position = slot.payload;
+        const uint8_t* end = slot.payload + slot.size;
+        std::size_t nArguments = site.formatted ? site.pieces.size() - 1 : SIZE_MAX;
+        bool dropped = false;
+        for (std::size_t i = 0; i < nArguments; ++i)
+        {
+            if (site.formatted)
+            {
+                line << site.pieces[i];
+            }
+            if (position == end)
+            {
+                if (!site.formatted)
+                {
+                    break;
+                }
+                if ((slot.flags & LOG_BINARY_TRUNCATED) && !dropped)
+                {
+                    line << "...";
+                    dropped = true;
+                }
+                continue;
+            }
+            if (!site.formatted && i > 0)
+            {
+                line << " ";
+            }
+            if (!DecodeArgument(position, end, line))
+            {
+                return false;
+            }
+        }
+        if (site.formatted)
+        {
+            line << site.pieces.back();
+        }
+        if (site.isFunction)
+        {
+            line << ")";
+        }
+        os << line.str() << std::endl;
+    }
+    return is.eof();
+}
+
+} // namespace ns3
@@ -0,0 +1,503 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef NS3_LOG_BINARY_H
+#define NS3_LOG_BINARY_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <memory>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup logging
+ * Binary ring buffer backend of the logging macros.
+ */
+
+namespace ns3
+{
+
+class LogComponent;
+
+/**
+ * \ingroup logging
+ *
+ * Store the log messages in a binary ring buffer, rather than formatting
+ * them to \c std::clog.
+ *
+ * While the binary log is enabled, the NS_LOG(), NS_LOG_FUNCTION() and
+ * NS_LOG_FUNCTION_NOARGS() statements of the enabled log components write
+ * a fixed size record to an in-memory ring of the last \p slots records:
+ * the id of the statement, the simulation time, the context and the raw
+ * values of the arguments. The text of the statement is recorded once per
+ * statement. Formatting is left to LogBinaryDecode(), or to the
+ * \c decode-log program:
+ * \verbatim
+   $ NS_LOG="AdaptiveTcp=level_info" NS_LOG_BINARY=run.nslog ./ns3 run adaptive-tcp-test
+   $ ./ns3 run "decode-log --input=run.nslog" \endverbatim
+ *
+ * The ring is written to \p filename by LogBinaryFlush(), at the exit of
+ * the program and when the program crashes on a signal or on
+ * NS_FATAL_ERROR(). Setting the \c NS_LOG_BINARY environment variable to
+ * a file name enables the binary log at startup.
+ *
+ * The arithmetic values, the strings, the pointers and the Ptr are stored
+ * raw; the other types are formatted through their own \c operator<<.
+ * Stream manipulators only apply within these values. The arguments beyond
+ * the size of a record are dropped, and marked as truncated. NS_LOG_UNCOND()
+ * and the NS_LOG_APPEND_CONTEXT of the files still write to \c std::clog.
+ *
+ * This should be called before the simulation starts.
+ *
+ * \param [in] filename The file of the records.
+ * \param [in] slots The number of records kept, rounded up to a power of 2.
+ */
+void LogBinaryEnable(const std::string& filename, uint32_t slots = 65536);
+
+/**
+ * \ingroup logging
+ * Write the binary log and return to the text output.
+ */
+void LogBinaryDisable();
+
+/**
+ * \ingroup logging
+ * Write the records of the ring to the file of the binary log.
+ */
+void LogBinaryFlush();
+
+/**
+ * \ingroup logging
+ * Check if the log messages go to the binary log.
+ * \returns \c true if the binary log is enabled.
+ */
+bool LogBinaryIsEnabled();
+
+/**
+ * \ingroup logging
+ * Format the records of a binary log as the text output would.
+ *
+ * \param [in] is The binary log.
+ * \param [in,out] os The output stream of the text.
+ * \returns \c false if the binary log is malformed.
+ */
+bool LogBinaryDecode(std::istream& is, std::ostream& os);
+
+/**
+ * \ingroup logging
+ *
+ * A logging statement of the binary log.
+ *
+ * Each statement holds a static LogSite, registered the first time the
+ * statement runs with the binary log enabled. The site has no destructor,
+ * so that the statements stay valid during the static destructions.
+ */
+class LogSite
+{
+  public:
+    /**
+     * Register a logging statement.
+     *
+     * \param [in] component The log component of the statement.
+     * \param [in] level The log level of the statement.
+     * \param [in] function The function of the statement.
+     * \param [in] isFunction Whether this is a NS_LOG_FUNCTION() statement.
+     */
+    LogSite(const LogComponent& component, int32_t level, const char* function, bool isFunction);
+
+    /**
+     * Get the id of the statement.
+     * \returns The id.
+     */
+    uint32_t GetId() const;
+
+    /**
+     * Check if this is a NS_LOG_FUNCTION() statement.
+     * \returns \c true for function statements.
+     */
+    bool IsFunction() const;
+
+    /**
+     * Check if the text of the statement is recorded.
+     * \returns \c true if the text is recorded.
+     */
+    bool IsFormatted() const;
+
+    /**
+     * Record the text of the statement, if not done yet.
+     *
+     * \param [in] pieces The texts around the arguments.
+     */
+    void SetFormat(const std::vector<std::string>& pieces);
+
+  private:
+    uint32_t m_id;                 //!< The index of the statement.
+    bool m_isFunction;             //!< Whether this is a NS_LOG_FUNCTION().
+    std::atomic<bool> m_formatted; //!< Whether the text is recorded.
+};
+
+/**
+ * \ingroup logging
+ *
+ * Writer of one record of the binary log.
+ *
+ * The logging macros stream their message into a temporary LogRecord,
+ * which commits the record to the ring at its destruction.
+ */
+class LogRecord
+{
+  public:
+    /** The size of a record in the ring. */
+    static constexpr std::size_t SLOT_SIZE = 128;
+    /** The size of the arguments in a record. */
+    static constexpr std::size_t PAYLOAD_SIZE = 96;
+
+    /** The types of the arguments, written before their value. */
+    enum Tag : uint8_t
+    {
+        BOOL = 'b',     //!< A bool, 1 byte.
+        CHAR = 'c',     //!< A character, 1 byte.
+        SIGNED = 'i',   //!< A signed integer, 8 bytes.
+        UNSIGNED = 'u', //!< An unsigned integer, 8 bytes.
+        DOUBLE = 'd',   //!< A floating point value, 8 bytes.
+        POINTER = 'p',  //!< A pointer, 8 bytes.
+        STRING = 's',   //!< A string, 2 bytes of length and the characters.
+    };
+
+    /** The bit of the length of a string which marks the strings cut. */
+    static constexpr uint16_t STRING_CUT = 0x8000;
+
+    /**
+     * Start a record in the ring.
+     *
+     * \param [in] site The statement.
+     */
+    LogRecord(LogSite& site);
+    /** Commit the record to the ring. */
+    ~LogRecord();
+
+    // Delete copy constructor and assignment operator to avoid misuse
+    LogRecord(const LogRecord&) = delete;
+    LogRecord& operator=(const LogRecord&) = delete;
+
+    /**
+     * Append a value.
+     *
+     * \param [in] value The value.
+     * \returns This LogRecord, so it's chainable.
+     */
+    template <typename T>
+    LogRecord& operator<<(const T& value);
+
+    /**
+     * Append a string literal, which is part of the text of the statement.
+     *
+     * \param [in] text The literal.
+     * \returns This LogRecord, so it's chainable.
+     */
+    template <std::size_t N>
+    LogRecord& operator<<(const char (&text)[N]);
+
+    /**
+     * Append a modifiable character array, which is an argument.
+     *
+     * \param [in] text The characters.
+     * \returns This LogRecord, so it's chainable.
+     */
+    template <std::size_t N>
+    LogRecord& operator<<(char (&text)[N]);
+
+    /**
+     * Append a stream manipulator: \c std::endl is kept as a new line,
+     * the other ones are ignored.
+     *
+     * \param [in] manipulator The manipulator.
+     * \returns This LogRecord, so it's chainable.
+     */
+    LogRecord& operator<<(std::ostream& (*manipulator)(std::ostream&));
+
+    /**
+     * Append the elements of a vector, as ParameterLogger does.
+     *
+     * \param [in] vector The vector.
+     * \returns This LogRecord, so it's chainable.
+     */
+    template <typename T>
+    LogRecord& operator<<(const std::vector<T>& vector);
+
+  private:
+    /**
+     * Append text to the statement, the first time it runs.
+     * \param [in] text The text.
+     */
+    void AddText(std::string_view text);
+    /**
+     * Start an argument: add the separator of function statements.
+     * \param [in] quoted Whether the argument is a quoted string.
+     */
+    void BeginArgument(bool quoted);
+    /**
+     * End an argument.
+     * \param [in] quoted Whether the argument is a quoted string.
+     */
+    void EndArgument(bool quoted);
+    /**
+     * Write a fixed size argument.
+     * \param [in] tag The type of the argument.
+     * \param [in] value The value.
+     * \param [in] size The size of the value.
+     */
+    void Write(Tag tag, const void* value, std::size_t size);
+    /**
+     * Write a string argument, truncated to the room left.
+     * \param [in] text The string.
+     */
+    void WriteString(std::string_view text);
+
+    LogSite& m_site;                                  //!< The statement.
+    uint8_t* m_slot;                                  //!< The slot, or nullptr.
+    uint64_t m_index;                                 //!< The index of the slot.
+    uint8_t* m_position;                              //!< The next byte of the arguments.
+    uint8_t* m_end;                                   //!< The end of the arguments.
+    bool m_truncated;                                 //!< Whether arguments were dropped.
+    bool m_first;                                     //!< Whether no argument was written.
+    std::unique_ptr<std::vector<std::string>> m_text; //!< The text, on the first run.
+};
+
+/*************************************************
+ **  Inline implementations
+ ************************************************/
+
+inline uint32_t
+LogSite::GetId() const
+{
+    return m_id;
+}
+
+inline bool
+LogSite::IsFunction() const
+{
+    return m_isFunction;
+}
+
+inline bool
+LogSite::IsFormatted() const
+{
+    return m_formatted.load(std::memory_order_acquire);
+}
+
+inline void
+LogRecord::AddText(std::string_view text)
+{
+    if (m_text) [[unlikely]]
+    {
+        m_text->back().append(text);
+    }
+}
+
+inline void
+LogRecord::BeginArgument(bool quoted)
+{
+    if (m_site.IsFunction() && !m_first)
+    {
+        AddText(", ");
+    }
+    m_first = false;
+    if (quoted && m_site.IsFunction())
+    {
+        AddText("\"");
+    }
+    if (m_text) [[unlikely]]
+    {
+        m_text->emplace_back();
+    }
+}
+
+inline void
+LogRecord::EndArgument(bool quoted)
+{
+    if (quoted && m_site.IsFunction())
+    {
+        AddText("\"");
+    }
+}
+
+inline void
+LogRecord::Write(Tag tag, const void* value, std::size_t size)
+{
+    if (m_end - m_position < static_cast<std::ptrdiff_t>(size + 1))
+    {
+        m_truncated = true;
+        m_position = m_end;
+        return;
+    }
+    *m_position++ = tag;
+    std::memcpy(m_position, value, size);
+    m_position += size;
+}
+
+inline void
+LogRecord::WriteString(std::string_view text)
+{
+    std::ptrdiff_t room = m_end - m_position - 3;
+    if (room < 0)
+    {
+        m_truncated = true;
+        m_position = m_end;
+        return;
+    }
+    uint16_t cut = 0;
+    if (text.size() > static_cast<std::size_t>(room))
+    {
+        text = text.substr(0, room);
+        cut = STRING_CUT;
+    }
+    auto size = static_cast<uint16_t>(text.size());
+    auto length = static_cast<uint16_t>(size | cut);
+    *m_position++ = STRING;
+    std::memcpy(m_position, &length, sizeof(length));
+    std::memcpy(m_position + sizeof(length), text.data(), size);
+    m_position += sizeof(length) + size;
+}
+
+template <typename T>
+LogRecord&
+LogRecord::operator<<(const T& value)
+{
+    if constexpr (std::is_same_v<T, char> || std::is_same_v<T, signed char> ||
+                  std::is_same_v<T, unsigned char>)
+    {
+        // NS_LOG_FUNCTION prints the characters as numbers, as ParameterLogger does.
+        if (m_site.IsFunction())
+        {
+            return *this << static_cast<int32_t>(value);
+        }
+    }
+    constexpr bool isString = std::is_convertible_v<T, std::string_view> ||
+                              std::is_same_v<std::decay_t<T>, char*> ||
+                              std::is_same_v<std::decay_t<T>, const char*>;
+    BeginArgument(isString);
+    if (m_slot == nullptr)
+    {
+        // The ring is gone, only the text of the statement is recorded.
+    }
+    else if constexpr (isString)
+    {
+        if constexpr (std::is_pointer_v<std::decay_t<T>>)
+        {
+            WriteString(value == nullptr ? std::string_view("(null)") : std::string_view(value));
+        }
+        else
+        {
+            WriteString(std::string_view(value));
+        }
+    }
+    else if constexpr (std::is_same_v<T, bool>)
+    {
+        Write(BOOL, &value, 1);
+    }
+    else if constexpr (std::is_same_v<T, char> || std::is_same_v<T, signed char> ||
+                       std::is_same_v<T, unsigned char>)
+    {
+        Write(CHAR, &value, 1);
+    }
+    else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>)
+    {
+        auto v = static_cast<int64_t>(value);
+        Write(SIGNED, &v, sizeof(v));
+    }
+    else if constexpr (std::is_integral_v<T>)
+    {
+        auto v = static_cast<uint64_t>(value);
+        Write(UNSIGNED, &v, sizeof(v));
+    }
+    else if constexpr (std::is_same_v<T, float> || std::is_same_v<T, double>)
+    {
+        auto v = static_cast<double>(value);
+        Write(DOUBLE, &v, sizeof(v));
+    }
+    else if constexpr (std::is_pointer_v<T> && !std::is_function_v<std::remove_pointer_t<T>>)
+    {
+        auto v = reinterpret_cast<uint64_t>(static_cast<const volatile void*>(value));
+        Write(POINTER, &v, sizeof(v));
+    }
+    else if constexpr (requires { PeekPointer(value); })
+    {
+        // Ptr<T> is printed as its pointer.
+        auto v = reinterpret_cast<uint64_t>(static_cast<const volatile void*>(PeekPointer(value)));
+        Write(POINTER, &v, sizeof(v));
+    }
+    else
+    {
+        std::ostringstream oss;
+        oss.setf(std::ios_base::boolalpha);
+        if constexpr (requires { oss << value; })
+        {
+            oss << value;
+        }
+        else
+        {
+            // Some operator<< take a non-const reference, as the text
+            // logging passes the argument as it is.
+            oss << const_cast<T&>(value);
+        }
+        WriteString(oss.str());
+    }
+    EndArgument(isString);
+    return *this;
+}
+
+template <std::size_t N>
+LogRecord&
+LogRecord::operator<<(const char (&text)[N])
+{
+    if (m_site.IsFunction())
+    {
+        // NS_LOG_FUNCTION parameters, as ParameterLogger prints them.
+        if (!m_first)
+        {
+            AddText(", ");
+        }
+        m_first = false;
+        AddText("\"");
+        AddText(text);
+        AddText("\"");
+    }
+    else
+    {
+        AddText(text);
+    }
+    return *this;
+}
+
+template <std::size_t N>
+LogRecord&
+LogRecord::operator<<(char (&text)[N])
+{
+    return *this << static_cast<const char*>(text);
+}
+
+template <typename T>
+LogRecord&
+LogRecord::operator<<(const std::vector<T>& vector)
+{
+    for (const auto& i : vector)
+    {
+        *this << i;
+    }
+    return *this;
+}
+
+} // namespace ns3
+
+#endif /* NS3_LOG_BINARY_H */
@@ -162,6 +162,9 @@
  * NS_LOG (LOG_DEBUG, "a number="<<aNumber<<", anotherNumber="<<anotherNumber);
  * \endcode
  *
+ * While LogBinaryEnable() is in effect, the message is stored in the
+ * binary ring buffer instead, without any prefix or context.
+ *
  * \param [in] level The log level
  * \param [in] msg The message to log
  * \internal
@@ -173,6 +176,12 @@
     {                                                                                              \
         if (g_log.IsEnabled(level))                                                                \
         {                                                                                          \
+            if (ns3::LogBinaryIsEnabled())                                                         \
+            {                                                                                      \
+                static ns3::LogSite nsLogSite(g_log, level, __FUNCTION__, false);                  \
+                ns3::LogRecord{nsLogSite} << msg;                                                  \
+                break;                                                                             \
+            }                                                                                      \
             NS_LOG_APPEND_TIME_PREFIX;                                                             \
             NS_LOG_APPEND_NODE_PREFIX;                                                             \
             NS_LOG_APPEND_CONTEXT;                                                                 \
@@ -198,6 +207,12 @@
     {                                                                                              \
         if (g_log.IsEnabled(ns3::LOG_FUNCTION))                                                    \
         {                                                                                          \
+            if (ns3::LogBinaryIsEnabled())                                                         \
+            {                                                                                      \
+                static ns3::LogSite nsLogSite(g_log, ns3::LOG_FUNCTION, __FUNCTION__, true);       \
+                ns3::LogRecord{nsLogSite};                                                         \
+                break;                                                                             \
+            }                                                                                      \
             NS_LOG_APPEND_TIME_PREFIX;                                                             \
             NS_LOG_APPEND_NODE_PREFIX;                                                             \
             NS_LOG_APPEND_CONTEXT;                                                                 \
@@ -232,6 +247,12 @@
     {                                                                                              \
         if (g_log.IsEnabled(ns3::LOG_FUNCTION))                                                    \
         {                                                                                          \
+            if (ns3::LogBinaryIsEnabled())                                                         \
+            {                                                                                      \
+                static ns3::LogSite nsLogSite(g_log, ns3::LOG_FUNCTION, __FUNCTION__, true);       \
+                ns3::LogRecord{nsLogSite} << parameters;                                           \
+                break;                                                                             \
+            }                                                                                      \
             NS_LOG_APPEND_TIME_PREFIX;                                                             \
             NS_LOG_APPEND_NODE_PREFIX;                                                             \
             NS_LOG_APPEND_CONTEXT;                                                                 \
@@ -11,6 +11,7 @@
 #include "warnings.h"
 
 #include <functional>
+#include <memory>
 #include <tuple>
 #include <type_traits>
 
@@ -126,6 +127,34 @@ struct EventMemberImplObjTraits<T*>
     }
 };
 
+/**
+ * \ingroup events
+ * Helper for the MakeEvent functions which take a class method.
+ *
+ * This helper gets the class of a pointer to member.
+ *
+ * This is the generic template declaration (with empty body).
+ *
+ * \tparam T \explicit The pointer to member type.
+ */
+template <typename T>
+struct MemberPointerTraits;
+
+/**
+ * \ingroup events
+ * Helper for the MakeEvent functions which take a class method.
+ *
+ * This helper gets the class of a pointer to member.
+ *
+ * \tparam R \explicit The member type.
+ * \tparam C \explicit The class type.
+ */
+template <typename R, typename C>
+struct MemberPointerTraits<R C::*>
+{
+    typedef C Class; //!< The class of the member.
+};
+
 } // namespace internal
 
 template <typename MEM, typename OBJ, typename... Ts>
@@ -138,8 +167,25 @@ MakeEvent(MEM mem_ptr, OBJ obj, Ts... args)
         EventMemberImpl() = delete;
 
         EventMemberImpl(OBJ obj, MEM function, Ts... args)
-            : m_function(std::bind(function, obj, args...))
+            : m_function(function),
+              m_obj(obj),
+              m_arguments(args...)
+        {
+        }
+
+        const void* GetHandler() const override
         {
+            if constexpr (std::is_member_function_pointer_v<MEM> && requires(OBJ o) { *o; })
+            {
+                const typename internal::MemberPointerTraits<MEM>::Class& object = *m_obj;
+                return GetMemberFunctionAddress(&m_function,
+                                                sizeof(m_function),
+                                                std::addressof(object));
+            }
+            else
+            {
+                return nullptr;
+            }
         }
 
       protected:
@@ -150,10 +196,13 @@ MakeEvent(MEM mem_ptr, OBJ obj, Ts... args)
       private:
         void Notify() override
         {
-            m_function();
+            std::apply([this](auto&... args) { std::invoke(m_function, m_obj, args...); },
+                       m_arguments);
         }
 
-        std::function<void()> m_function;
+        MEM m_function;
+        OBJ m_obj;
+        std::tuple<std::remove_reference_t<Ts>...> m_arguments;
     }* ev = new EventMemberImpl(obj, mem_ptr, args...);
 
     return ev;
@@ -172,6 +221,11 @@ MakeEvent(void (*f)(Us...), Ts... args)
         {
         }
 
+        const void* GetHandler() const override
+        {
+            return reinterpret_cast<const void*>(m_function);
+        }
+
       protected:
         ~EventFunctionImpl() override
         {
@@ -125,6 +125,34 @@ ObjectPtrContainerAccessor::Get(const ObjectBase* object, AttributeValue& value)
     return true;
 }
 
+bool
+ObjectPtrContainerAccessor::GetN(const ObjectBase* object, std::size_t* n) const
+{
+    NS_LOG_FUNCTION(this << object << n);
+    return DoGetN(object, n);
+}
+
+bool
+ObjectPtrContainerAccessor::GetAt(const ObjectBase* object,
+                                  std::size_t index,
+                                  Ptr<Object>* item) const
+{
+    NS_LOG_FUNCTION(this << object << index << item);
+    std::size_t n;
+    if (!DoGetN(object, &n) || index >= n)
+    {
+        return false;
+    }
+    std::size_t found;
+    Ptr<Object> o = DoGet(object, index, &found);
+    if (found != index)
+    {
+        return false;
+    }
+    *item = o;
+    return true;
+}
+
 bool
 ObjectPtrContainerAccessor::HasGetter() const
 {
@@ -245,6 +245,26 @@ class ObjectPtrContainerAccessor : public AttributeAccessor
     bool HasGetter() const override;
     bool HasSetter() const override;
 
+    /**
+     * Get the number of instances in the container.
+     *
+     * \param [in] object The container object.
+     * \param [out] n The number of instances in the container.
+     * \returns true if the value could be obtained successfully.
+     */
+    bool GetN(const ObjectBase* object, std::size_t* n) const;
+    /**
+     * Get an instance from the container, without getting the whole
+     * container, if the instance at position \pname{index} in the container
+     * has this index, as in the containers of MakeObjectVectorAccessor().
+     *
+     * \param [in] object The container object.
+     * \param [in] index The index of the instance.
+     * \param [out] item The instance.
+     * \returns true if the instance was found at its position.
+     */
+    bool GetAt(const ObjectBase* object, std::size_t index, Ptr<Object>* item) const;
+
   private:
     /**
      * Get the number of instances in the container.
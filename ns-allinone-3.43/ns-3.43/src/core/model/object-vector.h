@@ -13,6 +13,8 @@
 #include "object.h"
 #include "ptr.h"
 
+#include <iterator>
+
 /**
  * \file
  * \ingroup attribute_ObjectVector
@@ -82,20 +84,10 @@ MakeObjectVectorAccessor(U T::*memberVector)
                           std::size_t* index) const override
         {
             const T* obj = static_cast<const T*>(object);
-            auto begin = (obj->*m_memberVector).begin();
-            auto end = (obj->*m_memberVector).end();
-            std::size_t k = 0;
-            for (auto j = begin; j != end; j++, k++)
-            {
-                if (k == i)
-                {
-                    *index = k;
-                    return *j;
-                }
-            }
-            NS_ASSERT(false);
-            // quiet compiler.
-            return nullptr;
+            NS_ASSERT(i < (obj->*m_memberVector).size());
+            // Constant time for the random access containers.
+            *index = i;
+            return *std::next((obj->*m_memberVector).begin(), i);
         }
 
         U T::*m_memberVector;
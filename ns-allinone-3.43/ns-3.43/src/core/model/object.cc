@@ -37,6 +37,90 @@ NS_LOG_COMPONENT_DEFINE("Object");
 
 NS_OBJECT_ENSURE_REGISTERED(Object);
 
+/**
+ * Open addressing hash table, with linear probing, from the uid of the
+ * TypeIds looked up to the aggregate of this type, or nullptr if there
+ * is none.
+ *
+ * The table uses the same trick as Object::Aggregates: it is allocated
+ * with all its slots in one chunk of memory.
+ */
+struct Object::AggregateLookup
+{
+    /** A slot of the table. */
+    struct Slot
+    {
+        uint16_t uid;   //!< The TypeId uid, or 0 for an empty slot
+        Object* object; //!< The aggregate of this TypeId, or nullptr
+    };
+
+    uint32_t mask; //!< The number of slots minus one, a power of two minus one
+    uint32_t size; //!< The number of slots used
+    Slot slots[1]; //!< The slots
+
+    /** The number of slots of a new table. */
+    static constexpr uint32_t INITIAL_CAPACITY = 16;
+
+    /**
+     * Allocate an empty table.
+     *
+     * \param [in] capacity The number of slots, a power of two.
+     * \return The table.
+     */
+    static AggregateLookup* Create(uint32_t capacity)
+    {
+        std::size_t size = sizeof(AggregateLookup) + (capacity - 1) * sizeof(Slot);
+        auto lookup = (AggregateLookup*)std::calloc(1, size);
+        lookup->mask = capacity - 1;
+        return lookup;
+    }
+
+    /**
+     * Find the slot of a TypeId.
+     *
+     * \param [in] uid The TypeId uid.
+     * \return The slot of uid, or the empty slot where to insert it.
+     */
+    Slot* Find(uint16_t uid)
+    {
+        uint32_t i = uid & mask;
+        while (slots[i].uid != uid && slots[i].uid != 0)
+        {
+            i = (i + 1) & mask;
+        }
+        return &slots[i];
+    }
+
+    /**
+     * Insert a TypeId missing from the table.
+     *
+     * \param [in] lookup The table.
+     * \param [in] uid The TypeId uid.
+     * \param [in] object The aggregate of this TypeId, or nullptr.
+     * \return The table, reallocated when it is more than half full.
+     */
+    static AggregateLookup* Insert(AggregateLookup* lookup, uint16_t uid, Object* object)
+    {
+        if (2 * (lookup->size + 1) > lookup->mask + 1)
+        {
+            AggregateLookup* larger = Create(2 * (lookup->mask + 1));
+            for (uint32_t i = 0; i <= lookup->mask; i++)
+            {
+                if (lookup->slots[i].uid != 0)
+                {
+                    *larger->Find(lookup->slots[i].uid) = lookup->slots[i];
+                }
+            }
+            larger->size = lookup->size;
+            std::free(lookup);
+            lookup = larger;
+        }
+        *lookup->Find(uid) = {uid, object};
+        lookup->size++;
+        return lookup;
+    }
+};
+
 Object::AggregateIterator::AggregateIterator()
     : m_object(nullptr),
       m_current(0)
@@ -97,11 +181,10 @@ Object::Object()
     : m_tid(Object::GetTypeId()),
       m_disposed(false),
       m_initialized(false),
-      m_aggregates((Aggregates*)std::malloc(sizeof(Aggregates))),
+      m_aggregates(AllocateAggregates(1)),
       m_getObjectCount(0)
 {
     NS_LOG_FUNCTION(this);
-    m_aggregates->n = 1;
     m_aggregates->buffer[0] = this;
 }
 
@@ -121,11 +204,14 @@ Object::~Object()
             m_aggregates->n--;
         }
     }
+    // the lookup table may point to this object
+    std::free(m_aggregates->lookup);
+    m_aggregates->lookup = nullptr;
     // finally, if all objects have been removed from the list,
     // delete the aggregate list
     if (m_aggregates->n == 0)
     {
-        std::free(m_aggregates);
+        FreeAggregates(m_aggregates);
     }
     m_aggregates = nullptr;
     m_unidirectionalAggregates.clear();
@@ -135,10 +221,9 @@ Object::Object(const Object& o)
     : m_tid(o.m_tid),
       m_disposed(false),
       m_initialized(false),
-      m_aggregates((Aggregates*)std::malloc(sizeof(Aggregates))),
+      m_aggregates(AllocateAggregates(1)),
       m_getObjectCount(0)
 {
-    m_aggregates->n = 1;
     m_aggregates->buffer[0] = this;
 }
 
@@ -149,51 +234,108 @@ Object::Construct(const AttributeConstructionList& attributes)
     ConstructSelf(attributes);
 }
 
+Object::Aggregates*
+Object::AllocateAggregates(uint32_t n)
+{
+    auto aggregates = (Aggregates*)std::malloc(sizeof(Aggregates) + (n - 1) * sizeof(Object*));
+    aggregates->n = n;
+    aggregates->lookup = nullptr;
+    return aggregates;
+}
+
+void
+Object::FreeAggregates(Aggregates* aggregates)
+{
+    std::free(aggregates->lookup);
+    std::free(aggregates);
+}
+
 Ptr<Object>
 Object::DoGetObject(TypeId tid) const
 {
+    // The lookups already in the table skip the logging and the checks,
+    // like the dynamic_cast of GetObject() does.
+    uint16_t uid = tid.GetUid();
+    AggregateLookup::Slot* slot = nullptr;
+    if (m_aggregates->lookup != nullptr && uid != 0)
+    {
+        slot = m_aggregates->lookup->Find(uid);
+        if (slot->object != nullptr)
+        {
+            return slot->object;
+        }
+        if (slot->uid == uid && m_unidirectionalAggregates.empty())
+        {
+            return nullptr;
+        }
+    }
+
     NS_LOG_FUNCTION(this << tid);
     NS_ASSERT(CheckLoose());
 
     // First check if the object is in the normal aggregates.
-    uint32_t n = m_aggregates->n;
+    Object* found = nullptr;
+    if (slot == nullptr || slot->uid != uid)
+    {
+        found = SearchAggregates(tid);
+        if (uid != 0)
+        {
+            if (m_aggregates->lookup == nullptr)
+            {
+                m_aggregates->lookup = AggregateLookup::Create(AggregateLookup::INITIAL_CAPACITY);
+            }
+            m_aggregates->lookup = AggregateLookup::Insert(m_aggregates->lookup, uid, found);
+        }
+    }
+    if (found)
+    {
+        return found;
+    }
+
+    // Next check if it's a unidirectional aggregate
     TypeId objectTid = Object::GetTypeId();
-    for (uint32_t i = 0; i < n; i++)
+    for (auto& uniItem : m_unidirectionalAggregates)
     {
-        Object* current = m_aggregates->buffer[i];
-        TypeId cur = current->GetInstanceTypeId();
+        TypeId cur = uniItem->GetInstanceTypeId();
         while (cur != tid && cur != objectTid)
         {
             cur = cur.GetParent();
         }
         if (cur == tid)
         {
-            // This is an attempt to 'cache' the result of this lookup.
-            // the idea is that if we perform a lookup for a TypeId on this object,
-            // we are likely to perform the same lookup later so, we make sure
-            // that the aggregate array is sorted by the number of accesses
-            // to each object.
-
-            // first, increment the access count
-            current->m_getObjectCount++;
-            // then, update the sort
-            UpdateSortedArray(m_aggregates, i);
-            // finally, return the match
-            return const_cast<Object*>(current);
+            return uniItem;
         }
     }
+    return nullptr;
+}
 
-    // Next check if it's a unidirectional aggregate
-    for (auto& uniItem : m_unidirectionalAggregates)
+Object*
+Object::SearchAggregates(TypeId tid) const
+{
+    NS_LOG_FUNCTION(this << tid);
+    uint32_t n = m_aggregates->n;
+    TypeId objectTid = Object::GetTypeId();
+    for (uint32_t i = 0; i < n; i++)
     {
-        TypeId cur = uniItem->GetInstanceTypeId();
+        Object* current = m_aggregates->buffer[i];
+        TypeId cur = current->GetInstanceTypeId();
         while (cur != tid && cur != objectTid)
         {
             cur = cur.GetParent();
         }
         if (cur == tid)
         {
-            return uniItem;
+            // The lookup table of DoGetObject caches the result of this
+            // lookup. We also keep the aggregate array sorted by the number
+            // of searches of each object, so that the most searched ones are
+            // found first when the table is rebuilt.
+
+            // first, increment the access count
+            current->m_getObjectCount++;
+            // then, update the sort
+            UpdateSortedArray(m_aggregates, i);
+            // finally, return the match
+            return current;
         }
     }
     return nullptr;
@@ -306,8 +448,7 @@ Object::AggregateObject(Ptr<Object> o)
     Object* other = PeekPointer(o);
     // first create the new aggregate buffer.
     uint32_t total = m_aggregates->n + other->m_aggregates->n;
-    auto aggregates = (Aggregates*)std::malloc(sizeof(Aggregates) + (total - 1) * sizeof(Object*));
-    aggregates->n = total;
+    Aggregates* aggregates = AllocateAggregates(total);
 
     // copy our buffer to the new buffer
     std::memcpy(&aggregates->buffer[0],
@@ -359,9 +500,10 @@ Object::AggregateObject(Ptr<Object> o)
         current->NotifyNewAggregate();
     }
 
-    // Now that we are done with them, we can free our old aggregate buffers
-    std::free(a);
-    std::free(b);
+    // Now that we are done with them, we can free our old aggregate buffers,
+    // and their lookup tables which do not know the new aggregates.
+    FreeAggregates(a);
+    FreeAggregates(b);
 }
 
 void
@@ -427,6 +569,9 @@ Object::SetTypeId(TypeId tid)
     NS_LOG_FUNCTION(this << tid);
     NS_ASSERT(Check());
     m_tid = tid;
+    // the lookup table may hold lookups of the previous type
+    std::free(m_aggregates->lookup);
+    m_aggregates->lookup = nullptr;
 }
 
 void
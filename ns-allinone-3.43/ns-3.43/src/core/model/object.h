@@ -360,6 +360,14 @@ class Object : public SimpleRefCount<Object, ObjectBase, ObjectDeleter>
 
     /**@}*/
 
+    /**
+     * The lookup table of the Objects aggregated together, from the uid
+     * of a TypeId to the Object of this type or of a subclass.
+     *
+     * Defined in object.cc.
+     */
+    struct AggregateLookup;
+
     /**
      * The list of Objects aggregated to this one.
      *
@@ -376,6 +384,11 @@ class Object : public SimpleRefCount<Object, ObjectBase, ObjectDeleter>
     {
         /** The number of entries in \c buffer. */
         uint32_t n;
+        /**
+         * The TypeIds looked up by DoGetObject(), or nullptr before the
+         * first lookup. A new list of aggregates starts a new table.
+         */
+        AggregateLookup* lookup;
         /** The array of Objects. */
         Object* buffer[1];
     };
@@ -383,10 +396,35 @@ class Object : public SimpleRefCount<Object, ObjectBase, ObjectDeleter>
     /**
      * Find an Object of TypeId tid in the aggregates of this Object.
      *
+     * The result of the search in the aggregates shared with the other
+     * Objects is kept in the lookup table of the aggregates, so that
+     * the next lookups of tid take constant time.
+     *
      * \param [in] tid The TypeId we're looking for
      * \return The matching Object, if it is found
      */
     Ptr<Object> DoGetObject(TypeId tid) const;
+    /**
+     * Search an Object of TypeId tid in the aggregates shared with the
+     * other Objects, walking the TypeId parents of every aggregate.
+     *
+     * \param [in] tid The TypeId we're looking for
+     * \return The matching Object, or nullptr if it is not found
+     */
+    Object* SearchAggregates(TypeId tid) const;
+    /**
+     * Allocate a list of aggregates.
+     *
+     * \param [in] n The number of aggregates.
+     * \return The list, without lookup table.
+     */
+    static Aggregates* AllocateAggregates(uint32_t n);
+    /**
+     * Free a list of aggregates and its lookup table.
+     *
+     * \param [in] aggregates The list.
+     */
+    static void FreeAggregates(Aggregates* aggregates);
     /**
      * Verify that this Object is still live, by checking it's reference count.
      * \return \c true if the reference count is non zero.
@@ -517,7 +555,8 @@ Object::GetObject() const
     {
         return Ptr<T>(result);
     }
-    // if the cast does not work, we try to do a full type check.
+    // The lookup table of the aggregates finds the TypeIds already
+    // looked up in constant time.
     Ptr<Object> found = DoGetObject(T::GetTypeId());
     if (found)
     {
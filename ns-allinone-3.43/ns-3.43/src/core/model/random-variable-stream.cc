@@ -42,6 +42,62 @@ NS_LOG_COMPONENT_DEFINE("RandomVariableStream");
 
 NS_OBJECT_ENSURE_REGISTERED(RandomVariableStream);
 
+/**
+ * \ingroup randomvariable
+ * Fill a buffer with values transformed from uniforms, and redraw the values
+ * above the bound, as the rejection loops of GetValue() do.
+ *
+ * Every value takes at least one uniform, so drawing as many uniforms as the
+ * values missing never goes further in the stream than GetValue() would.
+ *
+ * \tparam F \deduced The transform of the uniforms.
+ * \param [in] rng The stream of uniforms.
+ * \param [in] isAntithetic Whether the uniforms \f$u\f$ are replaced by \f$1 - u\f$.
+ * \param [in] bound The upper bound of the values, 0 for none.
+ * \param [out] values The buffer to fill.
+ * \param [in] n The number of values.
+ * \param [in] transform The transform of the uniforms.
+ */
+template <typename F>
+static void
+FillBounded(RngStream* rng,
+            bool isAntithetic,
+            double bound,
+            double* values,
+            std::size_t n,
+            F transform)
+{
+    std::size_t filled = 0;
+    while (filled < n)
+    {
+        double* block = values + filled;
+        std::size_t size = n - filled;
+        rng->RandU01(block, size);
+        if (isAntithetic)
+        {
+            for (std::size_t i = 0; i < size; ++i)
+            {
+                block[i] = 1 - block[i];
+            }
+        }
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            block[i] = transform(block[i]);
+        }
+        if (bound == 0)
+        {
+            return;
+        }
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            if (block[i] <= bound)
+            {
+                values[filled++] = block[i];
+            }
+        }
+    }
+}
+
 TypeId
 RandomVariableStream::GetTypeId()
 {
@@ -100,6 +156,16 @@ RandomVariableStream::GetInteger()
     return value;
 }
 
+void
+RandomVariableStream::GetValues(double* values, std::size_t n)
+{
+    NS_LOG_FUNCTION(this << values << n);
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        values[i] = GetValue();
+    }
+}
+
 void
 RandomVariableStream::SetStream(int64_t stream)
 {
@@ -218,6 +284,26 @@ UniformRandomVariable::GetInteger()
     return v;
 }
 
+void
+UniformRandomVariable::GetValues(double* values, std::size_t n)
+{
+    const double min = m_min;
+    const double max = m_max;
+    Peek()->RandU01(values, n);
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        values[i] = min + values[i] * (max - min);
+    }
+    if (IsAntithetic())
+    {
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            values[i] = min + (max - values[i]);
+        }
+    }
+    NS_LOG_DEBUG(n << " values, stream: " << GetStream() << " min: " << min << " max: " << max);
+}
+
 NS_OBJECT_ENSURE_REGISTERED(ConstantRandomVariable);
 
 TypeId
@@ -443,6 +529,17 @@ ExponentialRandomVariable::GetValue()
     return GetValue(m_mean, m_bound);
 }
 
+void
+ExponentialRandomVariable::GetValues(double* values, std::size_t n)
+{
+    const double mean = m_mean;
+    FillBounded(Peek(), IsAntithetic(), m_bound, values, n, [mean](double v) {
+        return -mean * std::log(v);
+    });
+    NS_LOG_DEBUG(n << " values, stream: " << GetStream() << " mean: " << mean
+                   << " bound: " << m_bound);
+}
+
 NS_OBJECT_ENSURE_REGISTERED(ParetoRandomVariable);
 
 TypeId
@@ -539,6 +636,18 @@ ParetoRandomVariable::GetValue()
     return GetValue(m_scale, m_shape, m_bound);
 }
 
+void
+ParetoRandomVariable::GetValues(double* values, std::size_t n)
+{
+    const double scale = m_scale;
+    const double shape = m_shape;
+    FillBounded(Peek(), IsAntithetic(), m_bound, values, n, [scale, shape](double v) {
+        return (scale * (1.0 / std::pow(v, 1.0 / shape)));
+    });
+    NS_LOG_DEBUG(n << " values, stream: " << GetStream() << " scale: " << scale
+                   << " shape: " << shape << " bound: " << m_bound);
+}
+
 NS_OBJECT_ENSURE_REGISTERED(WeibullRandomVariable);
 
 TypeId
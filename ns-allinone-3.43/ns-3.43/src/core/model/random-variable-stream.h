@@ -19,6 +19,7 @@
 #include "object.h"
 #include "type-id.h"
 
+#include <cstddef>
 #include <map>
 #include <stdint.h>
 
@@ -143,6 +144,19 @@ class RandomVariableStream : public Object
     // The base implementation returns `(uint32_t)GetValue()`
     virtual uint32_t GetInteger();
 
+    /**
+     * \brief Fill a buffer with the next random values drawn from the distribution.
+     *
+     * The values are those that as many calls of GetValue() would return.
+     * The base implementation calls GetValue() for every value; the
+     * uniform, exponential and Pareto distributions transform a block
+     * of uniforms from the RngStream instead.
+     *
+     * \param [out] values The buffer to fill.
+     * \param [in] n The number of values.
+     */
+    virtual void GetValues(double* values, std::size_t n);
+
   protected:
     /**
      * \brief Get the pointer to the underlying RngStream.
@@ -273,6 +287,8 @@ class UniformRandomVariable : public RandomVariableStream
      */
     uint32_t GetInteger() override;
 
+    void GetValues(double* values, std::size_t n) override;
+
   private:
     /** The lower bound on values that can be returned by this RNG stream. */
     double m_min;
@@ -582,6 +598,7 @@ class ExponentialRandomVariable : public RandomVariableStream
     // Inherited
     double GetValue() override;
     using RandomVariableStream::GetInteger;
+    void GetValues(double* values, std::size_t n) override;
 
   private:
     /** The mean value of the unbounded exponential distribution. */
@@ -718,6 +735,7 @@ class ParetoRandomVariable : public RandomVariableStream
     // Inherited
     double GetValue() override;
     using RandomVariableStream::GetInteger;
+    void GetValues(double* values, std::size_t n) override;
 
   private:
     /** The scale parameter for the Pareto distribution returned by this RNG stream. */
@@ -326,45 +326,70 @@ namespace ns3
 
 using namespace MRG32k3a;
 
-double
-RngStream::RandU01()
+void
+RngStream::RandU01(double* values, std::size_t n)
 {
-    int32_t k;
-    double p1;
-    double p2;
-    double u;
-
-    /* Component 1 */
-    p1 = a12 * m_currentState[1] - a13n * m_currentState[0];
-    k = static_cast<int32_t>(p1 / m1);
-    p1 -= k * m1;
-    if (p1 < 0.0)
+    while (n > 0 && m_next < CACHE_SIZE)
     {
-        p1 += m1;
+        *values++ = m_cache[m_next++];
+        --n;
     }
-    m_currentState[0] = m_currentState[1];
-    m_currentState[1] = m_currentState[2];
-    m_currentState[2] = p1;
-
-    /* Component 2 */
-    p2 = a21 * m_currentState[5] - a23n * m_currentState[3];
-    k = static_cast<int32_t>(p2 / m2);
-    p2 -= k * m2;
-    if (p2 < 0.0)
+    Generate(values, n);
+}
+
+void
+RngStream::Generate(double* values, std::size_t n)
+{
+    // The state is kept in locals, so that it stays in registers.
+    double s10 = m_currentState[0];
+    double s11 = m_currentState[1];
+    double s12 = m_currentState[2];
+    double s20 = m_currentState[3];
+    double s21 = m_currentState[4];
+    double s22 = m_currentState[5];
+
+    for (std::size_t i = 0; i < n; ++i)
     {
-        p2 += m2;
-    }
-    m_currentState[3] = m_currentState[4];
-    m_currentState[4] = m_currentState[5];
-    m_currentState[5] = p2;
+        int32_t k;
+
+        /* Component 1 */
+        double p1 = a12 * s11 - a13n * s10;
+        k = static_cast<int32_t>(p1 / m1);
+        p1 -= k * m1;
+        if (p1 < 0.0)
+        {
+            p1 += m1;
+        }
+        s10 = s11;
+        s11 = s12;
+        s12 = p1;
+
+        /* Component 2 */
+        double p2 = a21 * s22 - a23n * s20;
+        k = static_cast<int32_t>(p2 / m2);
+        p2 -= k * m2;
+        if (p2 < 0.0)
+        {
+            p2 += m2;
+        }
+        s20 = s21;
+        s21 = s22;
+        s22 = p2;
 
-    /* Combination */
-    u = ((p1 > p2) ? (p1 - p2) * MRG32k3a::norm : (p1 - p2 + m1) * MRG32k3a::norm);
+        /* Combination */
+        values[i] = ((p1 > p2) ? (p1 - p2) * MRG32k3a::norm : (p1 - p2 + m1) * MRG32k3a::norm);
+    }
 
-    return u;
+    m_currentState[0] = s10;
+    m_currentState[1] = s11;
+    m_currentState[2] = s12;
+    m_currentState[3] = s20;
+    m_currentState[4] = s21;
+    m_currentState[5] = s22;
 }
 
 RngStream::RngStream(uint32_t seedNumber, uint64_t stream, uint64_t substream)
+    : m_next(CACHE_SIZE)
 {
     if (seedNumber >= m1 || seedNumber >= m2 || seedNumber == 0)
     {
@@ -379,11 +404,16 @@ RngStream::RngStream(uint32_t seedNumber, uint64_t stream, uint64_t substream)
 }
 
 RngStream::RngStream(const RngStream& r)
+    : m_next(r.m_next)
 {
     for (int i = 0; i < 6; ++i)
     {
         m_currentState[i] = r.m_currentState[i];
     }
+    for (std::size_t i = m_next; i < CACHE_SIZE; ++i)
+    {
+        m_cache[i] = r.m_cache[i];
+    }
 }
 
 void
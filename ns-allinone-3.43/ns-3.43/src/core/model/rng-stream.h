@@ -7,6 +7,7 @@
 
 #ifndef RNGSTREAM_H
 #define RNGSTREAM_H
+#include <cstddef>
 #include <stdint.h>
 #include <string>
 
@@ -34,6 +35,11 @@ namespace ns3
  * holds a static instance of this class.  The details of this
  * class are explained in:
  * http://www.iro.umontreal.ca/~lecuyer/myftp/papers/streams00.pdf
+ *
+ * The randoms are generated in blocks, with the state in registers,
+ * into a small cache from which RandU01() returns them one by one.
+ * RandU01(double*,std::size_t) fills a whole buffer in one call.
+ * Both return the same sequence as a generation one by one.
  */
 class RngStream
 {
@@ -60,7 +66,24 @@ class RngStream
      */
     double RandU01();
 
+    /**
+     * Fill a buffer with the next random numbers of this stream,
+     * in the order RandU01() would return them.
+     *
+     * \param [out] values The buffer to fill.
+     * \param [in] n The number of randoms.
+     */
+    void RandU01(double* values, std::size_t n);
+
   private:
+    /**
+     * Generate the next random numbers from the state.
+     *
+     * \param [out] values The buffer to fill.
+     * \param [in] n The number of randoms.
+     */
+    void Generate(double* values, std::size_t n);
+
     /**
      * Advance \pname{state} of the RNG by leaps and bounds.
      *
@@ -72,8 +95,30 @@ class RngStream
 
     /** The RNG state vector. */
     double m_currentState[6];
+
+    /** The number of randoms generated in advance. */
+    static constexpr std::size_t CACHE_SIZE = 16;
+    /** The randoms generated in advance. */
+    double m_cache[CACHE_SIZE];
+    /** The index of the next random of the cache. */
+    std::size_t m_next;
 };
 
+/*************************************************
+ **  Inline implementations
+ ************************************************/
+
+inline double
+RngStream::RandU01()
+{
+    if (m_next == CACHE_SIZE) [[unlikely]]
+    {
+        Generate(m_cache, CACHE_SIZE);
+        m_next = 0;
+    }
+    return m_cache[m_next++];
+}
+
 } // namespace ns3
 
 #endif
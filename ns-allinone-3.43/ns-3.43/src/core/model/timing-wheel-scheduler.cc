@@ -0,0 +1,307 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "timing-wheel-scheduler.h"
+
+#include "assert.h"
+#include "event-impl.h"
+#include "log.h"
+
+#include <algorithm>
+#include <bit>
+
+/**
+ * \file
+ * \ingroup scheduler
+ * ns3::TimingWheelScheduler implementation.
+ */
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("TimingWheelScheduler");
+
+NS_OBJECT_ENSURE_REGISTERED(TimingWheelScheduler);
+
+/** Removed events below which the wheel is never compacted. */
+static const std::size_t MIN_COMPACT = 1024;
+
+TypeId
+TimingWheelScheduler::GetTypeId()
+{
+    static TypeId tid = TypeId("ns3::TimingWheelScheduler")
+                            .SetParent<Scheduler>()
+                            .SetGroupName("Core")
+                            .AddConstructor<TimingWheelScheduler>();
+    return tid;
+}
+
+TimingWheelScheduler::TimingWheelScheduler()
+    : m_occupied{},
+      m_now(0),
+      m_head(0),
+      m_current(SLOTS),
+      m_size(0)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+TimingWheelScheduler::~TimingWheelScheduler()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+TimingWheelScheduler::Place(const Event& ev)
+{
+    uint64_t diff = ev.key.m_ts ^ m_now;
+    if (diff >> WHEEL_BITS)
+    {
+        m_overflow.insert(std::make_pair(ev.key, ev.impl));
+        return;
+    }
+
+    uint32_t level = diff ? (std::bit_width(diff) - 1) / DIGIT_BITS : 0;
+    uint32_t index = (ev.key.m_ts >> (level * DIGIT_BITS)) & (SLOTS - 1);
+    Slot& slot = m_slots[level][index];
+    m_occupied[level] |= uint64_t(1) << index;
+    if (level != 0 || index != m_current)
+    {
+        slot.push_back(ev);
+        return;
+    }
+
+    // The current slot is already sorted, and its first m_head events returned
+    std::size_t position = slot.size();
+    while (position > m_head && ev.key < slot[position - 1].key)
+    {
+        position--;
+    }
+    slot.insert(slot.begin() + position, ev);
+}
+
+void
+TimingWheelScheduler::Insert(const Event& ev)
+{
+    NS_LOG_FUNCTION(this << ev.impl << ev.key.m_ts << ev.key.m_uid);
+    m_size++;
+    if (ev.key.m_ts < m_now)
+    {
+        m_early.insert(std::make_pair(ev.key, ev.impl));
+        return;
+    }
+    Place(ev);
+}
+
+bool
+TimingWheelScheduler::IsEmpty() const
+{
+    NS_LOG_FUNCTION(this);
+    return m_size == 0;
+}
+
+bool
+TimingWheelScheduler::DropIfRemoved(const EventKey& key)
+{
+    return !m_removed.empty() && m_removed.erase(key) > 0;
+}
+
+void
+TimingWheelScheduler::Cascade(uint32_t level)
+{
+    NS_LOG_FUNCTION(this << level);
+    auto index = static_cast<uint32_t>(std::countr_zero(m_occupied[level]));
+    uint32_t shift = level * DIGIT_BITS;
+
+    // The current time moves to the start of the slot, which keeps the
+    // higher digits and makes the events of the slot differ in lower ones
+    uint64_t higher = m_now >> (shift + DIGIT_BITS) << (shift + DIGIT_BITS);
+    m_now = higher | (uint64_t(index) << shift);
+    m_head = 0;
+
+    m_cascade.swap(m_slots[level][index]);
+    m_occupied[level] &= ~(uint64_t(1) << index);
+    for (const auto& ev : m_cascade)
+    {
+        if (!DropIfRemoved(ev.key))
+        {
+            Place(ev);
+        }
+    }
+    m_cascade.clear();
+}
+
+void
+TimingWheelScheduler::Refill()
+{
+    NS_LOG_FUNCTION(this);
+    NS_ASSERT(!m_overflow.empty());
+    m_now = m_overflow.begin()->first.m_ts;
+    m_head = 0;
+    auto end = m_overflow.begin();
+    while (end != m_overflow.end() && ((end->first.m_ts ^ m_now) >> WHEEL_BITS) == 0)
+    {
+        Place(Event{end->second, end->first});
+        ++end;
+    }
+    m_overflow.erase(m_overflow.begin(), end);
+}
+
+void
+TimingWheelScheduler::Settle()
+{
+    while (true)
+    {
+        if (m_occupied[0])
+        {
+            auto index = static_cast<uint32_t>(std::countr_zero(m_occupied[0]));
+            Slot& slot = m_slots[0][index];
+            if (index != m_current)
+            {
+                // Level 0 slots hold a single timestamp, the next one becomes
+                // the current time, and its events are sorted by uid
+                std::sort(slot.begin(), slot.end(), [](const Event& a, const Event& b) {
+                    return a.key < b.key;
+                });
+                m_now = (m_now & ~uint64_t(SLOTS - 1)) | index;
+                m_current = index;
+                m_head = 0;
+            }
+            while (m_head < slot.size() && DropIfRemoved(slot[m_head].key))
+            {
+                m_head++;
+            }
+            if (m_head < slot.size())
+            {
+                return;
+            }
+            slot.clear();
+            m_head = 0;
+            m_current = SLOTS;
+            m_occupied[0] &= ~(uint64_t(1) << index);
+            continue;
+        }
+
+        uint32_t level = 1;
+        while (level < LEVELS && !m_occupied[level])
+        {
+            level++;
+        }
+        if (level < LEVELS)
+        {
+            Cascade(level);
+        }
+        else
+        {
+            Refill();
+        }
+    }
+}
+
+Scheduler::Event
+TimingWheelScheduler::PeekNext() const
+{
+    NS_LOG_FUNCTION(this);
+    NS_ASSERT(m_size > 0);
+    if (!m_early.empty())
+    {
+        return Event{m_early.begin()->second, m_early.begin()->first};
+    }
+
+    // Moving the wheel to its next event does not change the pending events
+    auto self = const_cast<TimingWheelScheduler*>(this);
+    self->Settle();
+    const Event& ev = m_slots[0][m_current][m_head];
+    NS_LOG_DEBUG(this << ": " << ev.impl << ", " << ev.key.m_ts << ", " << ev.key.m_uid);
+    return ev;
+}
+
+Scheduler::Event
+TimingWheelScheduler::RemoveNext()
+{
+    NS_LOG_FUNCTION(this);
+    NS_ASSERT(m_size > 0);
+    m_size--;
+    if (!m_early.empty())
+    {
+        Event ev{m_early.begin()->second, m_early.begin()->first};
+        m_early.erase(m_early.begin());
+        return ev;
+    }
+
+    Settle();
+    uint32_t index = m_current;
+    Slot& slot = m_slots[0][index];
+    Event ev = slot[m_head++];
+    if (m_head == slot.size())
+    {
+        slot.clear();
+        m_head = 0;
+        m_current = SLOTS;
+        m_occupied[0] &= ~(uint64_t(1) << index);
+    }
+    NS_LOG_DEBUG("@" << this << ": " << ev.impl << ", " << ev.key.m_ts << ", " << ev.key.m_uid);
+    return ev;
+}
+
+void
+TimingWheelScheduler::Remove(const Event& ev)
+{
+    NS_LOG_FUNCTION(this << ev.impl << ev.key.m_ts << ev.key.m_uid);
+    NS_ASSERT(m_size > 0);
+    m_size--;
+    if (ev.key.m_ts < m_now)
+    {
+        auto i = m_early.find(ev.key);
+        NS_ASSERT(i != m_early.end() && i->second == ev.impl);
+        m_early.erase(i);
+        return;
+    }
+    if ((ev.key.m_ts ^ m_now) >> WHEEL_BITS)
+    {
+        auto i = m_overflow.find(ev.key);
+        NS_ASSERT(i != m_overflow.end() && i->second == ev.impl);
+        m_overflow.erase(i);
+        return;
+    }
+
+    [[maybe_unused]] bool inserted = m_removed.insert(ev.key).second;
+    NS_ASSERT(inserted);
+    if (m_removed.size() > MIN_COMPACT && m_removed.size() > m_size)
+    {
+        Compact();
+    }
+}
+
+void
+TimingWheelScheduler::Compact()
+{
+    NS_LOG_FUNCTION(this << m_removed.size() << m_size);
+    for (uint32_t level = 0; level < LEVELS; level++)
+    {
+        for (uint64_t occupied = m_occupied[level]; occupied; occupied &= occupied - 1)
+        {
+            auto index = static_cast<uint32_t>(std::countr_zero(occupied));
+            Slot& slot = m_slots[level][index];
+            if (level == 0 && index == m_current)
+            {
+                slot.erase(slot.begin(), slot.begin() + m_head);
+                m_head = 0;
+            }
+            std::erase_if(slot, [this](const Event& ev) { return m_removed.count(ev.key) > 0; });
+            if (slot.empty())
+            {
+                m_occupied[level] &= ~(uint64_t(1) << index);
+                if (level == 0 && index == m_current)
+                {
+                    m_current = SLOTS;
+                }
+            }
+        }
+    }
+    // Removed events are only kept while they are in the wheel
+    m_removed.clear();
+}
+
+} // namespace ns3
@@ -0,0 +1,207 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef TIMING_WHEEL_SCHEDULER_H
+#define TIMING_WHEEL_SCHEDULER_H
+
+#include "scheduler.h"
+
+#include <array>
+#include <map>
+#include <stdint.h>
+#include <unordered_set>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup scheduler
+ * ns3::TimingWheelScheduler declaration.
+ */
+
+namespace ns3
+{
+
+class EventImpl;
+
+/**
+ * \ingroup scheduler
+ * \brief a hierarchical timing wheel event scheduler
+ *
+ * This event scheduler is a hierarchical timing wheel, as described in
+ * ["Hashed and Hierarchical Timing Wheels" by George Varghese and Tony
+ * Lauck][Varghese], with the placement rule of the Linux timer wheel.
+ *
+ * [Varghese]: https://doi.org/10.1145/41457.37504 "Varghese"
+ *
+ * The wheel has 8 levels of 64 slots. Timestamps are read as 6 bit digits:
+ * an event goes to the level of the highest digit where its timestamp
+ * differs from the current time of the wheel, in the slot given by that
+ * digit of its timestamp. Slots of level 0 hold a single timestamp each,
+ * slots of level \f$ l \f$ cover \f$ 64^l \f$ time steps: with the default
+ * nanosecond resolution a slot covers 64 ns at level 1, 262 us at level 3,
+ * 1.07 s at level 5 and 73 minutes at level 7. Every level keeps a bitmap
+ * of its occupied slots, so the next slot is found with one bit scan.
+ *
+ * When level 0 runs out of events, the wheel moves its current time to the
+ * next occupied slot of the lowest occupied level, and redistributes the
+ * events of that slot to the levels below. An event is redistributed at most
+ * once per level, so dense near-term events (transmissions, receptions) go
+ * straight to level 0 and far timers (retransmission timeouts) are only moved
+ * a few times, whatever the number of pending events.
+ *
+ * Events beyond the reach of the wheel (more than \f$ 2^{48} \f$ time steps
+ * away) wait in an overflow std::map until the wheel gets to them. Events
+ * inserted before the current time of the wheel, which can only happen after
+ * PeekNext() advanced it, go to a second std::map served before the wheel.
+ *
+ * Remove() marks an event as removed in a hash set, and the event is
+ * dropped when the wheel reaches it. The wheel is compacted when the
+ * removed events outnumber the pending ones, so cancelled timers never
+ * hold more memory than the live events.
+ *
+ * Events are appended to their slot. When the wheel gets to a level 0 slot,
+ * which holds simultaneous events, it sorts the slot by uid; later events for
+ * that slot are inserted in order, walking the slot back from its end.
+ *
+ * \par Time Complexity
+ *
+ * Operation    | Amortized %Time | Reason
+ * :----------- | :-------------- | :-----
+ * Insert()     | Constant        | Append to a slot
+ * IsEmpty()    | Constant        | Explicit queue size
+ * PeekNext()   | Constant        | Bit scan; at most 8 moves per event; sort of simultaneous events
+ * Remove()     | Constant        | Hash set insertion; compaction
+ * RemoveNext() | Constant        | Bit scan; at most 8 moves per event; sort of simultaneous events
+ *
+ * \par Memory Complexity
+ *
+ * Category  | Memory                           | Reason
+ * :-------- | :------------------------------- | :-----
+ * Overhead  | 512 x `std::vector`<br/>(12 kB)  | slots of the levels
+ * Per Event | `sizeof (Event)`<br/>(24 bytes)  | `std::vector`
+ */
+class TimingWheelScheduler : public Scheduler
+{
+  public:
+    /**
+     *  Register this type.
+     *  \return The object TypeId.
+     */
+    static TypeId GetTypeId();
+
+    /** Constructor. */
+    TimingWheelScheduler();
+    /** Destructor. */
+    ~TimingWheelScheduler() override;
+
+    // Inherited
+    void Insert(const Scheduler::Event& ev) override;
+    bool IsEmpty() const override;
+    Scheduler::Event PeekNext() const override;
+    Scheduler::Event RemoveNext() override;
+    void Remove(const Scheduler::Event& ev) override;
+
+  private:
+    /** Bits of a timestamp digit. */
+    static constexpr uint32_t DIGIT_BITS = 6;
+    /** Slots per level. */
+    static constexpr uint32_t SLOTS = 1 << DIGIT_BITS;
+    /** Number of levels. */
+    static constexpr uint32_t LEVELS = 8;
+    /** Bits of the timestamps covered by the wheel. */
+    static constexpr uint32_t WHEEL_BITS = DIGIT_BITS * LEVELS;
+
+    /** A slot: events in insertion order, or in uid order for the current slot. */
+    typedef std::vector<Scheduler::Event> Slot;
+    /** Events outside of the wheel, in order. */
+    typedef std::map<Scheduler::EventKey, EventImpl*> EventMap;
+
+    /** Hash of an EventKey, on its timestamp and uid. */
+    struct KeyHash
+    {
+        /**
+         * \param [in] key The key.
+         * \returns The hash of the key.
+         */
+        std::size_t operator()(const Scheduler::EventKey& key) const
+        {
+            return std::hash<uint64_t>()(key.m_ts * 0x9e3779b97f4a7c15ULL ^ key.m_uid);
+        }
+    };
+
+    /** Equality of EventKeys, on their timestamp and uid. */
+    struct KeyEqual
+    {
+        /**
+         * \param [in] a The first key.
+         * \param [in] b The second key.
+         * \returns \c true if the keys are equal.
+         */
+        bool operator()(const Scheduler::EventKey& a, const Scheduler::EventKey& b) const
+        {
+            return a.m_ts == b.m_ts && a.m_uid == b.m_uid;
+        }
+    };
+
+    /**
+     * Put an event of the wheel or of the overflow in its slot, according
+     * to the current time of the wheel.
+     *
+     * \param [in] ev The event, not before the current time of the wheel.
+     */
+    void Place(const Scheduler::Event& ev);
+    /**
+     * Move the wheel until the first event of the first slot of level 0 is
+     * the next event of the wheel, dropping removed events on the way.
+     * There must be a pending event in the wheel or in the overflow.
+     */
+    void Settle();
+    /**
+     * Move the events of the first occupied slot of a level to the levels
+     * below, after moving the current time of the wheel to that slot.
+     *
+     * \param [in] level The level, with at least one occupied slot.
+     */
+    void Cascade(uint32_t level);
+    /**
+     * Move the current time of the wheel to the first event of the
+     * overflow, and the events of the overflow the wheel now reaches to
+     * the wheel.
+     */
+    void Refill();
+    /**
+     * Check if an event was removed, and forget it if so.
+     *
+     * \param [in] key The key of the event.
+     * \returns \c true if the event was removed.
+     */
+    bool DropIfRemoved(const Scheduler::EventKey& key);
+    /** Drop the removed events from every slot. */
+    void Compact();
+
+    /** Slots of every level. */
+    std::array<std::array<Slot, SLOTS>, LEVELS> m_slots;
+    /** Occupied slots of every level, one bit per slot. */
+    std::array<uint64_t, LEVELS> m_occupied;
+    /** Current time of the wheel, not after any event of the wheel. */
+    uint64_t m_now;
+    /** Events already returned by RemoveNext() from the current slot. */
+    std::size_t m_head;
+    /** Sorted level 0 slot of m_now, or SLOTS if the wheel did not get to it yet. */
+    uint32_t m_current;
+    /** Events before the current time of the wheel. */
+    EventMap m_early;
+    /** Events beyond the reach of the wheel. */
+    EventMap m_overflow;
+    /** Removed events still in the wheel. */
+    std::unordered_set<Scheduler::EventKey, KeyHash, KeyEqual> m_removed;
+    /** Buffer of the events of a slot being redistributed. */
+    Slot m_cascade;
+    /** Number of pending events. */
+    uint32_t m_size;
+};
+
+} // namespace ns3
+
+#endif /* TIMING_WHEEL_SCHEDULER_H */
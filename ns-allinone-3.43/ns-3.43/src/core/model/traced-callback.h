@@ -11,7 +11,8 @@
 
 #include "callback.h"
 
-#include <list>
+#include <algorithm>
+#include <vector>
 
 /**
  * \file
@@ -36,6 +37,14 @@ namespace ns3
  * calling the \c operator() form with the appropriate
  * number of arguments.
  *
+ * The models invoke their TracedCallbacks whether or not a sink is
+ * connected, so invoking an empty chain is an inlined test.
+ *
+ * A Callback may connect or disconnect Callbacks while the chain is
+ * invoked. A Callback connected during the invocation is called by the
+ * same invocation, and a Callback disconnected during the invocation is
+ * not called anymore by it.
+ *
  * \tparam Ts \explicit Types of the functor arguments.
  */
 template <typename... Ts>
@@ -75,10 +84,16 @@ class TracedCallback
     void Disconnect(const CallbackBase& callback, std::string path);
     /**
      * \brief Functor which invokes the chain of Callbacks.
-     * \tparam Ts \deduced Types of the functor arguments.
      * \param [in] args The arguments to the functor
      */
-    void operator()(Ts... args) const;
+    void operator()(Ts... args) const
+    {
+        if (m_callbackList.empty()) [[likely]]
+        {
+            return;
+        }
+        DoInvoke(args...);
+    }
     /**
      * \brief Checks if the Callbacks list is empty.
      * \return true if the Callbacks list is empty.
@@ -97,14 +112,28 @@ class TracedCallback
     /**@}*/
 
   private:
+    /**
+     * Invoke the chain of Callbacks, once it is known to be non-empty.
+     *
+     * \param [in] args The arguments to the functor
+     */
+    void DoInvoke(const Ts&... args) const;
+
     /**
      * Container type for holding the chain of Callbacks.
      *
+     * The chain is short and changes seldom, so it is kept contiguous
+     * to be walked without chasing list nodes.
+     *
      * \tparam Ts \deduced Types of the functor arguments.
      */
-    typedef std::list<Callback<void, Ts...>> CallbackList;
+    typedef std::vector<Callback<void, Ts...>> CallbackList;
     /** The chain of Callbacks. */
     CallbackList m_callbackList;
+    /** The depth of the invocations of the chain in progress. */
+    mutable uint32_t m_invoking;
+    /** Whether Callbacks were disconnected during an invocation. */
+    bool m_disconnected;
 };
 
 } // namespace ns3
@@ -118,7 +147,9 @@ namespace ns3
 
 template <typename... Ts>
 TracedCallback<Ts...>::TracedCallback()
-    : m_callbackList()
+    : m_callbackList(),
+      m_invoking(0),
+      m_disconnected(false)
 {
 }
 
@@ -151,16 +182,24 @@ template <typename... Ts>
 void
 TracedCallback<Ts...>::DisconnectWithoutContext(const CallbackBase& callback)
 {
+    // While the chain is invoked, the disconnected Callbacks are only
+    // nullified, so that the invocation does not skip the next ones.
     for (auto i = m_callbackList.begin(); i != m_callbackList.end(); /* empty */)
     {
-        if ((*i).IsEqual(callback))
+        if (i->IsNull() || !i->IsEqual(callback))
         {
-            i = m_callbackList.erase(i);
+            i++;
         }
-        else
+        else if (m_invoking > 0)
         {
+            i->Nullify();
+            m_disconnected = true;
             i++;
         }
+        else
+        {
+            i = m_callbackList.erase(i);
+        }
     }
 }
 
@@ -179,11 +218,24 @@ TracedCallback<Ts...>::Disconnect(const CallbackBase& callback, std::string path
 
 template <typename... Ts>
 void
-TracedCallback<Ts...>::operator()(Ts... args) const
+TracedCallback<Ts...>::DoInvoke(const Ts&... args) const
 {
-    for (auto i = m_callbackList.begin(); i != m_callbackList.end(); i++)
+    // A Callback may connect another one to this chain, so the chain is
+    // walked by index rather than by iterator.
+    m_invoking++;
+    for (std::size_t i = 0; i < m_callbackList.size(); i++)
+    {
+        if (!m_callbackList[i].IsNull())
+        {
+            m_callbackList[i](args...);
+        }
+    }
+    m_invoking--;
+    if (m_invoking == 0 && m_disconnected)
     {
-        (*i)(args...);
+        auto self = const_cast<TracedCallback<Ts...>*>(this);
+        std::erase_if(self->m_callbackList, [](const auto& cb) { return cb.IsNull(); });
+        self->m_disconnected = false;
     }
 }
 
@@ -191,7 +243,9 @@ template <typename... Ts>
 bool
 TracedCallback<Ts...>::IsEmpty() const
 {
-    return m_callbackList.empty();
+    return std::none_of(m_callbackList.begin(), m_callbackList.end(), [](const auto& cb) {
+        return !cb.IsNull();
+    });
 }
 
 } // namespace ns3
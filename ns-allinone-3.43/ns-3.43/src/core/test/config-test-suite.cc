@@ -10,6 +10,7 @@
 #include "ns3/integer.h"
 #include "ns3/log.h"
 #include "ns3/names.h"
+#include "ns3/object-map.h"
 #include "ns3/object-vector.h"
 #include "ns3/object.h"
 #include "ns3/pointer.h"
@@ -18,6 +19,7 @@
 #include "ns3/trace-source-accessor.h"
 #include "ns3/traced-value.h"
 
+#include <map>
 #include <sstream>
 
 /**
@@ -853,6 +855,141 @@ SearchAttributesOfParentObjectsTestCase::DoRun()
     NS_TEST_ASSERT_MSG_EQ(iv.Get(), 42, "Object Attribute \"X\" not settable in derived class");
 }
 
+/**
+ * \ingroup config-tests
+ * An object with containers of many objects.
+ */
+class ConfigTestContainer : public Object
+{
+  public:
+    /**
+     * \brief Get the type ID.
+     * \return the object TypeId
+     */
+    static TypeId GetTypeId();
+
+    std::vector<Ptr<ConfigTestObject>> m_items;             //!< Items attribute target.
+    std::map<std::size_t, Ptr<ConfigTestObject>> m_itemMap; //!< ItemMap attribute target.
+};
+
+TypeId
+ConfigTestContainer::GetTypeId()
+{
+    static TypeId tid = TypeId("ConfigTestContainer")
+                            .SetParent<Object>()
+                            .AddAttribute("Items",
+                                          "",
+                                          ObjectVectorValue(),
+                                          MakeObjectVectorAccessor(&ConfigTestContainer::m_items),
+                                          MakeObjectVectorChecker<ConfigTestObject>())
+                            .AddAttribute("ItemMap",
+                                          "",
+                                          ObjectMapValue(),
+                                          MakeObjectMapAccessor(&ConfigTestContainer::m_itemMap),
+                                          MakeObjectMapChecker<ConfigTestObject>());
+    return tid;
+}
+
+/**
+ * \ingroup config-tests
+ * Test the matches of the indices of large containers, and Config::Resolve.
+ */
+class ResolveConfigTestCase : public TestCase
+{
+  public:
+    /** Constructor. */
+    ResolveConfigTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Get the matched paths of a path.
+     *
+     * \param [in] path The path.
+     * \returns The matched paths, separated by spaces.
+     */
+    static std::string Match(std::string path);
+};
+
+ResolveConfigTestCase::ResolveConfigTestCase()
+    : TestCase("Check the matches of the indices of containers and Config::Resolve")
+{
+}
+
+std::string
+ResolveConfigTestCase::Match(std::string path)
+{
+    Config::MatchContainer matches = Config::LookupMatches(path);
+    std::string paths;
+    for (std::size_t i = 0; i < matches.GetN(); ++i)
+    {
+        paths += (i == 0 ? "" : " ") + matches.GetMatchedPath(i);
+    }
+    return paths;
+}
+
+void
+ResolveConfigTestCase::DoRun()
+{
+    Ptr<ConfigTestContainer> root = CreateObject<ConfigTestContainer>();
+    Config::RegisterRootNamespaceObject(root);
+    for (std::size_t i = 0; i < 100; ++i)
+    {
+        root->m_items.push_back(CreateObject<ConfigTestObject>());
+    }
+    root->m_itemMap[7] = CreateObject<ConfigTestObject>();
+    root->m_itemMap[500] = CreateObject<DerivedConfigTestObject>();
+    root->m_itemMap[501] = CreateObject<ConfigTestObject>();
+
+    //
+    // The indices are matched in increasing order, by position in the vector.
+    //
+    NS_TEST_EXPECT_MSG_EQ(Match("/Items/5"), "/Items/5/", "Wrong match of an index");
+    NS_TEST_EXPECT_MSG_EQ(Match("/Items/12|[10-11]|3|10"),
+                          "/Items/3/ /Items/10/ /Items/11/ /Items/12/",
+                          "Wrong match of a list of indices");
+    NS_TEST_EXPECT_MSG_EQ(Match("/Items/[98-200]"),
+                          "/Items/98/ /Items/99/",
+                          "Wrong match of a range beyond the vector");
+    NS_TEST_EXPECT_MSG_EQ(Match("/Items/100"), "", "Unexpected match beyond the vector");
+    NS_TEST_EXPECT_MSG_EQ(Match("/Items/[3-1]"), "", "Unexpected match of an empty range");
+    NS_TEST_EXPECT_MSG_EQ(Config::LookupMatches("/Items/*").GetN(),
+                          100,
+                          "Wrong number of matches of *");
+
+    //
+    // The indices of the map are not their positions.
+    //
+    NS_TEST_EXPECT_MSG_EQ(Match("/ItemMap/500|7"),
+                          "/ItemMap/7/ /ItemMap/500/",
+                          "Wrong match of the map keys");
+    NS_TEST_EXPECT_MSG_EQ(Match("/ItemMap/1"), "", "Unexpected match of a map position");
+    NS_TEST_EXPECT_MSG_EQ(Match("/ItemMap/[0-1000]"),
+                          "/ItemMap/7/ /ItemMap/500/ /ItemMap/501/",
+                          "Wrong match of the map keys in a range");
+
+    //
+    // A path matched again sees the objects added since.
+    //
+    root->m_items.push_back(CreateObject<ConfigTestObject>());
+    NS_TEST_EXPECT_MSG_EQ(Match("/Items/100"), "/Items/100/", "Added object not matched");
+
+    //
+    // Config::Resolve gets the objects of a type, in the order of the matches.
+    //
+    std::vector<Ptr<ConfigTestObject>> items =
+        Config::Resolve<ConfigTestObject>("/Items/[0-2]|100");
+    NS_TEST_ASSERT_MSG_EQ(items.size(), 4, "Wrong number of resolved objects");
+    NS_TEST_EXPECT_MSG_EQ(items[1], root->m_items[1], "Wrong resolved object");
+    NS_TEST_EXPECT_MSG_EQ(items[3], root->m_items[100], "Wrong resolved object");
+    NS_TEST_EXPECT_MSG_EQ(Config::Resolve<DerivedConfigTestObject>("/ItemMap/*").size(),
+                          1,
+                          "Objects of another type not left out");
+
+    Config::UnregisterRootNamespaceObject(root);
+}
+
 /**
  * \ingroup config-tests
  * The Test Suite that glues all of the Test Cases together.
@@ -871,6 +1008,7 @@ ConfigTestSuite::ConfigTestSuite()
     AddTestCase(new UnderRootNamespaceConfigTestCase);
     AddTestCase(new ObjectVectorConfigTestCase);
     AddTestCase(new SearchAttributesOfParentObjectsTestCase);
+    AddTestCase(new ResolveConfigTestCase);
 }
 
 /**
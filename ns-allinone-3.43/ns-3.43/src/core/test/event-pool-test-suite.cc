@@ -0,0 +1,182 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/event-impl.h"
+#include "ns3/event-pool.h"
+#include "ns3/make-event.h"
+#include "ns3/simulator.h"
+#include "ns3/test.h"
+
+#include <thread>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup core-tests
+ * \ingroup events
+ * \ingroup event-pool-tests
+ * EventPool test suite.
+ */
+
+/**
+ * \ingroup core-tests
+ * \defgroup event-pool-tests EventPool test suite
+ */
+
+namespace ns3
+{
+
+namespace tests
+{
+
+/**
+ * \ingroup event-pool-tests
+ * Released events are reused by the next events of the same size class.
+ */
+class EventPoolReuseTestCase : public TestCase
+{
+  public:
+    /** Constructor. */
+    EventPoolReuseTestCase();
+
+  private:
+    void DoRun() override;
+
+    /** Event function, never invoked. */
+    static void Nothing();
+};
+
+EventPoolReuseTestCase::EventPoolReuseTestCase()
+    : TestCase("Released events are reused")
+{
+}
+
+void
+EventPoolReuseTestCase::Nothing()
+{
+}
+
+void
+EventPoolReuseTestCase::DoRun()
+{
+    if (!EventPool::IsEnabled())
+    {
+        return;
+    }
+
+    EventImpl* first = MakeEvent(&EventPoolReuseTestCase::Nothing);
+    first->Unref();
+    EventPool::Stats before = EventPool::GetStats();
+
+    EventImpl* second = MakeEvent(&EventPoolReuseTestCase::Nothing);
+    NS_TEST_EXPECT_MSG_EQ(second, first, "The released event was not reused");
+    EventImpl* third = MakeEvent(&EventPoolReuseTestCase::Nothing);
+    NS_TEST_EXPECT_MSG_NE(third, second, "Two live events share their memory");
+    second->Unref();
+    third->Unref();
+
+    EventPool::Stats after = EventPool::GetStats();
+    NS_TEST_EXPECT_MSG_EQ(after.allocations - before.allocations, 2, "Wrong allocation count");
+    NS_TEST_EXPECT_MSG_EQ(after.frees - before.frees, 2, "Wrong release count");
+    NS_TEST_EXPECT_MSG_EQ(after.systemAllocations - before.systemAllocations,
+                          0,
+                          "The events did not come from the free list");
+}
+
+/**
+ * \ingroup event-pool-tests
+ * Events scheduled by other threads with Simulator::ScheduleWithContext are
+ * allocated in these threads and released by the main thread.
+ */
+class EventPoolThreadsTestCase : public TestCase
+{
+  public:
+    /** Constructor. */
+    EventPoolThreadsTestCase();
+
+  private:
+    void DoRun() override;
+
+    /** Count an invoked event. */
+    void Count();
+
+    uint32_t m_count{0}; //!< Number of invoked events
+};
+
+EventPoolThreadsTestCase::EventPoolThreadsTestCase()
+    : TestCase("Events scheduled from other threads")
+{
+}
+
+void
+EventPoolThreadsTestCase::Count()
+{
+    m_count++;
+}
+
+void
+EventPoolThreadsTestCase::DoRun()
+{
+    const uint32_t threadCount = 4;
+    const uint32_t eventCount = 10000;
+
+    // Create the simulator in the main thread
+    Simulator::Now();
+    EventPool::Stats before = EventPool::GetStats();
+
+    std::vector<std::thread> threads;
+    for (uint32_t i = 0; i < threadCount; i++)
+    {
+        threads.emplace_back([this, i]() {
+            for (uint32_t j = 0; j < eventCount; j++)
+            {
+                Simulator::ScheduleWithContext(i,
+                                               NanoSeconds(j),
+                                               &EventPoolThreadsTestCase::Count,
+                                               this);
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    Simulator::Run();
+    Simulator::Destroy();
+
+    NS_TEST_EXPECT_MSG_EQ(m_count, threadCount * eventCount, "Events were lost");
+    EventPool::Stats after = EventPool::GetStats();
+    NS_TEST_EXPECT_MSG_EQ(after.allocations - before.allocations,
+                          after.frees - before.frees,
+                          "Events were not released");
+    NS_TEST_EXPECT_MSG_GT_OR_EQ(after.allocations - before.allocations,
+                                threadCount * eventCount,
+                                "Events were not counted");
+}
+
+/**
+ * \ingroup event-pool-tests
+ * EventPool test suite.
+ */
+class EventPoolTestSuite : public TestSuite
+{
+  public:
+    EventPoolTestSuite()
+        : TestSuite("event-pool")
+    {
+        AddTestCase(new EventPoolReuseTestCase());
+        AddTestCase(new EventPoolThreadsTestCase());
+    }
+};
+
+/**
+ * \ingroup event-pool-tests
+ * EventPoolTestSuite instance variable.
+ */
+static EventPoolTestSuite g_eventPoolTestSuite;
+
+} // namespace tests
+
+} // namespace ns3
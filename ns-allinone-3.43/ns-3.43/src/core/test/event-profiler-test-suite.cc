@@ -0,0 +1,331 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/config.h"
+#include "ns3/event-profiler.h"
+#include "ns3/make-event.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/test.h"
+#include "ns3/uinteger.h"
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup core-tests
+ * \ingroup simulator
+ * \ingroup event-profiler-tests
+ * EventProfiler test suite.
+ */
+
+/**
+ * \ingroup core-tests
+ * \defgroup event-profiler-tests EventProfiler test suite
+ */
+
+namespace ns3
+{
+
+namespace tests
+{
+
+/**
+ * \ingroup event-profiler-tests
+ * Base class of a virtual handler.
+ */
+class EventProfilerHandlerBase
+{
+  public:
+    /** Destructor. */
+    virtual ~EventProfilerHandlerBase() = default;
+    /** Virtual handler. */
+    virtual void Handle() = 0;
+};
+
+/**
+ * \ingroup event-profiler-tests
+ * Implementation of a virtual handler.
+ */
+class EventProfilerHandler : public EventProfilerHandlerBase
+{
+  public:
+    void Handle() override;
+
+    uint32_t m_handled{0}; //!< Events run
+};
+
+void
+EventProfilerHandler::Handle()
+{
+    m_handled++;
+}
+
+/**
+ * \ingroup event-profiler-tests
+ * Events run by EventProfilerFunction().
+ */
+uint32_t g_eventProfilerFunctionCount = 0;
+
+/**
+ * \ingroup event-profiler-tests
+ * Event function.
+ */
+void
+EventProfilerFunction()
+{
+    g_eventProfilerFunctionCount++;
+}
+
+/**
+ * \ingroup event-profiler-tests
+ * The events are measured by handler and context.
+ */
+class EventProfilerHandlersTestCase : public TestCase
+{
+  public:
+    /** Constructor. */
+    EventProfilerHandlersTestCase();
+
+  private:
+    void DoRun() override;
+
+    /** First event method. */
+    void First();
+    /** Second event method, with the signature of the first one. */
+    void Second();
+
+    /**
+     * Invoke and release an event.
+     *
+     * \param [in] profiler The profiler.
+     * \param [in] event The event.
+     * \param [in] context The context of the event.
+     */
+    static void Invoke(EventProfiler& profiler, EventImpl* event, uint32_t context);
+
+    /**
+     * Find the measurements of a handler.
+     *
+     * \param [in] records The measurements.
+     * \param [in] context The context of the handler.
+     * \param [in] name The name of the handler.
+     * \returns The number of events measured.
+     */
+    static uint64_t Count(const std::vector<EventProfiler::Record>& records,
+                          uint32_t context,
+                          const std::string& name);
+
+    uint32_t m_first{0};  //!< Events run by First()
+    uint32_t m_second{0}; //!< Events run by Second()
+};
+
+EventProfilerHandlersTestCase::EventProfilerHandlersTestCase()
+    : TestCase("The events are measured by handler and context")
+{
+}
+
+void
+EventProfilerHandlersTestCase::First()
+{
+    m_first++;
+}
+
+void
+EventProfilerHandlersTestCase::Second()
+{
+    // Not folded with First() by the compiler.
+    m_second += 2;
+}
+
+void
+EventProfilerHandlersTestCase::Invoke(EventProfiler& profiler, EventImpl* event, uint32_t context)
+{
+    profiler.Invoke(event, context);
+    event->Unref();
+}
+
+uint64_t
+EventProfilerHandlersTestCase::Count(const std::vector<EventProfiler::Record>& records,
+                                     uint32_t context,
+                                     const std::string& name)
+{
+    uint64_t count = 0;
+    for (const auto& record : records)
+    {
+        if (record.context == context && record.handler.find(name) != std::string::npos)
+        {
+            count += record.count;
+        }
+    }
+    return count;
+}
+
+void
+EventProfilerHandlersTestCase::DoRun()
+{
+    EventProfiler profiler(1);
+    EventProfilerHandler handler;
+    EventProfilerHandlerBase* base = &handler;
+
+    for (uint32_t i = 0; i < 3; ++i)
+    {
+        Invoke(profiler, MakeEvent(&EventProfilerHandlersTestCase::First, this), 1);
+    }
+    Invoke(profiler, MakeEvent(&EventProfilerHandlersTestCase::First, this), 2);
+    Invoke(profiler, MakeEvent(&EventProfilerHandlersTestCase::Second, this), 1);
+    Invoke(profiler, MakeEvent(&EventProfilerHandlerBase::Handle, base), 1);
+    Invoke(profiler, MakeEvent(&EventProfilerFunction), 1);
+    EventImpl* cancelled = MakeEvent(&EventProfilerHandlersTestCase::First, this);
+    cancelled->Cancel();
+    Invoke(profiler, cancelled, 1);
+
+    NS_TEST_EXPECT_MSG_EQ(m_first, 4, "Wrong number of events run");
+
+    auto records = profiler.GetRecords();
+    uint64_t total = 0;
+    for (const auto& record : records)
+    {
+        total += record.count;
+    }
+    NS_TEST_EXPECT_MSG_EQ(total, 7, "Wrong number of events measured");
+    NS_TEST_EXPECT_MSG_EQ(Count(records, 1, "EventProfilerHandlersTestCase"),
+                          4,
+                          "Wrong number of events of the methods in context 1");
+    NS_TEST_EXPECT_MSG_EQ(Count(records, 2, "EventProfilerHandlersTestCase"),
+                          1,
+                          "Wrong number of events of the methods in context 2");
+
+#if __has_include(<dlfcn.h>)
+    // The handlers are named from their symbols.
+    NS_TEST_EXPECT_MSG_EQ(Count(records, 1, "EventProfilerHandlersTestCase::First()"),
+                          3,
+                          "Wrong number of events of the first method");
+    NS_TEST_EXPECT_MSG_EQ(Count(records, 1, "EventProfilerHandlersTestCase::Second()"),
+                          1,
+                          "Wrong number of events of the second method");
+    NS_TEST_EXPECT_MSG_EQ(Count(records, 1, "EventProfilerHandler::Handle()"),
+                          1,
+                          "The virtual method is not resolved");
+    NS_TEST_EXPECT_MSG_EQ(Count(records, 1, "EventProfilerFunction()"),
+                          1,
+                          "Wrong number of events of the function");
+#endif
+}
+
+/**
+ * \ingroup event-profiler-tests
+ * One event out of the sampling period is measured.
+ */
+class EventProfilerSamplingTestCase : public TestCase
+{
+  public:
+    /** Constructor. */
+    EventProfilerSamplingTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+EventProfilerSamplingTestCase::EventProfilerSamplingTestCase()
+    : TestCase("One event out of the sampling period is measured")
+{
+}
+
+void
+EventProfilerSamplingTestCase::DoRun()
+{
+    EventProfiler profiler(4);
+    for (uint32_t i = 0; i < 100; ++i)
+    {
+        EventImpl* event = MakeEvent(&EventProfilerFunction);
+        profiler.Invoke(event, 0);
+        event->Unref();
+    }
+    auto records = profiler.GetRecords();
+    NS_TEST_ASSERT_MSG_EQ(records.size(), 1, "Wrong number of records");
+    NS_TEST_EXPECT_MSG_EQ(records[0].count, 25, "Wrong number of events measured");
+}
+
+/**
+ * \ingroup event-profiler-tests
+ * The DefaultSimulatorImpl writes the profile at Simulator::Destroy().
+ */
+class EventProfilerSimulatorTestCase : public TestCase
+{
+  public:
+    /** Constructor. */
+    EventProfilerSimulatorTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+EventProfilerSimulatorTestCase::EventProfilerSimulatorTestCase()
+    : TestCase("The simulator writes the profile at Destroy")
+{
+}
+
+void
+EventProfilerSimulatorTestCase::DoRun()
+{
+    std::string file = CreateTempDirFilename("event-profile.folded");
+    Config::SetDefault("ns3::DefaultSimulatorImpl::ProfileFile", StringValue(file));
+    for (uint32_t i = 0; i < 10; ++i)
+    {
+        Simulator::ScheduleWithContext(3, Seconds(i), &EventProfilerFunction);
+    }
+    Simulator::Schedule(Seconds(1), &EventProfilerFunction);
+    Simulator::Run();
+    Simulator::Destroy();
+    Config::SetDefault("ns3::DefaultSimulatorImpl::ProfileFile", StringValue(""));
+
+    std::ifstream is(file);
+    NS_TEST_ASSERT_MSG_EQ(is.is_open(), true, "No profile written");
+    std::vector<std::string> lines;
+    std::string line;
+    while (std::getline(is, line))
+    {
+        lines.push_back(line);
+    }
+    NS_TEST_ASSERT_MSG_EQ(lines.size(), 2, "Wrong number of stacks");
+    bool node = false;
+    bool noContext = false;
+    for (const auto& stack : lines)
+    {
+        node |= stack.starts_with("node 3;");
+        noContext |= stack.starts_with("no context;");
+        NS_TEST_EXPECT_MSG_NE(stack.rfind(' '), std::string::npos, "No count in " << stack);
+    }
+    NS_TEST_EXPECT_MSG_EQ(node, true, "No stack of node 3");
+    NS_TEST_EXPECT_MSG_EQ(noContext, true, "No stack without context");
+}
+
+/**
+ * \ingroup event-profiler-tests
+ * EventProfiler test suite.
+ */
+class EventProfilerTestSuite : public TestSuite
+{
+  public:
+    EventProfilerTestSuite()
+        : TestSuite("event-profiler")
+    {
+        AddTestCase(new EventProfilerHandlersTestCase());
+        AddTestCase(new EventProfilerSamplingTestCase());
+        AddTestCase(new EventProfilerSimulatorTestCase());
+    }
+};
+
+/**
+ * \ingroup event-profiler-tests
+ * EventProfilerTestSuite instance variable.
+ */
+static EventProfilerTestSuite g_eventProfilerTestSuite;
+
+} // namespace tests
+
+} // namespace ns3
@@ -0,0 +1,171 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/heap-scheduler.h"
+#include "ns3/map-scheduler.h"
+#include "ns3/test.h"
+
+#include <cstdint>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup core-tests
+ * \ingroup scheduler
+ * \ingroup heap-scheduler-tests
+ * HeapScheduler test suite.
+ */
+
+/**
+ * \ingroup core-tests
+ * \defgroup heap-scheduler-tests HeapScheduler test suite
+ */
+
+namespace ns3
+{
+
+namespace tests
+{
+
+/**
+ * \ingroup heap-scheduler-tests
+ * Run the same random operations on a HeapScheduler and on a
+ * MapScheduler, and check that they return the same events.
+ *
+ * The removed events are anywhere in the heap, so that the last item
+ * moved to their slot must sometimes go up and sometimes go down.
+ */
+class HeapSchedulerTestCase : public TestCase
+{
+  public:
+    /** Constructor. */
+    HeapSchedulerTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+HeapSchedulerTestCase::HeapSchedulerTestCase()
+    : TestCase("Same events as the MapScheduler")
+{
+}
+
+void
+HeapSchedulerTestCase::DoRun()
+{
+    Ptr<Scheduler> heap = CreateObject<HeapScheduler>();
+    Ptr<Scheduler> map = CreateObject<MapScheduler>();
+
+    std::mt19937_64 rng(1);
+    std::uniform_int_distribution<uint32_t> operation(0, 99);
+    std::uniform_int_distribution<uint64_t> nearDelay(0, 100000);
+    std::uniform_int_distribution<uint64_t> farDelay(200000000, 1000000000);
+
+    std::unordered_map<uint32_t, Scheduler::Event> pending; // Events that may be removed
+    std::vector<uint32_t> uids; // Uids of the events, including executed ones
+    uint64_t now = 0;
+    uint32_t uid = 0;
+    uint32_t removed = 0;
+    uint32_t executed = 0;
+
+    auto insert = [&](uint64_t ts) {
+        Scheduler::Event ev;
+        // The schedulers never dereference the events
+        ev.impl = reinterpret_cast<EventImpl*>(uintptr_t(uid + 1) * 8);
+        ev.key.m_ts = ts;
+        ev.key.m_uid = uid++;
+        ev.key.m_context = 0;
+        heap->Insert(ev);
+        map->Insert(ev);
+        pending[ev.key.m_uid] = ev;
+        uids.push_back(ev.key.m_uid);
+    };
+
+    for (uint32_t i = 0; i < 100000; i++)
+    {
+        uint32_t op = operation(rng);
+        if (op < 25)
+        {
+            insert(now + nearDelay(rng));
+        }
+        else if (op < 30)
+        {
+            insert(now);
+        }
+        else if (op < 45)
+        {
+            insert(now + farDelay(rng));
+        }
+        else if (op < 65 && !uids.empty())
+        {
+            std::uniform_int_distribution<std::size_t> pick(0, uids.size() - 1);
+            std::size_t index = pick(rng);
+            auto event = pending.find(uids[index]);
+            uids[index] = uids.back();
+            uids.pop_back();
+            if (event != pending.end())
+            {
+                heap->Remove(event->second);
+                map->Remove(event->second);
+                pending.erase(event);
+                removed++;
+            }
+        }
+        else if (op < 70 && !map->IsEmpty())
+        {
+            NS_TEST_ASSERT_MSG_EQ(heap->PeekNext().key.m_uid,
+                                  map->PeekNext().key.m_uid,
+                                  "Wrong next event");
+        }
+        else if (!map->IsEmpty())
+        {
+            Scheduler::Event expected = map->RemoveNext();
+            Scheduler::Event actual = heap->RemoveNext();
+            NS_TEST_ASSERT_MSG_EQ(actual.key.m_uid, expected.key.m_uid, "Wrong next event");
+            NS_TEST_ASSERT_MSG_EQ(actual.key.m_ts, expected.key.m_ts, "Wrong timestamp");
+            NS_TEST_ASSERT_MSG_EQ(actual.impl, expected.impl, "Wrong event");
+            now = actual.key.m_ts;
+            executed++;
+            // Executed events cannot be removed any more
+            pending.erase(actual.key.m_uid);
+        }
+        NS_TEST_ASSERT_MSG_EQ(heap->IsEmpty(), map->IsEmpty(), "Wrong emptiness");
+    }
+
+    while (!map->IsEmpty())
+    {
+        Scheduler::Event expected = map->RemoveNext();
+        Scheduler::Event actual = heap->RemoveNext();
+        NS_TEST_ASSERT_MSG_EQ(actual.key.m_uid, expected.key.m_uid, "Wrong next event");
+    }
+    NS_TEST_ASSERT_MSG_EQ(heap->IsEmpty(), true, "Events left in the heap");
+    NS_TEST_EXPECT_MSG_GT(removed, 5000, "Too few removals to test them");
+    NS_TEST_EXPECT_MSG_GT(executed, 20000, "Too few events executed");
+}
+
+/**
+ * \ingroup heap-scheduler-tests
+ * HeapScheduler test suite.
+ */
+class HeapSchedulerTestSuite : public TestSuite
+{
+  public:
+    HeapSchedulerTestSuite()
+        : TestSuite("heap-scheduler")
+    {
+        AddTestCase(new HeapSchedulerTestCase());
+    }
+};
+
+/**
+ * \ingroup heap-scheduler-tests
+ * HeapSchedulerTestSuite instance variable.
+ */
+static HeapSchedulerTestSuite g_heapSchedulerTestSuite;
+
+} // namespace tests
+
+} // namespace ns3
@@ -0,0 +1,256 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/log.h"
+#include "ns3/test.h"
+
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup core-tests
+ * \ingroup logging
+ * \ingroup log-binary-tests
+ * Binary log test suite.
+ */
+
+/**
+ * \ingroup core-tests
+ * \defgroup log-binary-tests Binary log test suite
+ */
+
+namespace ns3
+{
+
+namespace tests
+{
+
+NS_LOG_COMPONENT_DEFINE("LogBinaryTestSuite");
+
+/**
+ * \ingroup log-binary-tests
+ * Base class of the binary log tests, which decodes the records.
+ */
+class LogBinaryTestCase : public TestCase
+{
+  public:
+    /**
+     * Constructor.
+     * \param [in] name The name of the test case.
+     */
+    LogBinaryTestCase(std::string name);
+
+  protected:
+    /**
+     * Disable the binary log, and decode it.
+     *
+     * \param [in] filename The file of the binary log.
+     * \returns The lines of the records, from the name of the log component.
+     */
+    std::vector<std::string> Decode(const std::string& filename);
+};
+
+LogBinaryTestCase::LogBinaryTestCase(std::string name)
+    : TestCase(name)
+{
+}
+
+std::vector<std::string>
+LogBinaryTestCase::Decode(const std::string& filename)
+{
+    LogBinaryDisable();
+    std::ifstream is(filename, std::ios::binary);
+    std::ostringstream os;
+    NS_TEST_EXPECT_MSG_EQ(LogBinaryDecode(is, os), true, "Malformed binary log");
+
+    // The time and the context depend on the simulator left by other tests.
+    std::vector<std::string> lines;
+    std::istringstream text(os.str());
+    std::string line;
+    while (std::getline(text, line))
+    {
+        auto start = line.find("LogBinaryTestSuite:");
+        lines.push_back(start == std::string::npos ? line : line.substr(start));
+    }
+    return lines;
+}
+
+/**
+ * \ingroup log-binary-tests
+ * The records are decoded as the text output prints them.
+ */
+class LogBinaryFormatTestCase : public LogBinaryTestCase
+{
+  public:
+    LogBinaryFormatTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+LogBinaryFormatTestCase::LogBinaryFormatTestCase()
+    : LogBinaryTestCase("Check the decoding of the records")
+{
+}
+
+void
+LogBinaryFormatTestCase::DoRun()
+{
+    std::string filename = CreateTempDirFilename("format.nslog");
+    LogBinaryEnable(filename, 16);
+
+    LogSite info(g_log, LOG_INFO, "DoRun", false);
+    LogSite function(g_log, LOG_FUNCTION, "DoRun", true);
+    LogSite noArgs(g_log, LOG_FUNCTION, "DoRun", true);
+    LogSite truncated(g_log, LOG_DEBUG, "DoRun", false);
+
+    for (int i = 0; i < 2; ++i)
+    {
+        LogRecord{info} << "x=" << 42 + i << " y=" << 1.5 << " s=" << std::string("abc")
+                        << " b=" << (i == 0) << " c=" << 'q' << std::endl;
+    }
+    char name[] = "name";
+    LogRecord{function} << this << 7U << std::string("str") << "lit" << name << 'a';
+    LogRecord{noArgs};
+    LogRecord{truncated} << "long=" << std::string(200, 'a') << " after " << 1;
+
+    std::ostringstream pointer;
+    pointer << this;
+    auto lines = Decode(filename);
+    NS_TEST_ASSERT_MSG_EQ(lines.size(), 7, "Wrong number of lines");
+    NS_TEST_EXPECT_MSG_EQ(lines[0],
+                          "LogBinaryTestSuite:DoRun(): [INFO ] x=42 y=1.5 s=abc b=true c=q",
+                          "Wrong first record");
+    NS_TEST_EXPECT_MSG_EQ(lines[1], "", "Wrong new line");
+    NS_TEST_EXPECT_MSG_EQ(lines[2],
+                          "LogBinaryTestSuite:DoRun(): [INFO ] x=43 y=1.5 s=abc b=false c=q",
+                          "Wrong second record");
+    NS_TEST_EXPECT_MSG_EQ(lines[4],
+                          "LogBinaryTestSuite:DoRun(" + pointer.str() +
+                              ", 7, \"str\", \"lit\", \"name\", 97)",
+                          "Wrong function record");
+    NS_TEST_EXPECT_MSG_EQ(lines[5], "LogBinaryTestSuite:DoRun()", "Wrong record without arguments");
+    std::string expected = "LogBinaryTestSuite:DoRun(): [DEBUG] long=" +
+                           std::string(LogRecord::PAYLOAD_SIZE - 3, 'a') + "... after ...";
+    NS_TEST_EXPECT_MSG_EQ(lines[6], expected, "Wrong truncated record");
+}
+
+/**
+ * \ingroup log-binary-tests
+ * The ring keeps the last records.
+ */
+class LogBinaryRingTestCase : public LogBinaryTestCase
+{
+  public:
+    LogBinaryRingTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+LogBinaryRingTestCase::LogBinaryRingTestCase()
+    : LogBinaryTestCase("Check that the ring keeps the last records")
+{
+}
+
+void
+LogBinaryRingTestCase::DoRun()
+{
+    std::string filename = CreateTempDirFilename("ring.nslog");
+    LogBinaryEnable(filename, 4);
+    NS_TEST_EXPECT_MSG_EQ(LogBinaryIsEnabled(), true, "Binary log not enabled");
+
+    LogSite site(g_log, LOG_LOGIC, "DoRun", false);
+    for (int i = 0; i < 10; ++i)
+    {
+        LogRecord{site} << "record " << i;
+    }
+
+    auto lines = Decode(filename);
+    NS_TEST_EXPECT_MSG_EQ(LogBinaryIsEnabled(), false, "Binary log not disabled");
+    NS_TEST_ASSERT_MSG_EQ(lines.size(), 4, "Wrong number of records kept");
+    for (int i = 0; i < 4; ++i)
+    {
+        NS_TEST_EXPECT_MSG_EQ(lines[i],
+                              "LogBinaryTestSuite:DoRun(): [LOGIC] record " + std::to_string(6 + i),
+                              "Wrong record " << i);
+    }
+}
+
+#ifdef NS3_LOG_ENABLE
+/**
+ * \ingroup log-binary-tests
+ * The logging macros write to the binary log when it is enabled.
+ */
+class LogBinaryMacroTestCase : public LogBinaryTestCase
+{
+  public:
+    LogBinaryMacroTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+LogBinaryMacroTestCase::LogBinaryMacroTestCase()
+    : LogBinaryTestCase("Check the logging macros")
+{
+}
+
+void
+LogBinaryMacroTestCase::DoRun()
+{
+    std::string filename = CreateTempDirFilename("macros.nslog");
+    LogComponentEnable("LogBinaryTestSuite", LOG_LEVEL_FUNCTION);
+    LogBinaryEnable(filename, 16);
+
+    NS_LOG_FUNCTION(this << 5);
+    NS_LOG_INFO("value " << 3);
+    NS_LOG_LOGIC("not enabled");
+
+    LogComponentDisable("LogBinaryTestSuite", LOG_LEVEL_ALL);
+    std::ostringstream pointer;
+    pointer << this;
+    auto lines = Decode(filename);
+    NS_TEST_ASSERT_MSG_EQ(lines.size(), 2, "Wrong number of records");
+    NS_TEST_EXPECT_MSG_EQ(lines[0],
+                          "LogBinaryTestSuite:DoRun(" + pointer.str() + ", 5)",
+                          "Wrong NS_LOG_FUNCTION record");
+    NS_TEST_EXPECT_MSG_EQ(lines[1],
+                          "LogBinaryTestSuite:DoRun(): [INFO ] value 3",
+                          "Wrong NS_LOG_INFO record");
+}
+#endif /* NS3_LOG_ENABLE */
+
+/**
+ * \ingroup log-binary-tests
+ * Binary log test suite.
+ */
+class LogBinaryTestSuite : public TestSuite
+{
+  public:
+    LogBinaryTestSuite();
+};
+
+LogBinaryTestSuite::LogBinaryTestSuite()
+    : TestSuite("log-binary")
+{
+    AddTestCase(new LogBinaryFormatTestCase());
+    AddTestCase(new LogBinaryRingTestCase());
+#ifdef NS3_LOG_ENABLE
+    AddTestCase(new LogBinaryMacroTestCase());
+#endif
+}
+
+/**
+ * \ingroup log-binary-tests
+ * LogBinaryTestSuite instance variable.
+ */
+static LogBinaryTestSuite g_logBinaryTestSuite;
+
+} // namespace tests
+
+} // namespace ns3
@@ -521,6 +521,86 @@ UnidirectionalAggregateObjectTestCase::DoRun()
                           "Can GetObject (through baseB) for BaseA Object");
 }
 
+/**
+ * \ingroup object-tests
+ * Test the lookups of the aggregates by TypeId, which are cached.
+ */
+class AggregateLookupTestCase : public TestCase
+{
+  public:
+    /** Constructor. */
+    AggregateLookupTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+AggregateLookupTestCase::AggregateLookupTestCase()
+    : TestCase("Check the lookups of aggregates by TypeId")
+{
+}
+
+void
+AggregateLookupTestCase::DoRun()
+{
+    Ptr<BaseA> baseA = CreateObject<BaseA>();
+    Ptr<DerivedB> derivedB = CreateObject<DerivedB>();
+
+    //
+    // A missing aggregate is found once aggregated.
+    //
+    NS_TEST_ASSERT_MSG_EQ(baseA->GetObject<BaseB>(BaseB::GetTypeId()),
+                          nullptr,
+                          "Found a BaseB before the aggregation");
+    baseA->AggregateObject(derivedB);
+    NS_TEST_ASSERT_MSG_EQ(baseA->GetObject<BaseB>(BaseB::GetTypeId()),
+                          derivedB,
+                          "BaseB not found after the aggregation");
+    NS_TEST_ASSERT_MSG_EQ(baseA->GetObject<DerivedB>(DerivedB::GetTypeId()),
+                          derivedB,
+                          "DerivedB not found after the aggregation");
+    NS_TEST_ASSERT_MSG_EQ(derivedB->GetObject<BaseA>(BaseA::GetTypeId()),
+                          baseA,
+                          "BaseA not found through the other aggregate");
+
+    //
+    // Many lookups grow the table without losing the aggregates.
+    //
+    for (uint16_t i = 0; i < TypeId::GetRegisteredN(); ++i)
+    {
+        TypeId tid = TypeId::GetRegistered(i);
+        Ptr<Object> found = baseA->GetObject<Object>(tid);
+        if (tid == Object::GetTypeId() || tid == BaseA::GetTypeId())
+        {
+            NS_TEST_ASSERT_MSG_EQ(found, baseA, "Wrong aggregate of " << tid.GetName());
+        }
+        else if (tid == BaseB::GetTypeId() || tid == DerivedB::GetTypeId())
+        {
+            NS_TEST_ASSERT_MSG_EQ(found, derivedB, "Wrong aggregate of " << tid.GetName());
+        }
+        else if (tid != ObjectBase::GetTypeId())
+        {
+            NS_TEST_ASSERT_MSG_EQ(found, nullptr, "Unexpected aggregate of " << tid.GetName());
+        }
+    }
+    NS_TEST_ASSERT_MSG_EQ(baseA->GetObject<BaseB>(BaseB::GetTypeId()),
+                          derivedB,
+                          "BaseB not found after many lookups");
+
+    //
+    // A unidirectional aggregate is found after a failed lookup.
+    //
+    Ptr<DerivedA> derivedA = CreateObject<DerivedA>();
+    Ptr<BaseB> baseB = CreateObject<BaseB>();
+    NS_TEST_ASSERT_MSG_EQ(derivedA->GetObject<BaseB>(BaseB::GetTypeId()),
+                          nullptr,
+                          "Found a BaseB before the aggregation");
+    derivedA->UnidirectionalAggregateObject(baseB);
+    NS_TEST_ASSERT_MSG_EQ(derivedA->GetObject<BaseB>(BaseB::GetTypeId()),
+                          baseB,
+                          "Unidirectional aggregate not found");
+}
+
 /**
  * \ingroup object-tests
  * Test an Object factory can create Objects
@@ -623,6 +703,7 @@ ObjectTestSuite::ObjectTestSuite()
     AddTestCase(new CreateObjectTestCase);
     AddTestCase(new AggregateObjectTestCase);
     AddTestCase(new UnidirectionalAggregateObjectTestCase);
+    AddTestCase(new AggregateLookupTestCase);
     AddTestCase(new ObjectFactoryTestCase);
 }
 
@@ -0,0 +1,219 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/double.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/rng-stream.h"
+#include "ns3/test.h"
+
+#include <cstddef>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup core-tests
+ * \ingroup randomvariable
+ * \ingroup rng-tests
+ * Test of the generation of random values in blocks.
+ */
+
+namespace ns3
+{
+
+namespace tests
+{
+
+/**
+ * \ingroup rng-tests
+ * The blocks of RngStream::RandU01() follow the sequence of the randoms
+ * generated one by one.
+ */
+class RngStreamBlockTestCase : public TestCase
+{
+  public:
+    /** Constructor. */
+    RngStreamBlockTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+RngStreamBlockTestCase::RngStreamBlockTestCase()
+    : TestCase("The blocks of randoms follow the sequence of RandU01()")
+{
+}
+
+void
+RngStreamBlockTestCase::DoRun()
+{
+    RngStream scalar(1, 2, 3);
+    RngStream block(1, 2, 3);
+
+    // Blocks smaller and larger than the cache, after randoms taken one by one.
+    for (std::size_t n : {1, 5, 16, 17, 3, 100, 0, 31})
+    {
+        double single = block.RandU01();
+        NS_TEST_EXPECT_MSG_EQ(single, scalar.RandU01(), "Wrong single random");
+        std::vector<double> values(n);
+        block.RandU01(values.data(), n);
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            NS_TEST_EXPECT_MSG_EQ(values[i], scalar.RandU01(), "Wrong random " << i << " of " << n);
+        }
+    }
+
+    RngStream copy(block);
+    for (uint32_t i = 0; i < 40; ++i)
+    {
+        double expected = scalar.RandU01();
+        NS_TEST_EXPECT_MSG_EQ(block.RandU01(), expected, "Wrong random " << i);
+        NS_TEST_EXPECT_MSG_EQ(copy.RandU01(), expected, "Wrong random " << i << " of the copy");
+    }
+}
+
+/**
+ * \ingroup rng-tests
+ * RandomVariableStream::GetValues() returns the values of GetValue().
+ */
+class RandomVariableBlockTestCase : public TestCase
+{
+  public:
+    /** Constructor. */
+    RandomVariableBlockTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Check the values of two random variables of the same stream, one
+     * in blocks and the other one value by value.
+     *
+     * \param [in] name The name of the configuration.
+     * \param [in] block The variable read in blocks.
+     * \param [in] scalar The variable read value by value.
+     */
+    void Check(std::string name,
+               Ptr<RandomVariableStream> block,
+               Ptr<RandomVariableStream> scalar);
+
+    /**
+     * Create two random variables of the same stream.
+     *
+     * \tparam T \explicit The type of the random variables.
+     * \param [in] isAntithetic Whether the values are antithetic.
+     * \param [in] attributes The pairs of names and values of the attributes.
+     * \return The two random variables.
+     */
+    template <typename T>
+    static std::pair<Ptr<RandomVariableStream>, Ptr<RandomVariableStream>> Create(
+        bool isAntithetic,
+        const std::vector<std::pair<std::string, double>>& attributes);
+};
+
+RandomVariableBlockTestCase::RandomVariableBlockTestCase()
+    : TestCase("GetValues() returns the values of GetValue()")
+{
+}
+
+template <typename T>
+std::pair<Ptr<RandomVariableStream>, Ptr<RandomVariableStream>>
+RandomVariableBlockTestCase::Create(bool isAntithetic,
+                                    const std::vector<std::pair<std::string, double>>& attributes)
+{
+    Ptr<RandomVariableStream> variables[2];
+    for (auto& variable : variables)
+    {
+        variable = CreateObject<T>();
+        variable->SetStream(7);
+        variable->SetAntithetic(isAntithetic);
+        for (const auto& [name, value] : attributes)
+        {
+            variable->SetAttribute(name, DoubleValue(value));
+        }
+    }
+    return {variables[0], variables[1]};
+}
+
+void
+RandomVariableBlockTestCase::Check(std::string name,
+                                   Ptr<RandomVariableStream> block,
+                                   Ptr<RandomVariableStream> scalar)
+{
+    for (std::size_t n : {1, 7, 16, 50, 0, 300})
+    {
+        NS_TEST_EXPECT_MSG_EQ(block->GetValue(),
+                              scalar->GetValue(),
+                              name << ": wrong single value");
+        std::vector<double> values(n);
+        block->GetValues(values.data(), n);
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            NS_TEST_EXPECT_MSG_EQ(values[i],
+                                  scalar->GetValue(),
+                                  name << ": wrong value " << i << " of " << n);
+        }
+    }
+}
+
+void
+RandomVariableBlockTestCase::DoRun()
+{
+    for (bool isAntithetic : {false, true})
+    {
+        std::string suffix = isAntithetic ? ", antithetic" : "";
+        auto [block, scalar] =
+            Create<UniformRandomVariable>(isAntithetic, {{"Min", -3}, {"Max", 11}});
+        Check("uniform" + suffix, block, scalar);
+
+        std::tie(block, scalar) = Create<ExponentialRandomVariable>(isAntithetic, {{"Mean", 2}});
+        Check("exponential" + suffix, block, scalar);
+
+        // Bound below the mean, so that many values are redrawn.
+        std::tie(block, scalar) =
+            Create<ExponentialRandomVariable>(isAntithetic, {{"Mean", 2}, {"Bound", 1}});
+        Check("bounded exponential" + suffix, block, scalar);
+
+        std::tie(block, scalar) =
+            Create<ParetoRandomVariable>(isAntithetic, {{"Scale", 1}, {"Shape", 1.5}});
+        Check("Pareto" + suffix, block, scalar);
+
+        std::tie(block, scalar) = Create<ParetoRandomVariable>(isAntithetic,
+                                                               {{"Scale", 1},
+                                                                {"Shape", 1.5},
+                                                                {"Bound", 2}});
+        Check("bounded Pareto" + suffix, block, scalar);
+
+        std::tie(block, scalar) =
+            Create<NormalRandomVariable>(isAntithetic, {{"Mean", 5}, {"Variance", 4}});
+        Check("normal" + suffix, block, scalar);
+    }
+}
+
+/**
+ * \ingroup rng-tests
+ * Test suite of the generation of random values in blocks.
+ */
+class RandomVariableBlockTestSuite : public TestSuite
+{
+  public:
+    RandomVariableBlockTestSuite()
+        : TestSuite("random-variable-block")
+    {
+        AddTestCase(new RngStreamBlockTestCase());
+        AddTestCase(new RandomVariableBlockTestCase());
+    }
+};
+
+/**
+ * \ingroup rng-tests
+ * RandomVariableBlockTestSuite instance variable.
+ */
+static RandomVariableBlockTestSuite g_randomVariableBlockTestSuite;
+
+} // namespace tests
+
+} // namespace ns3
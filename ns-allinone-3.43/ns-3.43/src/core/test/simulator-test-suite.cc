@@ -12,6 +12,7 @@
 #include "ns3/priority-queue-scheduler.h"
 #include "ns3/simulator.h"
 #include "ns3/test.h"
+#include "ns3/timing-wheel-scheduler.h"
 
 using namespace ns3;
 
@@ -719,6 +720,8 @@ class SimulatorTestSuite : public TestSuite
         AddTestCase(new SimulatorEventsTestCase(factory), TestCase::Duration::QUICK);
         factory.SetTypeId(PriorityQueueScheduler::GetTypeId());
         AddTestCase(new SimulatorEventsTestCase(factory), TestCase::Duration::QUICK);
+        factory.SetTypeId(TimingWheelScheduler::GetTypeId());
+        AddTestCase(new SimulatorEventsTestCase(factory), TestCase::Duration::QUICK);
     }
 };
 
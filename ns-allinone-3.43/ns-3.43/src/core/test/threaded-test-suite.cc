@@ -14,11 +14,13 @@
 #include "ns3/string.h"
 #include "ns3/test.h"
 
+#include <atomic>
 #include <chrono> // seconds, milliseconds
 #include <ctime>
 #include <list>
 #include <thread> // sleep_for
 #include <utility>
+#include <vector>
 
 using namespace ns3;
 
@@ -267,6 +269,117 @@ ThreadedSimulatorEventsTestCase::DoRun()
     NS_TEST_EXPECT_MSG_EQ(m_a, m_d, "Bad scheduling");
 }
 
+/**
+ * \ingroup threaded-tests
+ *
+ * \brief Check that bursts of events scheduled by other threads all run,
+ * in the order of every thread, when they overflow the lock-free ring of
+ * the DefaultSimulatorImpl.
+ */
+class ThreadedSimulatorBurstTestCase : public TestCase
+{
+  public:
+    /**
+     * Constructor.
+     *
+     * \param threads The number of threads.
+     */
+    ThreadedSimulatorBurstTestCase(unsigned int threads);
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Schedule a burst of events.
+     * \param threadno The thread number.
+     */
+    void SchedulingThread(unsigned int threadno);
+    /**
+     * Event scheduled by a thread, checks the order of the thread events.
+     * \param threadno The thread number.
+     * \param sequence The number of the event in the thread.
+     */
+    void Receive(unsigned int threadno, uint32_t sequence);
+    /** Keep the simulation running until all the events are received. */
+    void Heartbeat();
+
+    /// Events scheduled by each thread.
+    static constexpr uint32_t EVENTS = 20000;
+
+    unsigned int m_threads;                //!< The number of threads.
+    std::atomic<unsigned int> m_producing; //!< Threads still scheduling events.
+    std::vector<uint32_t> m_next;          //!< Next expected event, by thread.
+    uint64_t m_received;                   //!< Events received.
+    uint64_t m_outOfOrder;                 //!< Events received out of order.
+};
+
+ThreadedSimulatorBurstTestCase::ThreadedSimulatorBurstTestCase(unsigned int threads)
+    : TestCase("Check bursts of threaded events with " + std::to_string(threads) + " threads"),
+      m_threads(threads),
+      m_producing(0),
+      m_received(0),
+      m_outOfOrder(0)
+{
+}
+
+void
+ThreadedSimulatorBurstTestCase::SchedulingThread(unsigned int threadno)
+{
+    for (uint32_t i = 0; i < EVENTS; ++i)
+    {
+        Simulator::ScheduleWithContext(threadno,
+                                       Time(0),
+                                       &ThreadedSimulatorBurstTestCase::Receive,
+                                       this,
+                                       threadno,
+                                       i);
+    }
+    m_producing--;
+}
+
+void
+ThreadedSimulatorBurstTestCase::Receive(unsigned int threadno, uint32_t sequence)
+{
+    if (sequence != m_next[threadno])
+    {
+        m_outOfOrder++;
+    }
+    m_next[threadno] = sequence + 1;
+    m_received++;
+}
+
+void
+ThreadedSimulatorBurstTestCase::Heartbeat()
+{
+    if (m_producing > 0 || m_received < uint64_t(m_threads) * EVENTS)
+    {
+        Simulator::Schedule(MicroSeconds(1), &ThreadedSimulatorBurstTestCase::Heartbeat, this);
+    }
+}
+
+void
+ThreadedSimulatorBurstTestCase::DoRun()
+{
+    m_next.assign(m_threads, 0);
+    m_producing = m_threads;
+    Simulator::Schedule(MicroSeconds(1), &ThreadedSimulatorBurstTestCase::Heartbeat, this);
+
+    std::list<std::thread> threads;
+    for (unsigned int i = 0; i < m_threads; ++i)
+    {
+        threads.emplace_back(&ThreadedSimulatorBurstTestCase::SchedulingThread, this, i);
+    }
+    Simulator::Run();
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    Simulator::Destroy();
+
+    NS_TEST_EXPECT_MSG_EQ(m_received, uint64_t(m_threads) * EVENTS, "Lost events");
+    NS_TEST_EXPECT_MSG_EQ(m_outOfOrder, 0, "Events of a thread out of order");
+}
+
 /**
  * \ingroup threaded-tests
  *
@@ -287,6 +400,7 @@ class ThreadedSimulatorTestSuite : public TestSuite
             "ns3::HeapScheduler",
             "ns3::MapScheduler",
             "ns3::CalendarScheduler",
+            "ns3::TimingWheelScheduler",
         };
         unsigned int threadCounts[] = {0, 2, 10, 20};
         ObjectFactory factory;
@@ -304,6 +418,11 @@ class ThreadedSimulatorTestSuite : public TestSuite
                 }
             }
         }
+        for (auto& threadCount : {1, 4, 16})
+        {
+            AddTestCase(new ThreadedSimulatorBurstTestCase(threadCount),
+                        TestCase::Duration::QUICK);
+        }
     }
 };
 
@@ -0,0 +1,195 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/map-scheduler.h"
+#include "ns3/test.h"
+#include "ns3/timing-wheel-scheduler.h"
+
+#include <cstdint>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup core-tests
+ * \ingroup scheduler
+ * \ingroup timing-wheel-tests
+ * TimingWheelScheduler test suite.
+ */
+
+/**
+ * \ingroup core-tests
+ * \defgroup timing-wheel-tests TimingWheelScheduler test suite
+ */
+
+namespace ns3
+{
+
+namespace tests
+{
+
+/**
+ * \ingroup timing-wheel-tests
+ * Run the same random operations on a TimingWheelScheduler and on a
+ * MapScheduler, and check that they return the same events.
+ *
+ * The delays mix simultaneous events, dense near-term events, timers
+ * that are mostly cancelled, and events beyond the reach of the wheel.
+ * Some events are inserted between the current time and the next event
+ * right after a PeekNext(), as the realtime simulator does.
+ */
+class TimingWheelSchedulerTestCase : public TestCase
+{
+  public:
+    /** Constructor. */
+    TimingWheelSchedulerTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+TimingWheelSchedulerTestCase::TimingWheelSchedulerTestCase()
+    : TestCase("Same events as the MapScheduler")
+{
+}
+
+void
+TimingWheelSchedulerTestCase::DoRun()
+{
+    Ptr<Scheduler> wheel = CreateObject<TimingWheelScheduler>();
+    Ptr<Scheduler> map = CreateObject<MapScheduler>();
+
+    std::mt19937_64 rng(1);
+    std::uniform_int_distribution<uint32_t> operation(0, 99);
+    std::uniform_int_distribution<uint64_t> nearDelay(0, 100000);
+    std::uniform_int_distribution<uint64_t> timerDelay(200000000, 1000000000);
+    std::uniform_int_distribution<uint64_t> farDelay(uint64_t(1) << 48, uint64_t(1) << 52);
+
+    std::unordered_map<uint32_t, Scheduler::Event> timers; // Pending events that may be removed
+    std::vector<uint32_t> timerUids; // Uids of the timers, including executed ones
+    uint64_t now = 0;
+    uint32_t uid = 0;
+    uint32_t removed = 0;
+    uint32_t executed = 0;
+
+    auto insert = [&](uint64_t ts) {
+        Scheduler::Event ev;
+        // The schedulers never dereference the events
+        ev.impl = reinterpret_cast<EventImpl*>(uintptr_t(uid + 1) * 8);
+        ev.key.m_ts = ts;
+        ev.key.m_uid = uid++;
+        ev.key.m_context = 0;
+        wheel->Insert(ev);
+        map->Insert(ev);
+        return ev;
+    };
+
+    for (uint32_t i = 0; i < 400000; i++)
+    {
+        uint32_t op = operation(rng);
+        if (op < 30)
+        {
+            insert(now + nearDelay(rng));
+        }
+        else if (op < 35)
+        {
+            insert(now);
+        }
+        else if (op < 50)
+        {
+            Scheduler::Event ev = insert(now + timerDelay(rng));
+            timers[ev.key.m_uid] = ev;
+            timerUids.push_back(ev.key.m_uid);
+        }
+        else if (op < 51)
+        {
+            insert(now + farDelay(rng));
+        }
+        else if (op < 65 && !timerUids.empty())
+        {
+            std::uniform_int_distribution<std::size_t> pick(0, timerUids.size() - 1);
+            std::size_t index = pick(rng);
+            auto timer = timers.find(timerUids[index]);
+            timerUids[index] = timerUids.back();
+            timerUids.pop_back();
+            if (timer != timers.end())
+            {
+                wheel->Remove(timer->second);
+                map->Remove(timer->second);
+                timers.erase(timer);
+                removed++;
+            }
+        }
+        else if (op < 70 && !map->IsEmpty())
+        {
+            Scheduler::Event next = wheel->PeekNext();
+            NS_TEST_ASSERT_MSG_EQ(next.key.m_uid, map->PeekNext().key.m_uid, "Wrong next event");
+            if (next.key.m_ts > now)
+            {
+                std::uniform_int_distribution<uint64_t> before(now, next.key.m_ts - 1);
+                insert(before(rng));
+            }
+        }
+        else if (!map->IsEmpty())
+        {
+            Scheduler::Event expected = map->RemoveNext();
+            Scheduler::Event actual = wheel->RemoveNext();
+            NS_TEST_ASSERT_MSG_EQ(actual.key.m_uid, expected.key.m_uid, "Wrong next event");
+            NS_TEST_ASSERT_MSG_EQ(actual.key.m_ts, expected.key.m_ts, "Wrong timestamp");
+            NS_TEST_ASSERT_MSG_EQ(actual.impl, expected.impl, "Wrong event");
+            now = actual.key.m_ts;
+            executed++;
+            // Executed timers cannot be removed any more
+            timers.erase(actual.key.m_uid);
+        }
+        NS_TEST_ASSERT_MSG_EQ(wheel->IsEmpty(), map->IsEmpty(), "Wrong emptiness");
+    }
+
+    // Cancel more timers than there are pending events, to compact the wheel
+    std::vector<Scheduler::Event> cancelled;
+    for (uint32_t i = 0; i < 100000; i++)
+    {
+        cancelled.push_back(insert(now + timerDelay(rng)));
+    }
+    for (const auto& ev : cancelled)
+    {
+        wheel->Remove(ev);
+        map->Remove(ev);
+    }
+
+    while (!map->IsEmpty())
+    {
+        Scheduler::Event expected = map->RemoveNext();
+        Scheduler::Event actual = wheel->RemoveNext();
+        NS_TEST_ASSERT_MSG_EQ(actual.key.m_uid, expected.key.m_uid, "Wrong next event");
+    }
+    NS_TEST_ASSERT_MSG_EQ(wheel->IsEmpty(), true, "Events left in the wheel");
+    NS_TEST_EXPECT_MSG_GT(removed, 10000, "Too few removals to test them");
+    NS_TEST_EXPECT_MSG_GT(executed, 100000, "Too few events executed");
+}
+
+/**
+ * \ingroup timing-wheel-tests
+ * TimingWheelScheduler test suite.
+ */
+class TimingWheelSchedulerTestSuite : public TestSuite
+{
+  public:
+    TimingWheelSchedulerTestSuite()
+        : TestSuite("timing-wheel-scheduler")
+    {
+        AddTestCase(new TimingWheelSchedulerTestCase());
+    }
+};
+
+/**
+ * \ingroup timing-wheel-tests
+ * TimingWheelSchedulerTestSuite instance variable.
+ */
+static TimingWheelSchedulerTestSuite g_timingWheelSchedulerTestSuite;
+
+} // namespace tests
+
+} // namespace ns3
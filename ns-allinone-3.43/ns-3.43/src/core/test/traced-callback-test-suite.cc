@@ -7,6 +7,8 @@
 #include "ns3/test.h"
 #include "ns3/traced-callback.h"
 
+#include <string>
+
 using namespace ns3;
 
 /**
@@ -122,6 +124,152 @@ BasicTracedCallbackTestCase::DoRun()
     NS_TEST_ASSERT_MSG_EQ(m_two, true, "Callback CbTwo not called");
 }
 
+/**
+ * \ingroup tracedcallback-tests
+ *
+ * TracedCallback Test case, check the order of the Callbacks and their arguments.
+ */
+class ChainTracedCallbackTestCase : public TestCase
+{
+  public:
+    ChainTracedCallbackTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Callback which records its bound and traced arguments.
+     * \param name Bound parameter.
+     * \param value Traced parameter.
+     */
+    void Record(std::string name, int value);
+
+    /**
+     * Callback which connects Record() to the traced callback.
+     * \param value Traced parameter.
+     */
+    void Connect(int value);
+
+    /**
+     * Callback which records its call and disconnects a Record() callback.
+     * \param name Bound parameter, name of the Record() callback to disconnect.
+     * \param value Traced parameter.
+     */
+    void Disconnect(std::string name, int value);
+
+    TracedCallback<int> m_trace; //!< The traced callback
+    std::string m_calls;         //!< The calls recorded
+};
+
+ChainTracedCallbackTestCase::ChainTracedCallbackTestCase()
+    : TestCase("Check the order of the TracedCallback chain")
+{
+}
+
+void
+ChainTracedCallbackTestCase::Record(std::string name, int value)
+{
+    m_calls += name + std::to_string(value);
+}
+
+void
+ChainTracedCallbackTestCase::Connect(int /* value */)
+{
+    m_trace.ConnectWithoutContext(
+        MakeCallback(&ChainTracedCallbackTestCase::Record, this).Bind(std::string("d")));
+}
+
+void
+ChainTracedCallbackTestCase::Disconnect(std::string name, int value)
+{
+    m_calls += "-" + name + std::to_string(value);
+    m_trace.DisconnectWithoutContext(
+        MakeCallback(&ChainTracedCallbackTestCase::Record, this).Bind(name));
+}
+
+void
+ChainTracedCallbackTestCase::DoRun()
+{
+    //
+    // Invoking an empty chain does nothing.
+    //
+    m_trace(0);
+    NS_TEST_ASSERT_MSG_EQ(m_trace.IsEmpty(), true, "Chain not empty");
+
+    //
+    // The callbacks are called in the order of their connection.
+    //
+    for (std::string name : {"a", "b", "c"})
+    {
+        m_trace.ConnectWithoutContext(
+            MakeCallback(&ChainTracedCallbackTestCase::Record, this).Bind(name));
+    }
+    m_trace(1);
+    NS_TEST_ASSERT_MSG_EQ(m_calls, "a1b1c1", "Callbacks not called in order");
+
+    //
+    // Disconnecting a callback in the middle of the chain keeps the order.
+    //
+    m_trace.Connect(MakeCallback(&ChainTracedCallbackTestCase::Record, this), "x");
+    m_trace.DisconnectWithoutContext(
+        MakeCallback(&ChainTracedCallbackTestCase::Record, this).Bind(std::string("b")));
+    m_calls.clear();
+    m_trace(2);
+    NS_TEST_ASSERT_MSG_EQ(m_calls, "a2c2x2", "Wrong chain after disconnection");
+
+    //
+    // A callback connected while the chain is invoked is called in the same invocation.
+    //
+    m_trace.Disconnect(MakeCallback(&ChainTracedCallbackTestCase::Record, this), "x");
+    m_trace.ConnectWithoutContext(MakeCallback(&ChainTracedCallbackTestCase::Connect, this));
+    m_calls.clear();
+    m_trace(3);
+    NS_TEST_ASSERT_MSG_EQ(m_calls, "a3c3d3", "Wrong chain after connection");
+
+    //
+    // A callback disconnecting an earlier callback while the chain is invoked
+    // does not make the invocation skip the next callback.
+    //
+    m_trace.DisconnectWithoutContext(MakeCallback(&ChainTracedCallbackTestCase::Connect, this));
+    m_trace.DisconnectWithoutContext(
+        MakeCallback(&ChainTracedCallbackTestCase::Record, this).Bind(std::string("d")));
+    m_trace.ConnectWithoutContext(
+        MakeCallback(&ChainTracedCallbackTestCase::Disconnect, this).Bind(std::string("a")));
+    m_trace.ConnectWithoutContext(
+        MakeCallback(&ChainTracedCallbackTestCase::Record, this).Bind(std::string("e")));
+    m_calls.clear();
+    m_trace(4);
+    NS_TEST_ASSERT_MSG_EQ(m_calls, "a4c4-a4e4", "Wrong chain after disconnecting an earlier one");
+    m_calls.clear();
+    m_trace(5);
+    NS_TEST_ASSERT_MSG_EQ(m_calls, "c5-a5e5", "Disconnected callback still called");
+
+    //
+    // A callback disconnected by an earlier callback while the chain is
+    // invoked is not called by the invocation.
+    //
+    m_trace.ConnectWithoutContext(
+        MakeCallback(&ChainTracedCallbackTestCase::Disconnect, this).Bind(std::string("c")));
+    m_trace.ConnectWithoutContext(
+        MakeCallback(&ChainTracedCallbackTestCase::Disconnect, this).Bind(std::string("e")));
+    m_trace.DisconnectWithoutContext(
+        MakeCallback(&ChainTracedCallbackTestCase::Record, this).Bind(std::string("c")));
+    m_trace.ConnectWithoutContext(
+        MakeCallback(&ChainTracedCallbackTestCase::Record, this).Bind(std::string("c")));
+    m_calls.clear();
+    m_trace(6);
+    NS_TEST_ASSERT_MSG_EQ(m_calls, "-a6e6-c6-e6", "Wrong chain after disconnecting a later one");
+
+    //
+    // The functor can be connected as a Callback to another TracedCallback.
+    //
+    TracedCallback<int> forward;
+    forward.ConnectWithoutContext(MakeCallback(&TracedCallback<int>::operator(), &m_trace));
+    m_calls.clear();
+    forward(7);
+    NS_TEST_ASSERT_MSG_EQ(m_calls, "-a7-c7-e7", "Wrong chain through the functor");
+}
+
 /**
  * \ingroup tracedcallback-tests
  *
@@ -137,6 +285,7 @@ TracedCallbackTestSuite::TracedCallbackTestSuite()
     : TestSuite("traced-callback", Type::UNIT)
 {
     AddTestCase(new BasicTracedCallbackTestCase, TestCase::Duration::QUICK);
+    AddTestCase(new ChainTracedCallbackTestCase, TestCase::Duration::QUICK);
 }
 
 static TracedCallbackTestSuite
@@ -13,6 +13,12 @@
 #include "adaptive-tcp.h"
 
 #include "ns3/log.h"
+#include "ns3/object-factory.h"
+#include "ns3/string.h"
+
+#include <algorithm>
+#include <bit>
+#include <sstream>
 
 NS_LOG_COMPONENT_DEFINE("AdaptiveTcp");
 
@@ -102,7 +108,23 @@ AdaptiveTcp::GetTypeId()
                           "Cubic Scaling factor",
                           DoubleValue(0.4),
                           MakeDoubleAccessor(&AdaptiveTcp::m_c),
-                          MakeDoubleChecker<double>(0.0));
+                          MakeDoubleChecker<double>(0.0))
+            .AddAttribute("FixedPoint",
+                          "Compute the cubic window target in fixed-point arithmetic, "
+                          "as Linux does, instead of floating point",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&AdaptiveTcp::m_fixedPoint),
+                          MakeBooleanChecker())
+            .AddAttribute("Candidates",
+                          "TypeId names of the congestion controls AdaptiveTcp can switch to, "
+                          "separated by ';'. The built-in CUBIC is always candidate 0.",
+                          StringValue(""),
+                          MakeStringAccessor(&AdaptiveTcp::m_candidateTypes),
+                          MakeStringChecker())
+            .AddTraceSource("Switch",
+                            "The active congestion control changed",
+                            MakeTraceSourceAccessor(&AdaptiveTcp::m_switchTrace),
+                            "ns3::AdaptiveTcp::SwitchTracedCallback");
     return tid;
 }
 
@@ -112,6 +134,8 @@ AdaptiveTcp::AdaptiveTcp()
       m_lastMaxCwnd(0),
       m_bicOriginPoint(0),
       m_bicK(0.0),
+      m_bicKFixed(0),
+      m_cubeRttScale(0),
       m_delayMin(Time::Min()),
       m_epochStart(Time::Min()),
       m_found(false),
@@ -139,10 +163,13 @@ AdaptiveTcp::AdaptiveTcp(const AdaptiveTcp& sock)
       m_initialCwnd(sock.m_initialCwnd),
       m_cntClamp(sock.m_cntClamp),
       m_c(sock.m_c),
+      m_fixedPoint(sock.m_fixedPoint),
       m_cWndCnt(sock.m_cWndCnt),
       m_lastMaxCwnd(sock.m_lastMaxCwnd),
       m_bicOriginPoint(sock.m_bicOriginPoint),
       m_bicK(sock.m_bicK),
+      m_bicKFixed(sock.m_bicKFixed),
+      m_cubeRttScale(sock.m_cubeRttScale),
       m_delayMin(sock.m_delayMin),
       m_epochStart(sock.m_epochStart),
       m_found(sock.m_found),
@@ -151,9 +178,21 @@ AdaptiveTcp::AdaptiveTcp(const AdaptiveTcp& sock)
       m_lastAck(sock.m_lastAck),
       m_cubicDelta(sock.m_cubicDelta),
       m_currRtt(sock.m_currRtt),
-      m_sampleCnt(sock.m_sampleCnt)
+      m_sampleCnt(sock.m_sampleCnt),
+      m_candidateTypes(sock.m_candidateTypes),
+      m_active(sock.m_active),
+      m_pendingSwitch(sock.m_pendingSwitch),
+      m_switchPending(sock.m_switchPending),
+      m_socketPacing(sock.m_socketPacing),
+      m_decision(sock.m_decision)
 {
     NS_LOG_FUNCTION(this);
+
+    // Every socket gets its own copy of the candidates
+    for (const auto& candidate : sock.m_candidates)
+    {
+        m_candidates.push_back(candidate ? candidate->Fork() : nullptr);
+    }
 }
 
 std::string
@@ -166,6 +205,186 @@ void
 AdaptiveTcp::Init(Ptr<TcpSocketState> tcb)
 {
     HystartReset(tcb);
+
+    m_socketPacing = tcb->m_pacing;
+    if (m_candidates.empty())
+    {
+        m_candidates.emplace_back(nullptr); // The built-in CUBIC
+        std::istringstream types(m_candidateTypes);
+        std::string name;
+        while (std::getline(types, name, ';'))
+        {
+            if (!name.empty())
+            {
+                ObjectFactory factory(name);
+                m_candidates.push_back(factory.Create<TcpCongestionOps>());
+            }
+        }
+    }
+
+    if (Ptr<TcpCongestionOps> active = GetActive())
+    {
+        active->Init(tcb);
+    }
+
+    m_measureStart = Simulator::Now();
+    m_measureStartSeq = tcb->m_lastAckedSeq;
+    m_measureEndSeq = tcb->m_highTxMark;
+}
+
+void
+AdaptiveTcp::SetDecisionCallback(DecisionCallback decision)
+{
+    NS_LOG_FUNCTION(this);
+    m_decision = decision;
+}
+
+void
+AdaptiveTcp::RequestSwitch(uint32_t candidate)
+{
+    NS_LOG_FUNCTION(this << candidate);
+    NS_ABORT_MSG_IF(candidate >= GetCandidateCount(), "No candidate " << candidate);
+    m_pendingSwitch = candidate;
+    m_switchPending = true;
+}
+
+uint32_t
+AdaptiveTcp::GetCandidateCount() const
+{
+    // Before Init, only the built-in CUBIC exists
+    return std::max<uint32_t>(m_candidates.size(), 1);
+}
+
+uint32_t
+AdaptiveTcp::GetCandidateIndex(TypeId tid) const
+{
+    if (tid == GetTypeId())
+    {
+        return 0;
+    }
+    for (uint32_t i = 1; i < m_candidates.size(); i++)
+    {
+        if (m_candidates[i]->GetInstanceTypeId() == tid)
+        {
+            return i;
+        }
+    }
+    return GetCandidateCount();
+}
+
+uint32_t
+AdaptiveTcp::GetActiveCandidate() const
+{
+    return m_active;
+}
+
+Ptr<TcpCongestionOps>
+AdaptiveTcp::GetActive() const
+{
+    return m_active == 0 ? nullptr : m_candidates[m_active];
+}
+
+void
+AdaptiveTcp::UpdateSwitching(Ptr<TcpSocketState> tcb)
+{
+    if (m_candidates.size() <= 1)
+    {
+        return;
+    }
+
+    // A round ends when everything that was in flight at its start is acked
+    if (tcb->m_lastAckedSeq >= m_measureEndSeq)
+    {
+        Time now = Simulator::Now();
+        Time elapsed = now - m_measureStart;
+        if (!m_decision.IsNull() && elapsed.IsStrictlyPositive())
+        {
+            Measurement measurement;
+            measurement.minRtt = tcb->m_minRtt;
+            measurement.srtt = tcb->m_srtt;
+            measurement.lastRtt = tcb->m_lastRtt;
+            uint32_t delivered = tcb->m_lastAckedSeq - m_measureStartSeq;
+            measurement.throughput =
+                DataRate(static_cast<uint64_t>(delivered * 8.0 / elapsed.GetSeconds()));
+            measurement.cWnd = tcb->m_cWnd;
+            measurement.active = m_active;
+
+            uint32_t choice = m_decision(measurement);
+            if (choice != m_active)
+            {
+                RequestSwitch(choice);
+            }
+        }
+        m_measureStart = now;
+        m_measureStartSeq = tcb->m_lastAckedSeq;
+        m_measureEndSeq = tcb->m_highTxMark;
+    }
+
+    // Never hand over in the middle of a recovery
+    if (m_switchPending && tcb->m_congState == TcpSocketState::CA_OPEN)
+    {
+        m_switchPending = false;
+        if (m_pendingSwitch != m_active)
+        {
+            SwitchTo(tcb, m_pendingSwitch);
+        }
+    }
+}
+
+void
+AdaptiveTcp::SwitchTo(Ptr<TcpSocketState> tcb, uint32_t candidate)
+{
+    NS_LOG_FUNCTION(this << tcb << candidate);
+
+    Ptr<TcpCongestionOps> previous = GetActive();
+    std::string oldName = previous ? previous->GetName() : GetName();
+
+    uint32_t cWnd = tcb->m_cWnd;
+    uint32_t ssThresh = tcb->m_ssThresh;
+    DataRate pacingRate = tcb->m_pacingRate;
+    if (HasCongControl())
+    {
+        // Rate-based CCAs do not maintain ssThresh, do not restart slow start
+        ssThresh = cWnd;
+        tcb->m_pacing = m_socketPacing;
+    }
+
+    m_active = candidate;
+    Ptr<TcpCongestionOps> next = GetActive();
+    if (next)
+    {
+        next->Init(tcb);
+    }
+    else
+    {
+        // Restart the built-in CUBIC with a plateau at the current window
+        CubicReset(tcb);
+        HystartReset(tcb);
+        m_epochStart = Time::Min();
+        m_cWndCnt = 0;
+        m_lastMaxCwnd = cWnd / tcb->m_segmentSize;
+    }
+
+    tcb->m_cWnd = cWnd;
+    tcb->m_ssThresh = ssThresh;
+    tcb->m_pacingRate = pacingRate;
+
+    if (tcb->m_minRtt != Time::Max())
+    {
+        if (next)
+        {
+            next->PktsAcked(tcb, 0, tcb->m_minRtt);
+        }
+        else
+        {
+            m_delayMin = tcb->m_minRtt;
+        }
+    }
+
+    std::string newName = next ? next->GetName() : GetName();
+    NS_LOG_INFO("Switched from " << oldName << " to " << newName << " at cwnd " << cWnd
+                                 << " ssthresh " << ssThresh);
+    m_switchTrace(oldName, newName);
 }
 
 void
@@ -184,6 +403,12 @@ AdaptiveTcp::IncreaseWindow(Ptr<TcpSocketState> tcb, uint32_t segmentsAcked)
 {
     NS_LOG_FUNCTION(this << tcb << segmentsAcked);
 
+    if (Ptr<TcpCongestionOps> active = GetActive())
+    {
+        active->IncreaseWindow(tcb, segmentsAcked);
+        return;
+    }
+
     if (!tcb->m_isCwndLimited)
     {
         NS_LOG_DEBUG("No increase because current cwnd " << tcb->m_cWnd
@@ -252,56 +477,69 @@ AdaptiveTcp::Update(Ptr<TcpSocketState> tcb, uint32_t segmentsAcked)
 
     m_ackCnt += segmentsAcked;
 
+    bool newEpoch = false;
     if (m_epochStart == Time::Min())
     {
         m_epochStart = Simulator::Now(); // record the beginning of an epoch
         m_ackCnt = segmentsAcked;
         m_tcpCwnd = segCwnd;
-
-        if (m_lastMaxCwnd <= segCwnd)
-        {
-            NS_LOG_DEBUG("lastMaxCwnd <= m_cWnd. K=0 and origin=" << segCwnd);
-            m_bicK = 0.0;
-            m_bicOriginPoint = segCwnd;
-        }
-        else
-        {
-            m_bicK = std::pow((m_lastMaxCwnd - segCwnd) / m_c, 1 / 3.);
-            m_bicOriginPoint = m_lastMaxCwnd;
-            NS_LOG_DEBUG("lastMaxCwnd > m_cWnd. K=" << m_bicK << " and origin=" << m_lastMaxCwnd);
-        }
+        newEpoch = true;
     }
 
-    t = Simulator::Now() + m_delayMin - m_epochStart;
-
-    if (t.GetSeconds() < m_bicK) /* t - K */
+    if (m_fixedPoint)
     {
-        offs = m_bicK - t.GetSeconds();
-        NS_LOG_DEBUG("t=" << t.GetSeconds() << " <k: offs=" << offs);
+        bicTarget = FixedPointTarget(segCwnd, newEpoch);
     }
     else
     {
-        offs = t.GetSeconds() - m_bicK;
-        NS_LOG_DEBUG("t=" << t.GetSeconds() << " >= k: offs=" << offs);
-    }
+        if (newEpoch)
+        {
+            if (m_lastMaxCwnd <= segCwnd)
+            {
+                NS_LOG_DEBUG("lastMaxCwnd <= m_cWnd. K=0 and origin=" << segCwnd);
+                m_bicK = 0.0;
+                m_bicOriginPoint = segCwnd;
+            }
+            else
+            {
+                m_bicK = std::pow((m_lastMaxCwnd - segCwnd) / m_c, 1 / 3.);
+                m_bicOriginPoint = m_lastMaxCwnd;
+                NS_LOG_DEBUG("lastMaxCwnd > m_cWnd. K=" << m_bicK
+                                                        << " and origin=" << m_lastMaxCwnd);
+            }
+        }
 
-    /* Constant value taken from Experimental Evaluation of Cubic Tcp, available at
-     * eprints.nuim.ie/1716/1/Hamiltonpfldnet2007_cubic_final.pdf */
-    delta = m_c * std::pow(offs, 3);
+        t = Simulator::Now() + m_delayMin - m_epochStart;
 
-    NS_LOG_DEBUG("delta: " << delta);
+        if (t.GetSeconds() < m_bicK) /* t - K */
+        {
+            offs = m_bicK - t.GetSeconds();
+            NS_LOG_DEBUG("t=" << t.GetSeconds() << " <k: offs=" << offs);
+        }
+        else
+        {
+            offs = t.GetSeconds() - m_bicK;
+            NS_LOG_DEBUG("t=" << t.GetSeconds() << " >= k: offs=" << offs);
+        }
 
-    if (t.GetSeconds() < m_bicK)
-    {
-        // below origin
-        bicTarget = m_bicOriginPoint - delta;
-        NS_LOG_DEBUG("t < k: Bic Target: " << bicTarget);
-    }
-    else
-    {
-        // above origin
-        bicTarget = m_bicOriginPoint + delta;
-        NS_LOG_DEBUG("t >= k: Bic Target: " << bicTarget);
+        /* Constant value taken from Experimental Evaluation of Cubic Tcp, available at
+         * eprints.nuim.ie/1716/1/Hamiltonpfldnet2007_cubic_final.pdf */
+        delta = m_c * std::pow(offs, 3);
+
+        NS_LOG_DEBUG("delta: " << delta);
+
+        if (t.GetSeconds() < m_bicK)
+        {
+            // below origin
+            bicTarget = m_bicOriginPoint - delta;
+            NS_LOG_DEBUG("t < k: Bic Target: " << bicTarget);
+        }
+        else
+        {
+            // above origin
+            bicTarget = m_bicOriginPoint + delta;
+            NS_LOG_DEBUG("t >= k: Bic Target: " << bicTarget);
+        }
     }
 
     // Next the window target is converted into a cnt or count value. CUBIC will
@@ -348,11 +586,89 @@ AdaptiveTcp::Update(Ptr<TcpSocketState> tcb, uint32_t segmentsAcked)
     return std::max(cnt, 2U);
 }
 
+uint32_t
+AdaptiveTcp::FixedPointTarget(uint32_t segCwnd, bool newEpoch)
+{
+    // Time is counted in 1/2^hz s, as with BICTCP_HZ in Linux
+    constexpr uint32_t hz = 10;
+
+    if (newEpoch)
+    {
+        m_cubeRttScale = std::max<int64_t>(std::llround(m_c * (1 << hz)), 1);
+        if (m_lastMaxCwnd <= segCwnd)
+        {
+            NS_LOG_DEBUG("lastMaxCwnd <= m_cWnd. K=0 and origin=" << segCwnd);
+            m_bicKFixed = 0;
+            m_bicOriginPoint = segCwnd;
+        }
+        else
+        {
+            // K^3 = (lastMaxCwnd - cWnd) / C, with C in 1/2^hz and K in 1/2^hz s
+            uint64_t cubeFactor = (uint64_t{1} << (hz + 3 * hz)) / m_cubeRttScale;
+            m_bicKFixed = CubicRoot(cubeFactor * (m_lastMaxCwnd - segCwnd));
+            m_bicOriginPoint = m_lastMaxCwnd;
+            NS_LOG_DEBUG("lastMaxCwnd > m_cWnd. K=" << m_bicKFixed << "/1024 and origin="
+                                                    << m_lastMaxCwnd);
+        }
+    }
+
+    int64_t elapsed = (Simulator::Now() + m_delayMin - m_epochStart).GetNanoSeconds();
+    uint64_t t = (static_cast<uint64_t>(std::max<int64_t>(elapsed, 0)) << hz) / 1000000000;
+
+    // Clamp |t - K| to 2^18 (256 s) so that C * |t - K|^3 fits in 64 bits
+    uint64_t offs = t < m_bicKFixed ? m_bicKFixed - t : t - m_bicKFixed;
+    offs = std::min<uint64_t>(offs, uint64_t{1} << 18);
+    auto delta = static_cast<uint32_t>((m_cubeRttScale * offs * offs * offs) >> (hz + 3 * hz));
+    NS_LOG_DEBUG("t=" << t << "/1024 offs=" << offs << "/1024 delta: " << delta);
+
+    if (t < m_bicKFixed)
+    {
+        // below origin
+        return m_bicOriginPoint - delta;
+    }
+    // above origin
+    return m_bicOriginPoint + delta;
+}
+
+uint32_t
+AdaptiveTcp::CubicRoot(uint64_t a)
+{
+    // cbrt(i) * 2^6 for i in [0..63], rounded; from cubic_root() of Linux
+    static const uint8_t v[] = {
+        0,   54,  54,  54,  118, 118, 118, 118, 123, 129, 134, 138, 143, 147, 151, 156,
+        157, 161, 164, 168, 170, 173, 176, 179, 181, 185, 187, 190, 192, 194, 197, 199,
+        200, 202, 204, 206, 209, 211, 213, 215, 217, 219, 221, 222, 224, 225, 227, 229,
+        231, 232, 234, 236, 237, 239, 240, 242, 244, 245, 246, 248, 250, 251, 252, 254,
+    };
+
+    auto b = static_cast<uint32_t>(std::bit_width(a));
+    if (b < 7)
+    {
+        // a in [0..63]
+        return (static_cast<uint32_t>(v[a]) + 35) >> 6;
+    }
+
+    // Estimate from the 6 most significant bits, then one Newton-Raphson step:
+    // x = (2 * x + a / x^2) / 3, with the division by 3 done as * 341 / 1024
+    b = ((b * 84) >> 8) - 1;
+    auto shift = static_cast<uint32_t>(a >> (b * 3));
+    uint32_t x = ((static_cast<uint32_t>(v[shift]) + 10) << b) >> 6;
+    x = 2 * x + static_cast<uint32_t>(a / (static_cast<uint64_t>(x) * (x - 1)));
+    return (x * 341) >> 10;
+}
+
 void
 AdaptiveTcp::PktsAcked(Ptr<TcpSocketState> tcb, uint32_t segmentsAcked, const Time& rtt)
 {
     NS_LOG_FUNCTION(this << tcb << segmentsAcked << rtt);
 
+    UpdateSwitching(tcb);
+    if (Ptr<TcpCongestionOps> active = GetActive())
+    {
+        active->PktsAcked(tcb, segmentsAcked, rtt);
+        return;
+    }
+
     /* Discard delay samples right after fast recovery */
     if (m_epochStart != Time::Min() && (Simulator::Now() - m_epochStart) < m_cubicDelta)
     {
@@ -451,6 +767,11 @@ AdaptiveTcp::GetSsThresh(Ptr<const TcpSocketState> tcb, uint32_t bytesInFlight)
 {
     NS_LOG_FUNCTION(this << tcb << bytesInFlight);
 
+    if (Ptr<TcpCongestionOps> active = GetActive())
+    {
+        return active->GetSsThresh(tcb, bytesInFlight);
+    }
+
     uint32_t segCwnd = tcb->GetCwndInSegments();
     NS_LOG_DEBUG("Loss at cWnd=" << segCwnd
                                  << " segments in flight=" << bytesInFlight / tcb->m_segmentSize);
@@ -480,6 +801,12 @@ AdaptiveTcp::CongestionStateSet(Ptr<TcpSocketState> tcb, const TcpSocketState::T
 {
     NS_LOG_FUNCTION(this << tcb << newState);
 
+    if (Ptr<TcpCongestionOps> active = GetActive())
+    {
+        active->CongestionStateSet(tcb, newState);
+        return;
+    }
+
     if (newState == TcpSocketState::CA_LOSS)
     {
         CubicReset(tcb);
@@ -487,6 +814,35 @@ AdaptiveTcp::CongestionStateSet(Ptr<TcpSocketState> tcb, const TcpSocketState::T
     }
 }
 
+void
+AdaptiveTcp::CwndEvent(Ptr<TcpSocketState> tcb, const TcpSocketState::TcpCAEvent_t event)
+{
+    NS_LOG_FUNCTION(this << tcb << event);
+
+    if (Ptr<TcpCongestionOps> active = GetActive())
+    {
+        active->CwndEvent(tcb, event);
+    }
+}
+
+bool
+AdaptiveTcp::HasCongControl() const
+{
+    Ptr<TcpCongestionOps> active = GetActive();
+    return active && active->HasCongControl();
+}
+
+void
+AdaptiveTcp::CongControl(Ptr<TcpSocketState> tcb,
+                         const TcpRateOps::TcpRateConnection& rc,
+                         const TcpRateOps::TcpRateSample& rs)
+{
+    NS_LOG_FUNCTION(this << tcb);
+
+    // Only called by TcpSocketBase when HasCongControl() is true
+    GetActive()->CongControl(tcb, rc, rs);
+}
+
 void
 AdaptiveTcp::CubicReset(Ptr<const TcpSocketState> tcb)
 {
@@ -494,6 +850,7 @@ AdaptiveTcp::CubicReset(Ptr<const TcpSocketState> tcb)
 
     m_bicOriginPoint = 0;
     m_bicK = 0;
+    m_bicKFixed = 0;
     m_ackCnt = 0;
     m_tcpCwnd = 0;
     m_delayMin = Time::Min();
@@ -11,6 +11,10 @@
 #include "tcp-congestion-ops.h"
 #include "tcp-socket-base.h"
 
+#include "ns3/traced-callback.h"
+
+#include <vector>
+
 namespace ns3
 {
 
@@ -54,6 +58,37 @@ namespace ns3
  *  https://web.archive.org/web/20160528233754/http://netsrv.csc.ncsu.edu/export/hystart_techreport_2008.pdf
  *
  * More information on this implementation: http://dl.acm.org/citation.cfm?id=2756518
+ *
+ * \section adaptive_tcp_switching Runtime CCA switching
+ *
+ * On top of its own CUBIC, AdaptiveTcp keeps a per-socket pool of candidate
+ * congestion controls, listed by TypeId name in the Candidates attribute. Each
+ * socket forks its own candidates, so no CCA state is shared between flows.
+ * Candidate 0 is always the built-in CUBIC, the listed ones follow in order.
+ * Every call from TcpSocketBase is forwarded to the active candidate.
+ *
+ * A switch is requested with RequestSwitch() or returned by the decision
+ * callback, which is invoked once per round trip with the measured RTT and
+ * delivery rate. It is applied on the next ACK received in the CA_OPEN state,
+ * so it takes effect in less than one RTT. The state-transfer contract is:
+ *
+ * - cWnd and the pacing rate are kept, so the new CCA starts from the current
+ *   operating point;
+ * - ssThresh is kept, except when leaving a CCA that implements CongControl
+ *   (e.g. BBR, which has no notion of ssThresh): it is then set to the current
+ *   cWnd so the new CCA does not restart slow start;
+ * - the new CCA is initialized with Init() (whose changes to cWnd, ssThresh
+ *   and pacing rate are undone) and its delay filter is seeded with the minimum
+ *   RTT of the connection through a PktsAcked() call with no acked segments;
+ * - the socket pacing setting is restored when leaving a CongControl CCA.
+ *
+ * \section adaptive_tcp_fixed_point Fixed-point window growth
+ *
+ * With the FixedPoint attribute, the built-in CUBIC computes its window target
+ * like Linux does: the time since the epoch start is counted in 1/1024 s, C in
+ * 1/1024 and K is found with an integer cube root, so that no std::pow call or
+ * floating point time conversion is done on the per-ACK path. The resulting
+ * cWnd trajectory matches the floating point one up to the rounding of K and t.
  */
 class AdaptiveTcp : public TcpCongestionOps
 {
@@ -89,9 +124,73 @@ class AdaptiveTcp : public TcpCongestionOps
     void CongestionStateSet(Ptr<TcpSocketState> tcb,
                             const TcpSocketState::TcpCongState_t newState) override;
 
+    void CwndEvent(Ptr<TcpSocketState> tcb, const TcpSocketState::TcpCAEvent_t event) override;
+    bool HasCongControl() const override;
+    void CongControl(Ptr<TcpSocketState> tcb,
+                     const TcpRateOps::TcpRateConnection& rc,
+                     const TcpRateOps::TcpRateSample& rs) override;
+
     Ptr<TcpCongestionOps> Fork() override;
     void Init(Ptr<TcpSocketState> tcb) override;
 
+    /**
+     * \brief Measurements of the last round trip, given to the decision callback
+     */
+    struct Measurement
+    {
+        Time minRtt;         //!< Minimum RTT of the connection
+        Time srtt;           //!< Smoothed RTT
+        Time lastRtt;        //!< Last RTT sample
+        DataRate throughput; //!< Delivery rate over the last round trip
+        uint32_t cWnd;       //!< Congestion window (bytes)
+        uint32_t active;     //!< Index of the active candidate
+    };
+
+    /**
+     * Callback choosing the candidate to use from the last measurements.
+     * It returns the index of the candidate, which may be the active one.
+     */
+    typedef Callback<uint32_t, const Measurement&> DecisionCallback;
+
+    /**
+     * TracedCallback signature for candidate switches.
+     *
+     * \param [in] oldName Name of the previously active candidate
+     * \param [in] newName Name of the new active candidate
+     */
+    typedef void (*SwitchTracedCallback)(const std::string& oldName, const std::string& newName);
+
+    /**
+     * \brief Set the callback deciding which candidate to use after every round trip
+     * \param decision The decision callback
+     */
+    void SetDecisionCallback(DecisionCallback decision);
+
+    /**
+     * \brief Switch to a candidate on the next ACK received in the CA_OPEN state
+     * \param candidate Index of the candidate (0 is the built-in CUBIC)
+     */
+    void RequestSwitch(uint32_t candidate);
+
+    /**
+     * \brief Get the number of candidates, including the built-in CUBIC
+     * \return the number of candidates
+     */
+    uint32_t GetCandidateCount() const;
+
+    /**
+     * \brief Get the index of the candidate of a given type
+     * \param tid TypeId of the candidate, or of AdaptiveTcp for the built-in CUBIC
+     * \return the index of the candidate, or GetCandidateCount() if there is none
+     */
+    uint32_t GetCandidateIndex(TypeId tid) const;
+
+    /**
+     * \brief Get the index of the active candidate
+     * \return the index of the active candidate
+     */
+    uint32_t GetActiveCandidate() const;
+
   private:
     bool m_fastConvergence; //!< Enable or disable fast convergence algorithm
     bool m_tcpFriendliness; //!< Enable or disable TCP-friendliness heuristic
@@ -108,7 +207,8 @@ class AdaptiveTcp : public TcpCongestionOps
     uint32_t m_initialCwnd; //!< Initial cWnd
     uint8_t m_cntClamp;     //!< Modulo of the (avoided) float division for cWnd
 
-    double m_c; //!< Cubic Scaling factor
+    double m_c;        //!< Cubic Scaling factor
+    bool m_fixedPoint; //!< Use the integer arithmetic of Linux in Update
 
     // Cubic parameters
     uint32_t m_cWndCnt;        //!<  cWnd integer-to-float counter
@@ -116,6 +216,8 @@ class AdaptiveTcp : public TcpCongestionOps
     uint32_t m_bicOriginPoint; //!<  Origin point of bic function
     double m_bicK;             //!<  Time to origin point from the beginning
                                //    of the current epoch (in s)
+    uint32_t m_bicKFixed;      //!<  m_bicK in 1/1024 s, in fixed-point mode
+    uint64_t m_cubeRttScale;   //!<  C in 1/1024, in fixed-point mode
     Time m_delayMin;           //!<  Min delay
     Time m_epochStart;         //!<  Beginning of an epoch
     bool m_found;              //!<  The exit point is found?
@@ -128,6 +230,19 @@ class AdaptiveTcp : public TcpCongestionOps
     uint32_t m_ackCnt;         //!<  Count the number of ACKed packets
     uint32_t m_tcpCwnd;        //!<  Estimated tcp cwnd (for Reno-friendliness)
 
+    // Switching parameters
+    std::string m_candidateTypes;                   //!< Candidate TypeId names, ';' separated
+    std::vector<Ptr<TcpCongestionOps>> m_candidates; //!< Forked candidates, index 0 unused
+    uint32_t m_active{0};                           //!< Index of the active candidate
+    uint32_t m_pendingSwitch{0};                    //!< Requested candidate, if m_switchPending
+    bool m_switchPending{false};                    //!< Whether a switch is requested
+    bool m_socketPacing{false};                     //!< Pacing setting of the socket at Init
+    DecisionCallback m_decision;                    //!< Decision callback
+    Time m_measureStart;                            //!< Beginning of the measured round
+    SequenceNumber32 m_measureStartSeq;             //!< Last acked seq at the round start
+    SequenceNumber32 m_measureEndSeq;               //!< Round ends when this seq is acked
+    TracedCallback<const std::string&, const std::string&> m_switchTrace; //!< Switch trace
+
   private:
     /**
      * \brief Reset HyStart parameters
@@ -149,6 +264,29 @@ class AdaptiveTcp : public TcpCongestionOps
      */
     uint32_t Update(Ptr<TcpSocketState> tcb, uint32_t segmentsAcked);
 
+    /**
+     * \brief Compute the cubic target of Update in fixed-point arithmetic
+     *
+     * Follows bictcp_update() of Linux: time is counted in 1/1024 s and
+     * K is obtained with CubicRoot() instead of std::pow.
+     *
+     * \param segCwnd Congestion window in segments
+     * \param newEpoch Whether a new epoch just started
+     * \returns the window target (in segments)
+     */
+    uint32_t FixedPointTarget(uint32_t segCwnd, bool newEpoch);
+
+    /**
+     * \brief Integer cube root, as cubic_root() of Linux
+     *
+     * A 64-entry lookup table gives a first estimate that is refined by one
+     * Newton-Raphson iteration. The average relative error is about 0.2%.
+     *
+     * \param a The value
+     * \returns the cube root of a
+     */
+    static uint32_t CubicRoot(uint64_t a);
+
     /**
      * \brief Update HyStart parameters
      *
@@ -168,6 +306,25 @@ class AdaptiveTcp : public TcpCongestionOps
      * value
      */
     Time HystartDelayThresh(const Time& t) const;
+
+    /**
+     * \brief Get the active candidate
+     * \return the active candidate, or nullptr when the built-in CUBIC is active
+     */
+    Ptr<TcpCongestionOps> GetActive() const;
+
+    /**
+     * \brief Update the round trip measurements and apply pending switches
+     * \param tcb Transmission Control Block of the connection
+     */
+    void UpdateSwitching(Ptr<TcpSocketState> tcb);
+
+    /**
+     * \brief Make a candidate active, following the state-transfer contract
+     * \param tcb Transmission Control Block of the connection
+     * \param candidate Index of the new candidate
+     */
+    void SwitchTo(Ptr<TcpSocketState> tcb, uint32_t candidate);
 };
 
 } // namespace ns3
@@ -11,6 +11,7 @@
 
 #include "ns3/header.h"
 #include "ns3/ipv4-address.h"
+#include "ns3/packet-header-cache.h"
 
 namespace ns3
 {
@@ -254,6 +255,14 @@ class Ipv4Header : public Header
     uint16_t m_headerSize;     //!< IP header size
 };
 
+/**
+ * \brief The Ipv4Header can be kept in the cache of the deserialized headers.
+ */
+template <>
+struct IsCacheableHeader<Ipv4Header> : std::true_type
+{
+};
+
 } // namespace ns3
 
 #endif /* IPV4_HEADER_H */
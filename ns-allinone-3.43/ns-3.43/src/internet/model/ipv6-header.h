@@ -11,6 +11,7 @@
 
 #include "ns3/header.h"
 #include "ns3/ipv6-address.h"
+#include "ns3/packet-header-cache.h"
 
 namespace ns3
 {
@@ -297,6 +298,14 @@ class Ipv6Header : public Header
     Ipv6Address m_destinationAddress;
 };
 
+/**
+ * \brief The Ipv6Header can be kept in the cache of the deserialized headers.
+ */
+template <>
+struct IsCacheableHeader<Ipv6Header> : std::true_type
+{
+};
+
 } /* namespace ns3 */
 
 #endif /* IPV6_HEADER_H */
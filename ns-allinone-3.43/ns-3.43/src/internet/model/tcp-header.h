@@ -16,6 +16,7 @@
 #include "ns3/header.h"
 #include "ns3/ipv4-address.h"
 #include "ns3/ipv6-address.h"
+#include "ns3/packet-header-cache.h"
 #include "ns3/sequence-number.h"
 
 #include <stdint.h>
@@ -339,6 +340,14 @@ class TcpHeader : public Header
     uint8_t m_optionsLen{0};                   //!< Tcp options length.
 };
 
+/**
+ * \brief The TcpHeader can be kept in the cache of the deserialized headers.
+ */
+template <>
+struct IsCacheableHeader<TcpHeader> : std::true_type
+{
+};
+
 } // namespace ns3
 
 #endif /* TCP_HEADER */
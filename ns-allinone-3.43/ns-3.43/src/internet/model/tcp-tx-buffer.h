@@ -536,11 +536,12 @@ class TcpTxBuffer : public Object
      * Merge operation is required when the requested block span over two (or more)
      * existing packets.
      *
-     * While this could be extremely slow in the worst possible scenario (one big
-     * packet which is split in small packets for transmission, and merged for
-     * re-transmission) that scenario is unlikely during a TCP transmission (since
-     * MSS can change, but it is stable, and retransmissions do not happen for
-     * each segment).
+     * Neither operation copies the data: a fragment shares the bytes of the
+     * original packet, and a merged packet chains the bytes of its parts (see
+     * Packet::AddAtEnd). Even the worst possible scenario (one big packet which
+     * is split in small packets for transmission, and merged for
+     * re-transmission) thus costs a number of operations proportional to the
+     * number of parts rather than to the number of bytes.
      *
      * \param list List to extract block from
      * \param startingSeq Starting sequence of the list
@@ -560,7 +561,8 @@ class TcpTxBuffer : public Object
      *
      * Merge t2 in t1. It consists in copying the lastSent field if t2 is more
      * recent than t1. Retransmitted field is copied only if it set in t2 but not
-     * in t1. Sacked is copied only if it is true in both items.
+     * in t1. Sacked is copied only if it is true in both items. The bytes of t2
+     * are chained after those of t1 rather than copied.
      *
      * \param t1 first item
      * \param t2 second item
@@ -12,6 +12,7 @@
 #include "ns3/header.h"
 #include "ns3/ipv4-address.h"
 #include "ns3/ipv6-address.h"
+#include "ns3/packet-header-cache.h"
 
 #include <stdint.h>
 #include <string>
@@ -165,6 +166,14 @@ class UdpHeader : public Header
     bool m_goodChecksum{true};  //!< Flag to indicate that checksum is correct
 };
 
+/**
+ * \brief The UdpHeader can be kept in the cache of the deserialized headers.
+ */
+template <>
+struct IsCacheableHeader<UdpHeader> : std::true_type
+{
+};
+
 } // namespace ns3
 
 #endif /* UDP_HEADER */
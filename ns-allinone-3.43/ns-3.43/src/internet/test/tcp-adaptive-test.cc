@@ -0,0 +1,263 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ */
+
+#include "ns3/adaptive-tcp.h"
+#include "ns3/boolean.h"
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/tcp-congestion-ops.h"
+#include "ns3/tcp-vegas.h"
+#include "ns3/test.h"
+
+#include <vector>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE("TcpAdaptiveTestSuite");
+
+/**
+ * \ingroup internet-test
+ *
+ * \brief Create an AdaptiveTcp with NewReno and Vegas candidates and a state in
+ * congestion avoidance.
+ *
+ * \param state The state to initialize
+ * \return the initialized AdaptiveTcp
+ */
+static Ptr<AdaptiveTcp>
+CreateAdaptiveTcp(Ptr<TcpSocketState> state)
+{
+    state->m_segmentSize = 1000;
+    state->m_cWnd = 20 * 1000;
+    state->m_ssThresh = 10 * 1000;
+    state->m_congState = TcpSocketState::CA_OPEN;
+    state->m_minRtt = MilliSeconds(10);
+    state->m_highTxMark = SequenceNumber32(20000);
+    state->m_lastAckedSeq = SequenceNumber32(0);
+
+    Ptr<AdaptiveTcp> cong = CreateObject<AdaptiveTcp>();
+    cong->SetAttribute("Candidates", StringValue("ns3::TcpNewReno;ns3::TcpVegas"));
+    cong->Init(state);
+    return cong;
+}
+
+/**
+ * \ingroup internet-test
+ *
+ * \brief Check that a requested switch keeps the operating point and then
+ * forwards every call to the new candidate.
+ */
+class TcpAdaptiveSwitchTest : public TestCase
+{
+  public:
+    TcpAdaptiveSwitchTest()
+        : TestCase("AdaptiveTcp switch and state handoff")
+    {
+    }
+
+  private:
+    void DoRun() override;
+};
+
+void
+TcpAdaptiveSwitchTest::DoRun()
+{
+    Ptr<TcpSocketState> state = CreateObject<TcpSocketState>();
+    Ptr<AdaptiveTcp> cong = CreateAdaptiveTcp(state);
+
+    NS_TEST_ASSERT_MSG_EQ(cong->GetCandidateCount(), 3, "Built-in CUBIC plus two candidates");
+    uint32_t newReno = cong->GetCandidateIndex(TcpNewReno::GetTypeId());
+    NS_TEST_ASSERT_MSG_EQ(newReno, 1, "Candidates keep the configured order");
+    NS_TEST_ASSERT_MSG_EQ(cong->GetCandidateIndex(AdaptiveTcp::GetTypeId()), 0, "Built-in CUBIC");
+    NS_TEST_ASSERT_MSG_EQ(cong->GetCandidateIndex(TcpVegas::GetTypeId()), 2, "Vegas candidate");
+
+    // No switch in the middle of a recovery
+    cong->RequestSwitch(newReno);
+    state->m_congState = TcpSocketState::CA_RECOVERY;
+    cong->PktsAcked(state, 1, MilliSeconds(10));
+    NS_TEST_ASSERT_MSG_EQ(cong->GetActiveCandidate(), 0, "Switch applied during recovery");
+
+    state->m_congState = TcpSocketState::CA_OPEN;
+    cong->PktsAcked(state, 1, MilliSeconds(10));
+    NS_TEST_ASSERT_MSG_EQ(cong->GetActiveCandidate(), newReno, "Switch not applied");
+    NS_TEST_ASSERT_MSG_EQ(state->m_cWnd.Get(), 20000, "cWnd not carried over");
+    NS_TEST_ASSERT_MSG_EQ(state->m_ssThresh.Get(), 10000, "ssThresh not carried over");
+
+    // From now on, AdaptiveTcp behaves exactly like NewReno
+    Ptr<TcpSocketState> referenceState = CopyObject(state);
+    Ptr<TcpNewReno> reference = CreateObject<TcpNewReno>();
+    cong->IncreaseWindow(state, 1);
+    reference->IncreaseWindow(referenceState, 1);
+    NS_TEST_ASSERT_MSG_EQ(state->m_cWnd.Get(),
+                          referenceState->m_cWnd.Get(),
+                          "IncreaseWindow not forwarded");
+    NS_TEST_ASSERT_MSG_EQ(cong->GetSsThresh(state, 20000),
+                          reference->GetSsThresh(referenceState, 20000),
+                          "GetSsThresh not forwarded");
+
+    // Forked sockets get their own candidates
+    Ptr<AdaptiveTcp> forked = DynamicCast<AdaptiveTcp>(cong->Fork());
+    NS_TEST_ASSERT_MSG_EQ(forked->GetActiveCandidate(), newReno, "Fork lost the active candidate");
+    NS_TEST_ASSERT_MSG_EQ(forked->GetCandidateCount(), 3, "Fork lost candidates");
+
+    Simulator::Destroy();
+}
+
+/**
+ * \ingroup internet-test
+ *
+ * \brief Check that the decision callback is called once per round with the
+ * measured delivery rate, and that its choice is applied.
+ */
+class TcpAdaptiveDecisionTest : public TestCase
+{
+  public:
+    TcpAdaptiveDecisionTest()
+        : TestCase("AdaptiveTcp decision callback")
+    {
+    }
+
+  private:
+    void DoRun() override;
+
+    /**
+     * \brief Decision callback choosing Vegas
+     * \param measurement Measurements of the last round
+     * \return the Vegas candidate
+     */
+    uint32_t Decide(const AdaptiveTcp::Measurement& measurement);
+
+    uint32_t m_decisions{0};         //!< Number of decisions taken
+    AdaptiveTcp::Measurement m_last; //!< Last measurement
+};
+
+uint32_t
+TcpAdaptiveDecisionTest::Decide(const AdaptiveTcp::Measurement& measurement)
+{
+    m_decisions++;
+    m_last = measurement;
+    return 2;
+}
+
+void
+TcpAdaptiveDecisionTest::DoRun()
+{
+    Ptr<TcpSocketState> state = CreateObject<TcpSocketState>();
+    Ptr<AdaptiveTcp> cong = CreateAdaptiveTcp(state);
+    cong->SetDecisionCallback(MakeCallback(&TcpAdaptiveDecisionTest::Decide, this));
+
+    // Half of the round is acked after 5 ms, the rest after 10 ms
+    Simulator::Schedule(MilliSeconds(5), [=]() {
+        state->m_lastAckedSeq = SequenceNumber32(10000);
+        cong->PktsAcked(state, 10, MilliSeconds(10));
+    });
+    Simulator::Schedule(MilliSeconds(10), [=]() {
+        state->m_lastAckedSeq = SequenceNumber32(20000);
+        cong->PktsAcked(state, 10, MilliSeconds(10));
+    });
+    Simulator::Run();
+
+    NS_TEST_ASSERT_MSG_EQ(m_decisions, 1, "One decision per round");
+    NS_TEST_ASSERT_MSG_EQ(m_last.throughput, DataRate("16Mbps"), "20000 bytes in 10 ms");
+    NS_TEST_ASSERT_MSG_EQ(m_last.minRtt, MilliSeconds(10), "Wrong min RTT");
+    NS_TEST_ASSERT_MSG_EQ(cong->GetActiveCandidate(), 2, "Decision not applied");
+    NS_TEST_ASSERT_MSG_EQ(state->m_cWnd.Get(), 20000, "cWnd not carried over");
+
+    Simulator::Destroy();
+}
+
+/**
+ * \ingroup internet-test
+ *
+ * \brief Check that the fixed-point CUBIC follows the cWnd trajectory of the
+ * floating point one, across several loss epochs.
+ */
+class TcpAdaptiveFixedPointTest : public TestCase
+{
+  public:
+    TcpAdaptiveFixedPointTest()
+        : TestCase("AdaptiveTcp fixed-point cubic")
+    {
+    }
+
+  private:
+    void DoRun() override;
+
+    /**
+     * \brief Acknowledge one segment every 500 us, with a loss every 5000 ACKs
+     * \param fixedPoint Value of the FixedPoint attribute
+     * \return the cWnd (in segments) after every ACK
+     */
+    std::vector<uint32_t> RunCubic(bool fixedPoint);
+};
+
+std::vector<uint32_t>
+TcpAdaptiveFixedPointTest::RunCubic(bool fixedPoint)
+{
+    Ptr<TcpSocketState> state = CreateObject<TcpSocketState>();
+    state->m_segmentSize = 1000;
+    state->m_cWnd = 100 * 1000;
+    state->m_ssThresh = 50 * 1000;
+    state->m_isCwndLimited = true;
+
+    Ptr<AdaptiveTcp> cong = CreateObject<AdaptiveTcp>();
+    cong->SetAttribute("FixedPoint", BooleanValue(fixedPoint));
+    cong->Init(state);
+    cong->PktsAcked(state, 1, MilliSeconds(50));
+
+    std::vector<uint32_t> cwnds;
+    for (uint32_t i = 1; i <= 20000; i++)
+    {
+        Simulator::Schedule(MicroSeconds(500) * i, [=, &cwnds]() {
+            if (i % 5000 == 0)
+            {
+                state->m_ssThresh = cong->GetSsThresh(state, state->m_cWnd);
+                state->m_cWnd = state->m_ssThresh.Get();
+            }
+            cong->IncreaseWindow(state, 1);
+            cwnds.push_back(state->GetCwndInSegments());
+        });
+    }
+    Simulator::Run();
+    Simulator::Destroy();
+    return cwnds;
+}
+
+void
+TcpAdaptiveFixedPointTest::DoRun()
+{
+    std::vector<uint32_t> floating = RunCubic(false);
+    std::vector<uint32_t> fixed = RunCubic(true);
+
+    NS_TEST_ASSERT_MSG_EQ(fixed.size(), floating.size(), "Missing ACKs");
+    NS_TEST_ASSERT_MSG_GT(floating.back(), 100, "The window did not grow");
+    for (uint32_t i = 0; i < floating.size(); i++)
+    {
+        NS_TEST_ASSERT_MSG_EQ_TOL(fixed[i],
+                                  floating[i],
+                                  floating[i] / 100 + 1,
+                                  "Trajectories diverge at ACK " << i);
+    }
+}
+
+/**
+ * \ingroup internet-test
+ *
+ * \brief AdaptiveTcp TestSuite
+ */
+class TcpAdaptiveTestSuite : public TestSuite
+{
+  public:
+    TcpAdaptiveTestSuite()
+        : TestSuite("tcp-adaptive-test", Type::UNIT)
+    {
+        AddTestCase(new TcpAdaptiveSwitchTest(), TestCase::Duration::QUICK);
+        AddTestCase(new TcpAdaptiveDecisionTest(), TestCase::Duration::QUICK);
+        AddTestCase(new TcpAdaptiveFixedPointTest(), TestCase::Duration::QUICK);
+    }
+};
+
+static TcpAdaptiveTestSuite g_tcpAdaptiveTest; //!< Static variable for test initialization
@@ -0,0 +1,211 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+/**
+ * \file
+ * \ingroup mtp
+ *
+ * The dumbbell topology of the simple-distributed example of the mpi
+ * module, run by the MultithreadedSimulatorImpl: the left half of the
+ * nodes has system id 0 and runs in the main thread, the right half has
+ * system id 1 and runs in a second thread.
+ *
+ *                 -------   -------
+ *                 THREAD 0  THREAD 1
+ *                 ------- | -------
+ *                         |
+ * n0 ---------|           |           |---------- n6
+ *             |           |           |
+ * n1 -------\ |           |           | /------- n7
+ *            n4 ----------|---------- n5
+ * n2 -------/ |           |           | \------- n8
+ *             |           |           |
+ * n3 ---------|           |           |---------- n9
+ *
+ * OnOff clients are placed on each left leaf node, and send to a packet
+ * sink on a right leaf node. The packets crossing the link between n4
+ * and n5 are deep copied for the other thread instead of being
+ * serialized.
+ *
+ * Unlike the MPI examples, every process builds and runs the whole
+ * topology: the applications are installed on all the nodes, without
+ * checking the system id. Run with --sequential to compare with the
+ * DefaultSimulatorImpl.
+ */
+
+#include "ns3/core-module.h"
+#include "ns3/internet-stack-helper.h"
+#include "ns3/ipv4-address-helper.h"
+#include "ns3/ipv4-global-routing-helper.h"
+#include "ns3/network-module.h"
+#include "ns3/on-off-helper.h"
+#include "ns3/packet-sink-helper.h"
+#include "ns3/packet-sink.h"
+#include "ns3/point-to-point-helper.h"
+
+#include <chrono>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE("SimpleMultithreaded");
+
+int
+main(int argc, char* argv[])
+{
+    bool sequential = false;
+    bool verbose = false;
+    uint32_t leaves = 4;
+    std::string dataRate = "1Mbps";
+
+    // Parse command line
+    CommandLine cmd(__FILE__);
+    cmd.AddValue("sequential", "Run with the default, sequential, simulator", sequential);
+    cmd.AddValue("leaves", "Number of leaf nodes on each side", leaves);
+    cmd.AddValue("dataRate", "Data rate of every client", dataRate);
+    cmd.AddValue("verbose", "verbose output", verbose);
+    cmd.Parse(argc, argv);
+
+    if (!sequential)
+    {
+        GlobalValue::Bind("SimulatorImplementationType",
+                          StringValue("ns3::MultithreadedSimulatorImpl"));
+    }
+
+    if (verbose)
+    {
+        LogComponentEnable("PacketSink",
+                           (LogLevel)(LOG_LEVEL_INFO | LOG_PREFIX_NODE | LOG_PREFIX_TIME));
+    }
+
+    // Some default values
+    Config::SetDefault("ns3::OnOffApplication::PacketSize", UintegerValue(512));
+    Config::SetDefault("ns3::OnOffApplication::DataRate", StringValue(dataRate));
+
+    // Create leaf nodes on left with system id 0
+    NodeContainer leftLeafNodes;
+    leftLeafNodes.Create(leaves, 0);
+
+    // Create router nodes.  Left router
+    // with system id 0, right router with
+    // system id 1
+    NodeContainer routerNodes;
+    Ptr<Node> routerNode1 = CreateObject<Node>(0);
+    Ptr<Node> routerNode2 = CreateObject<Node>(1);
+    routerNodes.Add(routerNode1);
+    routerNodes.Add(routerNode2);
+
+    // Create leaf nodes on right with system id 1
+    NodeContainer rightLeafNodes;
+    rightLeafNodes.Create(leaves, 1);
+
+    PointToPointHelper routerLink;
+    routerLink.SetDeviceAttribute("DataRate", StringValue("1Gbps"));
+    routerLink.SetChannelAttribute("Delay", StringValue("5ms"));
+
+    PointToPointHelper leafLink;
+    leafLink.SetDeviceAttribute("DataRate", StringValue("1Gbps"));
+    leafLink.SetChannelAttribute("Delay", StringValue("2ms"));
+
+    // Add link connecting routers
+    NetDeviceContainer routerDevices;
+    routerDevices = routerLink.Install(routerNodes);
+
+    // Add links for left side leaf nodes to left router
+    NetDeviceContainer leftRouterDevices;
+    NetDeviceContainer leftLeafDevices;
+    for (uint32_t i = 0; i < leaves; ++i)
+    {
+        NetDeviceContainer temp = leafLink.Install(leftLeafNodes.Get(i), routerNodes.Get(0));
+        leftLeafDevices.Add(temp.Get(0));
+        leftRouterDevices.Add(temp.Get(1));
+    }
+
+    // Add links for right side leaf nodes to right router
+    NetDeviceContainer rightRouterDevices;
+    NetDeviceContainer rightLeafDevices;
+    for (uint32_t i = 0; i < leaves; ++i)
+    {
+        NetDeviceContainer temp = leafLink.Install(rightLeafNodes.Get(i), routerNodes.Get(1));
+        rightLeafDevices.Add(temp.Get(0));
+        rightRouterDevices.Add(temp.Get(1));
+    }
+
+    InternetStackHelper stack;
+    stack.InstallAll();
+
+    Ipv4AddressHelper leftAddress;
+    leftAddress.SetBase("10.1.1.0", "255.255.255.0");
+
+    Ipv4AddressHelper routerAddress;
+    routerAddress.SetBase("10.2.1.0", "255.255.255.0");
+
+    Ipv4AddressHelper rightAddress;
+    rightAddress.SetBase("10.3.1.0", "255.255.255.0");
+
+    // Router-to-Router interfaces
+    routerAddress.Assign(routerDevices);
+
+    // Left interfaces
+    for (uint32_t i = 0; i < leaves; ++i)
+    {
+        NetDeviceContainer ndc;
+        ndc.Add(leftLeafDevices.Get(i));
+        ndc.Add(leftRouterDevices.Get(i));
+        leftAddress.Assign(ndc);
+        leftAddress.NewNetwork();
+    }
+
+    // Right interfaces
+    Ipv4InterfaceContainer rightLeafInterfaces;
+    for (uint32_t i = 0; i < leaves; ++i)
+    {
+        NetDeviceContainer ndc;
+        ndc.Add(rightLeafDevices.Get(i));
+        ndc.Add(rightRouterDevices.Get(i));
+        Ipv4InterfaceContainer ifc = rightAddress.Assign(ndc);
+        rightLeafInterfaces.Add(ifc.Get(0));
+        rightAddress.NewNetwork();
+    }
+
+    Ipv4GlobalRoutingHelper::PopulateRoutingTables();
+
+    // Create a packet sink on the right leafs to receive packets from left leafs
+    uint16_t port = 50000;
+    Address sinkLocalAddress(InetSocketAddress(Ipv4Address::GetAny(), port));
+    PacketSinkHelper sinkHelper("ns3::UdpSocketFactory", sinkLocalAddress);
+    ApplicationContainer sinkApps = sinkHelper.Install(rightLeafNodes);
+    sinkApps.Start(Seconds(1.0));
+    sinkApps.Stop(Seconds(5));
+
+    // Create the OnOff applications to send
+    OnOffHelper clientHelper("ns3::UdpSocketFactory", Address());
+    clientHelper.SetAttribute("OnTime", StringValue("ns3::ConstantRandomVariable[Constant=1]"));
+    clientHelper.SetAttribute("OffTime", StringValue("ns3::ConstantRandomVariable[Constant=0]"));
+
+    ApplicationContainer clientApps;
+    for (uint32_t i = 0; i < leaves; ++i)
+    {
+        AddressValue remoteAddress(InetSocketAddress(rightLeafInterfaces.GetAddress(i), port));
+        clientHelper.SetAttribute("Remote", remoteAddress);
+        clientApps.Add(clientHelper.Install(leftLeafNodes.Get(i)));
+    }
+    clientApps.Start(Seconds(1.0));
+    clientApps.Stop(Seconds(5));
+
+    Simulator::Stop(Seconds(5));
+    auto start = std::chrono::steady_clock::now();
+    Simulator::Run();
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    uint64_t totalRx = 0;
+    for (uint32_t i = 0; i < leaves; ++i)
+    {
+        totalRx += DynamicCast<PacketSink>(sinkApps.Get(i))->GetTotalRx();
+    }
+    std::cout << "Received " << totalRx << " bytes, " << Simulator::GetEventCount()
+              << " events in " << elapsed.count() << " s" << std::endl;
+
+    Simulator::Destroy();
+    return 0;
+}
@@ -0,0 +1,250 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "logical-process.h"
+
+#include "ns3/assert.h"
+#include "ns3/event-impl.h"
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+
+#include <algorithm>
+#include <limits>
+
+/**
+ * \file
+ * \ingroup mtp
+ * ns3::LogicalProcess implementation.
+ */
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("LogicalProcess");
+
+LogicalProcess::LogicalProcess(uint32_t systemId, Ptr<Scheduler> events)
+    : m_systemId(systemId),
+      m_events(events),
+      m_mailbox(nullptr),
+      m_earliestPostedTs(std::numeric_limits<uint64_t>::max()),
+      m_uid(EventId::UID::VALID),
+      m_currentUid(EventId::UID::INVALID),
+      m_currentTs(0),
+      m_currentContext(Simulator::NO_CONTEXT),
+      m_eventCount(0),
+      m_unscheduledEvents(0)
+{
+    NS_LOG_FUNCTION(this << systemId << events);
+}
+
+LogicalProcess::~LogicalProcess()
+{
+    NS_LOG_FUNCTION(this);
+    Dispose();
+}
+
+uint32_t
+LogicalProcess::GetSystemId() const
+{
+    return m_systemId;
+}
+
+void
+LogicalProcess::SetScheduler(Ptr<Scheduler> events)
+{
+    NS_LOG_FUNCTION(this << events);
+    while (!m_events->IsEmpty())
+    {
+        events->Insert(m_events->RemoveNext());
+    }
+    m_events = events;
+}
+
+EventId
+LogicalProcess::Schedule(uint64_t ts, uint32_t context, EventImpl* event)
+{
+    NS_ASSERT_MSG(ts >= m_currentTs, "Event scheduled in the past of system id " << m_systemId);
+    Scheduler::Event ev;
+    ev.impl = event;
+    ev.key.m_ts = ts;
+    ev.key.m_context = context;
+    ev.key.m_uid = m_uid;
+    m_uid++;
+    m_unscheduledEvents++;
+    m_events->Insert(ev);
+    return EventId(event, ev.key.m_ts, ev.key.m_context, ev.key.m_uid);
+}
+
+void
+LogicalProcess::Post(uint64_t ts, uint32_t context, EventImpl* event, LogicalProcess* source)
+{
+    auto message = new Message;
+    message->ev.impl = event;
+    message->ev.key.m_ts = ts;
+    message->ev.key.m_context = context;
+    message->ev.key.m_uid = source->m_uid;
+    message->source = source->m_systemId;
+    source->m_uid++;
+    source->m_earliestPostedTs = std::min(source->m_earliestPostedTs, ts);
+
+    // The release ordering publishes the event to the thread which takes
+    // the mailbox, after the next barrier of the simulator.
+    message->next = m_mailbox.load(std::memory_order_relaxed);
+    while (!m_mailbox.compare_exchange_weak(message->next,
+                                            message,
+                                            std::memory_order_release,
+                                            std::memory_order_relaxed))
+    {
+    }
+}
+
+void
+LogicalProcess::ReceiveMessages()
+{
+    Message* message = m_mailbox.exchange(nullptr, std::memory_order_acquire);
+    if (message == nullptr)
+    {
+        return;
+    }
+    for (; message != nullptr; message = message->next)
+    {
+        m_received.push_back(message);
+    }
+    std::sort(m_received.begin(), m_received.end(), [](const Message* a, const Message* b) {
+        if (a->ev.key.m_ts != b->ev.key.m_ts)
+        {
+            return a->ev.key.m_ts < b->ev.key.m_ts;
+        }
+        if (a->source != b->source)
+        {
+            return a->source < b->source;
+        }
+        return a->ev.key.m_uid < b->ev.key.m_uid;
+    });
+    NS_LOG_LOGIC("system id " << m_systemId << " receives " << m_received.size() << " events");
+    for (Message* received : m_received)
+    {
+        Schedule(received->ev.key.m_ts, received->ev.key.m_context, received->ev.impl);
+        delete received;
+    }
+    m_received.clear();
+}
+
+uint64_t
+LogicalProcess::TakeEarliestPostedTs()
+{
+    uint64_t ts = m_earliestPostedTs;
+    m_earliestPostedTs = std::numeric_limits<uint64_t>::max();
+    return ts;
+}
+
+uint64_t
+LogicalProcess::GetNextTs() const
+{
+    if (m_events->IsEmpty())
+    {
+        return std::numeric_limits<uint64_t>::max();
+    }
+    return m_events->PeekNext().key.m_ts;
+}
+
+void
+LogicalProcess::ProcessEvents(uint64_t end)
+{
+    while (!m_events->IsEmpty())
+    {
+        if (m_events->PeekNext().key.m_ts >= end)
+        {
+            break;
+        }
+        Scheduler::Event next = m_events->RemoveNext();
+        NS_ASSERT(next.key.m_ts >= m_currentTs);
+        m_unscheduledEvents--;
+        m_eventCount.store(m_eventCount.load(std::memory_order_relaxed) + 1,
+                           std::memory_order_relaxed);
+
+        m_currentTs = next.key.m_ts;
+        m_currentContext = next.key.m_context;
+        m_currentUid = next.key.m_uid;
+        next.impl->Invoke();
+        next.impl->Unref();
+    }
+}
+
+bool
+LogicalProcess::IsEmpty() const
+{
+    return m_events->IsEmpty();
+}
+
+uint64_t
+LogicalProcess::GetCurrentTs() const
+{
+    return m_currentTs;
+}
+
+uint32_t
+LogicalProcess::GetContext() const
+{
+    return m_currentContext;
+}
+
+uint64_t
+LogicalProcess::GetEventCount() const
+{
+    return m_eventCount.load(std::memory_order_relaxed);
+}
+
+void
+LogicalProcess::Remove(const EventId& id)
+{
+    if (IsExpired(id))
+    {
+        return;
+    }
+    Scheduler::Event event;
+    event.impl = id.PeekEventImpl();
+    event.key.m_ts = id.GetTs();
+    event.key.m_context = id.GetContext();
+    event.key.m_uid = id.GetUid();
+    m_events->Remove(event);
+    event.impl->Cancel();
+    // whenever we remove an event from the event list, we have to unref it.
+    event.impl->Unref();
+
+    m_unscheduledEvents--;
+}
+
+bool
+LogicalProcess::IsExpired(const EventId& id) const
+{
+    return id.PeekEventImpl() == nullptr || id.GetTs() < m_currentTs ||
+           (id.GetTs() == m_currentTs && id.GetUid() <= m_currentUid) ||
+           id.PeekEventImpl()->IsCancelled();
+}
+
+void
+LogicalProcess::Dispose()
+{
+    NS_LOG_FUNCTION(this);
+    Message* message = m_mailbox.exchange(nullptr, std::memory_order_acquire);
+    while (message != nullptr)
+    {
+        Message* next = message->next;
+        message->ev.impl->Unref();
+        delete message;
+        message = next;
+    }
+    if (m_events)
+    {
+        while (!m_events->IsEmpty())
+        {
+            Scheduler::Event next = m_events->RemoveNext();
+            next.impl->Unref();
+        }
+        m_events = nullptr;
+    }
+}
+
+} // namespace ns3
@@ -0,0 +1,184 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef NS3_LOGICAL_PROCESS_H
+#define NS3_LOGICAL_PROCESS_H
+
+#include "ns3/event-id.h"
+#include "ns3/ptr.h"
+#include "ns3/scheduler.h"
+
+#include <atomic>
+#include <stdint.h>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup mtp
+ * ns3::LogicalProcess declaration.
+ */
+
+namespace ns3
+{
+
+class EventImpl;
+
+/**
+ * \ingroup mtp
+ *
+ * \brief The events of the nodes of one system id, in a multithreaded
+ * simulation.
+ *
+ * A logical process has its own event queue, clock and event uids, and is
+ * run by a single thread. Events are inserted directly in the event queue
+ * by that thread, or by any thread while the simulation is not running.
+ * The threads of the other logical processes post their events for this
+ * one to its mailbox, a lock-free list which is moved to the event queue
+ * at the start of every time window of the MultithreadedSimulatorImpl.
+ *
+ * Events are posted with the uid of the logical process which posts them,
+ * and received in (timestamp, posting logical process, uid) order, so the
+ * order of simultaneous events does not depend on the thread schedule.
+ */
+class LogicalProcess
+{
+  public:
+    /**
+     * Create a logical process.
+     *
+     * \param [in] systemId The system id of the nodes of the logical process.
+     * \param [in] events The event queue.
+     */
+    LogicalProcess(uint32_t systemId, Ptr<Scheduler> events);
+    /** Destructor. */
+    ~LogicalProcess();
+
+    // Delete copy constructor and assignment operator to avoid misuse
+    LogicalProcess(const LogicalProcess&) = delete;
+    LogicalProcess& operator=(const LogicalProcess&) = delete;
+
+    /**
+     * \returns The system id of the nodes of the logical process.
+     */
+    uint32_t GetSystemId() const;
+
+    /**
+     * Replace the event queue, moving the pending events to the new one.
+     *
+     * \param [in] events The new event queue.
+     */
+    void SetScheduler(Ptr<Scheduler> events);
+
+    /**
+     * Insert an event in the event queue.
+     *
+     * Only the thread which runs the logical process, or any thread
+     * while the simulation is not running, can insert events.
+     *
+     * \param [in] ts The absolute timestamp of the event.
+     * \param [in] context The context of the event.
+     * \param [in] event The event.
+     * \returns The id of the event.
+     */
+    EventId Schedule(uint64_t ts, uint32_t context, EventImpl* event);
+
+    /**
+     * Post an event of another logical process to the mailbox.
+     *
+     * The event is received by the next call to ReceiveMessages().
+     *
+     * \param [in] ts The absolute timestamp of the event.
+     * \param [in] context The context of the event.
+     * \param [in] event The event.
+     * \param [in] source The logical process which posts the event, run
+     *             by the calling thread.
+     */
+    void Post(uint64_t ts, uint32_t context, EventImpl* event, LogicalProcess* source);
+
+    /** Move the events of the mailbox to the event queue. */
+    void ReceiveMessages();
+
+    /**
+     * Get the earliest timestamp of the events posted to other logical
+     * processes since the last call, and forget it.
+     *
+     * \returns The earliest timestamp, or the largest timestamp if no
+     *          event was posted.
+     */
+    uint64_t TakeEarliestPostedTs();
+
+    /**
+     * \returns The timestamp of the next event, or the largest timestamp
+     *          if the event queue is empty.
+     */
+    uint64_t GetNextTs() const;
+
+    /**
+     * Run the events before the end of a time window.
+     *
+     * \param [in] end The end of the time window, excluded.
+     */
+    void ProcessEvents(uint64_t end);
+
+    /**
+     * \returns \c true if the event queue is empty.
+     */
+    bool IsEmpty() const;
+
+    /**
+     * \returns The timestamp of the current event.
+     */
+    uint64_t GetCurrentTs() const;
+
+    /**
+     * \returns The context of the current event.
+     */
+    uint32_t GetContext() const;
+
+    /**
+     * \returns The number of events executed.
+     */
+    uint64_t GetEventCount() const;
+
+    /**
+     * Remove a pending event from the event queue.
+     *
+     * \param [in] id The event.
+     */
+    void Remove(const EventId& id);
+
+    /**
+     * \param [in] id The event.
+     * \returns \c true if the event was executed, cancelled or removed.
+     */
+    bool IsExpired(const EventId& id) const;
+
+    /** Release the pending events, including the events of the mailbox. */
+    void Dispose();
+
+  private:
+    /** An event posted by another logical process. */
+    struct Message
+    {
+        Message* next;       //!< Next message of the mailbox
+        Scheduler::Event ev; //!< The event, with the uid of the source
+        uint32_t source;     //!< System id of the source
+    };
+
+    uint32_t m_systemId;                //!< System id of the nodes
+    Ptr<Scheduler> m_events;            //!< Event queue
+    std::atomic<Message*> m_mailbox;    //!< Posted events, last first
+    std::vector<Message*> m_received;   //!< Messages being received
+    uint64_t m_earliestPostedTs;        //!< Earliest event posted since the last window
+    uint32_t m_uid;                     //!< Next event uid
+    uint32_t m_currentUid;              //!< Uid of the current event
+    uint64_t m_currentTs;               //!< Timestamp of the current event
+    uint32_t m_currentContext;          //!< Context of the current event
+    std::atomic<uint64_t> m_eventCount; //!< Events executed, read by other threads
+    int m_unscheduledEvents;            //!< Events in the event queue, for validation
+};
+
+} // namespace ns3
+
+#endif /* NS3_LOGICAL_PROCESS_H */
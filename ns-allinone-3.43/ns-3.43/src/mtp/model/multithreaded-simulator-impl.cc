@@ -0,0 +1,574 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "multithreaded-simulator-impl.h"
+
+#include "logical-process.h"
+
+#include "ns3/abort.h"
+#include "ns3/assert.h"
+#include "ns3/channel.h"
+#include "ns3/log.h"
+#include "ns3/net-device.h"
+#include "ns3/node-list.h"
+#include "ns3/node.h"
+#include "ns3/nstime.h"
+#include "ns3/scheduler.h"
+#include "ns3/simulator.h"
+
+#include <algorithm>
+#include <limits>
+
+/**
+ * \file
+ * \ingroup mtp
+ * ns3::MultithreadedSimulatorImpl implementation.
+ */
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("MultithreadedSimulatorImpl");
+
+NS_OBJECT_ENSURE_REGISTERED(MultithreadedSimulatorImpl);
+
+namespace
+{
+
+/** Timestamp of the events which never run. */
+constexpr uint64_t NEVER = std::numeric_limits<uint64_t>::max();
+
+/** The logical process run by the current thread, if any. */
+thread_local LogicalProcess* t_current = nullptr;
+
+} // namespace
+
+TypeId
+MultithreadedSimulatorImpl::GetTypeId()
+{
+    static TypeId tid = TypeId("ns3::MultithreadedSimulatorImpl")
+                            .SetParent<SimulatorImpl>()
+                            .SetGroupName("Mtp")
+                            .AddConstructor<MultithreadedSimulatorImpl>();
+    return tid;
+}
+
+MultithreadedSimulatorImpl::MultithreadedSimulatorImpl()
+    : m_stop(false),
+      m_lookAheadBound(NEVER),
+      m_lookAhead(NEVER),
+      m_windowEnd(0),
+      m_finished(false),
+      m_quit(false),
+      m_running(false),
+      m_windowCount(0),
+      m_currentTs(0)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+MultithreadedSimulatorImpl::~MultithreadedSimulatorImpl()
+{
+    NS_LOG_FUNCTION(this);
+    StopThreads();
+}
+
+void
+MultithreadedSimulatorImpl::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    StopThreads();
+    for (auto& lp : m_lps)
+    {
+        lp->Dispose();
+    }
+    m_lps.clear();
+    m_partitionOfNode.clear();
+    SimulatorImpl::DoDispose();
+}
+
+void
+MultithreadedSimulatorImpl::Destroy()
+{
+    NS_LOG_FUNCTION(this);
+    while (true)
+    {
+        Ptr<EventImpl> ev;
+        {
+            std::unique_lock lock{m_mutex};
+            if (m_destroyEvents.empty())
+            {
+                break;
+            }
+            ev = m_destroyEvents.front().PeekEventImpl();
+            m_destroyEvents.pop_front();
+        }
+        NS_LOG_LOGIC("handle destroy " << ev);
+        if (!ev->IsCancelled())
+        {
+            ev->Invoke();
+        }
+    }
+}
+
+void
+MultithreadedSimulatorImpl::SetScheduler(ObjectFactory schedulerFactory)
+{
+    NS_LOG_FUNCTION(this << schedulerFactory);
+    NS_ABORT_MSG_IF(m_running, "Cannot change the scheduler while the simulation runs");
+    m_schedulerFactory = schedulerFactory;
+    for (auto& lp : m_lps)
+    {
+        lp->SetScheduler(m_schedulerFactory.Create<Scheduler>());
+    }
+}
+
+void
+MultithreadedSimulatorImpl::BoundLookAhead(const Time lookAhead)
+{
+    if (lookAhead > Time(0))
+    {
+        NS_LOG_FUNCTION(this << lookAhead);
+        m_lookAheadBound = std::min(m_lookAheadBound, (uint64_t)lookAhead.GetTimeStep());
+    }
+    else
+    {
+        NS_LOG_WARN("attempted to set lookahead to a negative time: " << lookAhead);
+    }
+}
+
+void
+MultithreadedSimulatorImpl::UpdatePartitions()
+{
+    uint32_t nNodes = NodeList::GetNNodes();
+    for (uint32_t i = m_partitionOfNode.size(); i < nNodes; ++i)
+    {
+        m_partitionOfNode.push_back(NodeList::GetNode(i)->GetSystemId());
+    }
+    uint32_t nPartitions = 1;
+    for (uint32_t systemId : m_partitionOfNode)
+    {
+        nPartitions = std::max(nPartitions, systemId + 1);
+    }
+    NS_ABORT_MSG_IF(m_start && nPartitions > m_lps.size(),
+                    "Nodes of a new system id were created after the first Simulator::Run");
+    while (m_lps.size() < nPartitions)
+    {
+        m_lps.push_back(std::make_unique<LogicalProcess>(m_lps.size(),
+                                                         m_schedulerFactory.Create<Scheduler>()));
+    }
+}
+
+void
+MultithreadedSimulatorImpl::CalculateLookAhead()
+{
+    NS_LOG_FUNCTION(this);
+    m_lookAhead = NEVER;
+    for (auto node = NodeList::Begin(); node != NodeList::End(); ++node)
+    {
+        for (uint32_t i = 0; i < (*node)->GetNDevices(); ++i)
+        {
+            Ptr<NetDevice> localNetDevice = (*node)->GetDevice(i);
+            // only works for p2p links currently
+            if (!localNetDevice->IsPointToPoint())
+            {
+                continue;
+            }
+            Ptr<Channel> channel = localNetDevice->GetChannel();
+            if (!channel || channel->GetNDevices() != 2)
+            {
+                continue;
+            }
+            // The channel looks up its receivers here, in the main thread,
+            // instead of in the thread of the first transmission.
+            channel->Initialize();
+
+            Ptr<Node> remoteNode;
+            if (channel->GetDevice(0) == localNetDevice)
+            {
+                remoteNode = channel->GetDevice(1)->GetNode();
+            }
+            else
+            {
+                remoteNode = channel->GetDevice(0)->GetNode();
+            }
+            if (remoteNode->GetSystemId() == (*node)->GetSystemId())
+            {
+                continue;
+            }
+            TimeValue delay;
+            if (channel->GetAttributeFailSafe("Delay", delay))
+            {
+                m_lookAhead = std::min(m_lookAhead, (uint64_t)delay.Get().GetTimeStep());
+            }
+        }
+    }
+    m_lookAhead = std::min(m_lookAhead, m_lookAheadBound);
+    NS_ABORT_MSG_IF(m_lps.size() > 1 && m_lookAhead == 0,
+                    "Zero delay channel between nodes of different system ids");
+    NS_LOG_LOGIC("lookahead " << m_lookAhead << " over " << m_lps.size() << " partitions");
+}
+
+LogicalProcess*
+MultithreadedSimulatorImpl::GetLogicalProcess(uint32_t context) const
+{
+    if (context < m_partitionOfNode.size())
+    {
+        return m_lps[m_partitionOfNode[context]].get();
+    }
+    return m_lps[0].get();
+}
+
+void
+MultithreadedSimulatorImpl::StartThreads()
+{
+    if (m_start)
+    {
+        return;
+    }
+    NS_LOG_FUNCTION(this << m_lps.size());
+    m_start = std::make_unique<std::barrier<>>(m_lps.size());
+    m_window =
+        std::make_unique<std::barrier<WindowCompletion>>(m_lps.size(), WindowCompletion{this});
+    m_nextTs.assign(m_lps.size(), NEVER);
+    for (std::size_t i = 1; i < m_lps.size(); ++i)
+    {
+        m_threads.emplace_back(&MultithreadedSimulatorImpl::DoWork, this, m_lps[i].get());
+    }
+}
+
+void
+MultithreadedSimulatorImpl::StopThreads()
+{
+    if (!m_start)
+    {
+        return;
+    }
+    NS_LOG_FUNCTION(this);
+    m_quit = true;
+    m_start->arrive_and_wait();
+    for (auto& thread : m_threads)
+    {
+        thread.join();
+    }
+    m_threads.clear();
+    m_start.reset();
+    m_window.reset();
+    m_quit = false;
+}
+
+void
+MultithreadedSimulatorImpl::DoWork(LogicalProcess* lp)
+{
+    while (true)
+    {
+        m_start->arrive_and_wait();
+        if (m_quit)
+        {
+            return;
+        }
+        RunWindows(lp);
+    }
+}
+
+void
+MultithreadedSimulatorImpl::RunWindows(LogicalProcess* lp)
+{
+    t_current = lp;
+    uint32_t systemId = lp->GetSystemId();
+    while (true)
+    {
+        // The events posted during the window are still in the mailboxes
+        // of the other logical processes: account for them here.
+        m_nextTs[systemId] = std::min(lp->GetNextTs(), lp->TakeEarliestPostedTs());
+        m_window->arrive_and_wait();
+        if (m_finished)
+        {
+            break;
+        }
+        lp->ReceiveMessages();
+        lp->ProcessEvents(m_windowEnd);
+    }
+    t_current = nullptr;
+}
+
+void
+MultithreadedSimulatorImpl::WindowCompletion::operator()() noexcept
+{
+    impl->ComputeWindow();
+}
+
+void
+MultithreadedSimulatorImpl::ComputeWindow()
+{
+    uint64_t next = *std::min_element(m_nextTs.begin(), m_nextTs.end());
+    uint64_t stopTs = NEVER;
+    {
+        std::unique_lock lock{m_mutex};
+        if (!m_stopTimes.empty())
+        {
+            stopTs = *m_stopTimes.begin();
+            if (next > stopTs)
+            {
+                // All the events up to the stop time have run.
+                m_stopTimes.erase(m_stopTimes.begin());
+                m_currentTs = stopTs;
+                m_finished = true;
+                return;
+            }
+        }
+    }
+    if (m_stop.load(std::memory_order_relaxed) || next == NEVER)
+    {
+        m_finished = true;
+        return;
+    }
+    m_windowEnd = next > NEVER - m_lookAhead ? NEVER : next + m_lookAhead;
+    if (stopTs < m_windowEnd)
+    {
+        m_windowEnd = stopTs + 1;
+    }
+    m_windowCount++;
+}
+
+void
+MultithreadedSimulatorImpl::Run()
+{
+    NS_LOG_FUNCTION(this);
+    NS_ABORT_MSG_IF(t_current != nullptr, "Simulator::Run called from an event");
+    UpdatePartitions();
+    CalculateLookAhead();
+    StartThreads();
+
+    m_stop = false;
+    m_finished = false;
+    m_running = true;
+    m_start->arrive_and_wait();
+    RunWindows(m_lps[0].get());
+    m_running = false;
+
+    for (auto& lp : m_lps)
+    {
+        m_currentTs = std::max(m_currentTs, lp->GetCurrentTs());
+    }
+    NS_LOG_LOGIC(m_windowCount << " time windows run");
+}
+
+bool
+MultithreadedSimulatorImpl::IsFinished() const
+{
+    if (m_stop)
+    {
+        return true;
+    }
+    for (const auto& lp : m_lps)
+    {
+        if (!lp->IsEmpty())
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void
+MultithreadedSimulatorImpl::Stop()
+{
+    NS_LOG_FUNCTION(this);
+    m_stop = true;
+}
+
+EventId
+MultithreadedSimulatorImpl::Stop(const Time& delay)
+{
+    NS_LOG_FUNCTION(this << delay.GetTimeStep());
+    NS_ASSERT_MSG(delay.IsPositive(), "MultithreadedSimulatorImpl::Stop(): Negative delay");
+    std::unique_lock lock{m_mutex};
+    m_stopTimes.insert((uint64_t)(delay + Now()).GetTimeStep());
+    return EventId();
+}
+
+EventId
+MultithreadedSimulatorImpl::Schedule(const Time& delay, EventImpl* event)
+{
+    NS_ASSERT_MSG(delay.IsPositive(), "MultithreadedSimulatorImpl::Schedule(): Negative delay");
+    LogicalProcess* lp = t_current;
+    if (lp == nullptr)
+    {
+        NS_ABORT_MSG_IF(m_running,
+                        "Simulator::Schedule called by a thread outside of the simulation");
+        UpdatePartitions();
+        return m_lps[0]->Schedule(m_currentTs + delay.GetTimeStep(),
+                                  Simulator::NO_CONTEXT,
+                                  event);
+    }
+    return lp->Schedule(lp->GetCurrentTs() + delay.GetTimeStep(), lp->GetContext(), event);
+}
+
+void
+MultithreadedSimulatorImpl::ScheduleWithContext(uint32_t context,
+                                                const Time& delay,
+                                                EventImpl* event)
+{
+    NS_LOG_FUNCTION(this << context << delay.GetTimeStep() << event);
+    LogicalProcess* lp = t_current;
+    if (lp == nullptr)
+    {
+        NS_ABORT_MSG_IF(m_running,
+                        "Simulator::ScheduleWithContext called by a thread outside of the "
+                        "simulation");
+        UpdatePartitions();
+        GetLogicalProcess(context)->Schedule(m_currentTs + delay.GetTimeStep(), context, event);
+        return;
+    }
+    uint64_t ts = lp->GetCurrentTs() + delay.GetTimeStep();
+    LogicalProcess* target = GetLogicalProcess(context);
+    if (target == lp)
+    {
+        lp->Schedule(ts, context, event);
+        return;
+    }
+    NS_ABORT_MSG_IF(ts < m_windowEnd,
+                    "Event for node " << context << " of system id " << target->GetSystemId()
+                                      << " scheduled by system id " << lp->GetSystemId()
+                                      << " within the lookahead");
+    target->Post(ts, context, event, lp);
+}
+
+EventId
+MultithreadedSimulatorImpl::ScheduleNow(EventImpl* event)
+{
+    return Schedule(Time(0), event);
+}
+
+EventId
+MultithreadedSimulatorImpl::ScheduleDestroy(EventImpl* event)
+{
+    std::unique_lock lock{m_mutex};
+    EventId id(Ptr<EventImpl>(event, false), Now().GetTimeStep(), 0xffffffff, 2);
+    m_destroyEvents.push_back(id);
+    return id;
+}
+
+Time
+MultithreadedSimulatorImpl::Now() const
+{
+    // Do not add function logging here, to avoid stack overflow
+    if (t_current != nullptr)
+    {
+        return TimeStep(t_current->GetCurrentTs());
+    }
+    return TimeStep(m_currentTs);
+}
+
+Time
+MultithreadedSimulatorImpl::GetDelayLeft(const EventId& id) const
+{
+    if (IsExpired(id))
+    {
+        return TimeStep(0);
+    }
+    return TimeStep(id.GetTs()) - Now();
+}
+
+void
+MultithreadedSimulatorImpl::Remove(const EventId& id)
+{
+    if (id.GetUid() == EventId::UID::DESTROY)
+    {
+        // destroy events.
+        std::unique_lock lock{m_mutex};
+        for (auto i = m_destroyEvents.begin(); i != m_destroyEvents.end(); i++)
+        {
+            if (*i == id)
+            {
+                m_destroyEvents.erase(i);
+                break;
+            }
+        }
+        return;
+    }
+    LogicalProcess* lp = GetLogicalProcess(id.GetContext());
+    NS_ABORT_MSG_IF(m_running && lp != t_current,
+                    "Event of system id " << lp->GetSystemId() << " removed by another thread");
+    lp->Remove(id);
+}
+
+void
+MultithreadedSimulatorImpl::Cancel(const EventId& id)
+{
+    if (!IsExpired(id))
+    {
+        id.PeekEventImpl()->Cancel();
+    }
+}
+
+bool
+MultithreadedSimulatorImpl::IsExpired(const EventId& id) const
+{
+    if (id.GetUid() == EventId::UID::DESTROY)
+    {
+        if (id.PeekEventImpl() == nullptr || id.PeekEventImpl()->IsCancelled())
+        {
+            return true;
+        }
+        // destroy events.
+        std::unique_lock lock{m_mutex};
+        for (auto i = m_destroyEvents.begin(); i != m_destroyEvents.end(); i++)
+        {
+            if (*i == id)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+    if (m_lps.empty())
+    {
+        return true;
+    }
+    LogicalProcess* lp = GetLogicalProcess(id.GetContext());
+    NS_ABORT_MSG_IF(m_running && lp != t_current,
+                    "Event of system id " << lp->GetSystemId() << " checked by another thread");
+    return lp->IsExpired(id);
+}
+
+Time
+MultithreadedSimulatorImpl::GetMaximumSimulationTime() const
+{
+    return TimeStep(0x7fffffffffffffffLL);
+}
+
+uint32_t
+MultithreadedSimulatorImpl::GetSystemId() const
+{
+    if (t_current != nullptr)
+    {
+        return t_current->GetSystemId();
+    }
+    return 0;
+}
+
+uint32_t
+MultithreadedSimulatorImpl::GetContext() const
+{
+    if (t_current != nullptr)
+    {
+        return t_current->GetContext();
+    }
+    return Simulator::NO_CONTEXT;
+}
+
+uint64_t
+MultithreadedSimulatorImpl::GetEventCount() const
+{
+    uint64_t count = 0;
+    for (const auto& lp : m_lps)
+    {
+        count += lp->GetEventCount();
+    }
+    return count;
+}
+
+} // namespace ns3
@@ -0,0 +1,213 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef NS3_MULTITHREADED_SIMULATOR_IMPL_H
+#define NS3_MULTITHREADED_SIMULATOR_IMPL_H
+
+#include "ns3/event-impl.h"
+#include "ns3/object-factory.h"
+#include "ns3/simulator-impl.h"
+
+#include <atomic>
+#include <barrier>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup mtp
+ * ns3::MultithreadedSimulatorImpl declaration.
+ */
+
+namespace ns3
+{
+
+class LogicalProcess;
+
+/**
+ * \ingroup simulator
+ * \ingroup mtp
+ *
+ * \brief Parallel simulator implementation running the nodes of every
+ * system id in its own thread, in a single process.
+ *
+ * The nodes are partitioned by system id, as for the
+ * DistributedSimulatorImpl, and the events of each partition are run by a
+ * LogicalProcess. The main thread runs the logical process of system id
+ * 0, and one worker thread is started for every other system id at the
+ * first call to Run().
+ *
+ * The logical processes run conservative time windows. At the end of a
+ * window they meet at a barrier, which computes the next window from the
+ * earliest pending event of all partitions and the lookahead: the
+ * smallest delay of the point-to-point channels between nodes of
+ * different system ids, or the bound set with BoundLookAhead(). An event
+ * scheduled for a node of another system id is posted to a lock-free
+ * mailbox of its logical process, which receives it at the start of the
+ * next window. The packets crossing partitions are deep copied by the
+ * PointToPointChannel instead of being serialized.
+ *
+ * The same events run in the same order for every thread schedule:
+ *
+ * - Simulator::Stop(delay) ends the simulation after the events of all
+ *   partitions at the stop time. It returns an invalid EventId: the stop
+ *   cannot be cancelled.
+ * - Simulator::Stop() ends the simulation at the end of the current time
+ *   window.
+ * - Simultaneous events received from other partitions are ordered by
+ *   the system id and the event order of the partition which sent them.
+ *
+ * Events can only be removed or cancelled by the logical process which
+ * runs them. All the nodes must be created before the first call to
+ * Run().
+ */
+class MultithreadedSimulatorImpl : public SimulatorImpl
+{
+  public:
+    /**
+     *  Register this type.
+     *  \return The object TypeId.
+     */
+    static TypeId GetTypeId();
+
+    /** Default constructor. */
+    MultithreadedSimulatorImpl();
+    /** Destructor. */
+    ~MultithreadedSimulatorImpl() override;
+
+    // virtual from SimulatorImpl
+    void Destroy() override;
+    bool IsFinished() const override;
+    void Stop() override;
+    EventId Stop(const Time& delay) override;
+    EventId Schedule(const Time& delay, EventImpl* event) override;
+    void ScheduleWithContext(uint32_t context, const Time& delay, EventImpl* event) override;
+    EventId ScheduleNow(EventImpl* event) override;
+    EventId ScheduleDestroy(EventImpl* event) override;
+    void Remove(const EventId& id) override;
+    void Cancel(const EventId& id) override;
+    bool IsExpired(const EventId& id) const override;
+    void Run() override;
+    Time Now() const override;
+    Time GetDelayLeft(const EventId& id) const override;
+    Time GetMaximumSimulationTime() const override;
+    void SetScheduler(ObjectFactory schedulerFactory) override;
+    uint32_t GetSystemId() const override;
+    uint32_t GetContext() const override;
+    uint64_t GetEventCount() const override;
+
+    /**
+     * Add additional bound to lookahead constraints.
+     *
+     * The method may be invoked more than once, the minimum time will
+     * be used to constrain lookahead.
+     *
+     * \param [in] lookAhead The maximum lookahead; must be > 0.
+     */
+    void BoundLookAhead(const Time lookAhead);
+
+  private:
+    // Inherited from Object
+    void DoDispose() override;
+
+    /** Barrier completion step computing the next time window. */
+    struct WindowCompletion
+    {
+        MultithreadedSimulatorImpl* impl; //!< The simulator
+
+        /** Compute the next time window. */
+        void operator()() noexcept;
+    };
+
+    /**
+     * Map the nodes created since the last call to their logical process,
+     * creating the logical processes of new system ids.
+     */
+    void UpdatePartitions();
+    /**
+     * Calculate the lookahead from the point-to-point channels between
+     * nodes of different system ids, and locate the receivers of these
+     * channels before the threads start.
+     */
+    void CalculateLookAhead();
+    /**
+     * Get the logical process running the events of a context.
+     *
+     * \param [in] context The context, a node id or another value.
+     * \returns The logical process of the node, or of system id 0.
+     */
+    LogicalProcess* GetLogicalProcess(uint32_t context) const;
+    /** Start a thread for every logical process but the first one. */
+    void StartThreads();
+    /** Stop and join the threads. */
+    void StopThreads();
+    /**
+     * Body of the worker threads.
+     *
+     * \param [in] lp The logical process of the thread.
+     */
+    void DoWork(LogicalProcess* lp);
+    /**
+     * Run the time windows of a logical process until the end of the
+     * simulation.
+     *
+     * \param [in] lp The logical process.
+     */
+    void RunWindows(LogicalProcess* lp);
+    /** Compute the next time window from the earliest events. */
+    void ComputeWindow();
+
+    /** Container type for the events to run at Simulator::Destroy(). */
+    typedef std::list<EventId> DestroyEvents;
+
+    /** The container of events to run at Destroy() */
+    DestroyEvents m_destroyEvents;
+    /** Mutex protecting m_destroyEvents and m_stopTimes. */
+    mutable std::mutex m_mutex;
+    /** Pending stop times, in timesteps. */
+    std::multiset<uint64_t> m_stopTimes;
+    /** Flag calling for the end of the simulation. */
+    std::atomic<bool> m_stop;
+    /** The factory of the event queues. */
+    ObjectFactory m_schedulerFactory;
+
+    /** The logical processes, indexed by system id. */
+    std::vector<std::unique_ptr<LogicalProcess>> m_lps;
+    /** The system id of each node, indexed by node id. */
+    std::vector<uint32_t> m_partitionOfNode;
+    /** The lookahead bound set with BoundLookAhead(), in timesteps. */
+    uint64_t m_lookAheadBound;
+    /** The lookahead, in timesteps. */
+    uint64_t m_lookAhead;
+
+    /** The worker threads, running the logical processes 1 and above. */
+    std::vector<std::thread> m_threads;
+    /** Barrier releasing the worker threads for a run, or to quit. */
+    std::unique_ptr<std::barrier<>> m_start;
+    /** Barrier between the time windows. */
+    std::unique_ptr<std::barrier<WindowCompletion>> m_window;
+    /** Earliest event of each logical process, at the end of the window. */
+    std::vector<uint64_t> m_nextTs;
+    /** End of the current time window, excluded. */
+    uint64_t m_windowEnd;
+    /** \c true when the last time window has been run. */
+    bool m_finished;
+    /** \c true to terminate the worker threads. */
+    bool m_quit;
+    /** \c true while Run() runs the logical processes. */
+    bool m_running;
+    /** Number of time windows run. */
+    uint64_t m_windowCount;
+
+    /** Timestamp at the end of the last run. */
+    uint64_t m_currentTs;
+};
+
+} // namespace ns3
+
+#endif /* NS3_MULTITHREADED_SIMULATOR_IMPL_H */
@@ -0,0 +1,227 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/global-value.h"
+#include "ns3/multithreaded-simulator-impl.h"
+#include "ns3/node.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/test.h"
+
+#include <algorithm>
+#include <tuple>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup mtp-tests
+ * MultithreadedSimulatorImpl test suite.
+ */
+
+/**
+ * \ingroup mtp
+ * \defgroup mtp-tests Multithreaded simulator tests
+ */
+
+using namespace ns3;
+
+/**
+ * \ingroup mtp-tests
+ *
+ * \brief Check that the multithreaded simulator runs the same events as
+ * the default simulator.
+ *
+ * Chains of events hop between nodes of different system ids, with
+ * delays of at least the lookahead, and run local events in between.
+ * The events run by every node are compared with a sequential run.
+ */
+class MtpSameEventsTestCase : public TestCase
+{
+  public:
+    /**
+     * Constructor.
+     *
+     * \param [in] scheduler The event queue type.
+     * \param [in] stop The stop time, or zero to run until the end.
+     */
+    MtpSameEventsTestCase(const std::string& scheduler, Time stop);
+
+  private:
+    void DoRun() override;
+
+    /** An event run by a node: timestamp, chain and hops left. */
+    using Record = std::tuple<int64_t, uint32_t, uint32_t>;
+
+    /**
+     * Run the chains of events.
+     *
+     * \param [in] simulatorType The simulator implementation.
+     * \returns The events run by every node.
+     */
+    std::vector<std::vector<Record>> RunChains(const std::string& simulatorType);
+    /**
+     * Event of a chain.
+     *
+     * \param [in] node The node running the event.
+     * \param [in] chain The chain.
+     * \param [in] hops The hops left.
+     */
+    void Hop(uint32_t node, uint32_t chain, uint32_t hops);
+    /**
+     * Local event of a chain.
+     *
+     * \param [in] node The node running the event.
+     * \param [in] chain The chain.
+     */
+    void Local(uint32_t node, uint32_t chain);
+
+    static constexpr uint32_t N_NODES = 8;   //!< Nodes, on 4 system ids
+    static constexpr uint32_t N_CHAINS = 16; //!< Chains of events
+    static constexpr uint32_t N_HOPS = 150;  //!< Hops of every chain
+
+    std::string m_scheduler;                  //!< Event queue type
+    Time m_stop;                              //!< Stop time
+    std::vector<Ptr<Node>> m_nodes;           //!< The nodes
+    std::vector<std::vector<Record>> m_trace; //!< Events run, by node
+    std::vector<uint32_t> m_wrongSystemId;    //!< Events run by another system id, by node
+    bool m_multithreaded;                     //!< Run by the multithreaded simulator
+};
+
+MtpSameEventsTestCase::MtpSameEventsTestCase(const std::string& scheduler, Time stop)
+    : TestCase("Check the events of a multithreaded run with " + scheduler +
+               (stop.IsZero() ? "" : " and a stop time")),
+      m_scheduler(scheduler),
+      m_stop(stop),
+      m_multithreaded(false)
+{
+}
+
+void
+MtpSameEventsTestCase::Hop(uint32_t node, uint32_t chain, uint32_t hops)
+{
+    m_trace[node].emplace_back(Simulator::Now().GetTimeStep(), chain, hops);
+    if (m_multithreaded && Simulator::GetSystemId() != m_nodes[node]->GetSystemId())
+    {
+        m_wrongSystemId[node]++;
+    }
+    if (hops == 0)
+    {
+        return;
+    }
+    Simulator::Schedule(MicroSeconds(1 + (hops * 37 + node) % 5000),
+                        &MtpSameEventsTestCase::Local,
+                        this,
+                        node,
+                        chain);
+    uint32_t next = (node + 1 + (hops + chain) % 3) % N_NODES;
+    Simulator::ScheduleWithContext(next,
+                                   MilliSeconds(10) + MicroSeconds((hops * 13 + chain * 7) % 997),
+                                   &MtpSameEventsTestCase::Hop,
+                                   this,
+                                   next,
+                                   chain,
+                                   hops - 1);
+}
+
+void
+MtpSameEventsTestCase::Local(uint32_t node, uint32_t chain)
+{
+    m_trace[node].emplace_back(Simulator::Now().GetTimeStep(), chain, N_HOPS + 1);
+}
+
+std::vector<std::vector<MtpSameEventsTestCase::Record>>
+MtpSameEventsTestCase::RunChains(const std::string& simulatorType)
+{
+    GlobalValue::Bind("SimulatorImplementationType", StringValue(simulatorType));
+    GlobalValue::Bind("SchedulerType", StringValue(m_scheduler));
+    Ptr<MultithreadedSimulatorImpl> impl =
+        DynamicCast<MultithreadedSimulatorImpl>(Simulator::GetImplementation());
+    m_multithreaded = impl != nullptr;
+    if (m_multithreaded)
+    {
+        impl->BoundLookAhead(MilliSeconds(10));
+    }
+
+    m_nodes.clear();
+    for (uint32_t i = 0; i < N_NODES; ++i)
+    {
+        m_nodes.push_back(CreateObject<Node>(i % 4));
+    }
+    m_trace.assign(N_NODES, {});
+    m_wrongSystemId.assign(N_NODES, 0);
+    for (uint32_t chain = 0; chain < N_CHAINS; ++chain)
+    {
+        uint32_t node = chain % N_NODES;
+        Simulator::ScheduleWithContext(node,
+                                       MicroSeconds(chain * 101),
+                                       &MtpSameEventsTestCase::Hop,
+                                       this,
+                                       node,
+                                       chain,
+                                       N_HOPS);
+    }
+    if (!m_stop.IsZero())
+    {
+        Simulator::Stop(m_stop);
+    }
+    Simulator::Run();
+    if (!m_stop.IsZero())
+    {
+        NS_TEST_EXPECT_MSG_EQ(Simulator::Now(), m_stop, "Wrong time after the stop");
+    }
+    for (uint32_t i = 0; i < N_NODES; ++i)
+    {
+        NS_TEST_EXPECT_MSG_EQ(m_wrongSystemId[i],
+                              0,
+                              "Events of node " << i << " in another thread");
+    }
+    Simulator::Destroy();
+    m_nodes.clear();
+
+    GlobalValue::Bind("SimulatorImplementationType", StringValue("ns3::DefaultSimulatorImpl"));
+    GlobalValue::Bind("SchedulerType", StringValue("ns3::MapScheduler"));
+
+    // Simultaneous events of a node may be ordered differently.
+    for (auto& trace : m_trace)
+    {
+        std::sort(trace.begin(), trace.end());
+    }
+    return m_trace;
+}
+
+void
+MtpSameEventsTestCase::DoRun()
+{
+    auto expected = RunChains("ns3::DefaultSimulatorImpl");
+    auto trace = RunChains("ns3::MultithreadedSimulatorImpl");
+    for (uint32_t i = 0; i < N_NODES; ++i)
+    {
+        NS_TEST_ASSERT_MSG_GT(expected[i].size(), 0, "No event run by node " << i);
+        NS_TEST_ASSERT_MSG_EQ(trace[i].size(),
+                              expected[i].size(),
+                              "Wrong event count of node " << i);
+        NS_TEST_EXPECT_MSG_EQ((trace[i] == expected[i]), true, "Wrong events of node " << i);
+    }
+}
+
+/**
+ * \ingroup mtp-tests
+ *
+ * \brief The multithreaded simulator test suite.
+ */
+class MtpTestSuite : public TestSuite
+{
+  public:
+    MtpTestSuite();
+};
+
+MtpTestSuite::MtpTestSuite()
+    : TestSuite("mtp", Type::UNIT)
+{
+    AddTestCase(new MtpSameEventsTestCase("ns3::MapScheduler", Time(0)));
+    AddTestCase(new MtpSameEventsTestCase("ns3::HeapScheduler", Time(0)));
+    AddTestCase(new MtpSameEventsTestCase("ns3::MapScheduler", MilliSeconds(500)));
+}
+
+static MtpTestSuite g_mtpTestSuite; //!< Static variable for test initialization
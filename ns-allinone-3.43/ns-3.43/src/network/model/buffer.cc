@@ -7,6 +7,8 @@
  */
 #include "buffer.h"
 
+#include "free-list-owner.h"
+
 #include "ns3/assert.h"
 #include "ns3/log.h"
 
@@ -43,7 +45,7 @@ namespace ns3
 
 NS_LOG_COMPONENT_DEFINE("Buffer");
 
-uint32_t Buffer::g_recommendedStart = 0;
+thread_local uint32_t Buffer::g_recommendedStart = 0;
 #ifdef BUFFER_FREE_LIST
 /* The following macros are pretty evil but they are needed to allow us to
  * keep track of 3 possible states for the g_freeList variable:
@@ -51,8 +53,8 @@ uint32_t Buffer::g_recommendedStart = 0;
  *    so no one has created the associated free list (it is created
  *    on-demand when the first buffer is created)
  *  - initialized means that the free list exists and is valid
- *  - destroyed means that the static destructors of this compilation unit
- *    have run so, the free list has been cleared from its content
+ *  - destroyed means that the thread local destructors of this compilation
+ *    unit have run so, the free list has been cleared from its content
  * The key is that in destroyed state, we are careful not re-create it
  * which is a typical weakness of lazy evaluation schemes which use
  * '0' as a special value to indicate both un-initialized and destroyed.
@@ -68,9 +70,10 @@ uint32_t Buffer::g_recommendedStart = 0;
 #define IS_INITIALIZED(x) (!IS_UNINITIALIZED(x) && !IS_DESTROYED(x))
 #define DESTROYED ((Buffer::FreeList*)MAGIC_DESTROYED)
 #define UNINITIALIZED ((Buffer::FreeList*)0)
-uint32_t Buffer::g_maxSize = 0;
-Buffer::FreeList* Buffer::g_freeList = nullptr;
-Buffer::LocalStaticDestructor Buffer::g_localStaticDestructor;
+thread_local uint32_t Buffer::g_maxSize = 0;
+thread_local Buffer::FreeList* Buffer::g_freeList = nullptr;
+thread_local FreeListOwner* Buffer::g_owner = nullptr;
+thread_local Buffer::LocalStaticDestructor Buffer::g_localStaticDestructor;
 
 Buffer::LocalStaticDestructor::~LocalStaticDestructor()
 {
@@ -83,6 +86,10 @@ Buffer::LocalStaticDestructor::~LocalStaticDestructor()
         }
         delete g_freeList;
         g_freeList = DESTROYED;
+        // The buffers of this thread released later by any thread
+        // are deallocated
+        g_owner->Close();
+        g_owner = nullptr;
     }
 }
 
@@ -91,6 +98,13 @@ Buffer::Recycle(Buffer::Data* data)
 {
     NS_LOG_FUNCTION(data);
     NS_ASSERT(data->m_count == 0);
+    if (g_owner == nullptr || FreeListOwner::GetOwner(data) != g_owner)
+    {
+        // Give the buffer back to the thread which allocated it, if
+        // this thread has no free list
+        FreeListOwner::Return(data);
+        return;
+    }
     NS_ASSERT(!IS_UNINITIALIZED(g_freeList));
     g_maxSize = std::max(g_maxSize, data->m_size);
     /* feed into free list */
@@ -113,9 +127,17 @@ Buffer::Create(uint32_t dataSize)
     if (IS_UNINITIALIZED(g_freeList))
     {
         g_freeList = new Buffer::FreeList();
+        g_owner = new FreeListOwner();
+        // Thread local objects are only constructed, and later destroyed,
+        // in the threads which use them
+        static_cast<void>(&g_localStaticDestructor);
     }
     else if (IS_INITIALIZED(g_freeList))
     {
+        if (g_freeList->empty())
+        {
+            g_owner->TakeReturned(*g_freeList);
+        }
         while (!g_freeList->empty())
         {
             Buffer::Data* data = g_freeList->back();
@@ -162,8 +184,12 @@ Buffer::Allocate(uint32_t reqSize)
     NS_ASSERT(reqSize >= 1);
     reqSize += ALLOC_OVER_PROVISION;
     uint32_t size = reqSize - 1 + sizeof(Buffer::Data);
+#ifdef BUFFER_FREE_LIST
+    auto data = static_cast<Buffer::Data*>(FreeListOwner::Allocate(g_owner, size));
+#else
     auto b = new uint8_t[size];
     auto data = reinterpret_cast<Buffer::Data*>(b);
+#endif
     data->m_size = reqSize;
     data->m_count = 1;
     return data;
@@ -174,8 +200,12 @@ Buffer::Deallocate(Buffer::Data* data)
 {
     NS_LOG_FUNCTION(data);
     NS_ASSERT(data->m_count == 0);
+#ifdef BUFFER_FREE_LIST
+    FreeListOwner::Deallocate(data);
+#else
     auto buf = reinterpret_cast<uint8_t*>(data);
     delete[] buf;
+#endif
 }
 
 Buffer::Buffer()
@@ -551,6 +581,23 @@ Buffer::CreateFullCopy() const
     return *this;
 }
 
+Buffer
+Buffer::CreateDeepCopy() const
+{
+    NS_LOG_FUNCTION(this);
+    NS_ASSERT(CheckInternalState());
+    Buffer tmp = *this;
+    tmp.m_data->m_count--;
+    tmp.m_data = Buffer::Create(m_data->m_size);
+    // The bytes after the virtual zero area follow the bytes before it
+    uint32_t used = m_end - (m_zeroAreaEnd - m_zeroAreaStart);
+    memcpy(tmp.m_data->m_data + m_start, m_data->m_data + m_start, used - m_start);
+    tmp.m_data->m_dirtyStart = m_data->m_dirtyStart;
+    tmp.m_data->m_dirtyEnd = m_data->m_dirtyEnd;
+    NS_ASSERT(tmp.CheckInternalState());
+    return tmp;
+}
+
 uint32_t
 Buffer::GetSerializedSize() const
 {
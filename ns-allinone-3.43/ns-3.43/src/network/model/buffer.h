@@ -19,6 +19,8 @@
 namespace ns3
 {
 
+class FreeListOwner;
+
 /**
  * \ingroup packet
  *
@@ -545,6 +547,14 @@ class Buffer
      */
     Buffer CreateFragment(uint32_t start, uint32_t length) const;
 
+    /**
+     * \brief Create a copy of the buffer which does not share its
+     * internal data with this buffer.
+     *
+     * \returns a copy of the buffer
+     */
+    Buffer CreateDeepCopy() const;
+
     /**
      * \return an Iterator which points to the
      * start of this Buffer.
@@ -758,7 +768,7 @@ class Buffer
      * writing data. i.e., m_start should be initialized to this
      * value.
      */
-    static uint32_t g_recommendedStart;
+    static thread_local uint32_t g_recommendedStart;
 
     /**
      * offset to the start of the virtual zero area from the start
@@ -791,9 +801,13 @@ class Buffer
         ~LocalStaticDestructor();
     };
 
-    static uint32_t g_maxSize;                            //!< Max observed data size
-    static FreeList* g_freeList;                          //!< Buffer data container
-    static LocalStaticDestructor g_localStaticDestructor; //!< Local static destructor
+    // Every thread has its own free list, so that buffers can be
+    // created and released by several threads of a parallel simulation
+    static thread_local uint32_t g_maxSize;   //!< Max observed data size
+    static thread_local FreeList* g_freeList; //!< Buffer data container
+    /** The owner of the buffer data allocated by this thread. */
+    static thread_local FreeListOwner* g_owner;
+    static thread_local LocalStaticDestructor g_localStaticDestructor; //!< Local static destructor
 #endif
 };
 
@@ -7,6 +7,8 @@
  */
 #include "byte-tag-list.h"
 
+#include "free-list-owner.h"
+
 #include "ns3/log.h"
 
 #include <cstring>
@@ -45,21 +47,34 @@ struct ByteTagListData
  *
  * Internal use only.
  */
-static class ByteTagListDataFreeList : public std::vector<ByteTagListData*>
+static thread_local class ByteTagListDataFreeList : public std::vector<ByteTagListData*>
 {
   public:
     ~ByteTagListDataFreeList();
-} g_freeList; //!< Container for struct ByteTagListData
+} g_freeList; //!< Container for struct ByteTagListData, one per thread
+
+/** Set when the free list of this thread has been destroyed. */
+static thread_local bool g_freeListDestroyed = false;
+
+static thread_local uint32_t g_maxSize = 0; //!< maximum data size (used for allocation)
 
-static uint32_t g_maxSize = 0; //!< maximum data size (used for allocation)
+/** The owner of the tag lists allocated by this thread. */
+static thread_local FreeListOwner* g_owner = nullptr;
 
 ByteTagListDataFreeList::~ByteTagListDataFreeList()
 {
     NS_LOG_FUNCTION(this);
     for (auto i = begin(); i != end(); i++)
     {
-        auto buffer = (uint8_t*)(*i);
-        delete[] buffer;
+        FreeListOwner::Deallocate(*i);
+    }
+    // Tag lists released later by this thread bypass the free list,
+    // and the tag lists of this thread released later are deallocated
+    g_freeListDestroyed = true;
+    if (g_owner != nullptr)
+    {
+        g_owner->Close();
+        g_owner = nullptr;
     }
 }
 #endif /* USE_FREE_LIST */
@@ -181,6 +196,22 @@ ByteTagList::operator=(const ByteTagList& o)
     return *this;
 }
 
+ByteTagList
+ByteTagList::CreateDeepCopy() const
+{
+    NS_LOG_FUNCTION(this);
+    ByteTagList copy = *this;
+    if (m_data != nullptr)
+    {
+        ByteTagListData* newData = copy.Allocate(m_used);
+        std::memcpy(&newData->data, &m_data->data, m_used);
+        newData->dirty = m_used;
+        copy.Deallocate(copy.m_data);
+        copy.m_data = newData;
+    }
+    return copy;
+}
+
 ByteTagList::~ByteTagList()
 {
     NS_LOG_FUNCTION(this);
@@ -344,7 +375,15 @@ ByteTagListData*
 ByteTagList::Allocate(uint32_t size)
 {
     NS_LOG_FUNCTION(this << size);
-    while (!g_freeList.empty())
+    if (g_owner == nullptr && !g_freeListDestroyed)
+    {
+        g_owner = new FreeListOwner();
+    }
+    if (g_owner != nullptr && g_freeList.empty())
+    {
+        g_owner->TakeReturned(g_freeList);
+    }
+    while (!g_freeListDestroyed && !g_freeList.empty())
     {
         ByteTagListData* data = g_freeList.back();
         g_freeList.pop_back();
@@ -355,11 +394,11 @@ ByteTagList::Allocate(uint32_t size)
             data->dirty = 0;
             return data;
         }
-        auto buffer = (uint8_t*)data;
-        delete[] buffer;
+        FreeListOwner::Deallocate(data);
     }
-    auto buffer = new uint8_t[std::max(size, g_maxSize) + sizeof(ByteTagListData) - 4];
-    auto data = (ByteTagListData*)buffer;
+    auto data = static_cast<ByteTagListData*>(
+        FreeListOwner::Allocate(g_owner,
+                                std::max(size, g_maxSize) + sizeof(ByteTagListData) - 4));
     data->count = 1;
     data->size = size;
     data->dirty = 0;
@@ -378,10 +417,16 @@ ByteTagList::Deallocate(ByteTagListData* data)
     data->count--;
     if (data->count == 0)
     {
-        if (g_freeList.size() > FREE_LIST_SIZE || data->size < g_maxSize)
+        if (g_owner == nullptr || FreeListOwner::GetOwner(data) != g_owner)
+        {
+            // Give the tag list back to the thread which allocated it, if
+            // this thread has no free list
+            FreeListOwner::Return(data);
+        }
+        else if (g_freeListDestroyed || g_freeList.size() > FREE_LIST_SIZE ||
+                 data->size < g_maxSize)
         {
-            auto buffer = (uint8_t*)data;
-            delete[] buffer;
+            FreeListOwner::Deallocate(data);
         }
         else
         {
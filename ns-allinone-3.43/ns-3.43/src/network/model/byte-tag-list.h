@@ -165,6 +165,12 @@ class ByteTagList
     ByteTagList& operator=(const ByteTagList& o);
     ~ByteTagList();
 
+    /**
+     * \returns a copy of this ByteTagList which does not share its
+     * data with this ByteTagList.
+     */
+    ByteTagList CreateDeepCopy() const;
+
     /**
      * \param tid the typeid of the tag added
      * \param bufferSize the size of the tag when its serialization will
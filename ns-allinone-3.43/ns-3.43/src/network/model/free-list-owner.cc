@@ -0,0 +1,138 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "free-list-owner.h"
+
+#include "ns3/assert.h"
+#include "ns3/log.h"
+
+#include <new>
+
+/**
+ * \file
+ * \ingroup packet
+ * ns3::FreeListOwner implementation.
+ */
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("FreeListOwner");
+
+FreeListOwner::FreeListOwner()
+    : m_count(1),
+      m_closed(false),
+      m_returned(nullptr),
+      m_blocks(0)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void*
+FreeListOwner::Allocate(FreeListOwner* owner, std::size_t size)
+{
+    auto header = static_cast<BlockHeader*>(::operator new(sizeof(BlockHeader) + size));
+    header->owner = owner;
+    header->next = nullptr;
+    if (owner != nullptr)
+    {
+        owner->m_blocks++;
+    }
+    return header + 1;
+}
+
+void
+FreeListOwner::Deallocate(void* block)
+{
+    BlockHeader* header = GetHeader(block);
+    FreeListOwner* owner = header->owner;
+    ::operator delete(header);
+    if (owner != nullptr)
+    {
+        NS_ASSERT(owner->m_blocks > 0);
+        owner->m_blocks--;
+    }
+}
+
+void
+FreeListOwner::Release(BlockHeader* header)
+{
+    FreeListOwner* owner = header->owner;
+    ::operator delete(header);
+    owner->Unref();
+}
+
+void
+FreeListOwner::Return(void* block)
+{
+    BlockHeader* header = GetHeader(block);
+    FreeListOwner* owner = header->owner;
+    if (owner == nullptr)
+    {
+        ::operator delete(header);
+        return;
+    }
+    // Keep the owner alive if its thread closes it and deallocates
+    // the block concurrently
+    owner->Ref();
+    header->next = owner->m_returned.load(std::memory_order_relaxed);
+    while (!owner->m_returned.compare_exchange_weak(header->next, header))
+    {
+    }
+    // Either the owner thread sees the block when it closes, or this
+    // thread sees that the owner is closed
+    if (owner->m_closed.load())
+    {
+        owner->DeallocateReturned();
+    }
+    owner->Unref();
+}
+
+void
+FreeListOwner::Close()
+{
+    NS_LOG_FUNCTION(this);
+    NS_ASSERT(!m_closed.load());
+    // From now on, the blocks are counted by the references
+    m_count.fetch_add(m_blocks);
+    m_closed.store(true);
+    DeallocateReturned();
+    Unref();
+}
+
+FreeListOwner::BlockHeader*
+FreeListOwner::TakeReturnedList()
+{
+    return m_returned.exchange(nullptr);
+}
+
+void
+FreeListOwner::DeallocateReturned()
+{
+    BlockHeader* header = TakeReturnedList();
+    while (header != nullptr)
+    {
+        BlockHeader* next = header->next;
+        Release(header);
+        header = next;
+    }
+}
+
+void
+FreeListOwner::Ref()
+{
+    m_count.fetch_add(1, std::memory_order_relaxed);
+}
+
+void
+FreeListOwner::Unref()
+{
+    if (m_count.fetch_sub(1, std::memory_order_acq_rel) == 1)
+    {
+        NS_LOG_LOGIC("delete owner " << this);
+        delete this;
+    }
+}
+
+} // namespace ns3
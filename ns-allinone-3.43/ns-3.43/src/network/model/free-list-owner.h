@@ -0,0 +1,191 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+#ifndef FREE_LIST_OWNER_H
+#define FREE_LIST_OWNER_H
+
+/**
+\file   free-list-owner.h
+\brief  Defines the owner of the memory blocks of a per-thread free list.
+*/
+
+#include <atomic>
+#include <cstddef>
+#include <stdint.h>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * \ingroup packet
+ *
+ * \brief The owner of the memory blocks of a per-thread free list.
+ *
+ * The Packet, Buffer, PacketMetadata, ByteTagList and PacketTagList
+ * keep the memory they release in free lists, one per thread. Every
+ * free list has an owner, which allocates its blocks. A block released
+ * by another thread, for instance when a packet crosses threads in a
+ * parallel simulation, is returned to the free list of its owner with
+ * a lock-free queue instead of being kept by the thread which released
+ * it. A thread which only creates packets thus keeps reusing their
+ * memory.
+ *
+ * This class is private to the free lists of the packets and users
+ * should never have to access it directly.
+ *
+ * \internal
+ *
+ * Every block is preceded by a hidden header which points to its owner.
+ * The owner is reference counted by its thread and by the blocks it
+ * allocated, so that the blocks can outlive the thread: the blocks
+ * returned after Close() are deallocated. While the thread runs, it
+ * counts its blocks without atomic operations, and they are added to
+ * the reference count when it exits.
+ */
+class FreeListOwner
+{
+  public:
+    /**
+     * \brief Create the owner of the free list of the current thread.
+     */
+    FreeListOwner();
+
+    /**
+     * \brief Allocate a block.
+     *
+     * \param [in] owner The owner of the block, or nullptr if the block
+     *             is never recycled.
+     * \param [in] size The size of the block.
+     * \returns the block.
+     */
+    static void* Allocate(FreeListOwner* owner, std::size_t size);
+    /**
+     * \brief Deallocate a block, from the thread of its owner, or a block
+     * without owner.
+     *
+     * \param [in] block The block.
+     */
+    static void Deallocate(void* block);
+    /**
+     * \brief Get the owner of a block.
+     *
+     * \param [in] block The block.
+     * \returns the owner of the block, or nullptr.
+     */
+    static FreeListOwner* GetOwner(const void* block);
+    /**
+     * \brief Return a block to the free list of its owner.
+     *
+     * This method is called by the threads other than the owner thread.
+     * The block is deallocated if its owner is closed.
+     *
+     * \param [in] block The block.
+     */
+    static void Return(void* block);
+
+    /**
+     * \brief Move the blocks returned by the other threads to the free
+     * list of the owner thread.
+     *
+     * \tparam T \deduced The type of the blocks of the free list.
+     * \param [in,out] freeList The free list of the owner thread.
+     */
+    template <typename T>
+    void TakeReturned(std::vector<T*>& freeList);
+    /**
+     * \brief Stop returning blocks to the free list, when the owner
+     * thread exits.
+     *
+     * The blocks returned later are deallocated, and the owner is
+     * deleted with its last block.
+     */
+    void Close();
+
+  private:
+    /**
+     * \brief The header of a block.
+     */
+    struct alignas(std::max_align_t) BlockHeader
+    {
+        FreeListOwner* owner; //!< the owner of the block
+        BlockHeader* next;    //!< the next block returned to the owner
+    };
+
+    /**
+     * \brief Delete the owner when it is closed and all its blocks
+     * are deallocated.
+     */
+    ~FreeListOwner() = default;
+
+    /**
+     * \param [in] block The block.
+     * \returns the header of the block.
+     */
+    static BlockHeader* GetHeader(const void* block);
+    /**
+     * \brief Take the list of the returned blocks.
+     *
+     * \returns the first returned block, or nullptr.
+     */
+    BlockHeader* TakeReturnedList();
+    /**
+     * \brief Deallocate a block of a closed owner, from any thread.
+     *
+     * \param [in] header The header of the block.
+     */
+    static void Release(BlockHeader* header);
+    /**
+     * \brief Deallocate the returned blocks, once the owner is closed.
+     */
+    void DeallocateReturned();
+    /** \brief Add a reference to the owner. */
+    void Ref();
+    /** \brief Remove a reference to the owner, and delete it with the last one. */
+    void Unref();
+
+    std::atomic<uint64_t> m_count;        //!< the number of references
+    std::atomic<bool> m_closed;           //!< whether the owner thread has exited
+    std::atomic<BlockHeader*> m_returned; //!< the blocks returned by the other threads
+    uint64_t m_blocks;                    //!< the blocks counted by the owner thread
+};
+
+} // namespace ns3
+
+/****************************************************
+ *  Implementation of inline methods for performance
+ ****************************************************/
+
+namespace ns3
+{
+
+inline FreeListOwner::BlockHeader*
+FreeListOwner::GetHeader(const void* block)
+{
+    return const_cast<BlockHeader*>(static_cast<const BlockHeader*>(block)) - 1;
+}
+
+inline FreeListOwner*
+FreeListOwner::GetOwner(const void* block)
+{
+    return GetHeader(block)->owner;
+}
+
+template <typename T>
+void
+FreeListOwner::TakeReturned(std::vector<T*>& freeList)
+{
+    // Avoid the atomic exchange when nothing was returned
+    if (m_returned.load(std::memory_order_relaxed) == nullptr)
+    {
+        return;
+    }
+    for (BlockHeader* header = TakeReturnedList(); header != nullptr; header = header->next)
+    {
+        freeList.push_back(reinterpret_cast<T*>(header + 1));
+    }
+}
+
+} // namespace ns3
+
+#endif /* FREE_LIST_OWNER_H */
@@ -0,0 +1,105 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "packet-header-cache.h"
+
+#include "ns3/log.h"
+
+/**
+ * \file
+ * \ingroup packet
+ * ns3::PacketHeaderCache implementation.
+ */
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("PacketHeaderCache");
+
+bool PacketHeaderCache::m_enabled = false;
+
+void
+PacketHeaderCache::Enable(bool enable)
+{
+    NS_LOG_FUNCTION(enable);
+    m_enabled = enable;
+}
+
+const Header*
+PacketHeaderCache::Find(const HeaderType* type, uint32_t fromEnd, uint32_t& size) const
+{
+    if (!m_data)
+    {
+        return nullptr;
+    }
+    // The outermost headers are the most likely to be looked up
+    for (uint32_t i = m_data->count; i > 0; i--)
+    {
+        const Entry& entry = m_data->entries[i - 1];
+        if (entry.fromEnd == fromEnd && *entry.type->type == *type->type)
+        {
+            size = entry.size;
+            return entry.header.get();
+        }
+    }
+    return nullptr;
+}
+
+void
+PacketHeaderCache::Add(const HeaderType* type, const Header& header, uint32_t fromEnd, uint32_t size)
+{
+    NS_LOG_FUNCTION(this << type->type->name() << fromEnd << size);
+    // The header is at the front of the packet, so the headers cached
+    // in front of it were removed
+    Data& data = GetWritableData(fromEnd);
+    if (data.count == Data::MAX_ENTRIES)
+    {
+        // Forget the innermost header
+        for (uint32_t i = 1; i < data.count; i++)
+        {
+            data.entries[i - 1] = std::move(data.entries[i]);
+        }
+        data.count--;
+    }
+    data.entries[data.count++] = {type, fromEnd, size, type->clone(header)};
+}
+
+void
+PacketHeaderCache::AddAtStart(uint32_t size)
+{
+    if (!m_data || m_data->count == 0 || m_data->entries[m_data->count - 1].fromEnd <= size)
+    {
+        return;
+    }
+    NS_LOG_FUNCTION(this << size);
+    GetWritableData(size);
+}
+
+PacketHeaderCache::Data&
+PacketHeaderCache::GetWritableData(uint32_t size)
+{
+    if (!m_data)
+    {
+        m_data = Create<Data>();
+    }
+    else if (m_data->GetReferenceCount() > 1)
+    {
+        // Copy on write: the other copies of the packet keep their headers
+        Ptr<Data> copy = Create<Data>();
+        for (uint32_t i = 0; i < m_data->count && m_data->entries[i].fromEnd <= size; i++)
+        {
+            copy->entries[copy->count++] = m_data->entries[i];
+        }
+        m_data = copy;
+        return *m_data;
+    }
+    // The entries are sorted by offset, the innermost first
+    while (m_data->count > 0 && m_data->entries[m_data->count - 1].fromEnd > size)
+    {
+        m_data->entries[--m_data->count].header.reset();
+    }
+    return *m_data;
+}
+
+} // namespace ns3
@@ -0,0 +1,222 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+#ifndef PACKET_HEADER_CACHE_H
+#define PACKET_HEADER_CACHE_H
+
+/**
+\file   packet-header-cache.h
+\brief  Defines the cache of the deserialized headers of a Packet.
+*/
+
+#include "header.h"
+
+#include "ns3/ptr.h"
+#include "ns3/simple-ref-count.h"
+
+#include <memory>
+#include <stdint.h>
+#include <type_traits>
+#include <typeinfo>
+
+namespace ns3
+{
+
+/**
+ * \ingroup packet
+ *
+ * \brief Whether the headers of type T may be kept in the cache of the
+ * deserialized headers of the packets.
+ *
+ * The headers of a type are only cached when this template is
+ * specialized for this type as std::true_type. A copy of such a header
+ * must be equal to the header, and its Deserialize method must only
+ * depend on the bytes of the header.
+ *
+ * \tparam T \explicit The type of the header.
+ */
+template <typename T>
+struct IsCacheableHeader : std::false_type
+{
+};
+
+/**
+ * \ingroup packet
+ *
+ * \brief Cache of the headers serialized at the front of a packet.
+ *
+ * This class is private to the Packet implementation and users
+ * should never have to access it directly.
+ *
+ * The cache keeps a copy of the headers added to the packet or
+ * peeked from it, so that the next Packet::PeekHeader or
+ * Packet::RemoveHeader of the same header is a copy of the header
+ * instead of its deserialization. A header is known by its C++ type
+ * and by its offset from the end of the packet, which does not change
+ * when the headers in front of it are added or removed.
+ *
+ * The cache is disabled by default, see Packet::EnableHeaderCache.
+ * It only holds the headers of the types for which IsCacheableHeader
+ * is specialized.
+ *
+ * \internal
+ *
+ * The cache has copy-on-write semantics: the copies of a packet share
+ * the cached headers until one of them adds a header. The cached headers
+ * themselves are never modified.
+ */
+class PacketHeaderCache
+{
+  public:
+    /**
+     * \brief The operations on the headers of a given C++ type.
+     */
+    struct HeaderType
+    {
+        const std::type_info* type;                                  //!< the type of the header
+        void (*assign)(Header& header, const Header& cached);        //!< copy a cached header
+        std::shared_ptr<const Header> (*clone)(const Header& header); //!< copy a header to cache
+    };
+
+    /**
+     * \brief Whether the headers of type T can be cached.
+     *
+     * \tparam T \explicit The type of the header.
+     */
+    template <typename T>
+    static constexpr bool IsCacheable = IsCacheableHeader<T>::value &&
+                                        std::is_base_of_v<Header, T> &&
+                                        std::is_copy_constructible_v<T> &&
+                                        std::is_copy_assignable_v<T>;
+
+    /**
+     * \brief Get the operations on the headers of type T.
+     *
+     * \tparam T \explicit The type of the header, which must be copyable.
+     * \returns the operations on the headers of type T.
+     */
+    template <typename T>
+    static const HeaderType* GetHeaderType();
+
+    /**
+     * \brief Enable or disable the caches of all the packets.
+     *
+     * \param [in] enable Whether the caches are enabled.
+     */
+    static void Enable(bool enable);
+    /**
+     * \brief Check whether the caches are enabled.
+     *
+     * \returns true if the caches are enabled.
+     */
+    static bool IsEnabled();
+
+    /**
+     * \brief Find a cached header.
+     *
+     * \param [in] type The type of the header.
+     * \param [in] fromEnd The offset of the header from the end of the packet.
+     * \param [out] size The serialized size of the header, if it is found.
+     * \returns the cached header, or nullptr.
+     */
+    const Header* Find(const HeaderType* type, uint32_t fromEnd, uint32_t& size) const;
+    /**
+     * \brief Cache a copy of the header at the front of the packet.
+     *
+     * The cached headers in front of the header are forgotten.
+     *
+     * \param [in] type The type of the header.
+     * \param [in] header The header.
+     * \param [in] fromEnd The offset of the header from the end of the packet.
+     * \param [in] size The serialized size of the header.
+     */
+    void Add(const HeaderType* type, const Header& header, uint32_t fromEnd, uint32_t size);
+    /**
+     * \brief Forget the cached headers overwritten by bytes added at the
+     * start of the packet.
+     *
+     * \param [in] size The size of the packet before the bytes are added.
+     */
+    void AddAtStart(uint32_t size);
+    /**
+     * \brief Forget all the cached headers, when the end of the packet changes.
+     */
+    void Clear();
+
+  private:
+    /**
+     * \brief A cached header.
+     */
+    struct Entry
+    {
+        const HeaderType* type;               //!< the type of the header
+        uint32_t fromEnd;                     //!< the offset from the end of the packet
+        uint32_t size;                        //!< the serialized size of the header
+        std::shared_ptr<const Header> header; //!< the copy of the header
+    };
+
+    /**
+     * \brief The cached headers, shared by the copies of a packet.
+     */
+    struct Data : public SimpleRefCount<Data>
+    {
+        /** The number of cached headers. */
+        static constexpr uint32_t MAX_ENTRIES = 4;
+
+        Entry entries[MAX_ENTRIES]; //!< the cached headers, the innermost first
+        uint32_t count{0};          //!< the number of cached headers
+    };
+
+    /**
+     * \brief Get the cached headers for a modification, and forget the
+     * headers which are not in the last bytes of the packet.
+     *
+     * \param [in] size The number of bytes at the end of the packet.
+     * \returns the cached headers, which are not shared with another packet.
+     */
+    Data& GetWritableData(uint32_t size);
+
+    Ptr<Data> m_data;      //!< the cached headers, or nullptr
+    static bool m_enabled; //!< whether the caches are enabled
+};
+
+} // namespace ns3
+
+/****************************************************
+ *  Implementation of inline methods for performance
+ ****************************************************/
+
+namespace ns3
+{
+
+template <typename T>
+const PacketHeaderCache::HeaderType*
+PacketHeaderCache::GetHeaderType()
+{
+    static const HeaderType type = {
+        &typeid(T),
+        [](Header& header, const Header& cached) {
+            static_cast<T&>(header) = static_cast<const T&>(cached);
+        },
+        [](const Header& header) -> std::shared_ptr<const Header> {
+            return std::make_shared<const T>(static_cast<const T&>(header));
+        },
+    };
+    return &type;
+}
+
+inline bool
+PacketHeaderCache::IsEnabled()
+{
+    return m_enabled;
+}
+
+inline void
+PacketHeaderCache::Clear()
+{
+    m_data = nullptr;
+}
+
+} // namespace ns3
+
+#endif /* PACKET_HEADER_CACHE_H */
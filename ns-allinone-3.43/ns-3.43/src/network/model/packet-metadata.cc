@@ -8,6 +8,7 @@
 #include "packet-metadata.h"
 
 #include "buffer.h"
+#include "free-list-owner.h"
 #include "header.h"
 #include "trailer.h"
 
@@ -26,9 +27,11 @@ NS_LOG_COMPONENT_DEFINE("PacketMetadata");
 bool PacketMetadata::m_enable = false;
 bool PacketMetadata::m_enableChecking = false;
 bool PacketMetadata::m_metadataSkipped = false;
-uint32_t PacketMetadata::m_maxSize = 0;
-uint16_t PacketMetadata::m_chunkUid = 0;
-PacketMetadata::DataFreeList PacketMetadata::m_freeList;
+thread_local uint32_t PacketMetadata::m_maxSize = 0;
+thread_local uint16_t PacketMetadata::m_chunkUid = 0;
+thread_local PacketMetadata::DataFreeList PacketMetadata::m_freeList;
+thread_local bool PacketMetadata::m_freeListDestroyed = false;
+thread_local FreeListOwner* PacketMetadata::m_owner = nullptr;
 
 PacketMetadata::DataFreeList::~DataFreeList()
 {
@@ -37,7 +40,14 @@ PacketMetadata::DataFreeList::~DataFreeList()
     {
         PacketMetadata::Deallocate(*i);
     }
-    PacketMetadata::m_enable = false;
+    // Metadata released later by this thread bypasses the free list,
+    // and the metadata of this thread released later is deallocated
+    PacketMetadata::m_freeListDestroyed = true;
+    if (PacketMetadata::m_owner != nullptr)
+    {
+        PacketMetadata::m_owner->Close();
+        PacketMetadata::m_owner = nullptr;
+    }
 }
 
 void
@@ -88,6 +98,15 @@ PacketMetadata::ReserveCopy(uint32_t size)
     }
 }
 
+PacketMetadata
+PacketMetadata::CreateDeepCopy() const
+{
+    NS_LOG_FUNCTION(this);
+    PacketMetadata copy = *this;
+    copy.ReserveCopy(0);
+    return copy;
+}
+
 void
 PacketMetadata::Reserve(uint32_t size)
 {
@@ -561,7 +580,15 @@ PacketMetadata::Create(uint32_t size)
     {
         m_maxSize = size;
     }
-    while (!m_freeList.empty())
+    if (m_owner == nullptr && !m_freeListDestroyed)
+    {
+        m_owner = new FreeListOwner();
+    }
+    if (m_owner != nullptr && m_freeList.empty())
+    {
+        m_owner->TakeReturned(m_freeList);
+    }
+    while (!m_freeListDestroyed && !m_freeList.empty())
     {
         PacketMetadata::Data* data = m_freeList.back();
         m_freeList.pop_back();
@@ -582,7 +609,16 @@ void
 PacketMetadata::Recycle(PacketMetadata::Data* data)
 {
     NS_LOG_FUNCTION(data);
-    if (!m_enable)
+    if (m_owner == nullptr || FreeListOwner::GetOwner(data) != m_owner)
+    {
+        // Give the metadata back to the thread which allocated it, if
+        // this thread has no free list
+        FreeListOwner::Return(data);
+        return;
+    }
+    // The storage is recycled even when the metadata is disabled, since
+    // every packet still has one
+    if (m_freeListDestroyed)
     {
         PacketMetadata::Deallocate(data);
         return;
@@ -609,8 +645,7 @@ PacketMetadata::Allocate(uint32_t n)
         n = PACKET_METADATA_DATA_M_DATA_SIZE;
     }
     size += n - PACKET_METADATA_DATA_M_DATA_SIZE;
-    auto buf = new uint8_t[size];
-    auto data = (PacketMetadata::Data*)buf;
+    auto data = static_cast<PacketMetadata::Data*>(FreeListOwner::Allocate(m_owner, size));
     data->m_size = n;
     data->m_count = 1;
     data->m_dirtyEnd = 0;
@@ -621,8 +656,7 @@ void
 PacketMetadata::Deallocate(PacketMetadata::Data* data)
 {
     NS_LOG_FUNCTION(data);
-    auto buf = (uint8_t*)data;
-    delete[] buf;
+    FreeListOwner::Deallocate(data);
 }
 
 PacketMetadata
@@ -23,6 +23,7 @@ namespace ns3
 
 class Chunk;
 class Buffer;
+class FreeListOwner;
 class Header;
 class Trailer;
 
@@ -178,6 +179,12 @@ class PacketMetadata
     inline PacketMetadata& operator=(const PacketMetadata& o);
     inline ~PacketMetadata();
 
+    /**
+     * \brief Create a copy which does not share its data with this object
+     * \return the copy
+     */
+    PacketMetadata CreateDeepCopy() const;
+
     // Delete default constructor to avoid misuse
     PacketMetadata() = delete;
 
@@ -664,9 +671,13 @@ class PacketMetadata
      */
     static void Deallocate(PacketMetadata::Data* data);
 
-    static DataFreeList m_freeList; //!< the metadata data storage
-    static bool m_enable;           //!< Enable the packet metadata
-    static bool m_enableChecking;   //!< Enable the packet metadata checking
+    static thread_local DataFreeList m_freeList; //!< the metadata data storage of this thread
+    /** Set when the free list of this thread has been destroyed. */
+    static thread_local bool m_freeListDestroyed;
+    /** The owner of the metadata data storage allocated by this thread. */
+    static thread_local FreeListOwner* m_owner;
+    static bool m_enable;         //!< Enable the packet metadata
+    static bool m_enableChecking; //!< Enable the packet metadata checking
 
     /**
      * Set to true when adding metadata to a packet is skipped because
@@ -675,8 +686,8 @@ class PacketMetadata
      */
     static bool m_metadataSkipped;
 
-    static uint32_t m_maxSize;  //!< maximum metadata size
-    static uint16_t m_chunkUid; //!< Chunk Uid
+    static thread_local uint32_t m_maxSize;  //!< maximum metadata size
+    static thread_local uint16_t m_chunkUid; //!< Chunk Uid
 
     Data* m_data; //!< Metadata storage
     /*
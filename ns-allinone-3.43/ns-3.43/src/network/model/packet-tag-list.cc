@@ -13,6 +13,7 @@
 
 #include "packet-tag-list.h"
 
+#include "free-list-owner.h"
 #include "tag-buffer.h"
 #include "tag.h"
 
@@ -20,12 +21,57 @@
 #include "ns3/log.h"
 
 #include <cstring>
+#include <vector>
 
 namespace ns3
 {
 
 NS_LOG_COMPONENT_DEFINE("PacketTagList");
 
+/**
+ * The largest serialized size of the tags whose TagData is kept in the
+ * free list. The TagData of the larger tags are deallocated.
+ */
+static constexpr size_t FREE_LIST_DATA_SIZE = 32;
+/** The largest number of TagData in the free list. */
+static constexpr size_t FREE_LIST_SIZE = 1000;
+
+/**
+ * \ingroup packet
+ *
+ * \brief Container class for the unused TagData.
+ *
+ * Internal use only.
+ */
+static thread_local class TagDataFreeList : public std::vector<PacketTagList::TagData*>
+{
+  public:
+    ~TagDataFreeList();
+} g_freeList; //!< Container for the unused TagData, one per thread
+
+/** Set when the free list of this thread has been destroyed. */
+static thread_local bool g_freeListDestroyed = false;
+
+/** The owner of the TagData allocated by this thread. */
+static thread_local FreeListOwner* g_owner = nullptr;
+
+TagDataFreeList::~TagDataFreeList()
+{
+    NS_LOG_FUNCTION(this);
+    for (auto i = begin(); i != end(); i++)
+    {
+        FreeListOwner::Deallocate(*i);
+    }
+    // Tags released later by this thread bypass the free list, and the
+    // tags of this thread released later are deallocated
+    g_freeListDestroyed = true;
+    if (g_owner != nullptr)
+    {
+        g_owner->Close();
+        g_owner = nullptr;
+    }
+}
+
 PacketTagList::TagData*
 PacketTagList::CreateTagData(size_t dataSize)
 {
@@ -33,14 +79,63 @@ PacketTagList::CreateTagData(size_t dataSize)
                   "Requested TagData size " << dataSize << " exceeds maximum "
                                             << std::numeric_limits<decltype(TagData::size)>::max());
 
-    void* p = std::malloc(sizeof(TagData) + dataSize - 1);
-    // The matching frees are in RemoveAll and RemoveWriter
+    void* p = nullptr;
+    if (dataSize > FREE_LIST_DATA_SIZE)
+    {
+        p = FreeListOwner::Allocate(nullptr, sizeof(TagData) + dataSize - 1);
+    }
+    else
+    {
+        if (g_owner == nullptr && !g_freeListDestroyed)
+        {
+            g_owner = new FreeListOwner();
+        }
+        if (g_owner != nullptr && g_freeList.empty())
+        {
+            g_owner->TakeReturned(g_freeList);
+        }
+        if (!g_freeListDestroyed && !g_freeList.empty())
+        {
+            p = g_freeList.back();
+            g_freeList.pop_back();
+        }
+        else
+        {
+            p = FreeListOwner::Allocate(g_owner, sizeof(TagData) + FREE_LIST_DATA_SIZE - 1);
+        }
+    }
+    // The matching deallocation is in DeleteTagData
 
     auto tag = new (p) TagData;
     tag->size = dataSize;
     return tag;
 }
 
+void
+PacketTagList::DeleteTagData(TagData* tag)
+{
+    bool recycle = tag->size <= FREE_LIST_DATA_SIZE;
+    tag->~TagData();
+    if (!recycle)
+    {
+        FreeListOwner::Deallocate(tag);
+    }
+    else if (g_owner == nullptr || FreeListOwner::GetOwner(tag) != g_owner)
+    {
+        // Give the tag back to the thread which allocated it, if this
+        // thread has no free list
+        FreeListOwner::Return(tag);
+    }
+    else if (g_freeList.size() > FREE_LIST_SIZE)
+    {
+        FreeListOwner::Deallocate(tag);
+    }
+    else
+    {
+        g_freeList.push_back(tag);
+    }
+}
+
 bool
 PacketTagList::COWTraverse(Tag& tag, PacketTagList::COWWriter Writer)
 {
@@ -184,8 +279,7 @@ PacketTagList::RemoveWriter(Tag& tag,
     if (preMerge)
     {
         // found tid before first merge, so delete cur
-        cur->~TagData();
-        std::free(cur);
+        DeleteTagData(cur);
     }
     else
     {
@@ -247,6 +341,25 @@ PacketTagList::ReplaceWriter(Tag& tag,
     return found;
 }
 
+PacketTagList
+PacketTagList::CreateDeepCopy() const
+{
+    NS_LOG_FUNCTION(this);
+    PacketTagList copy;
+    TagData** prevNext = &copy.m_next;
+    for (TagData* cur = m_next; cur != nullptr; cur = cur->next)
+    {
+        TagData* tag = CreateTagData(cur->size);
+        tag->next = nullptr;
+        tag->count = 1;
+        tag->tid = cur->tid;
+        memcpy(tag->data, cur->data, cur->size);
+        *prevNext = tag;
+        prevNext = &tag->next;
+    }
+    return copy;
+}
+
 void
 PacketTagList::Add(const Tag& tag) const
 {
@@ -167,6 +167,12 @@ class PacketTagList
      */
     inline ~PacketTagList();
 
+    /**
+     * \returns a copy of this PacketTagList which does not share any
+     * \ref TagData with this PacketTagList.
+     */
+    PacketTagList CreateDeepCopy() const;
+
     /**
      * Add a tag to the head of this branch.
      *
@@ -241,6 +247,12 @@ class PacketTagList
      * \returns The newly constructed TagData object.
      */
     static TagData* CreateTagData(size_t dataSize);
+    /**
+     * Destroy and deallocate a TagData struct created by CreateTagData.
+     *
+     * \param [in] tag The TagData object.
+     */
+    static void DeleteTagData(TagData* tag);
 
     /**
      * Typedef of method function pointer for copy-on-write operations
@@ -354,15 +366,13 @@ PacketTagList::RemoveAll()
         }
         if (prev != nullptr)
         {
-            prev->~TagData();
-            std::free(prev);
+            DeleteTagData(prev);
         }
         prev = cur;
     }
     if (prev != nullptr)
     {
-        prev->~TagData();
-        std::free(prev);
+        DeleteTagData(prev);
     }
     m_next = nullptr;
 }
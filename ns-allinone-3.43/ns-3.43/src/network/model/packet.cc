@@ -7,19 +7,70 @@
  */
 #include "packet.h"
 
+#include "free-list-owner.h"
+
 #include "ns3/assert.h"
 #include "ns3/log.h"
 #include "ns3/simulator.h"
 
+#include <algorithm>
 #include <cstdarg>
 #include <string>
+#include <typeinfo>
+#include <vector>
 
 namespace ns3
 {
 
 NS_LOG_COMPONENT_DEFINE("Packet");
 
-uint32_t Packet::m_globalUid = 0;
+thread_local uint32_t Packet::m_globalUid = 0;
+
+/** The largest number of packets in the free list. */
+static constexpr size_t FREE_LIST_SIZE = 1000;
+
+/**
+ * The packets concatenated by AddAtEnd are copied rather than chained
+ * when the result is smaller than this size, so that the chain does
+ * not fill with tiny slices.
+ */
+static constexpr uint32_t CHAIN_COPY_SIZE = 1024;
+
+/**
+ * \ingroup packet
+ *
+ * \brief Container class for the memory of the released packets.
+ *
+ * Internal use only.
+ */
+static thread_local class PacketFreeList : public std::vector<void*>
+{
+  public:
+    ~PacketFreeList();
+} g_freeList; //!< Container for the memory of the released packets, one per thread
+
+/** Set when the free list of this thread has been destroyed. */
+static thread_local bool g_freeListDestroyed = false;
+
+/** The owner of the packets allocated by this thread. */
+static thread_local FreeListOwner* g_owner = nullptr;
+
+PacketFreeList::~PacketFreeList()
+{
+    NS_LOG_FUNCTION(this);
+    for (auto i = begin(); i != end(); i++)
+    {
+        FreeListOwner::Deallocate(*i);
+    }
+    // Packets released later by this thread bypass the free list, and
+    // the packets of this thread released later are deallocated
+    g_freeListDestroyed = true;
+    if (g_owner != nullptr)
+    {
+        g_owner->Close();
+        g_owner = nullptr;
+    }
+}
 
 TypeId
 ByteTagIterator::Item::GetTypeId() const
@@ -125,8 +176,74 @@ Packet::Copy() const
     return Ptr<Packet>(new Packet(*this), false);
 }
 
+Ptr<Packet>
+Packet::DeepCopy() const
+{
+    NS_LOG_FUNCTION(this);
+    Ptr<Packet> copy = Copy();
+    copy->m_buffer = m_buffer.CreateDeepCopy();
+    for (auto& slice : copy->m_chain)
+    {
+        slice = slice.CreateDeepCopy();
+    }
+    copy->m_byteTagList = m_byteTagList.CreateDeepCopy();
+    copy->m_packetTagList = m_packetTagList.CreateDeepCopy();
+    copy->m_metadata = m_metadata.CreateDeepCopy();
+    // The cached headers may share objects with the original ones
+    copy->m_headerCache.Clear();
+    return copy;
+}
+
+void*
+Packet::operator new(size_t size)
+{
+    if (size != sizeof(Packet))
+    {
+        return FreeListOwner::Allocate(nullptr, size);
+    }
+    if (g_owner == nullptr && !g_freeListDestroyed)
+    {
+        g_owner = new FreeListOwner();
+    }
+    if (g_owner != nullptr && g_freeList.empty())
+    {
+        g_owner->TakeReturned(g_freeList);
+    }
+    if (!g_freeListDestroyed && !g_freeList.empty())
+    {
+        void* p = g_freeList.back();
+        g_freeList.pop_back();
+        return p;
+    }
+    return FreeListOwner::Allocate(g_owner, size);
+}
+
+void
+Packet::operator delete(void* p)
+{
+    FreeListOwner* owner = FreeListOwner::GetOwner(p);
+    if (owner == nullptr)
+    {
+        FreeListOwner::Deallocate(p);
+    }
+    else if (owner != g_owner)
+    {
+        // Give the packet back to the thread which allocated it
+        FreeListOwner::Return(p);
+    }
+    else if (g_freeList.size() > FREE_LIST_SIZE)
+    {
+        FreeListOwner::Deallocate(p);
+    }
+    else
+    {
+        g_freeList.push_back(p);
+    }
+}
+
 Packet::Packet()
     : m_buffer(),
+      m_chainSize(0),
       m_byteTagList(),
       m_packetTagList(),
       /* The upper 32 bits of the packet id in
@@ -143,9 +260,12 @@ Packet::Packet()
 
 Packet::Packet(const Packet& o)
     : m_buffer(o.m_buffer),
+      m_chain(o.m_chain),
+      m_chainSize(o.m_chainSize),
       m_byteTagList(o.m_byteTagList),
       m_packetTagList(o.m_packetTagList),
-      m_metadata(o.m_metadata)
+      m_metadata(o.m_metadata),
+      m_headerCache(o.m_headerCache)
 {
     o.m_nixVector ? m_nixVector = o.m_nixVector->Copy() : m_nixVector = nullptr;
 }
@@ -158,15 +278,19 @@ Packet::operator=(const Packet& o)
         return *this;
     }
     m_buffer = o.m_buffer;
+    m_chain = o.m_chain;
+    m_chainSize = o.m_chainSize;
     m_byteTagList = o.m_byteTagList;
     m_packetTagList = o.m_packetTagList;
     m_metadata = o.m_metadata;
+    m_headerCache = o.m_headerCache;
     o.m_nixVector ? m_nixVector = o.m_nixVector->Copy() : m_nixVector = nullptr;
     return *this;
 }
 
 Packet::Packet(uint32_t size)
     : m_buffer(size),
+      m_chainSize(0),
       m_byteTagList(),
       m_packetTagList(),
       /* The upper 32 bits of the packet id in
@@ -183,6 +307,7 @@ Packet::Packet(uint32_t size)
 
 Packet::Packet(const uint8_t* buffer, uint32_t size, bool magic)
     : m_buffer(0, false),
+      m_chainSize(0),
       m_byteTagList(),
       m_packetTagList(),
       m_metadata(0, 0),
@@ -194,6 +319,7 @@ Packet::Packet(const uint8_t* buffer, uint32_t size, bool magic)
 
 Packet::Packet(const uint8_t* buffer, uint32_t size)
     : m_buffer(),
+      m_chainSize(0),
       m_byteTagList(),
       m_packetTagList(),
       /* The upper 32 bits of the packet id in
@@ -216,6 +342,7 @@ Packet::Packet(const Buffer& buffer,
                const PacketTagList& packetTagList,
                const PacketMetadata& metadata)
     : m_buffer(buffer),
+      m_chainSize(0),
       m_byteTagList(byteTagList),
       m_packetTagList(packetTagList),
       m_metadata(metadata),
@@ -227,20 +354,129 @@ Ptr<Packet>
 Packet::CreateFragment(uint32_t start, uint32_t length) const
 {
     NS_LOG_FUNCTION(this << start << length);
-    Buffer buffer = m_buffer.CreateFragment(start, length);
+    NS_ASSERT(GetSize() >= start + length);
+    uint32_t bufferSize = m_buffer.GetSize();
+    uint32_t bufferStart = std::min(start, bufferSize);
+    Buffer buffer =
+        m_buffer.CreateFragment(bufferStart, std::min(start + length, bufferSize) - bufferStart);
     ByteTagList byteTagList = m_byteTagList;
     byteTagList.Adjust(-start);
-    NS_ASSERT(m_buffer.GetSize() >= start + length);
-    uint32_t end = m_buffer.GetSize() - (start + length);
+    uint32_t end = GetSize() - (start + length);
     PacketMetadata metadata = m_metadata.CreateFragment(start, end);
     // again, call the constructor directly rather than
     // through Create because it is private.
     Ptr<Packet> ret =
         Ptr<Packet>(new Packet(buffer, byteTagList, m_packetTagList, metadata), false);
+    // The fragment shares the slices which it overlaps
+    uint32_t offset = bufferSize;
+    for (const auto& slice : m_chain)
+    {
+        uint32_t sliceStart = std::max(start, offset);
+        uint32_t sliceEnd = std::min(start + length, offset + slice.GetSize());
+        if (sliceStart < sliceEnd)
+        {
+            ret->AddSliceAtEnd(slice.CreateFragment(sliceStart - offset, sliceEnd - sliceStart));
+        }
+        offset += slice.GetSize();
+    }
     ret->SetNixVector(GetNixVector());
     return ret;
 }
 
+void
+Packet::AddSliceAtEnd(const Buffer& slice)
+{
+    if (slice.GetSize() == 0)
+    {
+        return;
+    }
+    if (GetSize() == 0)
+    {
+        m_buffer = slice;
+        return;
+    }
+    m_chain.push_back(slice);
+    m_chainSize += slice.GetSize();
+}
+
+void
+Packet::Flatten() const
+{
+    if (m_chain.empty())
+    {
+        return;
+    }
+    NS_LOG_FUNCTION(this << m_chain.size());
+    Buffer buffer;
+    buffer.AddAtEnd(GetSize());
+    Buffer::Iterator i = buffer.Begin();
+    i.Write(m_buffer.Begin(), m_buffer.End());
+    for (const auto& slice : m_chain)
+    {
+        i.Write(slice.Begin(), slice.End());
+    }
+    // Only the representation of the content changes
+    auto self = const_cast<Packet*>(this);
+    self->m_buffer = buffer;
+    self->m_chain.clear();
+    self->m_chainSize = 0;
+}
+
+void
+Packet::FlattenStart(uint32_t size) const
+{
+    if (size > m_buffer.GetSize())
+    {
+        Flatten();
+    }
+}
+
+void
+Packet::RemoveBytesAtStart(uint32_t size)
+{
+    uint32_t bufferSize = m_buffer.GetSize();
+    m_buffer.RemoveAtStart(size);
+    if (size < bufferSize || m_chain.empty())
+    {
+        return;
+    }
+    size -= bufferSize;
+    auto slice = m_chain.begin();
+    while (slice != m_chain.end() && size >= slice->GetSize())
+    {
+        size -= slice->GetSize();
+        m_chainSize -= slice->GetSize();
+        slice++;
+    }
+    // The first remaining slice becomes the packet buffer
+    if (slice != m_chain.end())
+    {
+        m_buffer = *slice;
+        m_buffer.RemoveAtStart(size);
+        m_chainSize -= slice->GetSize();
+        slice++;
+    }
+    m_chain.erase(m_chain.begin(), slice);
+}
+
+void
+Packet::RemoveBytesAtEnd(uint32_t size)
+{
+    while (size > 0 && !m_chain.empty())
+    {
+        Buffer& slice = m_chain.back();
+        uint32_t removed = std::min(size, slice.GetSize());
+        slice.RemoveAtEnd(removed);
+        m_chainSize -= removed;
+        size -= removed;
+        if (slice.GetSize() == 0)
+        {
+            m_chain.pop_back();
+        }
+    }
+    m_buffer.RemoveAtEnd(size);
+}
+
 void
 Packet::SetNixVector(Ptr<NixVector> nixVector) const
 {
@@ -258,6 +494,7 @@ Packet::AddHeader(const Header& header)
 {
     uint32_t size = header.GetSerializedSize();
     NS_LOG_FUNCTION(this << header.GetInstanceTypeId().GetName() << size);
+    m_headerCache.AddAtStart(GetSize());
     m_buffer.AddAtStart(size);
     m_byteTagList.Adjust(size);
     m_byteTagList.AddAtStart(size);
@@ -265,15 +502,27 @@ Packet::AddHeader(const Header& header)
     m_metadata.AddHeader(header, size);
 }
 
+void
+Packet::DoAddHeader(const Header& header, const PacketHeaderCache::HeaderType* type)
+{
+    uint32_t size = GetSize();
+    AddHeader(header);
+    if (PacketHeaderCache::IsEnabled() && typeid(header) == *type->type)
+    {
+        m_headerCache.Add(type, header, GetSize(), GetSize() - size);
+    }
+}
+
 uint32_t
 Packet::RemoveHeader(Header& header, uint32_t size)
 {
+    FlattenStart(size);
     Buffer::Iterator end;
     end = m_buffer.Begin();
     end.Next(size);
     uint32_t deserialized = header.Deserialize(m_buffer.Begin(), end);
     NS_LOG_FUNCTION(this << header.GetInstanceTypeId().GetName() << deserialized);
-    m_buffer.RemoveAtStart(deserialized);
+    RemoveBytesAtStart(deserialized);
     m_byteTagList.Adjust(-deserialized);
     m_metadata.RemoveHeader(header, deserialized);
     return deserialized;
@@ -282,9 +531,21 @@ Packet::RemoveHeader(Header& header, uint32_t size)
 uint32_t
 Packet::RemoveHeader(Header& header)
 {
+    // The size of the header is known only once it is deserialized
+    Flatten();
     uint32_t deserialized = header.Deserialize(m_buffer.Begin());
     NS_LOG_FUNCTION(this << header.GetInstanceTypeId().GetName() << deserialized);
-    m_buffer.RemoveAtStart(deserialized);
+    RemoveBytesAtStart(deserialized);
+    m_byteTagList.Adjust(-deserialized);
+    m_metadata.RemoveHeader(header, deserialized);
+    return deserialized;
+}
+
+uint32_t
+Packet::DoRemoveHeader(Header& header, const PacketHeaderCache::HeaderType* type)
+{
+    uint32_t deserialized = DoPeekHeader(header, type);
+    RemoveBytesAtStart(deserialized);
     m_byteTagList.Adjust(-deserialized);
     m_metadata.RemoveHeader(header, deserialized);
     return deserialized;
@@ -293,14 +554,38 @@ Packet::RemoveHeader(Header& header)
 uint32_t
 Packet::PeekHeader(Header& header) const
 {
+    Flatten();
     uint32_t deserialized = header.Deserialize(m_buffer.Begin());
     NS_LOG_FUNCTION(this << header.GetInstanceTypeId().GetName() << deserialized);
     return deserialized;
 }
 
+uint32_t
+Packet::DoPeekHeader(Header& header, const PacketHeaderCache::HeaderType* type) const
+{
+    // A header passed as one of its base classes is not cached, so that
+    // it is not sliced
+    if (!PacketHeaderCache::IsEnabled() || typeid(header) != *type->type)
+    {
+        return PeekHeader(header);
+    }
+    uint32_t deserialized;
+    const Header* cached = m_headerCache.Find(type, GetSize(), deserialized);
+    if (cached)
+    {
+        type->assign(header, *cached);
+        NS_LOG_FUNCTION(this << header.GetInstanceTypeId().GetName() << deserialized << "cached");
+        return deserialized;
+    }
+    deserialized = PeekHeader(header);
+    m_headerCache.Add(type, header, GetSize(), deserialized);
+    return deserialized;
+}
+
 uint32_t
 Packet::PeekHeader(Header& header, uint32_t size) const
 {
+    FlattenStart(size);
     Buffer::Iterator end;
     end = m_buffer.Begin();
     end.Next(size);
@@ -315,25 +600,39 @@ Packet::AddTrailer(const Trailer& trailer)
     uint32_t size = trailer.GetSerializedSize();
     NS_LOG_FUNCTION(this << trailer.GetInstanceTypeId().GetName() << size);
     m_byteTagList.AddAtEnd(GetSize());
-    m_buffer.AddAtEnd(size);
-    Buffer::Iterator end = m_buffer.End();
-    trailer.Serialize(end);
+    if (m_chain.empty())
+    {
+        m_buffer.AddAtEnd(size);
+        trailer.Serialize(m_buffer.End());
+    }
+    else
+    {
+        // The trailer gets its own slice rather than a copy of the last one
+        Buffer slice;
+        slice.AddAtEnd(size);
+        trailer.Serialize(slice.End());
+        AddSliceAtEnd(slice);
+    }
     m_metadata.AddTrailer(trailer, size);
+    m_headerCache.Clear();
 }
 
 uint32_t
 Packet::RemoveTrailer(Trailer& trailer)
 {
+    Flatten();
     uint32_t deserialized = trailer.Deserialize(m_buffer.End());
     NS_LOG_FUNCTION(this << trailer.GetInstanceTypeId().GetName() << deserialized);
     m_buffer.RemoveAtEnd(deserialized);
     m_metadata.RemoveTrailer(trailer, deserialized);
+    m_headerCache.Clear();
     return deserialized;
 }
 
 uint32_t
 Packet::PeekTrailer(Trailer& trailer)
 {
+    Flatten();
     uint32_t deserialized = trailer.Deserialize(m_buffer.End());
     NS_LOG_FUNCTION(this << trailer.GetInstanceTypeId().GetName() << deserialized);
     return deserialized;
@@ -348,8 +647,24 @@ Packet::AddAtEnd(Ptr<const Packet> packet)
     copy.AddAtStart(0);
     copy.Adjust(GetSize());
     m_byteTagList.Add(copy);
-    m_buffer.AddAtEnd(packet->m_buffer);
+    Buffer& last = m_chain.empty() ? m_buffer : m_chain.back();
+    if (packet->m_chain.empty() && last.GetSize() + packet->GetSize() < CHAIN_COPY_SIZE)
+    {
+        last.AddAtEnd(packet->m_buffer);
+        m_chainSize += m_chain.empty() ? 0 : packet->GetSize();
+    }
+    else
+    {
+        // The packet may be this packet, whose chain grows meanwhile
+        std::size_t slices = packet->m_chain.size();
+        AddSliceAtEnd(packet->m_buffer);
+        for (std::size_t i = 0; i < slices; i++)
+        {
+            AddSliceAtEnd(packet->m_chain[i]);
+        }
+    }
     m_metadata.AddAtEnd(packet->m_metadata);
+    m_headerCache.Clear();
 }
 
 void
@@ -357,23 +672,32 @@ Packet::AddPaddingAtEnd(uint32_t size)
 {
     NS_LOG_FUNCTION(this << size);
     m_byteTagList.AddAtEnd(GetSize());
-    m_buffer.AddAtEnd(size);
+    if (m_chain.empty())
+    {
+        m_buffer.AddAtEnd(size);
+    }
+    else
+    {
+        AddSliceAtEnd(Buffer(size));
+    }
     m_metadata.AddPaddingAtEnd(size);
+    m_headerCache.Clear();
 }
 
 void
 Packet::RemoveAtEnd(uint32_t size)
 {
     NS_LOG_FUNCTION(this << size);
-    m_buffer.RemoveAtEnd(size);
+    RemoveBytesAtEnd(size);
     m_metadata.RemoveAtEnd(size);
+    m_headerCache.Clear();
 }
 
 void
 Packet::RemoveAtStart(uint32_t size)
 {
     NS_LOG_FUNCTION(this << size);
-    m_buffer.RemoveAtStart(size);
+    RemoveBytesAtStart(size);
     m_byteTagList.Adjust(-size);
     m_metadata.RemoveAtStart(size);
 }
@@ -388,13 +712,24 @@ Packet::RemoveAllByteTags()
 uint32_t
 Packet::CopyData(uint8_t* buffer, uint32_t size) const
 {
-    return m_buffer.CopyData(buffer, size);
+    uint32_t copied = m_buffer.CopyData(buffer, size);
+    for (auto slice = m_chain.begin(); slice != m_chain.end() && copied < size; slice++)
+    {
+        copied += slice->CopyData(buffer + copied, size - copied);
+    }
+    return copied;
 }
 
 void
 Packet::CopyData(std::ostream* os, uint32_t size) const
 {
-    return m_buffer.CopyData(os, size);
+    m_buffer.CopyData(os, size);
+    size -= std::min(size, m_buffer.GetSize());
+    for (auto slice = m_chain.begin(); slice != m_chain.end() && size > 0; slice++)
+    {
+        slice->CopyData(os, size);
+        size -= std::min(size, slice->GetSize());
+    }
 }
 
 uint64_t
@@ -444,6 +779,7 @@ Packet::ToString() const
 void
 Packet::Print(std::ostream& os) const
 {
+    Flatten();
     PacketMetadata::ItemIterator i = m_metadata.BeginItem(m_buffer);
     while (i.HasNext())
     {
@@ -578,6 +914,7 @@ Packet::Print(std::ostream& os) const
 PacketMetadata::ItemIterator
 Packet::BeginItem() const
 {
+    Flatten();
     return m_metadata.BeginItem(m_buffer);
 }
 
@@ -595,9 +932,25 @@ Packet::EnableChecking()
     PacketMetadata::EnableChecking();
 }
 
+void
+Packet::EnableHeaderCache()
+{
+    NS_LOG_FUNCTION_NOARGS();
+    PacketHeaderCache::Enable(true);
+}
+
+void
+Packet::DisableHeaderCache()
+{
+    NS_LOG_FUNCTION_NOARGS();
+    PacketHeaderCache::Enable(false);
+}
+
 uint32_t
 Packet::GetSerializedSize() const
 {
+    // The buffer is serialized as a whole
+    Flatten();
     uint32_t size = 0;
 
     if (m_nixVector)
@@ -651,6 +1004,7 @@ Packet::GetSerializedSize() const
 uint32_t
 Packet::Serialize(uint8_t* buffer, uint32_t maxSize) const
 {
+    Flatten();
     auto p = reinterpret_cast<uint32_t*>(buffer);
     uint32_t size = 0;
 
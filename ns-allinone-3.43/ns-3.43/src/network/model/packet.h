@@ -12,6 +12,7 @@
 #include "byte-tag-list.h"
 #include "header.h"
 #include "nix-vector.h"
+#include "packet-header-cache.h"
 #include "packet-metadata.h"
 #include "packet-tag-list.h"
 #include "tag.h"
@@ -23,6 +24,8 @@
 #include "ns3/ptr.h"
 
 #include <stdint.h>
+#include <type_traits>
+#include <vector>
 
 namespace ns3
 {
@@ -351,6 +354,41 @@ class Packet : public SimpleRefCount<Packet>
      * \returns the number of bytes read from the packet.
      */
     uint32_t PeekHeader(Header& header, uint32_t size) const;
+    /**
+     * \brief Add header to this packet, and cache a copy of it.
+     *
+     * This overload is selected for the header types which specialize
+     * IsCacheableHeader. When the header cache is enabled, the next PeekHeader or
+     * RemoveHeader of this header copies it instead of deserializing it.
+     *
+     * \tparam T \deduced The type of the header.
+     * \param header a reference to the header to add to this packet.
+     * \sa EnableHeaderCache
+     */
+    template <typename T, std::enable_if_t<PacketHeaderCache::IsCacheable<T>, bool> = true>
+    void AddHeader(const T& header);
+    /**
+     * \brief Remove the header from the internal buffer, copying it from
+     * the header cache if possible.
+     *
+     * \tparam T \deduced The type of the header.
+     * \param header a reference to the header to remove from the internal buffer.
+     * \returns the number of bytes removed from the packet.
+     * \sa EnableHeaderCache
+     */
+    template <typename T, std::enable_if_t<PacketHeaderCache::IsCacheable<T>, bool> = true>
+    uint32_t RemoveHeader(T& header);
+    /**
+     * \brief Read the header from the internal buffer, copying it from
+     * the header cache if possible.
+     *
+     * \tparam T \deduced The type of the header.
+     * \param header a reference to the header to read from the internal buffer.
+     * \returns the number of bytes read from the packet.
+     * \sa EnableHeaderCache
+     */
+    template <typename T, std::enable_if_t<PacketHeaderCache::IsCacheable<T>, bool> = true>
+    uint32_t PeekHeader(T& header) const;
     /**
      * \brief Add trailer to this packet.
      *
@@ -387,6 +425,10 @@ class Packet : public SimpleRefCount<Packet>
      *
      * This does not alter the uid of either packet.
      *
+     * The bytes of a large packet are not copied: they are chained after
+     * the bytes of the current packet, and copied to a contiguous buffer
+     * only when an operation needs them contiguous.
+     *
      * \param packet packet to concatenate
      */
     void AddAtEnd(Ptr<const Packet> packet);
@@ -448,6 +490,36 @@ class Packet : public SimpleRefCount<Packet>
      */
     Ptr<Packet> Copy() const;
 
+    /**
+     * \brief performs a deep copy of the packet.
+     *
+     * \returns a copy of the packet which shares no dataset with
+     * the original packet.
+     *
+     * Unlike Copy(), the reference counts of the datasets of the
+     * original packet are not touched by the later use of the copy,
+     * so the copy can be handed over to another thread. The memory of
+     * the copy is given back to the free lists of this thread when the
+     * other thread releases it.
+     */
+    Ptr<Packet> DeepCopy() const;
+
+    /**
+     * \brief Allocate the memory of a packet, from the free list of the
+     * current thread.
+     *
+     * \param [in] size The size of the packet.
+     * \returns the memory of the packet.
+     */
+    static void* operator new(size_t size);
+    /**
+     * \brief Deallocate the memory of a packet, to the free list of the
+     * thread which allocated it.
+     *
+     * \param [in] p The memory of the packet.
+     */
+    static void operator delete(void* p);
+
     /**
      * \brief Returns the packet's Uid.
      *
@@ -525,6 +597,22 @@ class Packet : public SimpleRefCount<Packet>
      * errors will be detected and will abort the program.
      */
     static void EnableChecking();
+    /**
+     * \brief Enable the cache of the deserialized headers.
+     *
+     * A packet then keeps a copy of the last headers added to its front
+     * or peeked from it. The next PeekHeader or RemoveHeader of one of
+     * these headers is a copy of the header instead of a deserialization.
+     * The cached headers are forgotten when the end of the packet changes.
+     *
+     * The cache only holds the headers of the types which specialize
+     * IsCacheableHeader, when they are passed with their own type.
+     */
+    static void EnableHeaderCache();
+    /**
+     * \brief Disable the cache of the deserialized headers.
+     */
+    static void DisableHeaderCache();
 
     /**
      * \brief Returns number of bytes required for packet
@@ -776,7 +864,61 @@ class Packet : public SimpleRefCount<Packet>
      */
     uint32_t Deserialize(const uint8_t* buffer, uint32_t size);
 
+    /**
+     * \brief Add a header, and cache a copy of it.
+     * \param [in] header the header to add.
+     * \param [in] type the type of the header.
+     */
+    void DoAddHeader(const Header& header, const PacketHeaderCache::HeaderType* type);
+    /**
+     * \brief Remove a header, copying it from the header cache if possible.
+     * \param [out] header the header to remove.
+     * \param [in] type the type of the header.
+     * \returns the number of bytes removed from the packet.
+     */
+    uint32_t DoRemoveHeader(Header& header, const PacketHeaderCache::HeaderType* type);
+    /**
+     * \brief Read a header, copying it from the header cache if possible.
+     * \param [out] header the header to read.
+     * \param [in] type the type of the header.
+     * \returns the number of bytes read from the packet.
+     */
+    uint32_t DoPeekHeader(Header& header, const PacketHeaderCache::HeaderType* type) const;
+
+    /**
+     * \brief Append a slice to the bytes of the packet, without copying it.
+     * \param [in] slice the slice to append.
+     */
+    void AddSliceAtEnd(const Buffer& slice);
+    /**
+     * \brief Copy the chained slices to the packet buffer.
+     *
+     * This method is const since it does not change the content of the
+     * packet, only its representation.
+     */
+    void Flatten() const;
+    /**
+     * \brief Flatten the packet if the first size bytes do not all belong
+     * to the packet buffer.
+     * \param [in] size the number of bytes which must be contiguous.
+     */
+    void FlattenStart(uint32_t size) const;
+    /**
+     * \brief Remove bytes from the start of the packet buffer and of
+     * the chained slices.
+     * \param [in] size the number of bytes to remove.
+     */
+    void RemoveBytesAtStart(uint32_t size);
+    /**
+     * \brief Remove bytes from the end of the chained slices and of the
+     * packet buffer.
+     * \param [in] size the number of bytes to remove.
+     */
+    void RemoveBytesAtEnd(uint32_t size);
+
     Buffer m_buffer;               //!< the packet buffer (it's actual contents)
+    std::vector<Buffer> m_chain;   //!< the slices of the content which follow m_buffer
+    uint32_t m_chainSize;          //!< the total size of the chained slices
     ByteTagList m_byteTagList;     //!< the ByteTag list
     PacketTagList m_packetTagList; //!< the packet's Tag list
     PacketMetadata m_metadata;     //!< the packet's metadata
@@ -784,7 +926,14 @@ class Packet : public SimpleRefCount<Packet>
     /* Please see comments above about nix-vector */
     mutable Ptr<NixVector> m_nixVector; //!< the packet's Nix vector
 
-    static uint32_t m_globalUid; //!< Global counter of packets Uid
+    /* The cache is filled by PeekHeader, which is const */
+    mutable PacketHeaderCache m_headerCache; //!< the packet's deserialized headers
+
+    /**
+     * Counter of packets Uid, below the system id in the packet Uid.
+     * The packets of a system id are created by a single thread.
+     */
+    static thread_local uint32_t m_globalUid;
 };
 
 /**
@@ -816,6 +965,12 @@ std::ostream& operator<<(std::ostream& os, const Packet& packet);
  *   - ns3::Packet::RemovePacketTag
  *   - ns3::Packet::ReplacePacketTag
  *
+ * ns3::Packet::AddAtEnd does not copy the bytes of large packets: it
+ * chains them after the bytes of the packet. The chain is copied to a
+ * contiguous buffer when a header is read or removed past its first
+ * slice, when a trailer is read or removed, and when the packet is
+ * printed or serialized.
+ *
  * Non-dirty operations:
  *   - ns3::Packet::AddPacketTag
  *   - ns3::Packet::PeekPacketTag
@@ -849,7 +1004,28 @@ namespace ns3
 uint32_t
 Packet::GetSize() const
 {
-    return m_buffer.GetSize();
+    return m_buffer.GetSize() + m_chainSize;
+}
+
+template <typename T, std::enable_if_t<PacketHeaderCache::IsCacheable<T>, bool>>
+void
+Packet::AddHeader(const T& header)
+{
+    DoAddHeader(header, PacketHeaderCache::GetHeaderType<T>());
+}
+
+template <typename T, std::enable_if_t<PacketHeaderCache::IsCacheable<T>, bool>>
+uint32_t
+Packet::RemoveHeader(T& header)
+{
+    return DoRemoveHeader(header, PacketHeaderCache::GetHeaderType<T>());
+}
+
+template <typename T, std::enable_if_t<PacketHeaderCache::IsCacheable<T>, bool>>
+uint32_t
+Packet::PeekHeader(T& header) const
+{
+    return DoPeekHeader(header, PacketHeaderCache::GetHeaderType<T>());
 }
 
 } // namespace ns3
@@ -14,7 +14,10 @@
 #include <iomanip>
 #include <iostream>
 #include <limits> // std:numeric_limits
+#include <set>
+#include <sstream>
 #include <string>
+#include <thread>
 
 using namespace ns3;
 
@@ -1257,6 +1260,478 @@ PacketTagListTest::DoRun()
     } // Timing
 }
 
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * Packet deep copy unit tests.
+ */
+class PacketDeepCopyTest : public TestCase
+{
+  public:
+    PacketDeepCopyTest();
+
+  private:
+    void DoRun() override;
+};
+
+PacketDeepCopyTest::PacketDeepCopyTest()
+    : TestCase("Packet::DeepCopy")
+{
+}
+
+void
+PacketDeepCopyTest::DoRun()
+{
+    uint8_t payload[100];
+    for (uint32_t i = 0; i < sizeof(payload); ++i)
+    {
+        payload[i] = i;
+    }
+    Ptr<Packet> p = Create<Packet>(payload, sizeof(payload));
+    p->AddHeader(ATestHeader<10>());
+    p->AddTrailer(ATestTrailer<4>());
+    p->AddByteTag(ATestTag<5>(7));
+    p->AddPacketTag(ATestTag<3>(9));
+
+    Ptr<Packet> copy = p->DeepCopy();
+    NS_TEST_EXPECT_MSG_EQ(copy->GetUid(), p->GetUid(), "The copy keeps the uid");
+    NS_TEST_ASSERT_MSG_EQ(copy->GetSize(), p->GetSize(), "Wrong size of the copy");
+    std::vector<uint8_t> expected(p->GetSize());
+    std::vector<uint8_t> data(copy->GetSize());
+    p->CopyData(expected.data(), expected.size());
+    copy->CopyData(data.data(), data.size());
+    NS_TEST_EXPECT_MSG_EQ((data == expected), true, "Wrong bytes of the copy");
+
+    ATestTag<5> byteTag;
+    NS_TEST_EXPECT_MSG_EQ(copy->FindFirstMatchingByteTag(byteTag), true, "Missing byte tag");
+    NS_TEST_EXPECT_MSG_EQ(byteTag.GetData(), 7, "Wrong byte tag");
+    ATestTag<3> packetTag;
+    NS_TEST_EXPECT_MSG_EQ(copy->RemovePacketTag(packetTag), true, "Missing packet tag");
+    NS_TEST_EXPECT_MSG_EQ(packetTag.GetData(), 9, "Wrong packet tag");
+
+    // Changing the copy leaves the original untouched.
+    ATestHeader<10> header;
+    copy->RemoveHeader(header);
+    NS_TEST_EXPECT_MSG_EQ(header.m_error, false, "Wrong header of the copy");
+    copy->AddHeader(ATestHeader<2>());
+    copy->AddByteTag(ATestTag<6>());
+    NS_TEST_EXPECT_MSG_EQ(p->GetSize(), expected.size(), "The original changed");
+    std::vector<uint8_t> original(p->GetSize());
+    p->CopyData(original.data(), original.size());
+    NS_TEST_EXPECT_MSG_EQ((original == expected), true, "The original bytes changed");
+    ATestTag<6> otherTag;
+    NS_TEST_EXPECT_MSG_EQ(p->FindFirstMatchingByteTag(otherTag),
+                          false,
+                          "The original tags changed");
+    NS_TEST_EXPECT_MSG_EQ(p->PeekPacketTag(packetTag), true, "The original packet tags changed");
+}
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * Packets whose bytes are chained by Packet::AddAtEnd.
+ */
+class PacketChainTest : public TestCase
+{
+  public:
+    PacketChainTest();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Create a packet and append its bytes to the expected bytes.
+     * \param size the size of the packet
+     * \param seed the value of the first byte
+     * \param [in,out] bytes the expected bytes
+     * \returns the packet
+     */
+    static Ptr<Packet> Make(uint32_t size, uint8_t seed, std::vector<uint8_t>& bytes);
+    /**
+     * Check the bytes of a packet.
+     * \param p the packet
+     * \param expected the expected bytes
+     * \param step the step of the check
+     */
+    void Check(Ptr<const Packet> p, const std::vector<uint8_t>& expected, const std::string& step);
+};
+
+PacketChainTest::PacketChainTest()
+    : TestCase("Packet chained bytes")
+{
+}
+
+Ptr<Packet>
+PacketChainTest::Make(uint32_t size, uint8_t seed, std::vector<uint8_t>& bytes)
+{
+    std::vector<uint8_t> data(size);
+    for (uint32_t i = 0; i < size; ++i)
+    {
+        data[i] = seed + i;
+    }
+    bytes.insert(bytes.end(), data.begin(), data.end());
+    return Create<Packet>(data.data(), size);
+}
+
+void
+PacketChainTest::Check(Ptr<const Packet> p,
+                       const std::vector<uint8_t>& expected,
+                       const std::string& step)
+{
+    NS_TEST_ASSERT_MSG_EQ(p->GetSize(), expected.size(), "Wrong size after " << step);
+    std::vector<uint8_t> data(expected.size() + 10);
+    NS_TEST_EXPECT_MSG_EQ(p->CopyData(data.data(), data.size()),
+                          expected.size(),
+                          "Wrong size of the copy after " << step);
+    data.resize(expected.size());
+    NS_TEST_EXPECT_MSG_EQ((data == expected), true, "Wrong bytes after " << step);
+    uint32_t half = expected.size() / 2;
+    std::vector<uint8_t> start(half);
+    NS_TEST_EXPECT_MSG_EQ(p->CopyData(start.data(), half), half, "Wrong partial copy");
+    NS_TEST_EXPECT_MSG_EQ(std::equal(start.begin(), start.end(), expected.begin()),
+                          true,
+                          "Wrong partial bytes after " << step);
+    std::ostringstream oss;
+    p->CopyData(&oss, expected.size());
+    NS_TEST_EXPECT_MSG_EQ(oss.str(),
+                          std::string(expected.begin(), expected.end()),
+                          "Wrong streamed bytes after " << step);
+}
+
+void
+PacketChainTest::DoRun()
+{
+    std::vector<uint8_t> bytes;
+    Ptr<Packet> p = Make(1500, 0, bytes);
+    Ptr<Packet> second = Make(2000, 1, bytes);
+    second->AddByteTag(ATestTag<5>(7));
+    p->AddAtEnd(second);
+    p->AddAtEnd(Make(1000, 2, bytes));
+    p->AddAtEnd(Create<Packet>(1200));
+    bytes.insert(bytes.end(), 1200, 0);
+    Check(p, bytes, "AddAtEnd");
+
+    // The appended packets are not changed by the chain, and conversely.
+    second->AddHeader(ATestHeader<10>());
+    second->RemoveAtEnd(100);
+    Check(p, bytes, "changing an appended packet");
+
+    ByteTagIterator tags = p->GetByteTagIterator();
+    NS_TEST_ASSERT_MSG_EQ(tags.HasNext(), true, "Missing byte tag");
+    ByteTagIterator::Item tag = tags.Next();
+    NS_TEST_EXPECT_MSG_EQ(tag.GetStart(), 1500, "Wrong start of byte tag");
+    NS_TEST_EXPECT_MSG_EQ(tag.GetEnd(), 3500, "Wrong end of byte tag");
+
+    // Fragments share the slices which they overlap.
+    Ptr<Packet> fragment = p->CreateFragment(1400, 2200);
+    Check(fragment,
+          std::vector<uint8_t>(bytes.begin() + 1400, bytes.begin() + 3600),
+          "CreateFragment");
+    fragment = p->CreateFragment(3600, 1000);
+    Check(fragment,
+          std::vector<uint8_t>(bytes.begin() + 3600, bytes.begin() + 4600),
+          "CreateFragment of the chain");
+
+    Ptr<Packet> q = p->Copy();
+    q->RemoveAtStart(1600);
+    q->RemoveAtEnd(1300);
+    Check(q, std::vector<uint8_t>(bytes.begin() + 1600, bytes.end() - 1300), "RemoveAtStart");
+    Check(p, bytes, "changing a copy");
+
+    // Small packets are copied at the end of the chain.
+    for (uint8_t i = 0; i < 20; ++i)
+    {
+        q->AddAtEnd(Make(10, i, bytes));
+    }
+    q->AddPaddingAtEnd(10);
+    std::vector<uint8_t> expected(bytes.begin() + 1600, bytes.end() - 1300 - 200);
+    expected.insert(expected.end(), bytes.end() - 200, bytes.end());
+    expected.insert(expected.end(), 10, 0);
+    bytes.resize(bytes.size() - 200);
+    Check(q, expected, "AddAtEnd of small packets");
+
+    // A packet can be appended to itself.
+    q = p->Copy();
+    q->AddAtEnd(q);
+    expected = bytes;
+    expected.insert(expected.end(), bytes.begin(), bytes.end());
+    Check(q, expected, "AddAtEnd of itself");
+
+    // The headers are added before the chain, and flatten it when read.
+    q = p->Copy();
+    q->AddHeader(ATestHeader<10>());
+    q->AddTrailer(ATestTrailer<4>());
+    Ptr<Packet> deep = q->DeepCopy();
+    ATestHeader<10> header;
+    NS_TEST_EXPECT_MSG_EQ(q->RemoveHeader(header), 10, "Wrong size of header");
+    NS_TEST_EXPECT_MSG_EQ(header.m_error, false, "Wrong header");
+    ATestTrailer<4> trailer;
+    NS_TEST_EXPECT_MSG_EQ(q->RemoveTrailer(trailer), 4, "Wrong size of trailer");
+    NS_TEST_EXPECT_MSG_EQ(trailer.m_error, false, "Wrong trailer");
+    Check(q, bytes, "RemoveHeader");
+    NS_TEST_EXPECT_MSG_EQ(deep->GetSize(), bytes.size() + 14, "Wrong size of deep copy");
+    deep->RemoveAtStart(10);
+    deep->RemoveAtEnd(4);
+    Check(deep, bytes, "DeepCopy");
+
+    // The chain is serialized as contiguous bytes.
+    std::vector<uint8_t> serialized(p->GetSerializedSize());
+    NS_TEST_EXPECT_MSG_EQ(p->Serialize(serialized.data(), serialized.size()),
+                          1,
+                          "Serialization failed");
+    Check(Create<Packet>(serialized.data(), serialized.size(), true), bytes, "Serialize");
+    Check(p, bytes, "flattening");
+}
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * Packets released by another thread than the one which created them.
+ */
+class PacketFreeListThreadTest : public TestCase
+{
+  public:
+    PacketFreeListThreadTest();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Create a packet with a header and tags.
+     * \returns the packet.
+     */
+    static Ptr<Packet> CreatePacket();
+};
+
+PacketFreeListThreadTest::PacketFreeListThreadTest()
+    : TestCase("Packets released by another thread")
+{
+}
+
+Ptr<Packet>
+PacketFreeListThreadTest::CreatePacket()
+{
+    Ptr<Packet> p = Create<Packet>(100);
+    p->AddHeader(ATestHeader<10>());
+    p->AddByteTag(ATestTag<5>(7));
+    p->AddPacketTag(ATestTag<3>(9));
+    return p;
+}
+
+void
+PacketFreeListThreadTest::DoRun()
+{
+    const uint32_t count = 100;
+    std::vector<Ptr<Packet>> survivors;
+    std::set<const Packet*> addresses;
+    uint32_t reused = 0;
+    uint32_t tagged = 0;
+
+    std::thread creator([&]() {
+        std::vector<Ptr<Packet>> packets;
+        for (uint32_t i = 0; i < count; i++)
+        {
+            packets.push_back(CreatePacket());
+            addresses.insert(PeekPointer(packets.back()));
+        }
+        // The packets go back to the free lists of this thread
+        std::thread releaser([&packets]() { packets.clear(); });
+        releaser.join();
+
+        for (uint32_t i = 0; i < count; i++)
+        {
+            survivors.push_back(CreatePacket());
+            reused += addresses.count(PeekPointer(survivors.back()));
+            ATestTag<3> tag;
+            tagged += survivors.back()->PeekPacketTag(tag) && tag.GetData() == 9;
+        }
+    });
+    creator.join();
+
+    NS_TEST_EXPECT_MSG_EQ(reused, count, "The released packets were not reused by their thread");
+    NS_TEST_EXPECT_MSG_EQ(tagged, count, "Wrong tags of the reused packets");
+
+    // The packets outlive the thread which created them
+    ATestHeader<10> header;
+    survivors.front()->RemoveHeader(header);
+    NS_TEST_EXPECT_MSG_EQ(header.m_error, false, "Wrong header of a packet of an exited thread");
+    survivors.clear();
+}
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * \brief Header which counts its deserializations
+ *
+ * \note Class internal to packet-test-suite.cc
+ */
+class ACountedHeader : public Header
+{
+  public:
+    /**
+     * Constructor
+     * \param value the value of the header
+     */
+    ACountedHeader(uint32_t value = 0)
+        : m_value(value)
+    {
+    }
+
+    /**
+     * Register this type.
+     * \return The TypeId.
+     */
+    static TypeId GetTypeId()
+    {
+        static TypeId tid = TypeId("anon::ACountedHeader")
+                                .SetParent<Header>()
+                                .SetGroupName("Network")
+                                .HideFromDocumentation()
+                                .AddConstructor<ACountedHeader>();
+        return tid;
+    }
+
+    TypeId GetInstanceTypeId() const override
+    {
+        return GetTypeId();
+    }
+
+    uint32_t GetSerializedSize() const override
+    {
+        return 4;
+    }
+
+    void Serialize(Buffer::Iterator iter) const override
+    {
+        iter.WriteHtonU32(m_value);
+    }
+
+    uint32_t Deserialize(Buffer::Iterator iter) override
+    {
+        m_value = iter.ReadNtohU32();
+        g_deserialized++;
+        return 4;
+    }
+
+    void Print(std::ostream& os) const override
+    {
+        os << m_value;
+    }
+
+    uint32_t m_value;               //!< the value of the header
+    static uint32_t g_deserialized; //!< the number of deserializations
+};
+
+uint32_t ACountedHeader::g_deserialized = 0;
+
+namespace ns3
+{
+
+/// The ACountedHeader can be kept in the cache of the deserialized headers.
+template <>
+struct IsCacheableHeader<ACountedHeader> : std::true_type
+{
+};
+
+} // namespace ns3
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * Packet header cache unit tests.
+ */
+class PacketHeaderCacheTest : public TestCase
+{
+  public:
+    PacketHeaderCacheTest();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Peek the header at the front of a packet.
+     * \param p the packet
+     * \param value the expected value of the header
+     * \param deserialized whether the header is expected to be deserialized
+     */
+    void CheckPeek(Ptr<const Packet> p, uint32_t value, bool deserialized);
+};
+
+PacketHeaderCacheTest::PacketHeaderCacheTest()
+    : TestCase("Packet header cache")
+{
+}
+
+void
+PacketHeaderCacheTest::CheckPeek(Ptr<const Packet> p, uint32_t value, bool deserialized)
+{
+    ACountedHeader header;
+    uint32_t count = ACountedHeader::g_deserialized;
+    NS_TEST_EXPECT_MSG_EQ(p->PeekHeader(header), 4, "Wrong size of header " << value);
+    NS_TEST_EXPECT_MSG_EQ(header.m_value, value, "Wrong header");
+    NS_TEST_EXPECT_MSG_EQ(ACountedHeader::g_deserialized - count,
+                          (deserialized ? 1 : 0),
+                          "Wrong deserialization of header " << value);
+}
+
+void
+PacketHeaderCacheTest::DoRun()
+{
+    Packet::EnableHeaderCache();
+
+    // The added headers are cached.
+    Ptr<Packet> p = Create<Packet>(10);
+    p->AddHeader(ACountedHeader(1));
+    p->AddHeader(ACountedHeader(2));
+    CheckPeek(p, 2, false);
+    ACountedHeader header;
+    NS_TEST_EXPECT_MSG_EQ(p->RemoveHeader(header), 4, "Wrong size of removed header");
+    NS_TEST_EXPECT_MSG_EQ(header.m_value, 2, "Wrong removed header");
+    NS_TEST_EXPECT_MSG_EQ(p->GetSize(), 14, "Wrong packet size");
+    CheckPeek(p, 1, false);
+
+    // The copies share the cache until they change.
+    Ptr<Packet> q = p->Copy();
+    q->RemoveHeader(header);
+    q->AddHeader(ACountedHeader(3));
+    CheckPeek(q, 3, false);
+    CheckPeek(p, 1, false);
+
+    // A header added without its type overwrites the cached one.
+    p->RemoveHeader(header);
+    p->AddHeader(static_cast<const Header&>(ACountedHeader(4)));
+    CheckPeek(p, 4, true);
+    CheckPeek(p, 4, false);
+
+    // The cache is cleared when the end of the packet changes.
+    p->AddTrailer(ATestTrailer<4>());
+    CheckPeek(p, 4, true);
+    p->AddAtEnd(Create<Packet>(5));
+    CheckPeek(p, 4, true);
+    p->RemoveAtEnd(5);
+    CheckPeek(p, 4, true);
+
+    // A deep copy does not share the cache.
+    Ptr<Packet> deep = p->DeepCopy();
+    CheckPeek(deep, 4, true);
+
+    // A header passed as a base class is not cached.
+    Header& base = header;
+    uint32_t count = ACountedHeader::g_deserialized;
+    p->PeekHeader(base);
+    NS_TEST_EXPECT_MSG_EQ(ACountedHeader::g_deserialized - count, 1, "Header not deserialized");
+
+    Packet::DisableHeaderCache();
+    q->AddHeader(ACountedHeader(5));
+    CheckPeek(q, 5, true);
+    CheckPeek(q, 5, true);
+}
+
 /**
  * \ingroup network-test
  * \ingroup tests
@@ -1274,6 +1749,10 @@ PacketTestSuite::PacketTestSuite()
 {
     AddTestCase(new PacketTest, TestCase::Duration::QUICK);
     AddTestCase(new PacketTagListTest, TestCase::Duration::QUICK);
+    AddTestCase(new PacketDeepCopyTest, TestCase::Duration::QUICK);
+    AddTestCase(new PacketChainTest, TestCase::Duration::QUICK);
+    AddTestCase(new PacketFreeListThreadTest, TestCase::Duration::QUICK);
+    AddTestCase(new PacketHeaderCacheTest, TestCase::Duration::QUICK);
 }
 
 static PacketTestSuite g_packetTestSuite; //!< Static variable for test initialization
@@ -9,6 +9,7 @@
 #include "point-to-point-net-device.h"
 
 #include "ns3/log.h"
+#include "ns3/node.h"
 #include "ns3/packet.h"
 #include "ns3/simulator.h"
 #include "ns3/trace-source-accessor.h"
@@ -48,7 +49,8 @@ PointToPointChannel::GetTypeId()
 PointToPointChannel::PointToPointChannel()
     : Channel(),
       m_delay(Seconds(0.)),
-      m_nDevices(0)
+      m_nDevices(0),
+      m_destinationsLocated(false)
 {
     NS_LOG_FUNCTION_NOARGS();
 }
@@ -83,19 +85,66 @@ PointToPointChannel::TransmitStart(Ptr<const Packet> p, Ptr<PointToPointNetDevic
     NS_ASSERT(m_link[0].m_state != INITIALIZING);
     NS_ASSERT(m_link[1].m_state != INITIALIZING);
 
+    if (!m_destinationsLocated)
+    {
+        LocateDestinations();
+    }
+
     uint32_t wire = src == m_link[0].m_src ? 0 : 1;
+    const Link& link = m_link[wire];
 
-    Simulator::ScheduleWithContext(m_link[wire].m_dst->GetNode()->GetId(),
-                                   txTime + m_delay,
-                                   &PointToPointNetDevice::Receive,
-                                   m_link[wire].m_dst,
-                                   p->Copy());
+    if (link.m_dstRemote)
+    {
+        // The destination may be run by another thread: hand over a packet
+        // and a device whose reference counts are left alone by this one
+        Simulator::ScheduleWithContext(link.m_dstNode,
+                                       txTime + m_delay,
+                                       &PointToPointNetDevice::Receive,
+                                       PeekPointer(link.m_dst),
+                                       p->DeepCopy());
+    }
+    else
+    {
+        Simulator::ScheduleWithContext(link.m_dstNode,
+                                       txTime + m_delay,
+                                       &PointToPointNetDevice::Receive,
+                                       link.m_dst,
+                                       p->Copy());
+    }
 
     // Call the tx anim callback on the net device
-    m_txrxPointToPoint(p, src, m_link[wire].m_dst, txTime, txTime + m_delay);
+    if (!m_txrxPointToPoint.IsEmpty())
+    {
+        m_txrxPointToPoint(p, src, link.m_dst, txTime, txTime + m_delay);
+    }
     return true;
 }
 
+void
+PointToPointChannel::DoInitialize()
+{
+    NS_LOG_FUNCTION(this);
+    if (m_nDevices == N_DEVICES)
+    {
+        LocateDestinations();
+    }
+    Channel::DoInitialize();
+}
+
+void
+PointToPointChannel::LocateDestinations()
+{
+    NS_LOG_FUNCTION(this);
+    for (auto& link : m_link)
+    {
+        Ptr<Node> src = link.m_src->GetNode();
+        Ptr<Node> dst = link.m_dst->GetNode();
+        link.m_dstNode = dst->GetId();
+        link.m_dstRemote = src->GetSystemId() != dst->GetSystemId();
+    }
+    m_destinationsLocated = true;
+}
+
 std::size_t
 PointToPointChannel::GetNDevices() const
 {
@@ -137,12 +137,25 @@ class PointToPointChannel : public Channel
                                           Time duration,
                                           Time lastBitTime);
 
+    void DoInitialize() override;
+
   private:
     /** Each point to point link has exactly two net devices. */
     static const std::size_t N_DEVICES = 2;
 
-    Time m_delay;           //!< Propagation delay
-    std::size_t m_nDevices; //!< Devices of this channel
+    /**
+     * \brief Find the node of the destination of each link, and
+     * whether it is in another partition (system id) than the source.
+     *
+     * Nodes are looked up when the channel is initialized, or else on
+     * the first transmission, so that transmissions between partitions
+     * never touch the reference counts of the destination node.
+     */
+    void LocateDestinations();
+
+    Time m_delay;               //!< Propagation delay
+    std::size_t m_nDevices;     //!< Devices of this channel
+    bool m_destinationsLocated; //!< LocateDestinations() was called
 
     /**
      * The trace source for the packet transmission animation events that the
@@ -193,6 +206,8 @@ class PointToPointChannel : public Channel
         WireState m_state{INITIALIZING};  //!< State of the link
         Ptr<PointToPointNetDevice> m_src; //!< First NetDevice
         Ptr<PointToPointNetDevice> m_dst; //!< Second NetDevice
+        uint32_t m_dstNode{0};            //!< Id of the node of the second NetDevice
+        bool m_dstRemote{false};          //!< Second NetDevice in another partition
     };
 
     Link m_link[N_DEVICES]; //!< Link model
@@ -8,6 +8,7 @@
 #define PPP_HEADER_H
 
 #include "ns3/header.h"
+#include "ns3/packet-header-cache.h"
 
 namespace ns3
 {
@@ -91,6 +92,14 @@ class PppHeader : public Header
     uint16_t m_protocol;
 };
 
+/**
+ * \brief The PppHeader can be kept in the cache of the deserialized headers.
+ */
+template <>
+struct IsCacheableHeader<PppHeader> : std::true_type
+{
+};
+
 } // namespace ns3
 
 #endif /* PPP_HEADER_H */
@@ -0,0 +1,96 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+// This program measures the cost of the Config paths which set the
+// attributes and connect the trace sources of every node, as the
+// scenarios with many nodes do in their setup.
+// Sample usage:  ./ns3 run 'bench-config --nodes=10000'
+
+#include "ns3/boolean.h"
+#include "ns3/command-line.h"
+#include "ns3/config.h"
+#include "ns3/node.h"
+#include "ns3/simple-net-device.h"
+#include "ns3/simulator.h"
+
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+using namespace ns3;
+
+/// Clock of the measurements
+using Clock = std::chrono::steady_clock;
+
+/// Number of bytes dropped, counted by the trace sink
+static uint64_t g_dropped = 0;
+
+/**
+ * Trace sink of the devices.
+ *
+ * \param packet The packet dropped.
+ */
+static void
+PhyRxDrop(Ptr<const Packet> packet)
+{
+    g_dropped += packet->GetSize();
+}
+
+/**
+ * Print the time taken by a measurement.
+ *
+ * \param name The name of the measurement.
+ * \param start The start of the measurement.
+ * \param n The number of operations measured.
+ */
+static void
+Print(std::string name, Clock::time_point start, uint32_t n)
+{
+    double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+    std::cout << std::left << std::setw(40) << name << std::right << std::fixed
+              << std::setprecision(3) << elapsed << " s, " << std::setprecision(1)
+              << elapsed * 1e6 / n << " us per node" << std::endl;
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t nodes = 10000;
+
+    CommandLine cmd(__FILE__);
+    cmd.AddValue("nodes", "Number of nodes", nodes);
+    cmd.Parse(argc, argv);
+
+    for (uint32_t i = 0; i < nodes; ++i)
+    {
+        Ptr<Node> node = CreateObject<Node>();
+        node->AddDevice(CreateObject<SimpleNetDevice>());
+    }
+
+    auto start = Clock::now();
+    for (uint32_t i = 0; i < nodes; ++i)
+    {
+        Config::Set("/NodeList/" + std::to_string(i) + "/DeviceList/0/PointToPointMode",
+                    BooleanValue(true));
+    }
+    Print("Config::Set per node:", start, nodes);
+
+    start = Clock::now();
+    for (uint32_t i = 0; i < nodes; ++i)
+    {
+        Config::ConnectWithoutContext("/NodeList/" + std::to_string(i) +
+                                          "/DeviceList/0/$ns3::SimpleNetDevice/PhyRxDrop",
+                                      MakeCallback(&PhyRxDrop));
+    }
+    Print("Config::ConnectWithoutContext per node:", start, nodes);
+
+    start = Clock::now();
+    auto devices = Config::Resolve<SimpleNetDevice>("/NodeList/*/DeviceList/*");
+    Print("Config::Resolve of all the devices:", start, nodes);
+
+    Simulator::Destroy();
+    return devices.size() == nodes ? 0 : 1;
+}
@@ -0,0 +1,168 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+// This program measures the cost of Object::GetObject() on the aggregates
+// of a node with an internet stack, and the run time of a simulation of
+// TCP bulk transfers, where the models look up the node aggregates for
+// every packet.
+// Sample usage:  ./ns3 run 'bench-get-object --lookups=10000000 --flows=8'
+
+#include "ns3/applications-module.h"
+#include "ns3/core-module.h"
+#include "ns3/internet-module.h"
+#include "ns3/network-module.h"
+#include "ns3/point-to-point-module.h"
+#include "ns3/traffic-control-layer.h"
+
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+using namespace ns3;
+
+/// Clock of the measurements
+using Clock = std::chrono::steady_clock;
+
+/// Keeps the results of the lookups alive
+static uintptr_t g_sink = 0;
+
+/**
+ * Look up an aggregate of a node.
+ *
+ * \tparam T \explicit The type of the aggregate.
+ * \param node The node.
+ * \param lookups Number of lookups
+ * \return the time per lookup, in nanoseconds
+ */
+template <typename T>
+static double
+LookUp(Ptr<Node> node, uint64_t lookups)
+{
+    auto start = Clock::now();
+    for (uint64_t i = 0; i < lookups; ++i)
+    {
+        g_sink += reinterpret_cast<uintptr_t>(PeekPointer(node->GetObject<T>()));
+    }
+    return std::chrono::duration<double, std::nano>(Clock::now() - start).count() / lookups;
+}
+
+/**
+ * Look up the aggregates of a node in turn, as the models of a node do.
+ *
+ * \param node The node.
+ * \param lookups Number of lookups
+ * \return the time per lookup, in nanoseconds
+ */
+static double
+LookUpInTurn(Ptr<Node> node, uint64_t lookups)
+{
+    auto start = Clock::now();
+    for (uint64_t i = 0; i < lookups; i += 4)
+    {
+        g_sink += reinterpret_cast<uintptr_t>(PeekPointer(node->GetObject<Ipv4>()));
+        g_sink += reinterpret_cast<uintptr_t>(PeekPointer(node->GetObject<TcpL4Protocol>()));
+        g_sink += reinterpret_cast<uintptr_t>(PeekPointer(node->GetObject<TrafficControlLayer>()));
+        g_sink += reinterpret_cast<uintptr_t>(PeekPointer(node->GetObject<UdpL4Protocol>()));
+    }
+    return std::chrono::duration<double, std::nano>(Clock::now() - start).count() / lookups;
+}
+
+/**
+ * Run TCP bulk transfers over a dumbbell.
+ *
+ * \param flows Number of flows
+ * \param duration Simulated time
+ */
+static void
+RunBulkTransfers(uint32_t flows, Time duration)
+{
+    NodeContainer senders;
+    senders.Create(flows);
+    NodeContainer routers;
+    routers.Create(2);
+    NodeContainer receivers;
+    receivers.Create(flows);
+
+    PointToPointHelper leaf;
+    leaf.SetDeviceAttribute("DataRate", StringValue("100Mbps"));
+    leaf.SetChannelAttribute("Delay", StringValue("1ms"));
+    PointToPointHelper bottleneck;
+    bottleneck.SetDeviceAttribute("DataRate", StringValue("100Mbps"));
+    bottleneck.SetChannelAttribute("Delay", StringValue("10ms"));
+
+    InternetStackHelper stack;
+    stack.InstallAll();
+    Ipv4AddressHelper address("10.0.0.0", "255.255.255.0");
+    address.Assign(bottleneck.Install(routers));
+    Ipv4InterfaceContainer sinks;
+    for (uint32_t i = 0; i < flows; ++i)
+    {
+        address.NewNetwork();
+        address.Assign(leaf.Install(senders.Get(i), routers.Get(0)));
+        address.NewNetwork();
+        sinks.Add(address.Assign(leaf.Install(receivers.Get(i), routers.Get(1))).Get(0));
+    }
+    Ipv4GlobalRoutingHelper::PopulateRoutingTables();
+
+    uint16_t port = 9;
+    PacketSinkHelper sink("ns3::TcpSocketFactory", InetSocketAddress(Ipv4Address::GetAny(), port));
+    sink.Install(receivers).Start(Seconds(0));
+    for (uint32_t i = 0; i < flows; ++i)
+    {
+        BulkSendHelper source("ns3::TcpSocketFactory",
+                              InetSocketAddress(sinks.GetAddress(i), port));
+        source.Install(senders.Get(i)).Start(MilliSeconds(i));
+    }
+
+    Simulator::Stop(duration);
+    auto start = Clock::now();
+    Simulator::Run();
+    double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+    std::cout << "TCP bulk transfers: " << flows << " flows, " << Simulator::GetEventCount()
+              << " events in " << std::setprecision(3) << elapsed << " s" << std::endl;
+    Simulator::Destroy();
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint64_t lookups = 10000000;
+    uint32_t flows = 8;
+    Time duration = Seconds(10);
+
+    CommandLine cmd(__FILE__);
+    cmd.AddValue("lookups", "Number of lookups of every measurement", lookups);
+    cmd.AddValue("flows", "Number of TCP flows, 0 to skip the simulation", flows);
+    cmd.AddValue("duration", "Simulated time of the TCP flows", duration);
+    cmd.Parse(argc, argv);
+
+    {
+        Ptr<Node> node = CreateObject<Node>();
+        InternetStackHelper stack;
+        stack.Install(node);
+
+        std::cout << std::fixed << std::setprecision(1);
+        std::cout << "GetObject<Ipv4>():                " << LookUp<Ipv4>(node, lookups)
+                  << " ns" << std::endl;
+        std::cout << "GetObject<TcpL4Protocol>():       " << LookUp<TcpL4Protocol>(node, lookups)
+                  << " ns" << std::endl;
+        std::cout << "GetObject<TrafficControlLayer>(): "
+                  << LookUp<TrafficControlLayer>(node, lookups) << " ns" << std::endl;
+        std::cout << "GetObject<Node>():                " << LookUp<Node>(node, lookups)
+                  << " ns" << std::endl;
+        std::cout << "GetObject<PacketSink>() (absent): " << LookUp<PacketSink>(node, lookups)
+                  << " ns" << std::endl;
+        std::cout << "four aggregates in turn:          " << LookUpInTurn(node, lookups)
+                  << " ns" << std::endl;
+        Simulator::Destroy();
+    }
+
+    if (flows > 0)
+    {
+        RunBulkTransfers(flows, duration);
+    }
+    return g_sink == 1 ? 1 : 0;
+}
@@ -0,0 +1,161 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/core-module.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+/**
+ * \file
+ * Benchmark of the events scheduled by other threads.
+ *
+ * Producer threads schedule events with Simulator::ScheduleWithContext()
+ * as fast as they can, while the simulation runs a chain of heartbeat
+ * events which keeps it alive until every event is received. The
+ * benchmark reports the injection rate of the producers, the rate of the
+ * events received by the simulation, and the time per event of a chain
+ * run without producers, which measures the overhead of the check for
+ * events from other threads in the event loop.
+ */
+
+using namespace ns3;
+
+namespace
+{
+
+/** Clock of the measurements. */
+using Clock = std::chrono::steady_clock;
+
+/** State of a run, written by the simulation thread. */
+struct Run
+{
+    uint64_t expected{0};               //!< Events to receive
+    uint64_t received{0};               //!< Events received
+    uint64_t heartbeats{0};             //!< Heartbeat events run
+    std::atomic<unsigned> producing{0}; //!< Producers still injecting
+} g_run;                                //!< The current run
+
+/** Event scheduled by the producers. */
+void
+Receive()
+{
+    g_run.received++;
+}
+
+/** Keep the simulation running until all the events are received. */
+void
+Heartbeat()
+{
+    g_run.heartbeats++;
+    if (g_run.producing > 0 || g_run.received < g_run.expected)
+    {
+        Simulator::Schedule(NanoSeconds(1), &Heartbeat);
+    }
+}
+
+/**
+ * Schedule events from another thread.
+ *
+ * \param [in] events The number of events.
+ * \param [out] elapsed The time taken.
+ */
+void
+Produce(uint64_t events, double* elapsed)
+{
+    auto start = Clock::now();
+    for (uint64_t i = 0; i < events; ++i)
+    {
+        Simulator::ScheduleWithContext(0, Time(0), &Receive);
+    }
+    *elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+    g_run.producing--;
+}
+
+/**
+ * Chain of events without producers.
+ *
+ * \param [in] count The number of events left.
+ */
+void
+Chain(uint64_t count)
+{
+    if (count > 0)
+    {
+        Simulator::Schedule(NanoSeconds(1), &Chain, count - 1);
+    }
+}
+
+} // namespace
+
+int
+main(int argc, char* argv[])
+{
+    uint64_t events = 1000000;
+    uint64_t chain = 10000000;
+    std::string producers = "1,4,16";
+
+    CommandLine cmd(__FILE__);
+    cmd.AddValue("events", "Number of events scheduled by every producer", events);
+    cmd.AddValue("chain", "Number of events of the chain without producers", chain);
+    cmd.AddValue("producers", "Comma separated numbers of producer threads", producers);
+    cmd.Parse(argc, argv);
+
+    // Event loop overhead without producers
+    {
+        Simulator::Schedule(NanoSeconds(1), &Chain, chain);
+        auto start = Clock::now();
+        Simulator::Run();
+        double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+        Simulator::Destroy();
+        std::cout << "event loop: " << std::fixed << std::setprecision(1)
+                  << elapsed * 1e9 / chain << " ns/event" << std::endl;
+    }
+
+    std::cout << std::setw(10) << "producers" << std::setw(18) << "inject (ev/s)"
+              << std::setw(18) << "receive (ev/s)" << std::setw(14) << "heartbeats"
+              << std::endl;
+
+    std::istringstream list(producers);
+    std::string item;
+    while (std::getline(list, item, ','))
+    {
+        unsigned threads = std::stoul(item);
+        g_run.expected = threads * events;
+        g_run.received = 0;
+        g_run.heartbeats = 0;
+        g_run.producing = threads;
+
+        Simulator::Schedule(NanoSeconds(1), &Heartbeat);
+        // Create the simulator before the producers
+        Simulator::Now();
+
+        std::vector<double> elapsed(threads);
+        std::vector<std::thread> pool;
+        auto start = Clock::now();
+        for (unsigned i = 0; i < threads; ++i)
+        {
+            pool.emplace_back(&Produce, events, &elapsed[i]);
+        }
+        Simulator::Run();
+        double total = std::chrono::duration<double>(Clock::now() - start).count();
+        for (auto& thread : pool)
+        {
+            thread.join();
+        }
+        Simulator::Destroy();
+
+        double slowest = *std::max_element(elapsed.begin(), elapsed.end());
+        std::cout << std::setw(10) << threads << std::setw(18) << std::setprecision(0)
+                  << g_run.expected / slowest << std::setw(18) << g_run.received / total
+                  << std::setw(14) << g_run.heartbeats << std::endl;
+    }
+    return 0;
+}
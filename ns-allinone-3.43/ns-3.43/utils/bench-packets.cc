@@ -9,6 +9,9 @@
 // This program can be used to benchmark packet serialization/deserialization
 // operations using Headers and Tags, for various numbers of packets 'n'
 // Sample usage:  ./ns3 run 'bench-packets --n=10000'
+//
+// With --allocations, it instead counts the memory allocations per packet
+// forwarded to another thread, once the free lists of the packets are warm.
 
 #include "ns3/command-line.h"
 #include "ns3/packet-metadata.h"
@@ -16,14 +19,59 @@
 #include "ns3/system-wall-clock-ms.h"
 
 #include <algorithm>
+#include <atomic>
+#include <cstdlib>
 #include <iostream>
 #include <limits>
+#include <new>
 #include <sstream>
 #include <stdlib.h> // for exit ()
 #include <string>
+#include <thread>
+#include <vector>
 
 using namespace ns3;
 
+/// The number of calls to the global operator new, by all the threads
+static std::atomic<uint64_t> g_allocations{0};
+
+/**
+ * Count the allocations.
+ * \param size the size of the allocation
+ * \returns the allocated memory
+ */
+void*
+operator new(std::size_t size)
+{
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    void* p = std::malloc(size == 0 ? 1 : size);
+    if (p == nullptr)
+    {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+/**
+ * Release the memory of operator new.
+ * \param p the memory
+ */
+void
+operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+/**
+ * Release the memory of operator new.
+ * \param p the memory
+ */
+void
+operator delete(void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
 /// BenchHeader class used for benchmarking packet serialization/deserialization
 template <int N>
 class BenchHeader : public Header
@@ -136,6 +184,21 @@ BenchHeader<N>::Deserialize(Buffer::Iterator start)
     return N;
 }
 
+namespace ns3
+{
+
+/**
+ * The BenchHeader can be kept in the cache of the deserialized headers.
+ * Its copies are only equal to the headers which were not deserialized,
+ * so IsOk() stays false when the header cache is enabled.
+ */
+template <int N>
+struct IsCacheableHeader<BenchHeader<N>> : std::true_type
+{
+};
+
+} // namespace ns3
+
 /// BenchTag class used for benchmarking packet serialization/deserialization
 template <int N>
 class BenchTag : public Tag
@@ -244,7 +307,8 @@ benchA(uint32_t n)
         o->RemoveHeader(ipv4);
         o->RemoveHeader(udp);
     }
-    NS_ASSERT_MSG(ipv4.IsOk() == true, "IsOk() should be true after deserialization");
+    NS_ASSERT_MSG(ipv4.IsOk() == true || PacketHeaderCache::IsEnabled(),
+                  "IsOk() should be true after deserialization");
 }
 
 static void
@@ -339,6 +403,125 @@ benchByteTags(uint32_t n)
     }
 }
 
+/**
+ * Forward packets to a receiver thread, in batches, the way a parallel
+ * simulation hands them over a link between two threads.
+ */
+class Forwarder
+{
+  public:
+    Forwarder();
+    ~Forwarder();
+
+    /**
+     * Forward packets.
+     * \param n the number of packets
+     * \returns the number of forwarded packets, n rounded up to whole batches
+     */
+    uint32_t Forward(uint32_t n);
+
+  private:
+    /// Remove the headers and tags of the packets of the batch, and release them.
+    void Receive();
+
+    /// The number of packets in a batch
+    static constexpr uint32_t BATCH_SIZE = 64;
+    /// The turn of the sender
+    static constexpr uint32_t SENDER = 0;
+    /// The turn of the receiver
+    static constexpr uint32_t RECEIVER = 1;
+    /// The end of the receiver thread
+    static constexpr uint32_t STOP = 2;
+
+    std::vector<Ptr<Packet>> m_batch; //!< the packets handed over to the receiver
+    std::atomic<uint32_t> m_turn;     //!< the thread which owns the batch
+    std::thread m_receiver;           //!< the receiver thread
+};
+
+Forwarder::Forwarder()
+    : m_turn(SENDER)
+{
+    m_batch.reserve(BATCH_SIZE);
+    m_receiver = std::thread(&Forwarder::Receive, this);
+}
+
+Forwarder::~Forwarder()
+{
+    m_turn.store(STOP);
+    m_turn.notify_one();
+    m_receiver.join();
+}
+
+uint32_t
+Forwarder::Forward(uint32_t n)
+{
+    BenchHeader<25> ipv4;
+    BenchHeader<8> udp;
+    BenchTag<16> tag;
+
+    uint32_t i = 0;
+    for (; i < n; i += BATCH_SIZE)
+    {
+        for (uint32_t j = 0; j < BATCH_SIZE; j++)
+        {
+            Ptr<Packet> p = Create<Packet>(1000);
+            p->AddPacketTag(tag);
+            p->AddHeader(udp);
+            p->AddHeader(ipv4);
+            // The copy handed over shares nothing with the original
+            m_batch.push_back(p->DeepCopy());
+        }
+        m_turn.store(RECEIVER);
+        m_turn.notify_one();
+        m_turn.wait(RECEIVER);
+    }
+    return i;
+}
+
+void
+Forwarder::Receive()
+{
+    BenchHeader<25> ipv4;
+    BenchHeader<8> udp;
+    BenchTag<16> tag;
+
+    while (true)
+    {
+        m_turn.wait(SENDER);
+        if (m_turn.load() == STOP)
+        {
+            return;
+        }
+        for (auto& p : m_batch)
+        {
+            p->RemoveHeader(ipv4);
+            p->RemoveHeader(udp);
+            p->RemovePacketTag(tag);
+        }
+        // The memory of the packets goes back to the sender thread
+        m_batch.clear();
+        m_turn.store(SENDER);
+        m_turn.notify_one();
+    }
+}
+
+/**
+ * Report the number of allocations per forwarded packet, once the free
+ * lists are warm.
+ * \param n the number of packets
+ */
+static void
+benchAllocations(uint32_t n)
+{
+    Forwarder forwarder;
+    forwarder.Forward(n);
+    uint64_t allocations = g_allocations.load();
+    uint32_t forwarded = forwarder.Forward(n);
+    allocations = g_allocations.load() - allocations;
+    std::cout << static_cast<double>(allocations) / forwarded << " allocations per forwarded packet"
+              << " (" << allocations << " allocations)" << std::endl;
+}
+
 static uint64_t
 runBenchOneIteration(void (*bench)(uint32_t), uint32_t n)
 {
@@ -371,6 +554,8 @@ main(int argc, char* argv[])
     uint32_t n = 0;
     uint32_t minIterations = 1;
     bool enablePrinting = false;
+    bool enableHeaderCache = false;
+    bool allocations = false;
 
     CommandLine cmd(__FILE__);
     cmd.Usage("Benchmark Packet class");
@@ -379,8 +564,17 @@ main(int argc, char* argv[])
                  "number of subiterations to minimize iteration time over",
                  minIterations);
     cmd.AddValue("enable-printing", "enable packet printing", enablePrinting);
+    cmd.AddValue("enable-header-cache", "enable the packet header cache", enableHeaderCache);
+    cmd.AddValue("allocations",
+                 "count the allocations per packet forwarded to another thread",
+                 allocations);
     cmd.Parse(argc, argv);
 
+    if (enableHeaderCache)
+    {
+        Packet::EnableHeaderCache();
+    }
+
     if (n == 0)
     {
         std::cerr << "Error-- number of packets must be specified "
@@ -388,6 +582,12 @@ main(int argc, char* argv[])
         exit(1);
     }
     std::cout << "Running bench-packets with n=" << n << std::endl;
+
+    if (allocations)
+    {
+        benchAllocations(n);
+        return 0;
+    }
     std::cout << "All tests begin by adding UDP and IPv4 headers." << std::endl;
 
     runBench(&benchA, n, minIterations, "Copy packet, remove headers");
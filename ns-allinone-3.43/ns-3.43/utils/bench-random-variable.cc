@@ -0,0 +1,87 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+// This program measures the cost of the random values of the common
+// distributions, drawn one by one with GetValue() and in blocks with
+// GetValues().
+// Sample usage:  ./ns3 run 'bench-random-variable --values=10000000 --block=64'
+
+#include "ns3/command-line.h"
+#include "ns3/double.h"
+#include "ns3/random-variable-stream.h"
+
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace ns3;
+
+/// Clock of the measurements
+using Clock = std::chrono::steady_clock;
+
+/// Keeps the values alive
+static double g_sink = 0;
+
+/**
+ * Measure the values of a random variable.
+ *
+ * \param name The name of the distribution.
+ * \param variable The random variable.
+ * \param values Number of values
+ * \param block Number of values per call of GetValues()
+ */
+static void
+Measure(std::string name, Ptr<RandomVariableStream> variable, uint64_t values, uint32_t block)
+{
+    auto start = Clock::now();
+    for (uint64_t i = 0; i < values; ++i)
+    {
+        g_sink += variable->GetValue();
+    }
+    double scalar = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / values;
+
+    std::vector<double> buffer(block);
+    start = Clock::now();
+    for (uint64_t i = 0; i < values; i += block)
+    {
+        variable->GetValues(buffer.data(), block);
+        g_sink += buffer[0];
+    }
+    double blocks = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / values;
+
+    std::cout << std::left << std::setw(24) << name << std::right << std::fixed
+              << std::setprecision(2) << "GetValue() " << scalar << " ns, GetValues() " << blocks
+              << " ns per value" << std::endl;
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint64_t values = 10000000;
+    uint32_t block = 64;
+
+    CommandLine cmd(__FILE__);
+    cmd.AddValue("values", "Number of values of every measurement", values);
+    cmd.AddValue("block", "Number of values per call of GetValues()", block);
+    cmd.Parse(argc, argv);
+
+    auto uniform = CreateObject<UniformRandomVariable>();
+    Measure("uniform:", uniform, values, block);
+
+    auto exponential = CreateObject<ExponentialRandomVariable>();
+    exponential->SetAttribute("Mean", DoubleValue(1));
+    Measure("exponential:", exponential, values, block);
+
+    auto pareto = CreateObject<ParetoRandomVariable>();
+    pareto->SetAttribute("Shape", DoubleValue(1.5));
+    Measure("Pareto:", pareto, values, block);
+
+    auto normal = CreateObject<NormalRandomVariable>();
+    Measure("normal:", normal, values, block);
+
+    return g_sink == 0 ? 1 : 0;
+}
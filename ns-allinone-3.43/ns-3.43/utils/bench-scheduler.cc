@@ -36,6 +36,17 @@ std::string g_me;
 /** Output field width for numeric data. */
 int g_fwidth = 6;
 
+/** Flag to compare the runs with and without the EventPool. */
+bool g_allocs = false;
+
+/** Far events and timers mixed into the event delays, see Bench::SetFarEvents(). */
+struct FarEvents
+{
+    double fraction{0};                /**< Fraction of far events. */
+    Ptr<RandomVariableStream> stream;  /**< Stream for far event delays. */
+    uint64_t timers{0};                /**< Number of timers restarted by the events. */
+} g_far; /**< Far events of the selected distribution. */
+
 /**
  *  Benchmark instance which can do a single run.
  *
@@ -55,7 +66,9 @@ class Bench
     Bench(const uint64_t population, const uint64_t total)
         : m_population(population),
           m_total(total),
-          m_count(0)
+          m_count(0),
+          m_farFraction(0),
+          m_mix(CreateObject<UniformRandomVariable>())
     {
     }
 
@@ -70,6 +83,24 @@ class Bench
         m_rand = stream;
     }
 
+    /**
+     * Mix far events into the event delays, like the retransmission timers
+     * of a TCP network, and restart timers from every event, the way a TCP
+     * sender restarts its retransmission timer on every ACK.
+     *
+     * A restarted timer is removed from the scheduler with Simulator::Remove().
+     *
+     * \param [in] farFraction Fraction of the events scheduled with a far delay.
+     * \param [in] far The random variable stream of far delays, also used for the timers.
+     * \param [in] timers Number of timers restarted in turn by the events, 0 for none.
+     */
+    void SetFarEvents(double farFraction, Ptr<RandomVariableStream> far, uint64_t timers)
+    {
+        m_farFraction = farFraction;
+        m_far = far;
+        m_timers.resize(timers);
+    }
+
     /**
      * Set the number of events to populate the scheduler with.
      * Each event executed schedules a new event, maintaining the population.
@@ -112,10 +143,23 @@ class Bench
      */
     void Cb();
 
+    /** Timer function, the timer is restarted by the next events. */
+    void Timeout();
+
+    /**
+     * Draw the delay of a new event.
+     * \returns The delay.
+     */
+    Time NextDelay();
+
     Ptr<RandomVariableStream> m_rand; /**< Stream for event delays. */
     uint64_t m_population;            /**< Event population size. */
     uint64_t m_total;                 /**< Total number of events to execute. */
     uint64_t m_count;                 /**< Count of events executed so far. */
+    double m_farFraction;             /**< Fraction of far events. */
+    Ptr<RandomVariableStream> m_far;  /**< Stream for far event delays. */
+    Ptr<UniformRandomVariable> m_mix; /**< Stream picking the far events. */
+    std::vector<EventId> m_timers;    /**< Timers restarted by the events. */
 
 }; // class Bench
 
@@ -132,8 +176,7 @@ Bench::Run()
     timer.Start();
     for (uint64_t i = 0; i < m_population; ++i)
     {
-        Time at = NanoSeconds(m_rand->GetValue());
-        Simulator::Schedule(at, &Bench::Cb, this);
+        Simulator::Schedule(NextDelay(), &Bench::Cb, this);
     }
     init = timer.End() / 1000.0;
     DEB("initialization took " << init << "s");
@@ -145,6 +188,8 @@ Bench::Run()
     DEB("run took " << simu << "s");
 
     Simulator::Destroy();
+    // The timers of this run are gone with its simulator
+    std::fill(m_timers.begin(), m_timers.end(), EventId());
 
     return Result{init, simu, m_population, m_count};
 }
@@ -159,11 +204,32 @@ Bench::Cb()
     }
     DEB("event at " << Simulator::Now().GetSeconds() << "s");
 
-    Time after = NanoSeconds(m_rand->GetValue());
-    Simulator::Schedule(after, &Bench::Cb, this);
+    Simulator::Schedule(NextDelay(), &Bench::Cb, this);
+    if (!m_timers.empty())
+    {
+        EventId& timer = m_timers[m_count % m_timers.size()];
+        Simulator::Remove(timer);
+        timer = Simulator::Schedule(NanoSeconds(m_far->GetValue()), &Bench::Timeout, this);
+    }
     ++m_count;
 }
 
+void
+Bench::Timeout()
+{
+    DEB("timeout at " << Simulator::Now().GetSeconds() << "s");
+}
+
+Time
+Bench::NextDelay()
+{
+    if (m_farFraction > 0 && m_mix->GetValue() < m_farFraction)
+    {
+        return NanoSeconds(m_far->GetValue());
+    }
+    return NanoSeconds(m_rand->GetValue());
+}
+
 /** Benchmark which performs an ensemble of runs. */
 class BenchSuite
 {
@@ -274,6 +340,7 @@ BenchSuite::BenchSuite(ObjectFactory& factory,
 
     Bench bench(pop, total);
     bench.SetRandomStream(eventStream);
+    bench.SetFarEvents(g_far.fraction, g_far.stream, g_far.timers);
     bench.SetPopulation(pop);
     bench.SetTotal(total);
 
@@ -440,6 +507,52 @@ GetRandomStream(std::string filename)
     return stream;
 }
 
+/**
+ * Perform and log the runs for a single scheduler type. With --allocs, the
+ * runs are performed with and without the EventPool, and the event and
+ * system allocations of each are logged after their table.
+ *
+ * \param [in] factory Factory pre-configured to create the desired Scheduler.
+ * \param [in] pop The event population size.
+ * \param [in] total The total number of events to execute.
+ * \param [in] runs The number of replications.
+ * \param [in] eventStream The random stream of event delays.
+ * \param [in] calRev For the CalendarScheduler, whether the Reverse attribute was set.
+ */
+void
+RunSuite(ObjectFactory& factory,
+         uint64_t pop,
+         uint64_t total,
+         uint64_t runs,
+         Ptr<RandomVariableStream> eventStream,
+         bool calRev)
+{
+    if (!g_allocs)
+    {
+        BenchSuite(factory, pop, total, runs, eventStream, calRev).Log();
+        return;
+    }
+
+    bool enabled = EventPool::IsEnabled();
+    for (bool pool : {false, true})
+    {
+        EventPool::SetEnabled(pool);
+        LOG("Event pool " << (pool ? "enabled" : "disabled"));
+        auto before = EventPool::GetStats();
+        BenchSuite(factory, pop, total, runs, eventStream, calRev).Log();
+        auto after = EventPool::GetStats();
+
+        uint64_t events = after.allocations - before.allocations;
+        uint64_t system = after.systemAllocations - before.systemAllocations;
+        LOG("  Events allocated:             " << events);
+        LOG("  System allocations:           " << system << " ("
+                                               << static_cast<double>(system) / events
+                                               << " per event)");
+        LOG("");
+    }
+    EventPool::SetEnabled(enabled);
+}
+
 int
 main(int argc, char* argv[])
 {
@@ -449,12 +562,14 @@ main(int argc, char* argv[])
     bool schedList = false;
     bool schedMap = false; // default scheduler
     bool schedPQ = false;
+    bool schedWheel = false;
 
     uint64_t pop = 100000;
     uint64_t total = 1000000;
     uint64_t runs = 1;
     std::string filename = "";
     bool calRev = false;
+    std::string dist = "exp";
 
     CommandLine cmd(__FILE__);
     cmd.Usage("Benchmark the simulator scheduler.\n"
@@ -466,6 +581,14 @@ main(int argc, char* argv[])
               "In the case of either --file form, the input is expected\n"
               "to be ascii, giving the relative event times in ns.\n"
               "\n"
+              "The --dist argument mixes far events into these intervals,\n"
+              "uniform between 200 ms and 1 s, as in a TCP network:\n"
+              "  exp:     none,\n"
+              "  bimodal: 5% of the events are far events,\n"
+              "  tcp:     1% of the events are far events, and every event\n"
+              "           restarts one of pop/10 retransmission timers, which\n"
+              "           removes the previous timer from the scheduler.\n"
+              "\n"
               "If no scheduler is specified the MapScheduler will be run.");
     cmd.AddValue("all", "use all schedulers", allSched);
     cmd.AddValue("cal", "use CalendarScheduler", schedCal);
@@ -474,12 +597,15 @@ main(int argc, char* argv[])
     cmd.AddValue("list", "use ListScheduler", schedList);
     cmd.AddValue("map", "use MapScheduler (default)", schedMap);
     cmd.AddValue("pri", "use PriorityQueue", schedPQ);
+    cmd.AddValue("wheel", "use TimingWheelScheduler", schedWheel);
     cmd.AddValue("debug", "enable debugging output", g_debug);
     cmd.AddValue("pop", "event population size", pop);
     cmd.AddValue("total", "total number of events to run", total);
     cmd.AddValue("runs", "number of runs", runs);
     cmd.AddValue("file", "file of relative event times", filename);
+    cmd.AddValue("dist", "far events mixed into the event times: exp, bimodal or tcp", dist);
     cmd.AddValue("prec", "printed output precision", g_fwidth);
+    cmd.AddValue("allocs", "compare the runs with and without the event pool", g_allocs);
     cmd.Parse(argc, argv);
 
     g_me = cmd.GetName() + ": ";
@@ -490,36 +616,53 @@ main(int argc, char* argv[])
     LOG("  Event population size:        " << pop);
     LOG("  Total events per run:         " << total);
     LOG("  Number of runs per scheduler: " << runs);
+    if (g_allocs)
+    {
+        LOG("  Event pool:                   with and without");
+    }
     DEB("debugging is ON");
 
     if (allSched)
     {
-        schedCal = schedHeap = schedList = schedMap = schedPQ = true;
+        schedCal = schedHeap = schedList = schedMap = schedPQ = schedWheel = true;
     }
     // Set the default case if nothing else is set
-    if (!(schedCal || schedHeap || schedList || schedMap || schedPQ))
+    if (!(schedCal || schedHeap || schedList || schedMap || schedPQ || schedWheel))
     {
         schedMap = true;
     }
 
     auto eventStream = GetRandomStream(filename);
 
+    if (dist != "exp")
+    {
+        NS_ABORT_MSG_IF(dist != "bimodal" && dist != "tcp", "Unknown distribution " << dist);
+        auto far = CreateObject<UniformRandomVariable>();
+        far->SetAttribute("Min", DoubleValue(200e6));
+        far->SetAttribute("Max", DoubleValue(1e9));
+        g_far.stream = far;
+        g_far.fraction = (dist == "bimodal" ? 0.05 : 0.01);
+        g_far.timers = (dist == "tcp" ? pop / 10 : 0);
+        LOG("  Far events:                   " << g_far.fraction * 100 << "%, "
+                                               << g_far.timers << " timers");
+    }
+
     ObjectFactory factory("ns3::MapScheduler");
     if (schedCal)
     {
         factory.SetTypeId("ns3::CalendarScheduler");
         factory.Set("Reverse", BooleanValue(calRev));
-        BenchSuite(factory, pop, total, runs, eventStream, calRev).Log();
+        RunSuite(factory, pop, total, runs, eventStream, calRev);
         if (allSched)
         {
             factory.Set("Reverse", BooleanValue(!calRev));
-            BenchSuite(factory, pop, total, runs, eventStream, !calRev).Log();
+            RunSuite(factory, pop, total, runs, eventStream, !calRev);
         }
     }
     if (schedHeap)
     {
         factory.SetTypeId("ns3::HeapScheduler");
-        BenchSuite(factory, pop, total, runs, eventStream, calRev).Log();
+        RunSuite(factory, pop, total, runs, eventStream, calRev);
     }
     if (schedList)
     {
@@ -530,17 +673,22 @@ main(int argc, char* argv[])
             LOG("Running List scheduler with 1/10 total events");
             listTotal /= 10;
         }
-        BenchSuite(factory, pop, listTotal, runs, eventStream, calRev).Log();
+        RunSuite(factory, pop, listTotal, runs, eventStream, calRev);
     }
     if (schedMap)
     {
         factory.SetTypeId("ns3::MapScheduler");
-        BenchSuite(factory, pop, total, runs, eventStream, calRev).Log();
+        RunSuite(factory, pop, total, runs, eventStream, calRev);
     }
     if (schedPQ)
     {
         factory.SetTypeId("ns3::PriorityQueueScheduler");
-        BenchSuite(factory, pop, total, runs, eventStream, calRev).Log();
+        RunSuite(factory, pop, total, runs, eventStream, calRev);
+    }
+    if (schedWheel)
+    {
+        factory.SetTypeId("ns3::TimingWheelScheduler");
+        RunSuite(factory, pop, total, runs, eventStream, calRev);
     }
 
     return 0;
@@ -0,0 +1,109 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+// This program compares the per-ACK cost of the floating point and of the
+// fixed-point window growth of the CUBIC built into AdaptiveTcp, and checks
+// that both produce the same congestion window trajectory.
+// Sample usage:  ./ns3 run 'bench-tcp-cubic --acks=1000000'
+
+#include "ns3/adaptive-tcp.h"
+#include "ns3/boolean.h"
+#include "ns3/command-line.h"
+#include "ns3/simulator.h"
+#include "ns3/tcp-socket-state.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+using namespace ns3;
+
+/// Per-ACK cost and cWnd trajectory of a run
+struct BenchResult
+{
+    double nsPerAck{0};            //!< Mean wall clock time of IncreaseWindow
+    std::vector<uint32_t> cwnds{}; //!< cWnd (in segments) after every ACK
+};
+
+/**
+ * Acknowledge one segment at a time, with a loss every lossInterval ACKs.
+ *
+ * \param fixedPoint Value of the FixedPoint attribute
+ * \param acks Number of ACKs
+ * \param lossInterval Number of ACKs between losses
+ * \param ackSpacing Time between ACKs
+ * \return the per-ACK cost and the cWnd trajectory
+ */
+static BenchResult
+RunCubic(bool fixedPoint, uint32_t acks, uint32_t lossInterval, Time ackSpacing)
+{
+    Ptr<TcpSocketState> tcb = CreateObject<TcpSocketState>();
+    tcb->m_segmentSize = 1000;
+    tcb->m_cWnd = 100 * tcb->m_segmentSize;
+    tcb->m_ssThresh = 50 * tcb->m_segmentSize;
+    tcb->m_isCwndLimited = true;
+
+    Ptr<AdaptiveTcp> cong = CreateObject<AdaptiveTcp>();
+    cong->SetAttribute("FixedPoint", BooleanValue(fixedPoint));
+    cong->Init(tcb);
+    cong->PktsAcked(tcb, 1, MilliSeconds(50));
+
+    BenchResult result;
+    result.cwnds.reserve(acks);
+    std::chrono::steady_clock::duration elapsed{0};
+    for (uint32_t i = 1; i <= acks; i++)
+    {
+        Simulator::Schedule(ackSpacing * i, [&, i]() {
+            if (i % lossInterval == 0)
+            {
+                tcb->m_ssThresh = cong->GetSsThresh(tcb, tcb->m_cWnd);
+                tcb->m_cWnd = tcb->m_ssThresh.Get();
+            }
+            auto start = std::chrono::steady_clock::now();
+            cong->IncreaseWindow(tcb, 1);
+            elapsed += std::chrono::steady_clock::now() - start;
+            result.cwnds.push_back(tcb->GetCwndInSegments());
+        });
+    }
+    Simulator::Run();
+    Simulator::Destroy();
+
+    result.nsPerAck = std::chrono::duration<double, std::nano>(elapsed).count() / acks;
+    return result;
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t acks = 200000;
+    uint32_t lossInterval = 20000;
+    Time ackSpacing = MicroSeconds(500);
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Benchmark the floating point and fixed-point CUBIC of AdaptiveTcp");
+    cmd.AddValue("acks", "number of ACKs per run", acks);
+    cmd.AddValue("lossInterval", "number of ACKs between losses", lossInterval);
+    cmd.AddValue("ackSpacing", "time between ACKs", ackSpacing);
+    cmd.Parse(argc, argv);
+
+    BenchResult floating = RunCubic(false, acks, lossInterval, ackSpacing);
+    BenchResult fixed = RunCubic(true, acks, lossInterval, ackSpacing);
+
+    double maxDifference = 0;
+    uint32_t differentAcks = 0;
+    for (uint32_t i = 0; i < acks; i++)
+    {
+        double difference = std::abs(static_cast<double>(fixed.cwnds[i]) - floating.cwnds[i]);
+        maxDifference = std::max(maxDifference, difference / floating.cwnds[i]);
+        differentAcks += difference > 0;
+    }
+
+    std::cout << "floating point: " << floating.nsPerAck << " ns/ack" << std::endl;
+    std::cout << "fixed point:    " << fixed.nsPerAck << " ns/ack" << std::endl;
+    std::cout << "cWnd differs on " << differentAcks << " of " << acks
+              << " ACKs, by at most " << maxDifference * 100 << "%" << std::endl;
+    return 0;
+}
@@ -0,0 +1,55 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+// This program formats the records of a binary log, written by the
+// NS_LOG statements while the binary log is enabled (see LogBinaryEnable()),
+// as the text output of the NS_LOG statements.
+// Sample usage:  ./ns3 run 'decode-log --input=run.nslog --output=run.log'
+
+#include "ns3/command-line.h"
+#include "ns3/log.h"
+
+#include <fstream>
+#include <iostream>
+#include <string>
+
+using namespace ns3;
+
+int
+main(int argc, char* argv[])
+{
+    std::string input;
+    std::string output;
+
+    CommandLine cmd(__FILE__);
+    cmd.AddValue("input", "The binary log", input);
+    cmd.AddValue("output", "The text file, standard output if empty", output);
+    cmd.Parse(argc, argv);
+
+    std::ifstream is(input, std::ios::binary);
+    if (!is.is_open())
+    {
+        std::cerr << "Cannot open " << input << std::endl;
+        return 1;
+    }
+
+    std::ofstream file;
+    if (!output.empty())
+    {
+        file.open(output);
+        if (!file.is_open())
+        {
+            std::cerr << "Cannot open " << output << std::endl;
+            return 1;
+        }
+    }
+    std::ostream& os = output.empty() ? std::cout : file;
+
+    if (!LogBinaryDecode(is, os))
+    {
+        std::cerr << input << " is not a complete binary log" << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,155 @@
+import glob
+import itertools
+import json
+import os
+import subprocess
+import time
+from concurrent.futures import ThreadPoolExecutor, as_completed
+
+import fire
+
+NS3_DIR = 'ns-allinone-3.43/ns-3.43'
+TARGET = 'adaptive-tcp-test'
+
+# Command-line values of adaptive-tcp-test that make up one scenario
+SWEEP_PARAMETERS = ['linkBandwidth', 'delay', 'buffer', 'senderCount', 'simulationTime']
+
+
+def parse_values(values):
+    # fire hands us either a scalar, a tuple or a comma separated string
+    if isinstance(values, (list, tuple)):
+        return [str(v) for v in values]
+    return [v.strip() for v in str(values).split(',') if v.strip()]
+
+
+def load_scenarios(list_file):
+    # One scenario per line, either as a JSON object or as "key=value key=value"
+    scenarios = []
+    with open(list_file, 'r') as f:
+        for line in f:
+            line = line.strip()
+            if not line or line.startswith('#'):
+                continue
+            if line.startswith('{'):
+                scenario = {k: str(v) for k, v in json.loads(line).items()}
+            else:
+                scenario = dict(item.split('=', 1) for item in line.split())
+            unknown = set(scenario) - set(SWEEP_PARAMETERS)
+            if unknown:
+                raise ValueError(f'Unknown parameters {sorted(unknown)} in {list_file}')
+            scenarios.append(scenario)
+    return scenarios
+
+
+def build_grid(grid):
+    keys = [k for k in SWEEP_PARAMETERS if k in grid]
+    return [dict(zip(keys, combo)) for combo in itertools.product(*(grid[k] for k in keys))]
+
+
+def scenario_name(index, scenario):
+    parts = [scenario[k] for k in SWEEP_PARAMETERS if k in scenario]
+    return f'{index:05d}-' + '-'.join(parts)
+
+
+def find_executable(ns3_dir):
+    candidates = glob.glob(os.path.join(ns3_dir, 'build', 'scratch', 'adaptive-tcp', f'ns3*-{TARGET}-*'))
+    if not candidates:
+        raise FileNotFoundError(f'Could not find the {TARGET} executable under {ns3_dir}/build')
+    # Prefer the most recently built profile
+    return max(candidates, key=os.path.getmtime)
+
+
+def run_scenario(executable, env, results_dir, index, scenario, seed, traces):
+    name = scenario_name(index, scenario)
+    args = [executable] + [f'--{k}={v}' for k, v in scenario.items()]
+    args += [f'--output={name}', f'--RngRun={seed}', f'--traces={str(traces).lower()}']
+
+    start = time.time()
+    with open(os.path.join(results_dir, f'{name}.log'), 'w') as log:
+        returncode = subprocess.call(args, cwd=results_dir, env=env, stdout=log, stderr=subprocess.STDOUT)
+
+    outputs = sorted(os.path.basename(p) for p in glob.glob(os.path.join(results_dir, f'{name}.*'))
+                     if not p.endswith('.log'))
+    summary = None
+    summary_file = os.path.join(results_dir, f'{name}.summary.json')
+    if returncode == 0 and os.path.exists(summary_file):
+        with open(summary_file, 'r') as f:
+            summary = json.load(f)
+    return {
+        'index': index,
+        'name': name,
+        'parameters': scenario,
+        'rngRun': seed,
+        'returncode': returncode,
+        'wallTime': time.time() - start,
+        'log': f'{name}.log',
+        'outputs': outputs,
+        'summary': summary,
+    }
+
+
+def run_sweep(
+        results_dir='sweep-results',
+        list_file=None,
+        linkBandwidth='1000Mbps',
+        delay='2ms',
+        buffer='50p',
+        senderCount='8',
+        simulationTime='60',
+        jobs=None,
+        base_seed=1,
+        ns3_dir=NS3_DIR,
+        build=True,
+        traces=True):
+    """Run adaptive-tcp-test for every scenario of a grid (or of list_file) in parallel.
+
+    Grid values are comma separated, e.g. --linkBandwidth=100Mbps,1000Mbps --delay=2ms,20ms.
+    Every run gets RngRun = base_seed + its index, writes into results_dir and is
+    listed in results_dir/index.json, together with its metrics summary.
+    With --traces=False the runs skip the per-flow traces and only write their summary.
+    """
+    if list_file:
+        scenarios = load_scenarios(list_file)
+    else:
+        scenarios = build_grid({
+            'linkBandwidth': parse_values(linkBandwidth),
+            'delay': parse_values(delay),
+            'buffer': parse_values(buffer),
+            'senderCount': parse_values(senderCount),
+            'simulationTime': parse_values(simulationTime),
+        })
+
+    if build:
+        subprocess.check_call(['./ns3', 'build', TARGET], cwd=ns3_dir)
+
+    executable = os.path.abspath(find_executable(ns3_dir))
+    env = dict(os.environ)
+    lib_dir = os.path.abspath(os.path.join(ns3_dir, 'build', 'lib'))
+    env['LD_LIBRARY_PATH'] = os.pathsep.join(filter(None, [lib_dir, env.get('LD_LIBRARY_PATH')]))
+
+    os.makedirs(results_dir, exist_ok=True)
+    results_dir = os.path.abspath(results_dir)
+    jobs = int(jobs or os.cpu_count() or 1)
+
+    print(f'Running {len(scenarios)} scenarios on {jobs} workers into {results_dir}')
+    runs = []
+    with ThreadPoolExecutor(max_workers=jobs) as pool:
+        futures = [pool.submit(run_scenario, executable, env, results_dir, i, s, base_seed + i, traces)
+                   for i, s in enumerate(scenarios)]
+        for future in as_completed(futures):
+            run = future.result()
+            runs.append(run)
+            status = 'ok' if run['returncode'] == 0 else f'failed ({run["returncode"]})'
+            print(f'[{len(runs)}/{len(scenarios)}] {run["name"]}: {status} in {run["wallTime"]:.1f}s')
+
+    runs.sort(key=lambda r: r['index'])
+    with open(os.path.join(results_dir, 'index.json'), 'w') as f:
+        json.dump({'executable': executable, 'runs': runs}, f, indent=4)
+
+    failed = [r['name'] for r in runs if r['returncode'] != 0]
+    if failed:
+        print(f'{len(failed)} scenarios failed: {", ".join(failed)}')
+
+
+if __name__ == '__main__':
+    fire.Fire(run_sweep)